@@ -0,0 +1,79 @@
+#include "market_data/basket_engine.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+using namespace mini_mart::market_data;
+using namespace mini_mart::types;
+
+// Constituent tick cost of BasketEngine over a 10k-symbol universe with
+// range(0) baskets of 200 constituents each (random, so a symbol sits in
+// baskets x 200 / 10k baskets on average). Every range(1) ticks the
+// changed baskets are flushed into the store, as a feed commit would (16 is
+// the default store_commit_batch); 4096 shows the delta path alone.
+
+namespace {
+
+struct LargeIndex {
+  static constexpr size_t CAPACITY = 16384;
+  static constexpr bool FIXED_SLOTS = false;
+};
+using LargeStore = BasicSecurityStore<LargeIndex>;
+
+constexpr size_t UNIVERSE = 10000;
+constexpr size_t BASKET_SIZE = 200;
+
+SecurityId symbol(char prefix, size_t n) {
+  char text[16];
+  std::snprintf(text, sizeof(text), "%c%zu", prefix, n);
+  return make_security_id(text);
+}
+
+void BM_BasketEngineTick(benchmark::State &state) {
+  const auto baskets = static_cast<size_t>(state.range(0));
+  const auto flush_every = static_cast<size_t>(state.range(1));
+  auto store = std::make_shared<LargeStore>();
+  std::vector<MarketDataL2Message> ticks(4096);
+  for (size_t i = 0; i < UNIVERSE; ++i) {
+    store->add_security(symbol('S', i));
+  }
+  auto engine = std::make_unique<BasketEngine<LargeStore>>(store);
+  uint64_t rng = 3;
+  const auto next = [&rng] {
+    rng = rng * 6364136223846793005ull + 1442695040888963407ull;
+    return rng >> 33;
+  };
+  std::vector<BasketComponent> components(BASKET_SIZE);
+  for (size_t b = 0; b < baskets; ++b) {
+    for (auto &component : components) {
+      component = {symbol('S', next() % UNIVERSE), BasketWeight{static_cast<uint64_t>(1 + next() % 5000000)}};
+    }
+    engine->add_basket(symbol('B', b), components.data(), components.size(), BasketWeight{1000.0});
+  }
+  for (auto &tick : ticks) {
+    tick.security_id = symbol('S', next() % UNIVERSE);
+    tick.bids[0].price = Price{1000000 + next() % 10000};
+    tick.asks[0].price = tick.bids[0].price + 100u;
+    tick.num_bid_levels = 1;
+    tick.num_ask_levels = 1;
+  }
+
+  size_t i = 0;
+  for (auto _ : state) {
+    engine->on_message(ticks[i++ & (ticks.size() - 1)]);
+    if (i % flush_every == 0) {
+      engine->flush();
+    }
+  }
+  state.counters["memberships/tick"] =
+      static_cast<double>(engine->memberships_applied()) / static_cast<double>(engine->ticks());
+  state.counters["published/tick"] =
+      static_cast<double>(engine->baskets_published()) / static_cast<double>(engine->ticks());
+}
+
+} // namespace
+
+BENCHMARK(BM_BasketEngineTick)
+    ->ArgNames({"baskets", "flush_every"})
+    ->ArgsProduct({{100, 1000, 4000}, {16, 4096}});
@@ -0,0 +1,152 @@
+#include "common/perf_counters.hpp"
+#include "market_data/layout_report.hpp"
+#include "market_data/security_seeder.hpp"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+using namespace mini_mart::market_data;
+using namespace mini_mart::common;
+
+// Hardware cache misses per operation for the operations listed in
+// layout_report.hpp (run with `make bench-cache`). Counters are reported per
+// iteration; without a PMU (e.g. most VMs) only timings are produced.
+
+namespace {
+
+using EquityIndex = StaticSecurityIndex<SecuritySeeder::EQUITY_SYMBOLS>;
+
+// Runs op once per iteration with the perf group enabled around the loop
+template <typename Op> void measure(benchmark::State &state, Op &&op) {
+  PerfCounters counters;
+  const int error = counters.open();
+  counters.start();
+  for (auto _ : state) {
+    op();
+  }
+  counters.stop();
+
+  if (error != 0) {
+    state.SetLabel("perf counters unavailable");
+    return;
+  }
+  const PerfCounters::Values values = counters.read();
+  for (size_t i = 0; i < PerfCounters::EVENT_COUNT; ++i) {
+    state.counters[PerfCounters::event_name(static_cast<PerfCounters::Event>(i))] =
+        benchmark::Counter(static_cast<double>(values[i]),
+                           benchmark::Counter::kAvgIterations);
+  }
+}
+
+std::vector<MarketDataL2Message> make_messages(const std::vector<SecurityId> &ids) {
+  std::vector<MarketDataL2Message> messages;
+  for (size_t i = 0; i < 1024; ++i) {
+    MarketDataL2Message message{};
+    message.security_id = ids[(i * 7) % ids.size()];
+    message.num_bid_levels = 5;
+    message.num_ask_levels = 5;
+    messages.push_back(message);
+  }
+  return messages;
+}
+
+std::vector<SecurityId> numbered_ids(size_t count) {
+  std::vector<SecurityId> ids;
+  for (size_t i = 0; i < count; ++i) {
+    SecurityId id{};
+    id[0] = 'S';
+    id[1] = static_cast<char>('A' + i / 26 % 26);
+    id[2] = static_cast<char>('A' + i % 26);
+    ids.push_back(id);
+  }
+  return ids;
+}
+
+} // namespace
+
+static void BM_CacheMisses_RingPushPop(benchmark::State &state) {
+  auto ring = std::make_unique<SpscRing<MarketDataL2Message, 1024>>();
+  MarketDataL2Message in{};
+  MarketDataL2Message out{};
+  // Keep the ring half full so push and pop walk the whole buffer
+  for (size_t i = 0; i < 512; ++i) {
+    ring->try_push(in);
+  }
+  measure(state, [&] {
+    ring->try_push(in);
+    ring->try_pop(out);
+    benchmark::DoNotOptimize(out);
+  });
+}
+BENCHMARK(BM_CacheMisses_RingPushPop);
+
+// Argument: active securities (dynamic index scans them in order)
+static void BM_CacheMisses_StoreUpdateDynamic(benchmark::State &state) {
+  auto store = std::make_unique<SecurityStore>();
+  const auto ids = numbered_ids(static_cast<size_t>(state.range(0)));
+  for (const auto &id : ids) {
+    store->add_security(id);
+  }
+  const auto messages = make_messages(ids);
+  size_t i = 0;
+  measure(state, [&] {
+    benchmark::DoNotOptimize(store->update_from_l2(messages[i]));
+    i = (i + 1) & 1023;
+  });
+}
+BENCHMARK(BM_CacheMisses_StoreUpdateDynamic)->Arg(8)->Arg(64)->Arg(256);
+
+static void BM_CacheMisses_StoreUpdateStatic(benchmark::State &state) {
+  auto store = std::make_unique<BasicSecurityStore<EquityIndex>>();
+  std::vector<SecurityId> ids;
+  for (const auto &entry : SecuritySeeder::MAJOR_US_EQUITIES) {
+    ids.push_back(make_security_id(entry.symbol));
+    store->add_security(ids.back());
+  }
+  const auto messages = make_messages(ids);
+  size_t i = 0;
+  measure(state, [&] {
+    benchmark::DoNotOptimize(store->update_from_l2(messages[i]));
+    i = (i + 1) & 1023;
+  });
+}
+BENCHMARK(BM_CacheMisses_StoreUpdateStatic);
+
+static void BM_CacheMisses_StoreUnknownSymbol(benchmark::State &state) {
+  auto store = std::make_unique<SecurityStore>();
+  for (const auto &id : numbered_ids(8)) {
+    store->add_security(id);
+  }
+  MarketDataL2Message message{};
+  message.security_id = SecuritySeeder::create_security_id("NOPE");
+  measure(state, [&] { benchmark::DoNotOptimize(store->update_from_l2(message)); });
+}
+BENCHMARK(BM_CacheMisses_StoreUnknownSymbol);
+
+static void BM_CacheMisses_StoreSnapshot(benchmark::State &state) {
+  auto store = std::make_unique<SecurityStore>();
+  const auto ids = numbered_ids(static_cast<size_t>(state.range(0)));
+  for (const auto &id : ids) {
+    store->add_security(id);
+  }
+  SecurityStore::SecuritySnapshot snapshot;
+  size_t i = 0;
+  measure(state, [&] {
+    benchmark::DoNotOptimize(store->get_security_snapshot(ids[i], snapshot));
+    i = (i + 1) % ids.size();
+  });
+}
+BENCHMARK(BM_CacheMisses_StoreSnapshot)->Arg(8)->Arg(256);
+
+static void BM_CacheMisses_LatencyRecord(benchmark::State &state) {
+  auto monitor = std::make_unique<LatencyMonitor>();
+  monitor->configure(1000000, {});
+  uint64_t now = 0;
+  uint64_t latency = 100;
+  measure(state, [&] {
+    monitor->record(FeedStage::RING_WAIT, latency, now);
+    now += 10;
+    latency = (latency * 7 + 13) & 65535;
+  });
+}
+BENCHMARK(BM_CacheMisses_LatencyRecord);
@@ -0,0 +1,100 @@
+#include "market_data/covariance_matrix.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <memory>
+
+using namespace mini_mart::common;
+using namespace mini_mart::market_data;
+using namespace mini_mart::types;
+
+// EwmaCovarianceMatrix over 256 symbols with a 10 s half-life. Update:
+// per-tick cost on the consumer path (one row pass). Publish: cost of
+// bringing the back buffer up to date after a given number of ticks,
+// incrementally (changed rows and their columns) or as a full refresh
+// spread over a WorkStealingPool with the given number of workers.
+
+namespace {
+
+constexpr size_t SYMBOLS = 256;
+constexpr uint64_t TICK_NS = 40000;
+constexpr uint64_t HALF_LIFE_NS = 10000000000;
+
+struct Setup {
+  std::unique_ptr<EwmaCovarianceMatrix<>> matrix;
+  uint64_t rng = 19;
+  uint64_t now = 0;
+
+  explicit Setup(WorkStealingPool *pool = nullptr)
+      : matrix(std::make_unique<EwmaCovarianceMatrix<>>(HALF_LIFE_NS, 0, pool)) {
+    for (size_t i = 0; i < SYMBOLS; ++i) {
+      char symbol[16];
+      std::snprintf(symbol, sizeof(symbol), "S%zu", i);
+      matrix->add_security(make_security_id(symbol));
+    }
+    for (size_t i = 0; i < SYMBOLS * 4; ++i) {
+      tick();
+    }
+  }
+
+  void tick() {
+    rng = rng * 6364136223846793005ull + 1442695040888963407ull;
+    now += TICK_NS;
+    const size_t index = static_cast<size_t>(rng >> 33) % SYMBOLS;
+    matrix->update(index, Price{1000000 + ((rng >> 40) & 1023)}, now);
+  }
+};
+
+void BM_CovarianceUpdate(benchmark::State &state) {
+  Setup setup;
+  for (auto _ : state) {
+    setup.tick();
+  }
+}
+
+// Ticks between publishes (range 0), pool workers (range 1; 0: no pool)
+void BM_CovariancePublish(benchmark::State &state) {
+  const auto ticks = static_cast<size_t>(state.range(0));
+  WorkStealingPool::Config config;
+  config.num_workers = static_cast<size_t>(state.range(1));
+  WorkStealingPool pool(config);
+  if (config.num_workers > 0) {
+    pool.start();
+  }
+  Setup setup(config.num_workers > 0 ? &pool : nullptr);
+  uint64_t rows = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    for (size_t i = 0; i < ticks; ++i) {
+      setup.tick();
+    }
+    state.ResumeTiming();
+    rows += setup.matrix->publish(setup.now);
+  }
+  state.counters["rows/publish"] = static_cast<double>(rows) / static_cast<double>(state.iterations());
+  if (config.num_workers > 0) {
+    pool.stop();
+  }
+}
+
+void BM_CovarianceReadRow(benchmark::State &state) {
+  Setup setup;
+  setup.matrix->publish(setup.now);
+  double row[SYMBOLS];
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(setup.matrix->correlation_row(i++ % SYMBOLS, row));
+    benchmark::ClobberMemory();
+  }
+}
+
+} // namespace
+
+BENCHMARK(BM_CovarianceUpdate);
+BENCHMARK(BM_CovariancePublish)
+    ->Args({4, 0})
+    ->Args({32, 0})
+    ->Args({1024, 0})
+    ->Args({1024, 1})
+    ->Args({1024, 2})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_CovarianceReadRow);
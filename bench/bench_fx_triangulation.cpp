@@ -0,0 +1,43 @@
+#include "market_data/fx_triangulation.hpp"
+#include "market_data/security_seeder.hpp"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+using namespace mini_mart::market_data;
+using namespace mini_mart::types;
+
+// Cost of one pair update over SecuritySeeder's 15 major FX pairs: the
+// recompute of the triangles it is a leg of plus the arbitrage checks.
+
+namespace {
+
+void BM_FxTriangulationUpdate(benchmark::State &state) {
+  auto engine = std::make_unique<FxTriangulationEngine>();
+  for (const auto &id : SecuritySeeder::get_major_fx_pairs()) {
+    engine->add_pair(id);
+  }
+  const size_t pairs = engine->pair_count();
+  std::vector<Price> mids(pairs);
+  for (size_t i = 0; i < pairs; ++i) {
+    const bool yen = engine->pair_id(i)[3] == 'J';
+    mids[i] = price_from_dollars(yen ? 150.0 : 1.1);
+    engine->update(i, mids[i], mids[i] + 2u, 0);
+  }
+
+  uint64_t rng = 1;
+  uint64_t now = 0;
+  for (auto _ : state) {
+    rng = rng * 6364136223846793005ull + 1442695040888963407ull;
+    const size_t index = (rng >> 33) % pairs;
+    const Price bid = mids[index] + ((rng >> 20) & 7);
+    engine->update(index, bid, bid + 2u, ++now);
+  }
+  state.counters["triangles"] = static_cast<double>(engine->triangle_count());
+  state.counters["recomputes/update"] =
+      static_cast<double>(engine->triangles_recomputed()) / static_cast<double>(engine->updates());
+}
+
+} // namespace
+
+BENCHMARK(BM_FxTriangulationUpdate);
@@ -0,0 +1,77 @@
+#include "market_data/instrument_loader.hpp"
+#include "market_data/security_seeder.hpp"
+#include <benchmark/benchmark.h>
+#include <string>
+#include <unordered_map>
+
+using namespace mini_mart::market_data;
+
+namespace {
+
+constexpr size_t UNIVERSE_SIZE = 100000;
+
+std::string make_symbol(size_t index) {
+  std::string symbol(5, 'A');
+  for (size_t i = 5; i > 0; --i) {
+    symbol[i - 1] = static_cast<char>('A' + index % 26);
+    index /= 26;
+  }
+  return symbol;
+}
+
+const std::string &universe_csv() {
+  static const std::string csv = [] {
+    std::string text = "symbol,tick_size,base_price,lot_size,venue\n";
+    text.reserve(UNIVERSE_SIZE * 32);
+    for (size_t i = 0; i < UNIVERSE_SIZE; ++i) {
+      // Scrambled order so build() has real sorting to do
+      text += make_symbol((i * 7919) % UNIVERSE_SIZE);
+      text += ",0.01,";
+      text += std::to_string(10 + i % 500);
+      text += ".25,100,XNAS\n";
+    }
+    return text;
+  }();
+  return csv;
+}
+
+} // namespace
+
+static void BM_LoadCsvUniverse(benchmark::State &state) {
+  const std::string &csv = universe_csv();
+  InstrumentDirectory directory;
+  for (auto _ : state) {
+    auto result = InstrumentLoader::load_csv(csv, directory);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(UNIVERSE_SIZE));
+}
+BENCHMARK(BM_LoadCsvUniverse)->Unit(benchmark::kMillisecond);
+
+static void BM_DirectoryLookup(benchmark::State &state) {
+  InstrumentDirectory directory;
+  InstrumentLoader::load_csv(universe_csv(), directory);
+  const auto ids = directory.get_security_ids();
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(directory.find(ids[i]));
+    i = (i + 7919) % ids.size();
+  }
+}
+BENCHMARK(BM_DirectoryLookup);
+
+// Baseline: the SecuritySeeder approach (std::string keyed unordered_map)
+static void BM_StringMapLookup(benchmark::State &state) {
+  std::unordered_map<std::string, SecuritySeeder::EquityInfo> map;
+  std::vector<std::string> symbols;
+  for (size_t i = 0; i < UNIVERSE_SIZE; ++i) {
+    symbols.push_back(make_symbol(i));
+    map.emplace(symbols.back(), SecuritySeeder::EquityInfo{symbols.back(), "", 100.0});
+  }
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(map.find(symbols[i]));
+    i = (i + 7919) % symbols.size();
+  }
+}
+BENCHMARK(BM_StringMapLookup);
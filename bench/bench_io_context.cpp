@@ -0,0 +1,287 @@
+#include "server/io_context.hpp"
+#include <benchmark/benchmark.h>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <functional>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <unordered_map>
+
+using namespace mini_mart::server;
+
+namespace {
+
+constexpr int CONNECTIONS_PER_ITERATION = 100;
+constexpr int ROUND_TRIPS_PER_ITERATION = 1000;
+constexpr size_t MESSAGE_SIZE = 64;
+
+sockaddr_in loopback(uint16_t port) {
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  return addr;
+}
+
+// RST on close so repeated connects do not exhaust ports in TIME_WAIT
+void close_with_reset(int fd) {
+  linger lin{1, 0};
+  ::setsockopt(fd, SOL_SOCKET, SO_LINGER, &lin, sizeof(lin));
+  ::close(fd);
+}
+
+// ---------------------------------------------------------------------------
+// Coroutine design
+// ---------------------------------------------------------------------------
+
+Task<void> coro_acceptor(IoContext &context, int listen_fd, int count) {
+  AsyncFd listener(context, listen_fd);
+  for (int i = 0; i < count; ++i) {
+    const int fd = co_await async_accept(listener);
+    if (fd >= 0) {
+      ::close(fd);
+    }
+  }
+}
+
+Task<void> coro_connector(IoContext &context, uint16_t port, int count) {
+  for (int i = 0; i < count; ++i) {
+    const int fd = open_tcp_socket();
+    {
+      AsyncFd socket(context, fd);
+      co_await async_connect(socket, loopback(port));
+    }
+    close_with_reset(fd);
+  }
+}
+
+Task<void> coro_echo_server(IoContext &context, int listen_fd) {
+  AsyncFd listener(context, listen_fd);
+  const int fd = co_await async_accept(listener);
+  AsyncFd conn(context, fd);
+  char buffer[MESSAGE_SIZE];
+  for (;;) {
+    const ssize_t n = co_await async_read(conn, buffer, sizeof(buffer));
+    if (n <= 0) {
+      break;
+    }
+    co_await async_write(conn, buffer, static_cast<size_t>(n));
+  }
+  ::close(fd);
+}
+
+Task<void> coro_ping_client(IoContext &context, int fd, uint16_t port,
+                            benchmark::State &state) {
+  AsyncFd socket(context, fd);
+  co_await async_connect(socket, loopback(port));
+  char buffer[MESSAGE_SIZE] = {};
+
+  for (auto _ : state) {
+    for (int i = 0; i < ROUND_TRIPS_PER_ITERATION; ++i) {
+      co_await async_write(socket, buffer, sizeof(buffer));
+      size_t received = 0;
+      while (received < sizeof(buffer)) {
+        const ssize_t n =
+            co_await async_read(socket, buffer + received, sizeof(buffer) - received);
+        if (n <= 0) {
+          co_return;
+        }
+        received += static_cast<size_t>(n);
+      }
+    }
+  }
+  ::shutdown(fd, SHUT_WR);
+}
+
+// ---------------------------------------------------------------------------
+// Equivalent callback design: epoll loop dispatching to per-fd handlers
+// ---------------------------------------------------------------------------
+
+class CallbackLoop {
+public:
+  using Handler = std::function<void(uint32_t)>;
+
+  CallbackLoop() : epoll_fd_(::epoll_create1(EPOLL_CLOEXEC)) {}
+  ~CallbackLoop() { ::close(epoll_fd_); }
+
+  void add(int fd, uint32_t events, Handler handler) {
+    handlers_[fd] = std::move(handler);
+    epoll_event event{};
+    event.events = events;
+    event.data.fd = fd;
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event);
+  }
+
+  void remove(int fd) {
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    handlers_.erase(fd);
+  }
+
+  void run_until(const bool &done) {
+    epoll_event events[64];
+    while (!done) {
+      const int count = ::epoll_wait(epoll_fd_, events, 64, -1);
+      for (int i = 0; i < count; ++i) {
+        auto it = handlers_.find(events[i].data.fd);
+        if (it != handlers_.end()) {
+          Handler handler = it->second;
+          handler(events[i].events);
+        }
+      }
+    }
+  }
+
+private:
+  int epoll_fd_;
+  std::unordered_map<int, Handler> handlers_;
+};
+
+struct CallbackConnector {
+  CallbackLoop &loop;
+  uint16_t port;
+  int remaining;
+  bool &done;
+
+  void start_next() {
+    if (remaining == 0) {
+      done = true;
+      return;
+    }
+    --remaining;
+    const int fd = open_tcp_socket();
+    sockaddr_in addr = loopback(port);
+    if (::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0) {
+      close_with_reset(fd);
+      start_next();
+      return;
+    }
+    loop.add(fd, EPOLLOUT, [this, fd](uint32_t) {
+      loop.remove(fd);
+      close_with_reset(fd);
+      start_next();
+    });
+  }
+};
+
+} // namespace
+
+static void BM_CoroutineConnectionsPerSec(benchmark::State &state) {
+  uint16_t port = 0;
+  const int listen_fd = open_tcp_listener(0, 1024, &port);
+  IoContext context;
+  for (auto _ : state) {
+    context.spawn(coro_acceptor(context, listen_fd, CONNECTIONS_PER_ITERATION));
+    context.spawn(coro_connector(context, port, CONNECTIONS_PER_ITERATION));
+    context.run();
+  }
+  ::close(listen_fd);
+  state.SetItemsProcessed(state.iterations() * CONNECTIONS_PER_ITERATION);
+}
+BENCHMARK(BM_CoroutineConnectionsPerSec)->UseRealTime();
+
+static void BM_CallbackConnectionsPerSec(benchmark::State &state) {
+  uint16_t port = 0;
+  const int listen_fd = open_tcp_listener(0, 1024, &port);
+  CallbackLoop loop;
+  loop.add(listen_fd, EPOLLIN, [listen_fd](uint32_t) {
+    for (;;) {
+      const int fd = ::accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK);
+      if (fd < 0) {
+        break;
+      }
+      ::close(fd);
+    }
+  });
+
+  for (auto _ : state) {
+    bool done = false;
+    CallbackConnector connector{loop, port, CONNECTIONS_PER_ITERATION, done};
+    connector.start_next();
+    loop.run_until(done);
+  }
+  loop.remove(listen_fd);
+  ::close(listen_fd);
+  state.SetItemsProcessed(state.iterations() * CONNECTIONS_PER_ITERATION);
+}
+BENCHMARK(BM_CallbackConnectionsPerSec)->UseRealTime();
+
+// Both ends on one loop: measures runtime overhead per 64-byte round trip
+static void BM_CoroutinePingPongLatency(benchmark::State &state) {
+  uint16_t port = 0;
+  const int listen_fd = open_tcp_listener(0, 16, &port);
+  const int client_fd = open_tcp_socket();
+  IoContext context;
+  context.spawn(coro_echo_server(context, listen_fd));
+  context.spawn(coro_ping_client(context, client_fd, port, state));
+  context.run();
+  ::close(client_fd);
+  ::close(listen_fd);
+  state.SetItemsProcessed(state.iterations() * ROUND_TRIPS_PER_ITERATION);
+}
+BENCHMARK(BM_CoroutinePingPongLatency)->UseRealTime();
+
+static void BM_CallbackPingPongLatency(benchmark::State &state) {
+  uint16_t port = 0;
+  const int listen_fd = open_tcp_listener(0, 16, &port);
+  const int client_fd = open_tcp_socket();
+  sockaddr_in addr = loopback(port);
+  ::connect(client_fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+
+  CallbackLoop loop;
+  int server_fd = -1;
+  char server_buffer[MESSAGE_SIZE];
+  char client_buffer[MESSAGE_SIZE] = {};
+  size_t client_received = 0;
+  int remaining = 0;
+  bool done = false;
+
+  loop.add(listen_fd, EPOLLIN, [&](uint32_t) {
+    server_fd = ::accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK);
+    loop.remove(listen_fd);
+    loop.add(server_fd, EPOLLIN, [&](uint32_t) {
+      for (;;) {
+        const ssize_t n = ::recv(server_fd, server_buffer, sizeof(server_buffer), 0);
+        if (n <= 0) {
+          break;
+        }
+        ::send(server_fd, server_buffer, static_cast<size_t>(n), MSG_NOSIGNAL);
+      }
+    });
+  });
+  loop.add(client_fd, EPOLLIN, [&](uint32_t) {
+    for (;;) {
+      const ssize_t n = ::recv(client_fd, client_buffer + client_received,
+                               sizeof(client_buffer) - client_received, 0);
+      if (n <= 0) {
+        break;
+      }
+      client_received += static_cast<size_t>(n);
+      if (client_received == sizeof(client_buffer)) {
+        client_received = 0;
+        if (--remaining == 0) {
+          done = true;
+          break;
+        }
+        ::send(client_fd, client_buffer, sizeof(client_buffer), MSG_NOSIGNAL);
+      }
+    }
+  });
+
+  for (auto _ : state) {
+    remaining = ROUND_TRIPS_PER_ITERATION;
+    done = false;
+    ::send(client_fd, client_buffer, sizeof(client_buffer), MSG_NOSIGNAL);
+    loop.run_until(done);
+  }
+
+  loop.remove(client_fd);
+  if (server_fd >= 0) {
+    loop.remove(server_fd);
+    ::close(server_fd);
+  }
+  ::close(client_fd);
+  ::close(listen_fd);
+  state.SetItemsProcessed(state.iterations() * ROUND_TRIPS_PER_ITERATION);
+}
+BENCHMARK(BM_CallbackPingPongLatency)->UseRealTime();
@@ -0,0 +1,39 @@
+#include "market_data/feed_policies.hpp"
+#include "market_data/latency_monitor.hpp"
+#include <benchmark/benchmark.h>
+#include <memory>
+
+using namespace mini_mart::market_data;
+
+// Per-hop cost of the stage monitors: one histogram sample plus SLO checks
+static void BM_LatencyMonitorRecord(benchmark::State &state) {
+  auto monitor = std::make_unique<LatencyMonitor>();
+  std::array<LatencyBudget, FEED_STAGE_COUNT> budgets{};
+  budgets[static_cast<size_t>(FeedStage::RING_WAIT)] = {50000, 1000000};
+  monitor->configure(1000000, budgets);
+
+  uint64_t now = 0;
+  uint64_t latency = 100;
+  for (auto _ : state) {
+    monitor->record(FeedStage::RING_WAIT, latency, now);
+    now += 10;
+    latency = (latency * 7 + 13) & 4095;
+  }
+  benchmark::DoNotOptimize(monitor->get_snapshot(FeedStage::RING_WAIT));
+}
+BENCHMARK(BM_LatencyMonitorRecord);
+
+// Clock read plus record: what one feed hop adds with statistics on
+static void BM_LatencyMonitorStampAndRecord(benchmark::State &state) {
+  auto monitor = std::make_unique<LatencyMonitor>();
+  monitor->configure(1000000, {});
+
+  uint64_t previous = HighResolutionClock::now_ns();
+  for (auto _ : state) {
+    const uint64_t now = HighResolutionClock::now_ns();
+    monitor->record(FeedStage::STORE_APPLY, now - previous, now);
+    previous = now;
+  }
+  benchmark::DoNotOptimize(monitor->get_snapshot(FeedStage::STORE_APPLY));
+}
+BENCHMARK(BM_LatencyMonitorStampAndRecord);
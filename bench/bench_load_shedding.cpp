@@ -0,0 +1,147 @@
+#include "market_data/latency_monitor.hpp"
+#include "market_data/load_shedder.hpp"
+#include "market_data/market_data_feed.hpp"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace mini_mart::market_data;
+using namespace mini_mart::common;
+
+namespace {
+
+constexpr size_t HIGH_PER_BURST = 256;
+constexpr size_t HIGH_SYMBOLS = 4;
+constexpr size_t LOW_SYMBOLS = 60;
+constexpr uint64_t APPLY_COST_NS = 300; // slow consumer, so bursts overload
+
+class DirectProvider : public MarketDataProvider {
+public:
+  bool start() override { return true; }
+  void stop() override {}
+  bool is_running() const override { return true; }
+  bool subscribe(const SecurityId &) override { return true; }
+  bool unsubscribe(const SecurityId &) override { return true; }
+  void set_callback(MarketDataCallback callback) override {
+    callback_ = std::move(callback);
+  }
+  std::vector<SecurityId> get_subscribed_securities() const override { return {}; }
+
+  void publish(const MarketDataL2Message &message) { callback_(message); }
+
+private:
+  MarketDataCallback callback_;
+};
+
+struct HighLatencyState {
+  LatencyHistogram histogram; // consumer thread only
+  std::atomic<uint64_t> seen{0};
+  std::atomic<uint64_t> high_delivered{0};
+};
+
+// Burns APPLY_COST_NS per message and records ring-wait latency of the
+// high-priority securities (message.timestamp_ns is the enqueue time)
+struct SlowObserver {
+  std::shared_ptr<HighLatencyState> state;
+  bool on_message(const MarketDataL2Message &message) {
+    const uint64_t start = HighResolutionClock::now_ns();
+    if (message.security_id[0] == 'H') {
+      state->histogram.record(start - message.timestamp_ns);
+      state->high_delivered.fetch_add(1, std::memory_order_relaxed);
+    }
+    while (HighResolutionClock::now_ns() - start < APPLY_COST_NS) {
+    }
+    state->seen.fetch_add(1, std::memory_order_release);
+    return true;
+  }
+};
+
+SecurityId symbol(char prefix, size_t i) {
+  SecurityId id{};
+  id[0] = prefix;
+  id[1] = static_cast<char>('A' + i / 26);
+  id[2] = static_cast<char>('A' + i % 26);
+  return id;
+}
+
+// Each iteration publishes a burst of HIGH_PER_BURST high-priority updates,
+// each followed by range(0) low-priority ones, then drains. With 0 the
+// high-priority latency is the baseline; shedding low priority at 10%
+// occupancy should keep it there as the low-priority load grows.
+template <typename Overload> void run_burst(benchmark::State &state) {
+  using Sink = FanoutSink<StoreSink<SecurityStore>, SlowObserver>;
+  using Feed = BasicMarketDataFeed<SpscRing<MarketDataL2Message, 1024>, YieldWait,
+                                   HighResolutionClock, RuntimeStatistics, Sink, Overload>;
+  const auto low_per_high = static_cast<size_t>(state.range(0));
+  const size_t burst = HIGH_PER_BURST * (1 + low_per_high);
+
+  auto provider = std::make_shared<DirectProvider>();
+  auto store = std::make_shared<SecurityStore>();
+  auto latency = std::make_shared<HighLatencyState>();
+  FeedConfig config;
+  config.default_priority = SymbolPriority::LOW;
+  config.shed_rules[static_cast<size_t>(SymbolPriority::LOW)] = {10, ShedAction::CONFLATE};
+  auto feed = std::make_unique<Feed>(
+      provider, Sink(StoreSink<SecurityStore>(store), SlowObserver{latency}), config);
+
+  std::vector<MarketDataL2Message> messages(burst);
+  for (size_t i = 0; i < burst; ++i) {
+    const size_t high = i / (1 + low_per_high);
+    messages[i].security_id = i % (1 + low_per_high) == 0
+                                  ? symbol('H', high % HIGH_SYMBOLS)
+                                  : symbol('L', i % LOW_SYMBOLS);
+    messages[i].num_bid_levels = 5;
+    messages[i].num_ask_levels = 5;
+  }
+  feed->start();
+  for (size_t i = 0; i < HIGH_SYMBOLS; ++i) {
+    feed->subscribe(symbol('H', i));
+    feed->set_priority(symbol('H', i), SymbolPriority::HIGH);
+  }
+  for (size_t i = 0; i < LOW_SYMBOLS; ++i) {
+    feed->subscribe(symbol('L', i));
+  }
+
+  uint64_t high_published = 0;
+  for (auto _ : state) {
+    for (const auto &message : messages) {
+      provider->publish(message);
+      high_published += message.security_id[0] == 'H' ? 1u : 0u;
+    }
+    // Drain before the next burst
+    while (latency->seen.load(std::memory_order_acquire) <
+           feed->get_statistics().messages_produced.load(std::memory_order_relaxed)) {
+      std::this_thread::yield();
+    }
+  }
+  feed->stop();
+
+  const auto &stats = feed->get_statistics();
+  state.counters["high_p50_us"] = static_cast<double>(latency->histogram.percentile(0.50)) / 1e3;
+  state.counters["high_p99_us"] = static_cast<double>(latency->histogram.percentile(0.99)) / 1e3;
+  state.counters["high_delivered_pct"] =
+      100.0 * static_cast<double>(latency->high_delivered.load()) /
+      static_cast<double>(high_published);
+  state.counters["ring_full"] = static_cast<double>(stats.ring_full_events.load());
+  state.counters["conflated"] = static_cast<double>(stats.messages_conflated.load());
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(burst));
+}
+
+} // namespace
+
+// Argument: low-priority updates per high-priority update
+BENCHMARK(run_burst<NoLoadShedding>)
+    ->Name("BM_Burst/NoShedding")
+    ->Arg(0)
+    ->Arg(3)
+    ->Arg(15)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(run_burst<PriorityLoadShedder>)
+    ->Name("BM_Burst/PriorityShedding")
+    ->Arg(0)
+    ->Arg(3)
+    ->Arg(15)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -0,0 +1,172 @@
+#include "common/mpmc_ring.hpp"
+#include "market_data/market_data_feed.hpp"
+#include "market_data/security_seeder.hpp"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <sys/epoll.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace mini_mart::market_data;
+using namespace mini_mart::common;
+
+namespace {
+
+constexpr uint64_t MESSAGES_PER_ITERATION = 100000;
+
+// Publishes on the benchmark thread, so the measured path is exactly
+// callback -> ring -> consumer -> sink
+class DirectProvider : public MarketDataProvider {
+public:
+  bool start() override { return true; }
+  void stop() override {}
+  bool is_running() const override { return true; }
+  bool subscribe(const SecurityId &) override { return true; }
+  bool unsubscribe(const SecurityId &) override { return true; }
+  void set_callback(MarketDataCallback callback) override {
+    callback_ = std::move(callback);
+  }
+  std::vector<SecurityId> get_subscribed_securities() const override { return {}; }
+
+  void publish(const MarketDataL2Message &message) { callback_(message); }
+
+private:
+  MarketDataCallback callback_;
+};
+
+// Observer counting consumed messages; works with every statistics policy
+struct CountingSink {
+  std::shared_ptr<std::atomic<uint64_t>> count =
+      std::make_shared<std::atomic<uint64_t>>(0);
+  bool on_message(const MarketDataL2Message &) {
+    count->fetch_add(1, std::memory_order_release);
+    return true;
+  }
+};
+
+template <typename Ring, typename Wait, typename Stats>
+void run_feed(benchmark::State &state) {
+  using Sink = FanoutSink<StoreSink<SecurityStore>, CountingSink>;
+  using Feed = BasicMarketDataFeed<Ring, Wait, HighResolutionClock, Stats, Sink>;
+
+  auto provider = std::make_shared<DirectProvider>();
+  auto store = std::make_shared<SecurityStore>();
+  CountingSink counter;
+  FeedConfig config;
+  config.consumer_yield_us = 1;
+  Feed feed(provider, Sink(StoreSink<SecurityStore>(store), counter), config);
+
+  const SecurityId id = SecuritySeeder::create_security_id("AAPL");
+  feed.start();
+  feed.subscribe(id);
+
+  MarketDataL2Message message{};
+  message.security_id = id;
+  message.num_bid_levels = 5;
+  message.num_ask_levels = 5;
+
+  constexpr uint64_t window = Ring::get_capacity() / 2;
+  uint64_t published = 0;
+  for (auto _ : state) {
+    for (uint64_t i = 0; i < MESSAGES_PER_ITERATION; ++i) {
+      while (published - counter.count->load(std::memory_order_acquire) >= window) {
+        std::this_thread::yield();
+      }
+      provider->publish(message);
+      ++published;
+    }
+    while (counter.count->load(std::memory_order_acquire) < published) {
+      std::this_thread::yield();
+    }
+  }
+
+  feed.stop();
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<int64_t>(MESSAGES_PER_ITERATION));
+}
+
+// EventfdWait: the consumer is an epoll loop calling poll(), as a gateway
+// would run it. Reports eventfd writes per message.
+void BM_FeedEpollLoop(benchmark::State &state) {
+  using Sink = FanoutSink<StoreSink<SecurityStore>, CountingSink>;
+  using Feed = BasicMarketDataFeed<SpscRing<MarketDataL2Message, 1024>, EventfdWait,
+                                   HighResolutionClock, RuntimeStatistics, Sink>;
+
+  auto provider = std::make_shared<DirectProvider>();
+  auto store = std::make_shared<SecurityStore>();
+  CountingSink counter;
+  Feed feed(provider, Sink(StoreSink<SecurityStore>(store), counter));
+  const SecurityId id = SecuritySeeder::create_security_id("AAPL");
+  feed.start();
+  feed.subscribe(id);
+
+  std::atomic<bool> running{true};
+  std::thread loop([&] {
+    const int epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+    epoll_event event{};
+    event.events = EPOLLIN;
+    ::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, feed.notification_fd(), &event);
+    while (running.load(std::memory_order_relaxed)) {
+      epoll_event ready{};
+      if (::epoll_wait(epoll_fd, &ready, 1, 10) == 1) {
+        feed.poll(256);
+      }
+    }
+    ::close(epoll_fd);
+  });
+
+  MarketDataL2Message message{};
+  message.security_id = id;
+  message.num_bid_levels = 5;
+  message.num_ask_levels = 5;
+  constexpr uint64_t window = 512;
+  uint64_t published = 0;
+  for (auto _ : state) {
+    for (uint64_t i = 0; i < MESSAGES_PER_ITERATION; ++i) {
+      while (published - counter.count->load(std::memory_order_acquire) >= window) {
+        std::this_thread::yield();
+      }
+      provider->publish(message);
+      ++published;
+    }
+    while (counter.count->load(std::memory_order_acquire) < published) {
+      std::this_thread::yield();
+    }
+  }
+
+  running.store(false, std::memory_order_relaxed);
+  loop.join();
+  feed.stop();
+  state.counters["signals_per_msg"] =
+      static_cast<double>(feed.notifications_sent()) / static_cast<double>(published);
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<int64_t>(MESSAGES_PER_ITERATION));
+}
+
+using Spsc = SpscRing<MarketDataL2Message, 1024>;
+using Mpmc = MpmcRing<MarketDataL2Message, 1024>;
+
+} // namespace
+
+// The runtime-configured default (MarketDataFeed)
+BENCHMARK(run_feed<Spsc, ConfiguredWait, RuntimeStatistics>)
+    ->Name("BM_Feed/Spsc/ConfiguredWait/RuntimeStats")
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(run_feed<Spsc, BackoffWait, RuntimeStatistics>)
+    ->Name("BM_Feed/Spsc/Backoff/RuntimeStats")
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(run_feed<Spsc, SpinWait, NoStatistics>)
+    ->Name("BM_Feed/Spsc/Spin/NoStats")
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(run_feed<Spsc, BackoffWait, NoStatistics>)
+    ->Name("BM_Feed/Spsc/Backoff/NoStats")
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(run_feed<Mpmc, BackoffWait, AtomicStatistics>)
+    ->Name("BM_Feed/Mpmc/Backoff/AtomicStats")
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_FeedEpollLoop)->Unit(benchmark::kMillisecond)->UseRealTime();
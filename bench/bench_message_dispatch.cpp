@@ -0,0 +1,125 @@
+#include "types/message_envelope.hpp"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+using namespace mini_mart::types;
+
+// Cost of routing a mixed message stream to per-type handlers: the
+// envelope's visit() against a hand-written switch and virtual calls.
+// range(0) = 1 is a mixed stream (60% L2, 25% deltas, 10% trades, 5%
+// heartbeats in pseudo-random order), 0 is L2 only.
+
+namespace {
+
+constexpr size_t STREAM_SIZE = 4096;
+
+// Touches a field of each message so the handler cannot be elided
+struct Handler {
+  uint64_t sum = 0;
+  void operator()(const MarketDataL2Message &message) { sum += message.num_bid_levels; }
+  void operator()(const TradeMessage &message) { sum += message.quantity; }
+  void operator()(const BookDeltaMessage &message) { sum += message.level_index; }
+  void operator()(const HeartbeatMessage &message) { sum += message.header.seq_no; }
+};
+
+std::vector<MarketDataEnvelope> make_stream(bool mixed) {
+  std::vector<MarketDataEnvelope> stream(STREAM_SIZE);
+  uint32_t state = 12345;
+  for (auto &envelope : stream) {
+    state = state * 1664525u + 1013904223u;
+    const uint32_t pick = mixed ? (state >> 8) % 100 : 0;
+    if (pick < 60) {
+      MarketDataL2Message message{};
+      message.num_bid_levels = 5;
+      envelope.store(message);
+    } else if (pick < 85) {
+      BookDeltaMessage message{};
+      message.level_index = 1;
+      envelope.store(message);
+    } else if (pick < 95) {
+      TradeMessage message{};
+      message.quantity = 100;
+      envelope.store(message);
+    } else {
+      envelope.store(HeartbeatMessage{});
+    }
+  }
+  return stream;
+}
+
+void BM_Dispatch_Visit(benchmark::State &state) {
+  const auto stream = make_stream(state.range(0) != 0);
+  Handler handler;
+  for (auto _ : state) {
+    for (const auto &envelope : stream) {
+      envelope.visit(handler);
+    }
+  }
+  benchmark::DoNotOptimize(handler.sum);
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(STREAM_SIZE));
+}
+
+void BM_Dispatch_Switch(benchmark::State &state) {
+  const auto stream = make_stream(state.range(0) != 0);
+  Handler handler;
+  for (auto _ : state) {
+    for (const auto &envelope : stream) {
+      switch (envelope.type()) {
+      case MessageType::MARKET_DATA_L2:
+        handler(envelope.as<MarketDataL2Message>());
+        break;
+      case MessageType::TRADE:
+        handler(envelope.as<TradeMessage>());
+        break;
+      case MessageType::BOOK_DELTA:
+        handler(envelope.as<BookDeltaMessage>());
+        break;
+      case MessageType::HEARTBEAT:
+        handler(envelope.as<HeartbeatMessage>());
+        break;
+      case MessageType::ORDER_EVENT: // not an envelope type
+        break;
+      }
+    }
+  }
+  benchmark::DoNotOptimize(handler.sum);
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(STREAM_SIZE));
+}
+
+// The alternative the envelope avoids: one heap object per message behind
+// a virtual apply()
+struct VirtualMessage {
+  virtual ~VirtualMessage() = default;
+  virtual void apply(Handler &handler) const = 0;
+};
+
+template <typename T> struct VirtualHolder final : VirtualMessage {
+  explicit VirtualHolder(const T &m) : message(m) {}
+  void apply(Handler &handler) const override { handler(message); }
+  T message;
+};
+
+void BM_Dispatch_Virtual(benchmark::State &state) {
+  std::vector<std::unique_ptr<VirtualMessage>> stream;
+  for (const auto &envelope : make_stream(state.range(0) != 0)) {
+    envelope.visit([&stream](const auto &message) {
+      using T = std::remove_cvref_t<decltype(message)>;
+      stream.push_back(std::make_unique<VirtualHolder<T>>(message));
+    });
+  }
+  Handler handler;
+  for (auto _ : state) {
+    for (const auto &message : stream) {
+      message->apply(handler);
+    }
+  }
+  benchmark::DoNotOptimize(handler.sum);
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(STREAM_SIZE));
+}
+
+} // namespace
+
+BENCHMARK(BM_Dispatch_Visit)->ArgName("mixed")->Arg(0)->Arg(1);
+BENCHMARK(BM_Dispatch_Switch)->ArgName("mixed")->Arg(0)->Arg(1);
+BENCHMARK(BM_Dispatch_Virtual)->ArgName("mixed")->Arg(0)->Arg(1);
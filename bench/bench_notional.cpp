@@ -0,0 +1,117 @@
+#include "types/notional.hpp"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+using namespace mini_mart::types;
+
+// Exact 128-bit notional/VWAP kernels against the usual shortcut of
+// converting through double (which is also inexact past 2^53).
+
+namespace {
+
+constexpr size_t LEVELS = 4096;
+
+std::vector<PriceLevel> make_levels() {
+  std::vector<PriceLevel> levels(LEVELS);
+  uint64_t state = 99;
+  for (auto &level : levels) {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    level.price = Price{1000000 + (state >> 50)};
+    level.quantity = 1 + ((state >> 20) & 0xfffff);
+  }
+  return levels;
+}
+
+void BM_Vwap_Int128Batch(benchmark::State &state) {
+  const auto levels = make_levels();
+  for (auto _ : state) {
+    VwapAccumulator vwap;
+    vwap.add(levels.data(), levels.size());
+    benchmark::DoNotOptimize(vwap.vwap());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(LEVELS));
+}
+
+void BM_Vwap_Int128PerLevel(benchmark::State &state) {
+  const auto levels = make_levels();
+  for (auto _ : state) {
+    VwapAccumulator vwap;
+    for (const auto &level : levels) {
+      vwap.add(level.price, level.quantity);
+    }
+    benchmark::DoNotOptimize(vwap.vwap());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(LEVELS));
+}
+
+void BM_Vwap_Double(benchmark::State &state) {
+  const auto levels = make_levels();
+  for (auto _ : state) {
+    double notional = 0.0;
+    double volume = 0.0;
+    for (const auto &level : levels) {
+      notional += level.price.dollars() * static_cast<double>(level.quantity);
+      volume += static_cast<double>(level.quantity);
+    }
+    benchmark::DoNotOptimize(price_from_dollars(notional / volume));
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(LEVELS));
+}
+
+// Scaling a 128-bit notional down to whole dollars
+std::vector<uint128_t> make_notionals() {
+  std::vector<uint128_t> values(LEVELS);
+  uint64_t state = 7;
+  for (auto &value : values) {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    value = (static_cast<uint128_t>(state >> 40) << 64) | (state * 31);
+  }
+  return values;
+}
+
+void BM_Scale_DividePow10(benchmark::State &state) {
+  const auto values = make_notionals();
+  for (auto _ : state) {
+    uint128_t sum = 0;
+    for (const uint128_t value : values) {
+      sum += divide_pow10<4>(value);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(LEVELS));
+}
+
+void BM_Scale_GenericDivide(benchmark::State &state) {
+  const auto values = make_notionals();
+  uint128_t divisor = 10000;
+  benchmark::DoNotOptimize(divisor);
+  for (auto _ : state) {
+    uint128_t sum = 0;
+    for (const uint128_t value : values) {
+      sum += value / divisor;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(LEVELS));
+}
+
+void BM_Scale_Double(benchmark::State &state) {
+  const auto values = make_notionals();
+  for (auto _ : state) {
+    double sum = 0.0;
+    for (const uint128_t value : values) {
+      sum += static_cast<double>(value) / 10000.0;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(LEVELS));
+}
+
+} // namespace
+
+BENCHMARK(BM_Vwap_Int128Batch);
+BENCHMARK(BM_Vwap_Int128PerLevel);
+BENCHMARK(BM_Vwap_Double);
+BENCHMARK(BM_Scale_DividePow10);
+BENCHMARK(BM_Scale_GenericDivide);
+BENCHMARK(BM_Scale_Double);
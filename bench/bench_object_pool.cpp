@@ -0,0 +1,171 @@
+#include "common/arena.hpp"
+#include "common/object_pool.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <map>
+#include <vector>
+
+using namespace mini_mart::common;
+
+namespace {
+
+// Resting order as an order-level book would hold it (64 bytes)
+struct Order {
+  uint64_t order_id;
+  uint64_t price;
+  uint64_t quantity;
+  uint64_t timestamp_ns;
+  Order *prev;
+  Order *next;
+  uint64_t participant;
+  uint64_t flags;
+
+  Order(uint64_t id, uint64_t px, uint64_t qty)
+      : order_id(id), price(px), quantity(qty), timestamp_ns(0), prev(nullptr),
+        next(nullptr), participant(0), flags(0) {}
+};
+static_assert(sizeof(Order) == 64, "Order should be one cache line");
+
+constexpr size_t LIVE_ORDERS = 10000;
+constexpr size_t CHURN_OPS = 100000;
+
+uint64_t next_random(uint64_t &state) {
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+}
+
+// Steady state of LIVE_ORDERS resting orders; each op cancels a random order
+// and adds a replacement, as a busy book does between trades.
+template <typename Allocate, typename Free>
+void run_churn(benchmark::State &state, Allocate allocate, Free release) {
+  std::vector<Order *> live(LIVE_ORDERS);
+  uint64_t rng = 0x9E3779B97F4A7C15ull;
+  for (size_t i = 0; i < LIVE_ORDERS; ++i) {
+    live[i] = allocate(i, 1000000 + i, 100);
+  }
+
+  uint64_t next_id = LIVE_ORDERS;
+  for (auto _ : state) {
+    for (size_t op = 0; op < CHURN_OPS; ++op) {
+      const size_t victim = next_random(rng) % LIVE_ORDERS;
+      release(live[victim]);
+      live[victim] = allocate(next_id++, 1000000 + (rng & 0xFF), 100);
+      benchmark::DoNotOptimize(live[victim]);
+    }
+  }
+
+  for (Order *order : live) {
+    release(order);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(CHURN_OPS));
+}
+
+} // namespace
+
+static void BM_ChurnNewDelete(benchmark::State &state) {
+  run_churn(
+      state,
+      [](uint64_t id, uint64_t px, uint64_t qty) { return new Order(id, px, qty); },
+      [](Order *order) { delete order; });
+}
+BENCHMARK(BM_ChurnNewDelete);
+
+static void BM_ChurnMalloc(benchmark::State &state) {
+  run_churn(
+      state,
+      [](uint64_t id, uint64_t px, uint64_t qty) {
+        return ::new (std::malloc(sizeof(Order))) Order(id, px, qty);
+      },
+      [](Order *order) {
+        order->~Order();
+        std::free(order);
+      });
+}
+BENCHMARK(BM_ChurnMalloc);
+
+static void BM_ChurnObjectPool(benchmark::State &state) {
+  ObjectPool<Order> pool(LIVE_ORDERS);
+  run_churn(
+      state,
+      [&pool](uint64_t id, uint64_t px, uint64_t qty) {
+        return pool.create(id, px, qty);
+      },
+      [&pool](Order *order) { pool.destroy(order); });
+}
+BENCHMARK(BM_ChurnObjectPool);
+
+static void BM_ChurnConcurrentPoolLocalCache(benchmark::State &state) {
+  ConcurrentObjectPool<Order> pool(static_cast<uint32_t>(LIVE_ORDERS + 64));
+  ConcurrentObjectPool<Order>::LocalCache cache(pool);
+  run_churn(
+      state,
+      [&cache](uint64_t id, uint64_t px, uint64_t qty) {
+        return cache.create(id, px, qty);
+      },
+      [&cache](Order *order) { cache.destroy(order); });
+}
+BENCHMARK(BM_ChurnConcurrentPoolLocalCache);
+
+// Price-level map churn: std::allocator vs PoolAllocator nodes
+template <typename Map> void run_level_churn(benchmark::State &state, Map &levels) {
+  uint64_t rng = 12345;
+  for (uint64_t px = 0; px < 1000; ++px) {
+    levels[px * 2] = px;
+  }
+  for (auto _ : state) {
+    for (size_t op = 0; op < 10000; ++op) {
+      const uint64_t px = (next_random(rng) % 2000);
+      auto it = levels.find(px);
+      if (it != levels.end()) {
+        levels.erase(it);
+      } else {
+        levels.emplace(px, op);
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * 10000);
+}
+
+static void BM_LevelMapStdAllocator(benchmark::State &state) {
+  std::map<uint64_t, uint64_t> levels;
+  run_level_churn(state, levels);
+}
+BENCHMARK(BM_LevelMapStdAllocator);
+
+static void BM_LevelMapPoolAllocator(benchmark::State &state) {
+  using Alloc = PoolAllocator<std::pair<const uint64_t, uint64_t>>;
+  FixedBlockPool pool(64, 4096);
+  std::map<uint64_t, uint64_t, std::less<>, Alloc> levels{Alloc(pool)};
+  run_level_churn(state, levels);
+}
+BENCHMARK(BM_LevelMapPoolAllocator);
+
+// Per-batch scratch: vector on the heap vs on a reset-per-batch arena
+static void BM_BatchScratchHeapVector(benchmark::State &state) {
+  for (auto _ : state) {
+    std::vector<uint64_t> scratch;
+    for (uint64_t i = 0; i < 512; ++i) {
+      scratch.push_back(i);
+    }
+    benchmark::DoNotOptimize(scratch.data());
+  }
+}
+BENCHMARK(BM_BatchScratchHeapVector);
+
+static void BM_BatchScratchArenaVector(benchmark::State &state) {
+  MonotonicArena arena(64 * 1024);
+  for (auto _ : state) {
+    {
+      std::vector<uint64_t, ArenaAllocator<uint64_t>> scratch{
+          ArenaAllocator<uint64_t>(arena)};
+      for (uint64_t i = 0; i < 512; ++i) {
+        scratch.push_back(i);
+      }
+      benchmark::DoNotOptimize(scratch.data());
+    }
+    arena.reset();
+  }
+}
+BENCHMARK(BM_BatchScratchArenaVector);
@@ -0,0 +1,80 @@
+#include "types/price.hpp"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+using namespace mini_mart::types;
+
+// Price is now FixedPoint<4, uint64_t>; these pit it against a copy of the
+// hand-written class it replaced on the operations the store and feed run
+// per update (spread, mid, compare, accumulate). Both should compile to
+// identical code, so any gap here is a regression.
+
+namespace {
+
+class LegacyPrice {
+  uint64_t value_;
+
+public:
+  constexpr LegacyPrice() noexcept : value_(0) {}
+  constexpr LegacyPrice(uint64_t raw) noexcept : value_(raw) {}
+  constexpr LegacyPrice operator+(LegacyPrice rhs) const noexcept { return LegacyPrice{value_ + rhs.value_}; }
+  constexpr LegacyPrice operator-(LegacyPrice rhs) const noexcept { return LegacyPrice{value_ - rhs.value_}; }
+  constexpr LegacyPrice operator/(uint64_t divisor) const noexcept { return LegacyPrice{value_ / divisor}; }
+  constexpr LegacyPrice operator*(uint64_t multiplier) const noexcept { return LegacyPrice{value_ * multiplier}; }
+  constexpr LegacyPrice &operator+=(LegacyPrice rhs) noexcept {
+    value_ += rhs.value_;
+    return *this;
+  }
+  constexpr bool operator<(LegacyPrice rhs) const noexcept { return value_ < rhs.value_; }
+  constexpr uint64_t raw() const noexcept { return value_; }
+};
+
+constexpr size_t BOOK_SIZE = 4096;
+
+template <typename P> std::vector<P> make_prices(uint64_t seed) {
+  std::vector<P> prices;
+  prices.reserve(BOOK_SIZE);
+  uint64_t state = seed;
+  for (size_t i = 0; i < BOOK_SIZE; ++i) {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    prices.push_back(P{1000000 + (state >> 48)});
+  }
+  return prices;
+}
+
+// Spread, mid and best-of over bid/ask pairs, plus a running sum
+template <typename P> void BM_PriceOps(benchmark::State &state) {
+  const auto bids = make_prices<P>(1);
+  const auto asks = make_prices<P>(2);
+  for (auto _ : state) {
+    P total{};
+    P best{};
+    for (size_t i = 0; i < BOOK_SIZE; ++i) {
+      const P bid = bids[i];
+      const P ask = asks[i] + bid;
+      total += (bid + ask) / 2 + (ask - bid) * 3;
+      best = best < bid ? bid : best;
+    }
+    benchmark::DoNotOptimize(total);
+    benchmark::DoNotOptimize(best);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(BOOK_SIZE));
+}
+
+// Scalar latency of one dependent add chain
+template <typename P> void BM_PriceAddChain(benchmark::State &state) {
+  P price{1000000ul};
+  const P tick{1ul};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(price);
+    price = price + tick;
+  }
+  benchmark::DoNotOptimize(price.raw());
+}
+
+} // namespace
+
+BENCHMARK(BM_PriceOps<LegacyPrice>);
+BENCHMARK(BM_PriceOps<Price>);
+BENCHMARK(BM_PriceAddChain<LegacyPrice>);
+BENCHMARK(BM_PriceAddChain<Price>);
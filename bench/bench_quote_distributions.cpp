@@ -0,0 +1,84 @@
+#include "market_data/quote_distributions.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+using namespace mini_mart::market_data;
+using namespace mini_mart::types;
+
+// QuoteDistributionTracker over 256 symbols with 1 s intervals and one
+// update every 40 us (~100/s per symbol, so each interval's lazy reset is
+// amortized over ~100 updates). Record: per-update cost on the consumer
+// path, with (OnMessage) and without (Indexed) the symbol lookup. Merge: a
+// stats thread's cost to pull one closed interval for every symbol into a
+// single view.
+
+namespace {
+
+constexpr size_t SYMBOLS = 256;
+constexpr uint64_t TICK_NS = 40000;
+constexpr uint64_t INTERVAL_NS = 1000000000;
+
+struct Setup {
+  std::unique_ptr<QuoteDistributionTracker<>> tracker = std::make_unique<QuoteDistributionTracker<>>(INTERVAL_NS);
+  std::vector<MarketDataL2Message> messages = std::vector<MarketDataL2Message>(SYMBOLS);
+  uint64_t rng = 11;
+  uint64_t now = 0;
+
+  Setup() {
+    for (size_t i = 0; i < SYMBOLS; ++i) {
+      char symbol[16];
+      std::snprintf(symbol, sizeof(symbol), "S%zu", i);
+      messages[i].security_id = make_security_id(symbol);
+      messages[i].num_bid_levels = 1;
+      messages[i].num_ask_levels = 1;
+      tracker->add_security(messages[i].security_id);
+    }
+  }
+
+  template <bool INDEXED> void tick() {
+    rng = rng * 6364136223846793005ull + 1442695040888963407ull;
+    now += TICK_NS;
+    const size_t index = (rng >> 33) % SYMBOLS;
+    MarketDataL2Message &message = messages[index];
+    const uint64_t bid = 1000000 + ((rng >> 40) & 1023);
+    message.timestamp_ns = now;
+    message.bids[0] = {Price{bid}, 100 + ((rng >> 20) & 4095)};
+    message.asks[0] = {Price{bid + 1 + ((rng >> 12) & 255)}, 100 + ((rng >> 4) & 4095)};
+    if constexpr (INDEXED) {
+      tracker->record(index, message);
+    } else {
+      tracker->on_message(message);
+    }
+  }
+};
+
+template <bool INDEXED> void BM_QuoteDistributionRecord(benchmark::State &state) {
+  Setup setup;
+  for (auto _ : state) {
+    setup.tick<INDEXED>();
+  }
+  state.counters["state_bytes/symbol"] = 2.0 * sizeof(QuoteDistributions);
+}
+
+void BM_QuoteDistributionMergeInterval(benchmark::State &state) {
+  Setup setup;
+  while (setup.tracker->current_interval() < 2) {
+    setup.tick<true>();
+  }
+  const uint64_t closed = setup.tracker->current_interval() - 1;
+  for (auto _ : state) {
+    QuoteDistributions total;
+    for (size_t i = 0; i < SYMBOLS; ++i) {
+      setup.tracker->merge_closed(i, closed, total);
+    }
+    benchmark::DoNotOptimize(total[QuoteMetric::SPREAD].percentile(0.99));
+  }
+}
+
+} // namespace
+
+BENCHMARK(BM_QuoteDistributionRecord<false>)->Name("BM_QuoteDistributionRecord/OnMessage");
+BENCHMARK(BM_QuoteDistributionRecord<true>)->Name("BM_QuoteDistributionRecord/Indexed");
+BENCHMARK(BM_QuoteDistributionMergeInterval)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,89 @@
+#include "market_data/feed_policies.hpp"
+#include "market_data/quote_validator.hpp"
+#include "market_data/security_store.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+using namespace mini_mart::market_data;
+using namespace mini_mart::types;
+
+// Clean 5x5 L2 snapshots over 64 symbols, cycling through 1024 prepared
+// messages with small mid moves. CheckLevels: the structural checks alone.
+// Validate: checks plus jump filter. Sink: applying through StoreSink
+// (Plain) versus ValidatingStoreSink (Validating), same store.
+
+namespace {
+
+constexpr size_t SYMBOLS = 64;
+constexpr size_t MESSAGES = 1024;
+
+std::vector<MarketDataL2Message> clean_messages() {
+  std::vector<MarketDataL2Message> messages(MESSAGES);
+  uint64_t rng = 5;
+  std::vector<uint64_t> bids(SYMBOLS, 1000000);
+  for (size_t m = 0; m < MESSAGES; ++m) {
+    rng = rng * 6364136223846793005ull + 1442695040888963407ull;
+    const size_t index = m % SYMBOLS;
+    bids[index] = (rng >> 40) & 1 ? bids[index] + 100 : bids[index] - 100;
+    MarketDataL2Message &message = messages[m];
+    char symbol[16];
+    std::snprintf(symbol, sizeof(symbol), "S%zu", index);
+    message.security_id = make_security_id(symbol);
+    message.timestamp_ns = m;
+    for (uint64_t i = 0; i < 5; ++i) {
+      message.bids[i] = {Price{bids[index] - i * 100}, 100 + ((rng >> (i * 4)) & 255)};
+      message.asks[i] = {Price{bids[index] + 100 + i * 100}, 100 + ((rng >> (i * 4 + 20)) & 255)};
+    }
+    message.num_bid_levels = 5;
+    message.num_ask_levels = 5;
+  }
+  return messages;
+}
+
+void BM_QuoteCheckLevels(benchmark::State &state) {
+  const auto messages = clean_messages();
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(check_book_levels(messages[i++ % MESSAGES]));
+  }
+}
+
+void BM_QuoteValidate(benchmark::State &state) {
+  const auto messages = clean_messages();
+  auto validator = std::make_unique<QuoteValidator<>>();
+  size_t i = 0;
+  for (auto _ : state) {
+    const size_t m = i++ % MESSAGES;
+    benchmark::DoNotOptimize(validator->validate(m % SYMBOLS, messages[m]));
+  }
+  state.counters["rejected"] = static_cast<double>(validator->rejected());
+}
+
+template <typename Sink> void apply_clean(benchmark::State &state, Sink sink) {
+  const auto messages = clean_messages();
+  for (size_t s = 0; s < SYMBOLS; ++s) {
+    sink.add_security(messages[s].security_id);
+  }
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sink.on_message(messages[i++ % MESSAGES]));
+  }
+}
+
+void BM_QuoteSinkPlain(benchmark::State &state) {
+  apply_clean(state, StoreSink<SecurityStore>(std::make_shared<SecurityStore>()));
+}
+
+void BM_QuoteSinkValidating(benchmark::State &state) {
+  apply_clean(state, ValidatingStoreSink<SecurityStore>(std::make_shared<SecurityStore>(),
+                                                        std::make_shared<QuoteValidator<>>()));
+}
+
+} // namespace
+
+BENCHMARK(BM_QuoteCheckLevels);
+BENCHMARK(BM_QuoteValidate);
+BENCHMARK(BM_QuoteSinkPlain)->Name("BM_QuoteSink/Plain");
+BENCHMARK(BM_QuoteSinkValidating)->Name("BM_QuoteSink/Validating");
@@ -0,0 +1,72 @@
+#include "market_data/rolling_windows.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+using namespace mini_mart::market_data;
+using namespace mini_mart::types;
+
+// Per-update cost of RollingWindowEngine over 256 symbols, with 1 and 3
+// window lengths. One mid arrives every 40 us round-robin-ish across the
+// symbols, i.e. ~100 updates/s each, so the 5 s window holds ~500 samples.
+// The Indexed variants update by index; the others look the symbol up
+// from the L2 message as the feed path does.
+
+namespace {
+
+constexpr size_t SYMBOLS = 256;
+constexpr uint64_t TICK_NS = 40000;
+
+template <size_t WINDOWS> std::array<uint64_t, WINDOWS> lengths();
+template <> std::array<uint64_t, 1> lengths<1>() { return {1000000000}; }
+template <> std::array<uint64_t, 3> lengths<3>() { return {100000000, 1000000000, 5000000000}; }
+
+template <size_t WINDOWS, bool INDEXED> void BM_RollingWindowUpdate(benchmark::State &state) {
+  using Engine = RollingWindowEngine<WINDOWS, 1024>;
+  auto engine = std::make_unique<Engine>(lengths<WINDOWS>());
+  std::vector<MarketDataL2Message> messages(SYMBOLS);
+  for (size_t i = 0; i < SYMBOLS; ++i) {
+    char symbol[16];
+    std::snprintf(symbol, sizeof(symbol), "S%zu", i);
+    messages[i].security_id = make_security_id(symbol);
+    messages[i].num_bid_levels = 1;
+    messages[i].num_ask_levels = 1;
+    engine->add_security(messages[i].security_id);
+  }
+
+  uint64_t rng = 7;
+  uint64_t now = 0;
+  const auto tick = [&] {
+    rng = rng * 6364136223846793005ull + 1442695040888963407ull;
+    now += TICK_NS;
+    const size_t index = (rng >> 33) % SYMBOLS;
+    const uint64_t bid = 1000000 + ((rng >> 40) & 1023);
+    if constexpr (INDEXED) {
+      engine->update(index, Price{bid + 50}, now);
+    } else {
+      MarketDataL2Message &message = messages[index];
+      message.timestamp_ns = now;
+      message.bids[0].price = Price{bid};
+      message.asks[0].price = Price{bid + 100};
+      benchmark::DoNotOptimize(engine->on_message(message));
+    }
+  };
+  // Fill the longest window before timing
+  for (uint64_t warm = 0; warm < lengths<WINDOWS>()[WINDOWS - 1] / TICK_NS; ++warm) {
+    tick();
+  }
+  for (auto _ : state) {
+    tick();
+  }
+  state.counters["window_samples"] =
+      static_cast<double>(engine->stats(0, WINDOWS - 1).samples);
+  state.counters["truncated"] = static_cast<double>(engine->truncated());
+}
+
+} // namespace
+
+BENCHMARK(BM_RollingWindowUpdate<1, true>)->Name("BM_RollingWindowUpdate/windows:1/Indexed");
+BENCHMARK(BM_RollingWindowUpdate<3, true>)->Name("BM_RollingWindowUpdate/windows:3/Indexed");
+BENCHMARK(BM_RollingWindowUpdate<1, false>)->Name("BM_RollingWindowUpdate/windows:1/OnMessage");
+BENCHMARK(BM_RollingWindowUpdate<3, false>)->Name("BM_RollingWindowUpdate/windows:3/OnMessage");
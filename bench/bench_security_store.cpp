@@ -0,0 +1,149 @@
+#include "market_data/security_store.hpp"
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace mini_mart::market_data;
+using namespace mini_mart::types;
+
+namespace {
+
+std::vector<SecurityId> numbered_ids(size_t count) {
+  std::vector<SecurityId> ids;
+  for (size_t i = 0; i < count; ++i) {
+    SecurityId id{};
+    id[0] = 'S';
+    id[1] = static_cast<char>('A' + i / 26 % 26);
+    id[2] = static_cast<char>('A' + i % 26);
+    ids.push_back(id);
+  }
+  return ids;
+}
+
+// Reader lookups (contains() scans the identity of every slot up to the
+// match) while a writer thread applies updates to all securities, as the
+// feed consumer does. range(0): active securities; range(1): writer on/off.
+void BM_ReaderLookupWithWriter(benchmark::State &state) {
+  auto store = std::make_unique<SecurityStore>();
+  const auto ids = numbered_ids(static_cast<size_t>(state.range(0)));
+  for (const auto &id : ids) {
+    store->add_security(id);
+  }
+
+  std::atomic<bool> running{true};
+  std::atomic<uint64_t> writes{0};
+  std::thread writer;
+  if (state.range(1) != 0) {
+    writer = std::thread([&] {
+      MarketDataL2Message message{};
+      message.num_bid_levels = 5;
+      message.num_ask_levels = 5;
+      size_t i = 0;
+      uint64_t count = 0;
+      while (running.load(std::memory_order_relaxed)) {
+        message.security_id = ids[i];
+        message.timestamp_ns = count;
+        store->update_from_l2(message);
+        i = i + 1 == ids.size() ? 0 : i + 1;
+        ++count;
+      }
+      writes.store(count, std::memory_order_relaxed);
+    });
+  }
+
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(store->contains(ids[i]));
+    i = i + 1 == ids.size() ? 0 : i + 1;
+  }
+
+  running.store(false, std::memory_order_relaxed);
+  if (writer.joinable()) {
+    writer.join();
+  }
+  state.counters["writes"] = static_cast<double>(writes.load());
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Consistent snapshot of range(0) securities while a writer commits
+// batches of 4 updates across all 64 securities. Reports how often a read
+// had to restart because one of its securities moved past the commit.
+void BM_ConsistentSnapshotWithWriter(benchmark::State &state) {
+  auto store = std::make_unique<SecurityStore>();
+  const auto ids = numbered_ids(64);
+  for (const auto &id : ids) {
+    store->add_security(id);
+  }
+  const size_t count = static_cast<size_t>(state.range(0));
+
+  std::atomic<bool> running{true};
+  std::thread writer([&] {
+    MarketDataL2Message message{};
+    message.num_bid_levels = 5;
+    message.num_ask_levels = 5;
+    size_t i = 0;
+    while (running.load(std::memory_order_relaxed)) {
+      store->begin_batch();
+      for (int update = 0; update < 4; ++update) {
+        message.security_id = ids[i];
+        store->update_from_l2(message);
+        i = i + 1 == ids.size() ? 0 : i + 1;
+      }
+      store->commit();
+      std::this_thread::yield(); // leave the reader CPU time on small boxes
+    }
+  });
+
+  std::vector<SecurityStore::SecuritySnapshot> snapshots(count);
+  uint64_t exhausted = 0;
+  for (auto _ : state) {
+    exhausted += store->get_consistent_snapshots(ids.data(), count, snapshots.data()) ==
+                         SecurityStore::ConsistentRead::SUCCESS
+                     ? 0u
+                     : 1u;
+    benchmark::DoNotOptimize(snapshots.data());
+  }
+
+  running.store(false, std::memory_order_relaxed);
+  writer.join();
+  state.counters["commits"] = static_cast<double>(store->committed_sequence());
+  state.counters["exhausted"] = static_cast<double>(exhausted);
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Consumer-side cost of an update with and without the per-security history
+// ring (template argument: history depth)
+template <size_t DEPTH> void BM_UpdateWithHistory(benchmark::State &state) {
+  auto store = std::make_unique<BasicSecurityStore<DynamicSecurityIndex, DEPTH>>();
+  const auto ids = numbered_ids(64);
+  for (const auto &id : ids) {
+    store->add_security(id);
+  }
+  MarketDataL2Message message{};
+  message.num_bid_levels = 5;
+  message.num_ask_levels = 5;
+  size_t i = 0;
+  for (auto _ : state) {
+    message.security_id = ids[i];
+    benchmark::DoNotOptimize(store->update_from_l2(message));
+    i = i + 1 == ids.size() ? 0 : i + 1;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+BENCHMARK(BM_UpdateWithHistory<0>);
+BENCHMARK(BM_UpdateWithHistory<8>);
+BENCHMARK(BM_ConsistentSnapshotWithWriter)->ArgName("securities")->Arg(2)->Arg(8)->Arg(32);
+BENCHMARK(BM_ReaderLookupWithWriter)
+    ->ArgNames({"securities", "writer"})
+    ->Args({8, 0})
+    ->Args({8, 1})
+    ->Args({64, 0})
+    ->Args({64, 1})
+    ->Args({256, 0})
+    ->Args({256, 1})
+    ->UseRealTime();
@@ -0,0 +1,110 @@
+#include "market_data/security_store.hpp"
+#include "market_data/surveillance_engine.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+using namespace mini_mart::market_data;
+using namespace mini_mart::types;
+
+// A balanced order stream over 64 symbols and 256 participants: every
+// order is added, then cancelled (4 in 5) or filled 64 events later, a
+// microsecond of event time apart. The stream replays with time shifted
+// on, so the windows keep rolling. Store: with a populated SecurityStore
+// for the near-touch check; NoStore: without.
+
+namespace {
+
+constexpr size_t SYMBOLS = 64;
+constexpr uint32_t PARTICIPANTS = 256;
+constexpr size_t ORDERS = 16384;
+constexpr size_t RESTING = 64;
+
+SecurityId symbol(size_t index) {
+  char name[16];
+  std::snprintf(name, sizeof(name), "S%zu", index);
+  return make_security_id(name);
+}
+
+std::vector<OrderEventMessage> order_stream() {
+  std::vector<OrderEventMessage> events;
+  events.reserve(ORDERS * 2);
+  uint64_t rng = 11;
+  auto add = [&](size_t k) {
+    rng = rng * 6364136223846793005ull + 1442695040888963407ull;
+    OrderEventMessage event{};
+    event.security_id = symbol(k % SYMBOLS);
+    event.order_id = k + 1;
+    event.participant_id = static_cast<uint32_t>(k % PARTICIPANTS);
+    event.side = (rng >> 40) & 1 ? Side::BID : Side::ASK;
+    event.price = price_from_raw(event.side == Side::BID ? 1000000 - ((rng >> 44) & 7) * 100
+                                                         : 1000100 + ((rng >> 44) & 7) * 100);
+    event.quantity = 100;
+    event.action = OrderAction::ADD;
+    return event;
+  };
+  std::vector<OrderEventMessage> adds;
+  for (size_t k = 0; k < ORDERS; ++k) {
+    adds.push_back(add(k));
+  }
+  for (size_t k = 0; k < ORDERS + RESTING; ++k) {
+    if (k < ORDERS) {
+      events.push_back(adds[k]);
+    }
+    if (k >= RESTING) {
+      OrderEventMessage remove = adds[k - RESTING];
+      remove.action = (k % 5) == 0 ? OrderAction::EXECUTE : OrderAction::CANCEL;
+      remove.quantity = 0;
+      events.push_back(remove);
+    }
+  }
+  for (size_t i = 0; i < events.size(); ++i) {
+    events[i].timestamp_ns = i * 1000;
+  }
+  return events;
+}
+
+void run(benchmark::State &state, std::shared_ptr<const SecurityStore> store) {
+  const auto events = order_stream();
+  const uint64_t period_ns = events.size() * 1000;
+  auto engine = std::make_unique<SurveillanceEngine<SecurityStore>>(std::move(store));
+  SurveillanceAlert alert;
+  size_t i = 0;
+  uint64_t shift = 0;
+  for (auto _ : state) {
+    OrderEventMessage event = events[i];
+    event.timestamp_ns += shift;
+    benchmark::DoNotOptimize(engine->on_message(event));
+    if (++i == events.size()) {
+      i = 0;
+      shift += period_ns;
+      while (engine->pop_alert(alert)) {
+      }
+    }
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+  state.counters["alerts"] = static_cast<double>(engine->alerts_raised());
+}
+
+void BM_SurveillanceStore(benchmark::State &state) {
+  auto store = std::make_shared<SecurityStore>();
+  for (size_t s = 0; s < SYMBOLS; ++s) {
+    MarketDataL2Message quote{};
+    quote.security_id = symbol(s);
+    quote.bids[0] = {price_from_raw(1000000u), 500};
+    quote.asks[0] = {price_from_raw(1000100u), 500};
+    quote.num_bid_levels = 1;
+    quote.num_ask_levels = 1;
+    store->add_security(quote.security_id);
+    store->update_from_l2(quote);
+  }
+  run(state, store);
+}
+
+void BM_SurveillanceNoStore(benchmark::State &state) { run(state, nullptr); }
+
+} // namespace
+
+BENCHMARK(BM_SurveillanceStore)->Name("BM_Surveillance/Store");
+BENCHMARK(BM_SurveillanceNoStore)->Name("BM_Surveillance/NoStore");
@@ -0,0 +1,74 @@
+#include "market_data/security_seeder.hpp"
+#include "market_data/security_store.hpp"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+using namespace mini_mart::market_data;
+using namespace mini_mart::types;
+
+namespace {
+
+using EquityIndex = StaticSecurityIndex<SecuritySeeder::EQUITY_SYMBOLS>;
+
+std::vector<MarketDataL2Message> make_messages() {
+  std::vector<MarketDataL2Message> messages;
+  for (size_t i = 0; i < 1024; ++i) {
+    MarketDataL2Message message{};
+    const auto &entry =
+        SecuritySeeder::MAJOR_US_EQUITIES[(i * 7) % SecuritySeeder::MAJOR_US_EQUITIES.size()];
+    message.security_id = make_security_id(entry.symbol);
+    message.timestamp_ns = i;
+    message.num_bid_levels = 5;
+    message.num_ask_levels = 5;
+    messages.push_back(message);
+  }
+  return messages;
+}
+
+template <typename Store> void run_updates(benchmark::State &state, Store &store) {
+  for (const auto &entry : SecuritySeeder::MAJOR_US_EQUITIES) {
+    store.add_security(make_security_id(entry.symbol));
+  }
+  const auto messages = make_messages();
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(store.update_from_l2(messages[i]));
+    i = (i + 1) & 1023;
+  }
+}
+
+} // namespace
+
+static void BM_StoreUpdateLinearIndex(benchmark::State &state) {
+  auto store = std::make_unique<SecurityStore>();
+  run_updates(state, *store);
+}
+BENCHMARK(BM_StoreUpdateLinearIndex);
+
+static void BM_StoreUpdateStaticIndex(benchmark::State &state) {
+  auto store = std::make_unique<BasicSecurityStore<EquityIndex>>();
+  run_updates(state, *store);
+}
+BENCHMARK(BM_StoreUpdateStaticIndex);
+
+static void BM_BasePriceStringLookup(benchmark::State &state) {
+  const auto messages = make_messages();
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(SecuritySeeder::get_base_price(
+        SecuritySeeder::security_id_to_string(messages[i].security_id)));
+    i = (i + 1) & 1023;
+  }
+}
+BENCHMARK(BM_BasePriceStringLookup);
+
+static void BM_BasePricePerfectHash(benchmark::State &state) {
+  const auto messages = make_messages();
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(SecuritySeeder::get_base_price(messages[i].security_id));
+    i = (i + 1) & 1023;
+  }
+}
+BENCHMARK(BM_BasePricePerfectHash);
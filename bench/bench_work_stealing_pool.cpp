@@ -0,0 +1,102 @@
+#include "common/work_stealing_pool.hpp"
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace mini_mart::common;
+
+namespace {
+
+WorkStealingPool::Config pool_config(int64_t workers) {
+  WorkStealingPool::Config config;
+  config.num_workers = static_cast<size_t>(workers);
+  config.idle_sleep_us = 20;
+  return config;
+}
+
+long fib_serial(int n) { return n < 2 ? n : fib_serial(n - 1) + fib_serial(n - 2); }
+
+long fib_parallel(WorkStealingPool &pool, int n) {
+  if (n < 16) {
+    return fib_serial(n);
+  }
+  long a = 0;
+  WorkStealingPool::TaskGroup group;
+  if (!pool.submit(group, [&]() { a = fib_parallel(pool, n - 1); })) {
+    a = fib_parallel(pool, n - 1);
+  }
+  long b = fib_parallel(pool, n - 2);
+  pool.wait(group);
+  return a + b;
+}
+
+// Small unit of analytics-style work (~1us)
+void busy_work(uint64_t seed) {
+  uint64_t x = seed;
+  for (int i = 0; i < 256; ++i) {
+    x = x * 6364136223846793005ull + 1442695040888963407ull;
+  }
+  benchmark::DoNotOptimize(x);
+}
+
+} // namespace
+
+// Recursive fork/join: measures spawn + steal + join overhead
+static void BM_ForkJoinFib(benchmark::State &state) {
+  WorkStealingPool pool(pool_config(state.range(0)));
+  pool.start();
+  for (auto _ : state) {
+    long result = 0;
+    WorkStealingPool::TaskGroup group;
+    pool.submit(group, [&]() { result = fib_parallel(pool, 27); });
+    pool.wait(group);
+    benchmark::DoNotOptimize(result);
+  }
+  state.counters["steals"] =
+      static_cast<double>(pool.get_statistics().tasks_stolen);
+}
+BENCHMARK(BM_ForkJoinFib)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_ForkJoinFibSerialBaseline(benchmark::State &state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fib_serial(27));
+  }
+}
+BENCHMARK(BM_ForkJoinFibSerialBaseline)->Unit(benchmark::kMillisecond);
+
+// Independent task throughput from an external submitter
+static void BM_PoolThroughput(benchmark::State &state) {
+  constexpr int tasks_per_batch = 1000;
+  WorkStealingPool pool(pool_config(state.range(0)));
+  pool.start();
+  for (auto _ : state) {
+    WorkStealingPool::TaskGroup group;
+    for (int i = 0; i < tasks_per_batch; ++i) {
+      if (!pool.submit(group, [i]() { busy_work(static_cast<uint64_t>(i)); })) {
+        busy_work(static_cast<uint64_t>(i));
+      }
+    }
+    pool.wait(group);
+  }
+  state.SetItemsProcessed(state.iterations() * tasks_per_batch);
+}
+BENCHMARK(BM_PoolThroughput)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+
+// What MarketDataFeed::start-style thread-per-task costs for the same work
+static void BM_ThreadPerTaskThroughput(benchmark::State &state) {
+  constexpr int tasks_per_batch = 1000;
+  for (auto _ : state) {
+    std::vector<std::thread> threads;
+    threads.reserve(tasks_per_batch);
+    for (int i = 0; i < tasks_per_batch; ++i) {
+      threads.emplace_back([i]() { busy_work(static_cast<uint64_t>(i)); });
+    }
+    for (auto &t : threads) {
+      t.join();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * tasks_per_batch);
+}
+BENCHMARK(BM_ThreadPerTaskThroughput)->UseRealTime();
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "common/object_pool.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace mini_mart::common {
+
+// Monotonic bump allocator over one buffer allocated at construction. Meant
+// for per-batch scratch: allocate freely while processing a batch, then
+// reset() to release everything at once. Individual frees are no-ops.
+// allocate() returns nullptr when the buffer is exhausted.
+class MonotonicArena {
+public:
+  static constexpr size_t BUFFER_ALIGNMENT = 64;
+
+  explicit MonotonicArena(size_t capacity_bytes)
+      : capacity_(capacity_bytes),
+        buffer_(static_cast<std::byte *>(::operator new(
+            capacity_bytes, std::align_val_t{BUFFER_ALIGNMENT}))) {}
+
+  ~MonotonicArena() {
+    ::operator delete(buffer_, std::align_val_t{BUFFER_ALIGNMENT});
+  }
+
+  MonotonicArena(const MonotonicArena &) = delete;
+  MonotonicArena &operator=(const MonotonicArena &) = delete;
+  MonotonicArena(MonotonicArena &&) = delete;
+  MonotonicArena &operator=(MonotonicArena &&) = delete;
+
+  void *allocate(size_t size, size_t alignment = alignof(std::max_align_t)) noexcept {
+    const size_t start = (offset_ + alignment - 1) & ~(alignment - 1);
+    if (start + size > capacity_) {
+#ifndef NDEBUG
+      ++stats_.failed_allocations;
+#endif
+      return nullptr;
+    }
+    offset_ = start + size;
+#ifndef NDEBUG
+    ++stats_.allocations;
+    stats_.in_use = offset_;
+    stats_.high_water = std::max<uint64_t>(stats_.high_water, offset_);
+#endif
+    return buffer_ + start;
+  }
+
+  template <typename T> T *allocate_array(size_t count) noexcept {
+    return static_cast<T *>(allocate(sizeof(T) * count, alignof(T)));
+  }
+
+  // Releases every allocation. Objects must be trivially destructible or
+  // already destroyed by the caller.
+  void reset() noexcept {
+#ifndef NDEBUG
+    std::memset(buffer_, FREED_MEMORY_PATTERN, offset_);
+    stats_.deallocations = stats_.allocations;
+    stats_.in_use = 0;
+#endif
+    offset_ = 0;
+  }
+
+  size_t capacity() const { return capacity_; }
+  size_t used() const { return offset_; }
+  size_t remaining() const { return capacity_ - offset_; }
+  // in_use/high_water are in bytes for the arena
+  const AllocatorStatistics &get_statistics() const { return stats_; }
+
+private:
+  size_t capacity_;
+  std::byte *buffer_;
+  size_t offset_{0};
+  AllocatorStatistics stats_;
+};
+
+// std-compatible allocator over a MonotonicArena, e.g. for a per-batch
+// std::vector. deallocate() is a no-op; memory comes back on reset().
+// Exhausting the arena is a sizing error and aborts (fail fast).
+template <typename T> class ArenaAllocator {
+public:
+  using value_type = T;
+
+  explicit ArenaAllocator(MonotonicArena &arena) noexcept : arena_(&arena) {}
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U> &other) noexcept
+      : arena_(other.arena()) {}
+
+  T *allocate(size_t n) {
+    void *ptr = arena_->allocate(sizeof(T) * n, alignof(T));
+    if (ptr == nullptr) {
+      std::abort();
+    }
+    return static_cast<T *>(ptr);
+  }
+
+  void deallocate(T *, size_t) noexcept {}
+
+  MonotonicArena *arena() const noexcept { return arena_; }
+
+  template <typename U> bool operator==(const ArenaAllocator<U> &other) const {
+    return arena_ == other.arena();
+  }
+
+private:
+  MonotonicArena *arena_;
+};
+
+} // namespace mini_mart::common
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace mini_mart::common {
+
+// Fixed-capacity Chase-Lev work-stealing deque (Le et al., PPoPP'13 orderings).
+// The owner thread pushes and pops at the bottom (LIFO); any other thread may
+// steal from the top (FIFO). No resizing: push fails when full, so callers
+// must have an overflow path (run inline or use a shared queue).
+template <typename T, size_t N> class ChaseLevDeque {
+
+  static_assert(N > 1, "N must be greater than 1");
+  static_assert((N & (N - 1)) == 0, "N must be a power of 2");
+  static_assert(std::is_trivially_copyable_v<T>,
+                "T must be trivially copyable (typically a pointer)");
+
+  static constexpr size_t CACHELINE_SIZE = 64;
+  static constexpr int64_t CAPACITY = static_cast<int64_t>(N);
+  static constexpr int64_t MASK = CAPACITY - 1;
+
+public:
+  ChaseLevDeque() : top(0), bottom(0) {}
+
+  ChaseLevDeque(const ChaseLevDeque &other) = delete;
+  ChaseLevDeque &operator=(const ChaseLevDeque &other) = delete;
+
+  // Approximate under concurrency
+  size_t size() const {
+    const int64_t bottom_val = bottom.load(std::memory_order_relaxed);
+    const int64_t top_val = top.load(std::memory_order_relaxed);
+    return bottom_val > top_val ? static_cast<size_t>(bottom_val - top_val) : 0;
+  }
+
+  bool empty() const { return size() == 0; }
+
+  static inline constexpr size_t get_capacity() { return N; }
+
+  // Owner only
+  bool try_push(T value) {
+    const int64_t bottom_val = bottom.load(std::memory_order_relaxed);
+    const int64_t top_val = top.load(std::memory_order_acquire);
+    if (bottom_val - top_val >= CAPACITY) {
+      return false;
+    }
+
+    buffer[bottom_val & MASK].store(value, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom.store(bottom_val + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  // Owner only
+  bool try_pop(T &out) {
+    const int64_t bottom_val = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(bottom_val, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top_val = top.load(std::memory_order_relaxed);
+
+    if (top_val > bottom_val) {
+      bottom.store(bottom_val + 1, std::memory_order_relaxed);
+      return false;
+    }
+
+    out = buffer[bottom_val & MASK].load(std::memory_order_relaxed);
+    if (top_val != bottom_val) {
+      return true;
+    }
+
+    // Last element: race against thieves for it
+    const bool won = top.compare_exchange_strong(
+        top_val, top_val + 1, std::memory_order_seq_cst,
+        std::memory_order_relaxed);
+    bottom.store(bottom_val + 1, std::memory_order_relaxed);
+    return won;
+  }
+
+  // Any thread. Returns false when empty or when another thief won the race.
+  bool try_steal(T &out) {
+    int64_t top_val = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int64_t bottom_val = bottom.load(std::memory_order_acquire);
+
+    if (top_val >= bottom_val) {
+      return false;
+    }
+
+    T value = buffer[top_val & MASK].load(std::memory_order_relaxed);
+    if (!top.compare_exchange_strong(top_val, top_val + 1,
+                                     std::memory_order_seq_cst,
+                                     std::memory_order_relaxed)) {
+      return false;
+    }
+
+    out = value;
+    return true;
+  }
+
+private:
+  alignas(CACHELINE_SIZE) std::atomic<int64_t> top;
+  alignas(CACHELINE_SIZE) std::atomic<int64_t> bottom;
+  alignas(CACHELINE_SIZE) std::atomic<T> buffer[N];
+};
+
+} // namespace mini_mart::common
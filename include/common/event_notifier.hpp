@@ -0,0 +1,93 @@
+#pragma once
+
+#include "common/futex.hpp"
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace mini_mart::common {
+
+// Lets a queue's consumer sleep in epoll/poll on fd() alongside sockets.
+// The producer signals the eventfd only when the consumer has armed it,
+// i.e. when it found the queue empty, so a busy queue costs no syscalls:
+//
+//   producer: push(); notifier.notify();
+//   consumer: fd readable -> drain(); pop until empty;
+//             arm(); if (!queue.empty()) { disarm(); keep popping; }
+//
+// arm() issues the heavy side of an asymmetric barrier (membarrier), so
+// notify() is a relaxed load unless the consumer is about to sleep.
+class EventNotifier {
+public:
+  EventNotifier() = default;
+  ~EventNotifier() { close(); }
+
+  EventNotifier(const EventNotifier &) = delete;
+  EventNotifier &operator=(const EventNotifier &) = delete;
+
+  // Returns -errno on failure
+  int open() {
+    close();
+    fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    return fd_ >= 0 ? 0 : -errno;
+  }
+
+  void close() {
+    if (fd_ >= 0) {
+      ::close(fd_);
+      fd_ = -1;
+    }
+  }
+
+  int fd() const { return fd_; }
+
+  // Producer, after publishing
+  void notify() {
+    if (producer_fence_) {
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+    } else {
+      // Light side of the membarrier: only the compiler must not hoist the
+      // armed_ load above the queue's publishing store
+      std::atomic_signal_fence(std::memory_order_seq_cst);
+    }
+    if (armed_.load(std::memory_order_relaxed) &&
+        armed_.exchange(false, std::memory_order_acq_rel)) {
+      signal();
+    }
+  }
+
+  // Consumer, after finding the queue empty; re-check the queue afterwards
+  void arm() {
+    armed_.store(true, std::memory_order_relaxed);
+    heavy_barrier();
+  }
+
+  // Consumer, when the re-check after arm() found work
+  void disarm() { armed_.store(false, std::memory_order_relaxed); }
+
+  // Consumer, clears readiness before draining the queue
+  void drain() {
+    uint64_t value;
+    [[maybe_unused]] const ssize_t result = ::read(fd_, &value, sizeof(value));
+  }
+
+  // Makes fd() readable (e.g. the consumer stopped with work left)
+  void signal() {
+    const uint64_t one = 1;
+    [[maybe_unused]] const ssize_t result = ::write(fd_, &one, sizeof(one));
+    signals_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  uint64_t signals_sent() const { return signals_.load(std::memory_order_relaxed); }
+
+private:
+  int fd_{-1};
+  const bool producer_fence_{!heavy_barrier_available()};
+  // Starts armed: the consumer has not seen anything yet
+  alignas(64) std::atomic<bool> armed_{true};
+  std::atomic<uint64_t> signals_{0};
+};
+
+} // namespace mini_mart::common
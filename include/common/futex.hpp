@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <ctime>
+#include <linux/futex.h>
+#include <linux/membarrier.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace mini_mart::common {
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+              "futex words must be plain 32-bit integers");
+
+// Sleeps while word == expected, for at most timeout_ns. Returns 0 when
+// woken (possibly spuriously), -EAGAIN if the word had already changed,
+// -ETIMEDOUT or -EINTR.
+inline int futex_wait(const std::atomic<uint32_t> &word, uint32_t expected,
+                      uint64_t timeout_ns) {
+  timespec timeout;
+  timeout.tv_sec = static_cast<time_t>(timeout_ns / 1000000000);
+  timeout.tv_nsec = static_cast<long>(timeout_ns % 1000000000);
+  const long result = syscall(SYS_futex, &word, FUTEX_WAIT_PRIVATE, expected, &timeout,
+                              nullptr, 0);
+  return result == 0 ? 0 : -errno;
+}
+
+// Wakes every thread sleeping on word
+inline void futex_wake_all(std::atomic<uint32_t> &word) {
+  syscall(SYS_futex, &word, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+}
+
+// Asymmetric barrier: a rarely-taken path calls heavy_barrier() so the hot
+// path on other threads can skip its StoreLoad fence. Uses membarrier
+// (Linux 4.14+); when unavailable the hot path must fence itself.
+inline bool heavy_barrier_available() {
+  static const bool available =
+      syscall(SYS_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0, 0) == 0;
+  return available;
+}
+
+// Full barrier on every running thread of the process
+inline void heavy_barrier() {
+  if (!heavy_barrier_available() ||
+      syscall(SYS_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0, 0) != 0) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+}
+
+} // namespace mini_mart::common
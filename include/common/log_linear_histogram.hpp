@@ -0,0 +1,103 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace mini_mart::common {
+
+// Log-linear histogram over uint64 values: exact below 2^SUB_BUCKET_BITS,
+// then 2^SUB_BUCKET_BITS sub-buckets per power of two, so a reported
+// percentile is within 2^-SUB_BUCKET_BITS relative error (the DDSketch
+// guarantee, with a mapping that needs no logarithm). Values of
+// 2^(MAX_EXPONENT + 1) and up share the last bucket. The bucket layout is
+// fixed, so histograms merge losslessly by adding counts, e.g. across
+// shards or consecutive time buckets. Single writer, no atomics.
+template <uint32_t SUB_BUCKET_BITS, uint32_t MAX_EXPONENT> class LogLinearHistogram {
+  static_assert(SUB_BUCKET_BITS >= 1 && SUB_BUCKET_BITS < MAX_EXPONENT && MAX_EXPONENT < 64,
+                "invalid bucket layout");
+
+public:
+  static constexpr uint32_t SUB_BUCKETS = 1u << SUB_BUCKET_BITS;
+  static constexpr uint32_t BUCKET_COUNT = (MAX_EXPONENT - SUB_BUCKET_BITS + 2) * SUB_BUCKETS;
+
+  static uint32_t bucket_of(uint64_t value) {
+    if (value < SUB_BUCKETS) {
+      return static_cast<uint32_t>(value);
+    }
+    uint32_t exponent = 63u - static_cast<uint32_t>(__builtin_clzll(value));
+    if (exponent > MAX_EXPONENT) {
+      return BUCKET_COUNT - 1;
+    }
+    const uint32_t sub = static_cast<uint32_t>(value >> (exponent - SUB_BUCKET_BITS)) &
+                         (SUB_BUCKETS - 1);
+    return (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + sub;
+  }
+
+  // Upper bound of the values that land in bucket
+  static uint64_t bucket_upper_bound(uint32_t bucket) {
+    if (bucket < SUB_BUCKETS) {
+      return bucket;
+    }
+    const uint32_t exponent = bucket / SUB_BUCKETS + SUB_BUCKET_BITS - 1;
+    const uint64_t sub = bucket % SUB_BUCKETS;
+    const uint64_t width = uint64_t{1} << (exponent - SUB_BUCKET_BITS);
+    return ((SUB_BUCKETS + sub) << (exponent - SUB_BUCKET_BITS)) + width - 1;
+  }
+
+  void record(uint64_t value) {
+    ++counts_[bucket_of(value)];
+    ++total_;
+    if (value > max_) {
+      max_ = value;
+    }
+  }
+
+  void merge(const LogLinearHistogram &other) {
+    for (uint32_t bucket = 0; bucket < BUCKET_COUNT; ++bucket) {
+      counts_[bucket] += other.counts_[bucket];
+    }
+    total_ += other.total_;
+    if (other.max_ > max_) {
+      max_ = other.max_;
+    }
+  }
+
+  // Smallest bucket bound covering fraction q of the samples
+  uint64_t percentile(double q) const {
+    if (total_ == 0) {
+      return 0;
+    }
+    // Rank of the sample at quantile q (1-based, rounded up)
+    const double rank = q * static_cast<double>(total_);
+    auto target = static_cast<uint64_t>(rank);
+    if (static_cast<double>(target) < rank || target == 0) {
+      ++target;
+    }
+    uint64_t seen = 0;
+    for (uint32_t bucket = 0; bucket < BUCKET_COUNT; ++bucket) {
+      seen += counts_[bucket];
+      if (seen >= target) {
+        const uint64_t bound = bucket_upper_bound(bucket);
+        return bound < max_ ? bound : max_;
+      }
+    }
+    return max_;
+  }
+
+  uint64_t count() const { return total_; }
+  uint64_t max() const { return max_; }
+
+  void clear() {
+    std::memset(counts_.data(), 0, sizeof(counts_));
+    total_ = 0;
+    max_ = 0;
+  }
+
+private:
+  std::array<uint32_t, BUCKET_COUNT> counts_{};
+  uint64_t total_{0};
+  uint64_t max_{0};
+};
+
+} // namespace mini_mart::common
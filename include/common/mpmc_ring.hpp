@@ -0,0 +1,122 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace mini_mart::common {
+
+// Bounded multi-producer multi-consumer ring (per-slot sequence numbers).
+// Used where several threads hand work to a shared queue, e.g. task inboxes.
+template <typename T, size_t N> class MpmcRing {
+
+  static_assert(N > 1, "N must be greater than 1");
+  static_assert((N & (N - 1)) == 0, "N must be a power of 2");
+  static_assert(std::is_nothrow_move_constructible_v<T>,
+                "T must be nothrow move constructible");
+
+  static constexpr size_t CACHELINE_SIZE = 64;
+  static constexpr size_t CAPACITY = N;
+  static constexpr size_t MASK = N - 1;
+
+  struct alignas(std::max(alignof(T), CACHELINE_SIZE)) Slot {
+    std::atomic<size_t> sequence;
+    alignas(T) std::byte storage[sizeof(T)];
+  };
+
+public:
+  using value_type = T;
+
+  MpmcRing() : head(0), tail(0) {
+    for (size_t i = 0; i < CAPACITY; ++i) {
+      slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MpmcRing(const MpmcRing &other) = delete;
+  MpmcRing &operator=(const MpmcRing &other) = delete;
+
+  ~MpmcRing() {
+    T tmp;
+    while (this->try_pop(tmp)) {
+    }
+  }
+
+  // Approximate under concurrency
+  size_t size() const {
+    const size_t head_val = head.load(std::memory_order_relaxed);
+    const size_t tail_val = tail.load(std::memory_order_relaxed);
+    return tail_val >= head_val ? tail_val - head_val : 0;
+  }
+
+  bool empty() const { return size() == 0; }
+
+  static inline constexpr size_t get_capacity() { return CAPACITY; }
+
+  template <typename... Args> bool try_emplace(Args &&...args) {
+    size_t pos = tail.load(std::memory_order_relaxed);
+    Slot *slot;
+
+    for (;;) {
+      slot = &slots[pos & MASK];
+      const size_t seq = slot->sequence.load(std::memory_order_acquire);
+      const auto diff =
+          static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+      if (diff == 0) {
+        if (tail.compare_exchange_weak(pos, pos + 1,
+                                       std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false; // full
+      } else {
+        pos = tail.load(std::memory_order_relaxed);
+      }
+    }
+
+    ::new (static_cast<void *>(slot->storage)) T(std::forward<Args>(args)...);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool try_push(const T &value) { return this->try_emplace(value); }
+
+  bool try_push(T &&value) { return this->try_emplace(std::move(value)); }
+
+  bool try_pop(T &out) {
+    size_t pos = head.load(std::memory_order_relaxed);
+    Slot *slot;
+
+    for (;;) {
+      slot = &slots[pos & MASK];
+      const size_t seq = slot->sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::ptrdiff_t>(seq) -
+                        static_cast<std::ptrdiff_t>(pos + 1);
+      if (diff == 0) {
+        if (head.compare_exchange_weak(pos, pos + 1,
+                                       std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false; // empty
+      } else {
+        pos = head.load(std::memory_order_relaxed);
+      }
+    }
+
+    T *elem = std::launder(reinterpret_cast<T *>(slot->storage));
+    out = std::move(*elem);
+    elem->~T();
+    slot->sequence.store(pos + CAPACITY, std::memory_order_release);
+    return true;
+  }
+
+private:
+  alignas(CACHELINE_SIZE) std::atomic<size_t> head;
+  alignas(CACHELINE_SIZE) std::atomic<size_t> tail;
+  Slot slots[CAPACITY];
+};
+
+} // namespace mini_mart::common
@@ -0,0 +1,409 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace mini_mart::common {
+
+// Byte pattern written over freed blocks in debug builds so use-after-free
+// shows up as obviously bogus data instead of stale-but-plausible values.
+inline constexpr unsigned char FREED_MEMORY_PATTERN = 0xDD;
+
+// Usage counters. Maintained in debug builds only (NDEBUG compiles the
+// bookkeeping out of the hot path); release builds report zeros.
+struct AllocatorStatistics {
+  uint64_t allocations{0};
+  uint64_t deallocations{0};
+  uint64_t failed_allocations{0};
+  uint64_t in_use{0};
+  uint64_t high_water{0};
+};
+
+// Single-threaded pool of fixed-size blocks carved from one slab allocated
+// at construction. Free blocks form an intrusive singly linked list threaded
+// through the blocks themselves. allocate() returns nullptr when exhausted.
+class FixedBlockPool {
+public:
+  static constexpr size_t DEFAULT_ALIGNMENT = alignof(std::max_align_t);
+
+  FixedBlockPool(size_t block_size, size_t capacity,
+                 size_t alignment = DEFAULT_ALIGNMENT)
+      : block_size_(round_up(std::max(block_size, sizeof(FreeNode)),
+                             alignment)),
+        capacity_(capacity), alignment_(alignment),
+        slab_(static_cast<std::byte *>(::operator new(
+            block_size_ * capacity_, std::align_val_t{alignment_}))) {
+    for (size_t i = capacity_; i > 0; --i) {
+      push_free(slab_ + (i - 1) * block_size_);
+    }
+    available_ = capacity_;
+  }
+
+  ~FixedBlockPool() {
+    ::operator delete(slab_, std::align_val_t{alignment_});
+  }
+
+  FixedBlockPool(const FixedBlockPool &) = delete;
+  FixedBlockPool &operator=(const FixedBlockPool &) = delete;
+  FixedBlockPool(FixedBlockPool &&) = delete;
+  FixedBlockPool &operator=(FixedBlockPool &&) = delete;
+
+  void *allocate() noexcept {
+    FreeNode *node = free_head_;
+    if (node == nullptr) {
+#ifndef NDEBUG
+      ++stats_.failed_allocations;
+#endif
+      return nullptr;
+    }
+    free_head_ = node->next;
+    --available_;
+#ifndef NDEBUG
+    ++stats_.allocations;
+    ++stats_.in_use;
+    stats_.high_water = std::max(stats_.high_water, stats_.in_use);
+#endif
+    return node;
+  }
+
+  void deallocate(void *ptr) noexcept {
+#ifndef NDEBUG
+    std::memset(ptr, FREED_MEMORY_PATTERN, block_size_);
+    ++stats_.deallocations;
+    --stats_.in_use;
+#endif
+    push_free(ptr);
+    ++available_;
+  }
+
+  bool owns(const void *ptr) const noexcept {
+    const auto *p = static_cast<const std::byte *>(ptr);
+    return p >= slab_ && p < slab_ + block_size_ * capacity_;
+  }
+
+  size_t block_size() const { return block_size_; }
+  size_t capacity() const { return capacity_; }
+  size_t available() const { return available_; }
+  size_t alignment() const { return alignment_; }
+  const AllocatorStatistics &get_statistics() const { return stats_; }
+
+private:
+  struct FreeNode {
+    FreeNode *next;
+  };
+
+  static constexpr size_t round_up(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+  }
+
+  void push_free(void *ptr) noexcept {
+    auto *node = static_cast<FreeNode *>(ptr);
+    node->next = free_head_;
+    free_head_ = node;
+  }
+
+  size_t block_size_;
+  size_t capacity_;
+  size_t alignment_;
+  std::byte *slab_;
+  FreeNode *free_head_{nullptr};
+  size_t available_{0};
+  AllocatorStatistics stats_;
+};
+
+// Typed single-threaded object pool for hot-path objects (orders, book
+// levels, variable-size message nodes). create() returns nullptr when the
+// pool is exhausted; capacity is fixed at construction.
+template <typename T> class ObjectPool {
+public:
+  explicit ObjectPool(size_t capacity)
+      : blocks_(sizeof(T), capacity,
+                std::max(alignof(T), alignof(void *))) {}
+
+  ObjectPool(const ObjectPool &) = delete;
+  ObjectPool &operator=(const ObjectPool &) = delete;
+
+  template <typename... Args> T *create(Args &&...args) {
+    void *ptr = blocks_.allocate();
+    if (ptr == nullptr) {
+      return nullptr;
+    }
+    return ::new (ptr) T(std::forward<Args>(args)...);
+  }
+
+  void destroy(T *object) noexcept {
+    if (object == nullptr) {
+      return;
+    }
+    object->~T();
+    blocks_.deallocate(object);
+  }
+
+  bool owns(const T *object) const noexcept { return blocks_.owns(object); }
+  size_t capacity() const { return blocks_.capacity(); }
+  size_t available() const { return blocks_.available(); }
+  const AllocatorStatistics &get_statistics() const {
+    return blocks_.get_statistics();
+  }
+
+private:
+  FixedBlockPool blocks_;
+};
+
+// Object pool shared between threads. The global free list is a Treiber
+// stack of slot indices tagged with a generation counter (ABA-safe with a
+// single 64-bit CAS). The links live in their own array, not in the slots:
+// a popper may read a stale link while another thread constructs into the
+// slot it names. Threads that allocate and free frequently should go
+// through a LocalCache, which moves indices to and from the global list in
+// batches so the common case touches no shared cache line (debug builds
+// also count usage in shared atomics).
+template <typename T> class ConcurrentObjectPool {
+public:
+  static constexpr uint32_t NIL = UINT32_MAX;
+
+  explicit ConcurrentObjectPool(uint32_t capacity)
+      : capacity_(capacity), slots_(static_cast<Slot *>(::operator new(
+                                 sizeof(Slot) * capacity,
+                                 std::align_val_t{alignof(Slot)}))),
+        next_(std::make_unique<std::atomic<uint32_t>[]>(capacity)) {
+    for (uint32_t i = 0; i < capacity_; ++i) {
+      next_[i].store(i + 1 < capacity_ ? i + 1 : NIL, std::memory_order_relaxed);
+    }
+    head_.store(pack(capacity_ > 0 ? 0 : NIL, 0), std::memory_order_relaxed);
+  }
+
+  ~ConcurrentObjectPool() {
+    ::operator delete(slots_, std::align_val_t{alignof(Slot)});
+  }
+
+  ConcurrentObjectPool(const ConcurrentObjectPool &) = delete;
+  ConcurrentObjectPool &operator=(const ConcurrentObjectPool &) = delete;
+
+  template <typename... Args> T *create(Args &&...args) {
+    const uint32_t index = pop_global();
+    if (index == NIL) {
+      count_failed();
+      return nullptr;
+    }
+    return construct(index, std::forward<Args>(args)...);
+  }
+
+  void destroy(T *object) noexcept {
+    if (object != nullptr) {
+      push_global(release(object));
+    }
+  }
+
+  uint32_t capacity() const { return capacity_; }
+
+  // Snapshot of the usage counters, across all threads and caches; zeros
+  // in release builds
+  AllocatorStatistics get_statistics() const {
+    AllocatorStatistics stats;
+#ifndef NDEBUG
+    stats.allocations = allocations_.load(std::memory_order_relaxed);
+    stats.deallocations = deallocations_.load(std::memory_order_relaxed);
+    stats.failed_allocations = failed_allocations_.load(std::memory_order_relaxed);
+    stats.in_use = in_use_.load(std::memory_order_relaxed);
+    stats.high_water = high_water_.load(std::memory_order_relaxed);
+#endif
+    return stats;
+  }
+
+  // Per-thread cache. Not thread-safe itself: one instance per thread.
+  // Returns its cached slots to the pool on destruction.
+  class LocalCache {
+  public:
+    static constexpr uint32_t CACHE_SIZE = 64;
+    static constexpr uint32_t BATCH_SIZE = CACHE_SIZE / 2;
+
+    explicit LocalCache(ConcurrentObjectPool &pool) : pool_(pool) {}
+    ~LocalCache() {
+      while (count_ > 0) {
+        pool_.push_global(indices_[--count_]);
+      }
+    }
+
+    LocalCache(const LocalCache &) = delete;
+    LocalCache &operator=(const LocalCache &) = delete;
+
+    template <typename... Args> T *create(Args &&...args) {
+      if (count_ == 0) {
+        refill();
+        if (count_ == 0) {
+          pool_.count_failed();
+          return nullptr;
+        }
+      }
+      return pool_.construct(indices_[--count_], std::forward<Args>(args)...);
+    }
+
+    void destroy(T *object) noexcept {
+      if (object == nullptr) {
+        return;
+      }
+      if (count_ == CACHE_SIZE) {
+        for (uint32_t i = 0; i < BATCH_SIZE; ++i) {
+          pool_.push_global(indices_[--count_]);
+        }
+      }
+      indices_[count_++] = pool_.release(object);
+    }
+
+  private:
+    void refill() {
+      for (uint32_t i = 0; i < BATCH_SIZE; ++i) {
+        const uint32_t index = pool_.pop_global();
+        if (index == NIL) {
+          break;
+        }
+        indices_[count_++] = index;
+      }
+    }
+
+    ConcurrentObjectPool &pool_;
+    uint32_t indices_[CACHE_SIZE];
+    uint32_t count_{0};
+  };
+
+private:
+  struct Slot {
+    alignas(T) std::byte storage[sizeof(T)];
+  };
+
+  static uint64_t pack(uint32_t index, uint32_t tag) {
+    return (static_cast<uint64_t>(tag) << 32) | index;
+  }
+  static uint32_t index_of(uint64_t head) {
+    return static_cast<uint32_t>(head & 0xFFFFFFFFu);
+  }
+  static uint32_t tag_of(uint64_t head) {
+    return static_cast<uint32_t>(head >> 32);
+  }
+
+  template <typename... Args> T *construct(uint32_t index, Args &&...args) {
+#ifndef NDEBUG
+    allocations_.fetch_add(1, std::memory_order_relaxed);
+    const uint64_t in_use = in_use_.fetch_add(1, std::memory_order_relaxed) + 1;
+    uint64_t high_water = high_water_.load(std::memory_order_relaxed);
+    while (in_use > high_water &&
+           !high_water_.compare_exchange_weak(high_water, in_use, std::memory_order_relaxed)) {
+    }
+#endif
+    return ::new (static_cast<void *>(slots_[index].storage))
+        T(std::forward<Args>(args)...);
+  }
+
+  uint32_t release(T *object) noexcept {
+    object->~T();
+    auto *slot = reinterpret_cast<Slot *>(object);
+#ifndef NDEBUG
+    std::memset(slot->storage, FREED_MEMORY_PATTERN, sizeof(T));
+    deallocations_.fetch_add(1, std::memory_order_relaxed);
+    in_use_.fetch_sub(1, std::memory_order_relaxed);
+#endif
+    return static_cast<uint32_t>(slot - slots_);
+  }
+
+  void count_failed() noexcept {
+#ifndef NDEBUG
+    failed_allocations_.fetch_add(1, std::memory_order_relaxed);
+#endif
+  }
+
+  uint32_t pop_global() noexcept {
+    uint64_t head = head_.load(std::memory_order_acquire);
+    for (;;) {
+      const uint32_t index = index_of(head);
+      if (index == NIL) {
+        return NIL;
+      }
+      // A stale next is harmless: the tag makes the CAS fail
+      const uint32_t next = next_[index].load(std::memory_order_relaxed);
+      if (head_.compare_exchange_weak(head, pack(next, tag_of(head) + 1),
+                                      std::memory_order_acquire,
+                                      std::memory_order_acquire)) {
+        return index;
+      }
+    }
+  }
+
+  void push_global(uint32_t index) noexcept {
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    for (;;) {
+      next_[index].store(index_of(head), std::memory_order_relaxed);
+      if (head_.compare_exchange_weak(head, pack(index, tag_of(head) + 1),
+                                      std::memory_order_release,
+                                      std::memory_order_relaxed)) {
+        return;
+      }
+    }
+  }
+
+  uint32_t capacity_;
+  Slot *slots_;
+  std::unique_ptr<std::atomic<uint32_t>[]> next_; // free-list links by slot
+  alignas(64) std::atomic<uint64_t> head_;
+#ifndef NDEBUG
+  alignas(64) std::atomic<uint64_t> allocations_{0};
+  std::atomic<uint64_t> deallocations_{0};
+  std::atomic<uint64_t> failed_allocations_{0};
+  std::atomic<uint64_t> in_use_{0};
+  std::atomic<uint64_t> high_water_{0};
+#endif
+};
+
+// std-compatible allocator for node-based containers (std::map, std::list,
+// std::unordered_map nodes). Single-object allocations that fit the pool's
+// block size come from the FixedBlockPool; anything else (bucket arrays,
+// oversized rebinds) goes to the global heap. An exhausted pool aborts.
+template <typename T> class PoolAllocator {
+public:
+  using value_type = T;
+
+  explicit PoolAllocator(FixedBlockPool &pool) noexcept : pool_(&pool) {}
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U> &other) noexcept : pool_(other.pool()) {}
+
+  T *allocate(size_t n) {
+    if (n == 1 && fits_pool()) {
+      void *ptr = pool_->allocate();
+      if (ptr == nullptr) {
+        std::abort();
+      }
+      return static_cast<T *>(ptr);
+    }
+    return static_cast<T *>(::operator new(sizeof(T) * n, std::align_val_t{alignof(T)}));
+  }
+
+  void deallocate(T *ptr, size_t n) noexcept {
+    if (n == 1 && fits_pool()) {
+      pool_->deallocate(ptr);
+      return;
+    }
+    ::operator delete(ptr, std::align_val_t{alignof(T)});
+  }
+
+  FixedBlockPool *pool() const noexcept { return pool_; }
+
+  template <typename U> bool operator==(const PoolAllocator<U> &other) const {
+    return pool_ == other.pool();
+  }
+
+private:
+  bool fits_pool() const noexcept {
+    return sizeof(T) <= pool_->block_size() && alignof(T) <= pool_->alignment();
+  }
+
+  FixedBlockPool *pool_;
+};
+
+} // namespace mini_mart::common
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace mini_mart::common {
+
+// Cache-miss counters for the calling thread via perf_event_open, grouped so
+// all of them cover the same instructions. User space only, so it works at
+// perf_event_paranoid <= 2. Linux has no generic L2 event; misses out of L1D
+// are L2 lookups and LLC read accesses are (approximately) L2 misses.
+class PerfCounters {
+public:
+  enum Event : size_t {
+    INSTRUCTIONS = 0,
+    L1D_READ_MISSES = 1,  // ~ L2 accesses
+    LLC_READ_ACCESSES = 2, // ~ L2 misses
+    LLC_READ_MISSES = 3,
+    EVENT_COUNT = 4
+  };
+
+  using Values = std::array<uint64_t, EVENT_COUNT>;
+
+  PerfCounters() = default;
+  ~PerfCounters() { close_all(); }
+
+  PerfCounters(const PerfCounters &) = delete;
+  PerfCounters &operator=(const PerfCounters &) = delete;
+
+  // Returns -errno on failure (e.g. no PMU in a VM); the counters then stay
+  // unavailable and read() reports zeros
+  int open() {
+    close_all();
+    for (size_t i = 0; i < EVENT_COUNT; ++i) {
+      perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.disabled = i == 0 ? 1 : 0;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_GROUP;
+      config_for(static_cast<Event>(i), attr);
+
+      const long fd = syscall(__NR_perf_event_open, &attr, 0, -1, i == 0 ? -1 : fds_[0], 0);
+      if (fd < 0) {
+        const int error = errno;
+        close_all();
+        return -error;
+      }
+      fds_[i] = static_cast<int>(fd);
+    }
+    return 0;
+  }
+
+  bool available() const { return fds_[0] >= 0; }
+
+  void start() {
+    if (available()) {
+      ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+      ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+  }
+
+  void stop() {
+    if (available()) {
+      ioctl(fds_[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    }
+  }
+
+  Values read() const {
+    Values values{};
+    if (!available()) {
+      return values;
+    }
+    // PERF_FORMAT_GROUP: count, then one value per event
+    std::array<uint64_t, EVENT_COUNT + 1> buffer{};
+    if (::read(fds_[0], buffer.data(), sizeof(buffer)) ==
+        static_cast<ssize_t>(sizeof(buffer))) {
+      for (size_t i = 0; i < EVENT_COUNT; ++i) {
+        values[i] = buffer[i + 1];
+      }
+    }
+    return values;
+  }
+
+  static const char *event_name(Event event) {
+    switch (event) {
+    case INSTRUCTIONS:
+      return "instructions";
+    case L1D_READ_MISSES:
+      return "l1d_misses";
+    case LLC_READ_ACCESSES:
+      return "l2_misses";
+    case LLC_READ_MISSES:
+      return "llc_misses";
+    default:
+      return "unknown";
+    }
+  }
+
+private:
+  static void config_for(Event event, perf_event_attr &attr) {
+    const auto cache = [&attr](uint64_t cache_id, uint64_t result) {
+      attr.type = PERF_TYPE_HW_CACHE;
+      attr.config = cache_id | (uint64_t{PERF_COUNT_HW_CACHE_OP_READ} << 8) | (result << 16);
+    };
+    switch (event) {
+    case L1D_READ_MISSES:
+      cache(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_RESULT_MISS);
+      break;
+    case LLC_READ_ACCESSES:
+      cache(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_RESULT_ACCESS);
+      break;
+    case LLC_READ_MISSES:
+      cache(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_RESULT_MISS);
+      break;
+    default:
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+      break;
+    }
+  }
+
+  void close_all() {
+    for (int &fd : fds_) {
+      if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+      }
+    }
+  }
+
+  std::array<int, EVENT_COUNT> fds_{-1, -1, -1, -1};
+};
+
+} // namespace mini_mart::common
@@ -0,0 +1,267 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace mini_mart::common {
+
+// Time-windowed aggregators over one stream of timestamped samples, each
+// tracking up to WINDOWS window lengths at once in fixed storage.
+//
+// A window of length L covers (now - L, now], where now is the timestamp of
+// the latest push() or expire(): a sample at t leaves it once now reaches
+// t + L. Timestamps must not decrease. CAPACITY bounds the samples held for
+// the longest window; when it is exceeded the oldest sample is dropped
+// early and counted in truncated(), so size it for the peak rate times the
+// longest window. Every operation is O(WINDOWS) amortized and allocation
+// free.
+
+// Minimum or maximum (per Compare) over each window: a monotonic deque of
+// the samples that can still become the extremum, shared by all windows.
+// Entries run oldest to newest with values strictly ordered by Compare, so
+// each window's extremum is its oldest entry still inside the window; each
+// window keeps a cursor to it that only moves forward.
+template <typename T, size_t CAPACITY, size_t WINDOWS, typename Compare> class RollingExtremum {
+  static_assert(CAPACITY > 1 && (CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of 2");
+  static_assert(WINDOWS > 0, "at least one window");
+
+public:
+  explicit RollingExtremum(const std::array<uint64_t, WINDOWS> &lengths_ns = {}) { configure(lengths_ns); }
+
+  // Sets the window lengths and clears all samples
+  void configure(const std::array<uint64_t, WINDOWS> &lengths_ns) {
+    lengths_ = lengths_ns;
+    longest_ = 0;
+    for (size_t w = 1; w < WINDOWS; ++w) {
+      longest_ = lengths_[w] > lengths_[longest_] ? w : longest_;
+    }
+    head_ = tail_ = 0;
+    starts_.fill(0);
+    truncated_ = 0;
+  }
+
+  void push(uint64_t timestamp_ns, T value) {
+    // Entries the new value beats (or ties) can never be an extremum again
+    while (tail_ != head_ && !Compare{}(entries_[(tail_ - 1) & MASK].value, value)) {
+      --tail_;
+    }
+    if (tail_ - head_ == CAPACITY) {
+      ++head_;
+      ++truncated_;
+    }
+    entries_[tail_ & MASK] = Entry{timestamp_ns, value};
+    for (uint64_t &start : starts_) {
+      start = start > tail_ ? tail_ : (start < head_ ? head_ : start);
+    }
+    ++tail_;
+    expire(timestamp_ns);
+  }
+
+  // Ages the windows to now_ns without a sample (e.g. on a timer)
+  void expire(uint64_t now_ns) {
+    for (size_t w = 0; w < WINDOWS; ++w) {
+      uint64_t start = starts_[w];
+      while (start != tail_ && entries_[start & MASK].timestamp_ns + lengths_[w] <= now_ns) {
+        ++start;
+      }
+      starts_[w] = start;
+    }
+    head_ = starts_[longest_];
+  }
+
+  bool empty(size_t window) const { return starts_[window] == tail_; }
+  // Extremum of the window; T{} when it is empty
+  T value(size_t window) const { return empty(window) ? T{} : entries_[starts_[window] & MASK].value; }
+
+  uint64_t length_ns(size_t window) const { return lengths_[window]; }
+  uint64_t truncated() const { return truncated_; }
+
+private:
+  static constexpr uint64_t MASK = CAPACITY - 1;
+
+  struct Entry {
+    uint64_t timestamp_ns;
+    T value;
+  };
+
+  std::array<Entry, CAPACITY> entries_{};
+  std::array<uint64_t, WINDOWS> lengths_{};
+  std::array<uint64_t, WINDOWS> starts_{}; // oldest entry inside each window
+  uint64_t head_{0};                       // positions count up and never wrap
+  uint64_t tail_{0};
+  size_t longest_{0};
+  uint64_t truncated_{0};
+};
+
+template <typename T, size_t CAPACITY, size_t WINDOWS = 1>
+using RollingMin = RollingExtremum<T, CAPACITY, WINDOWS, std::less<T>>;
+template <typename T, size_t CAPACITY, size_t WINDOWS = 1>
+using RollingMax = RollingExtremum<T, CAPACITY, WINDOWS, std::greater<T>>;
+
+// Count, sum, mean and variance of int64 samples over each window, from a
+// ring of prefix sums: every entry records the running sum and sum of
+// squares before its sample, so a window's totals are the running totals
+// minus its oldest entry's, whatever the window length. Integer sums never
+// drift; running totals may wrap, the differences stay exact as long as a
+// window's own sum fits int64.
+template <size_t CAPACITY, size_t WINDOWS = 1> class RollingMoments {
+  static_assert(CAPACITY > 1 && (CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of 2");
+  static_assert(WINDOWS > 0, "at least one window");
+
+  __extension__ typedef unsigned __int128 Wide;
+
+public:
+  explicit RollingMoments(const std::array<uint64_t, WINDOWS> &lengths_ns = {}) { configure(lengths_ns); }
+
+  // Sets the window lengths and clears all samples
+  void configure(const std::array<uint64_t, WINDOWS> &lengths_ns) {
+    lengths_ = lengths_ns;
+    longest_ = 0;
+    for (size_t w = 1; w < WINDOWS; ++w) {
+      longest_ = lengths_[w] > lengths_[longest_] ? w : longest_;
+    }
+    head_ = tail_ = 0;
+    starts_.fill(0);
+    sum_ = 0;
+    sum_squares_ = 0;
+    truncated_ = 0;
+  }
+
+  void push(uint64_t timestamp_ns, int64_t value) {
+    if (tail_ - head_ == CAPACITY) {
+      ++head_;
+      ++truncated_;
+      for (uint64_t &start : starts_) {
+        start = start < head_ ? head_ : start;
+      }
+    }
+    entries_[tail_ & MASK] = Entry{timestamp_ns, sum_, sum_squares_};
+    ++tail_;
+    const uint64_t magnitude = value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+    sum_ += static_cast<uint64_t>(value);
+    sum_squares_ += static_cast<Wide>(magnitude) * magnitude;
+    expire(timestamp_ns);
+  }
+
+  // Ages the windows to now_ns without a sample (e.g. on a timer)
+  void expire(uint64_t now_ns) {
+    for (size_t w = 0; w < WINDOWS; ++w) {
+      uint64_t start = starts_[w];
+      while (start != tail_ && entries_[start & MASK].timestamp_ns + lengths_[w] <= now_ns) {
+        ++start;
+      }
+      starts_[w] = start;
+    }
+    head_ = starts_[longest_];
+  }
+
+  size_t count(size_t window) const { return static_cast<size_t>(tail_ - starts_[window]); }
+
+  int64_t sum(size_t window) const {
+    return count(window) == 0 ? 0 : static_cast<int64_t>(sum_ - oldest(window).sum_before);
+  }
+
+  Wide sum_squares(size_t window) const {
+    return count(window) == 0 ? 0 : sum_squares_ - oldest(window).sum_squares_before;
+  }
+
+  // Reporting values; zero for an empty window
+  double mean(size_t window) const {
+    const size_t n = count(window);
+    return n == 0 ? 0.0 : static_cast<double>(sum(window)) / static_cast<double>(n);
+  }
+
+  // Population variance, from n x sum of squares - sum^2 computed exactly in
+  // 128 bits (which needs n x sum of squares < 2^128)
+  double variance(size_t window) const {
+    const size_t n = count(window);
+    if (n < 2) {
+      return 0.0;
+    }
+    const int64_t total = sum(window);
+    const uint64_t magnitude = total < 0 ? 0 - static_cast<uint64_t>(total) : static_cast<uint64_t>(total);
+    const Wide spread = sum_squares(window) * n - static_cast<Wide>(magnitude) * magnitude;
+    return static_cast<double>(spread) / (static_cast<double>(n) * static_cast<double>(n));
+  }
+
+  uint64_t length_ns(size_t window) const { return lengths_[window]; }
+  uint64_t truncated() const { return truncated_; }
+
+private:
+  static constexpr uint64_t MASK = CAPACITY - 1;
+
+  struct Entry {
+    uint64_t timestamp_ns;
+    uint64_t sum_before; // running totals just before this sample
+    Wide sum_squares_before;
+  };
+
+  const Entry &oldest(size_t window) const { return entries_[starts_[window] & MASK]; }
+
+  std::array<Entry, CAPACITY> entries_{};
+  std::array<uint64_t, WINDOWS> lengths_{};
+  std::array<uint64_t, WINDOWS> starts_{}; // oldest sample inside each window
+  uint64_t head_{0};                       // positions count up and never wrap
+  uint64_t tail_{0};
+  size_t longest_{0};
+  uint64_t sum_{0};   // running, wrapping
+  Wide sum_squares_{0};
+  uint64_t truncated_{0};
+};
+
+// Event counts over a sliding window on a time wheel: BUCKETS buckets of a
+// caller-chosen span, the newest partly filled, so a window covers the
+// last BUCKETS - 1 whole buckets plus the current one. FIELDS counters
+// share the wheel. Advancing clears only the buckets that fell out (at
+// most BUCKETS, however long the gap), so state is fixed and every
+// operation is O(FIELDS) amortized; cheap enough to keep one per key.
+template <size_t FIELDS, size_t BUCKETS> class TimeWheelCounts {
+  static_assert(BUCKETS > 1 && (BUCKETS & (BUCKETS - 1)) == 0, "BUCKETS must be a power of 2");
+  static_assert(FIELDS > 0, "at least one counter");
+
+public:
+  // Moves the wheel to absolute bucket number bucket (timestamp / span);
+  // earlier buckets are ignored
+  void advance_to(uint64_t bucket) {
+    if (bucket <= current_) {
+      return;
+    }
+    const uint64_t expired = bucket - current_ < BUCKETS ? bucket - current_ : BUCKETS;
+    for (uint64_t b = current_ + 1; b <= current_ + expired; ++b) {
+      std::array<uint32_t, FIELDS> &counts = buckets_[b & MASK];
+      for (size_t f = 0; f < FIELDS; ++f) {
+        totals_[f] -= counts[f];
+        counts[f] = 0;
+      }
+    }
+    current_ = bucket;
+  }
+
+  // Into the current bucket
+  void add(size_t field, uint32_t count = 1) {
+    buckets_[current_ & MASK][field] += count;
+    totals_[field] += count;
+  }
+
+  uint32_t total(size_t field) const { return totals_[field]; }
+  uint64_t current_bucket() const { return current_; }
+
+  void clear() {
+    for (std::array<uint32_t, FIELDS> &counts : buckets_) {
+      counts.fill(0);
+    }
+    totals_.fill(0);
+    current_ = 0;
+  }
+
+private:
+  static constexpr uint64_t MASK = BUCKETS - 1;
+
+  std::array<std::array<uint32_t, FIELDS>, BUCKETS> buckets_{};
+  std::array<uint32_t, FIELDS> totals_{};
+  uint64_t current_{0};
+};
+
+} // namespace mini_mart::common
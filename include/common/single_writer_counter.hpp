@@ -0,0 +1,14 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace mini_mart::common {
+
+// Increments a statistics counter that only one thread writes (any thread
+// may read it relaxed): a plain load and store, no locked add needed
+inline void bump(std::atomic<uint64_t> &counter) {
+  counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+} // namespace mini_mart::common
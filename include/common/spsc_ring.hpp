@@ -21,6 +21,8 @@ template <typename T, size_t N> class SpscRing {
   static constexpr size_t STRIDE = sizeof(T);
 
 public:
+  using value_type = T;
+
   explicit SpscRing() : head(0), tail(0) {}
 
   SpscRing(const SpscRing &other) = delete;
@@ -0,0 +1,372 @@
+#pragma once
+
+#include "common/chase_lev_deque.hpp"
+#include "common/mpmc_ring.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <pthread.h>
+#include <sched.h>
+#include <thread>
+#include <vector>
+
+namespace mini_mart::common {
+
+// Work-stealing thread pool for non-latency-critical work (bars, analytics,
+// snapshot publishing, compression). Never run hot-path stages on it: use
+// Config::excluded_cores to keep its workers off the cores those threads own.
+// Workers are confined to the remaining cores of the process cpuset;
+// pin_threads further pins each worker to one of them.
+//
+// Each worker owns a Chase-Lev deque for tasks it spawns itself and an MPMC
+// inbox for tasks submitted from outside or with an affinity hint. Idle
+// workers steal from other workers' deques and inboxes.
+class WorkStealingPool {
+public:
+  static constexpr size_t DEQUE_CAPACITY = 4096;
+  static constexpr size_t INBOX_CAPACITY = 1024;
+  static constexpr size_t NO_AFFINITY = SIZE_MAX;
+
+  struct Config {
+    size_t num_workers;            // 0 = one per allowed core
+    std::vector<int> excluded_cores; // cores reserved for the hot path
+    bool pin_threads;                // one allowed core per worker
+    uint32_t idle_spin_count;
+    uint32_t idle_sleep_us;
+
+    Config()
+        : num_workers(0), pin_threads(false), idle_spin_count(64),
+          idle_sleep_us(50) {}
+  };
+
+  struct Statistics {
+    uint64_t tasks_submitted{0};
+    uint64_t tasks_executed{0};
+    uint64_t tasks_stolen{0};
+    uint64_t submit_failures{0};
+  };
+
+  // Join counter for fork/join. Tasks submitted against a group decrement it
+  // on completion; wait() runs other tasks until it reaches zero.
+  class TaskGroup {
+  public:
+    TaskGroup() = default;
+    TaskGroup(const TaskGroup &) = delete;
+    TaskGroup &operator=(const TaskGroup &) = delete;
+
+    bool done() const { return pending_.load(std::memory_order_acquire) == 0; }
+    size_t pending() const { return pending_.load(std::memory_order_relaxed); }
+
+  private:
+    friend class WorkStealingPool;
+    std::atomic<size_t> pending_{0};
+  };
+
+  explicit WorkStealingPool(const Config &config = Config())
+      : config_(config) {}
+
+  ~WorkStealingPool() { stop(); }
+
+  WorkStealingPool(const WorkStealingPool &) = delete;
+  WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+  WorkStealingPool(WorkStealingPool &&) = delete;
+  WorkStealingPool &operator=(WorkStealingPool &&) = delete;
+
+  bool start() {
+    if (running_.load(std::memory_order_acquire)) {
+      return false;
+    }
+
+    allowed_cores_ = compute_allowed_cores(config_.excluded_cores);
+    if ((config_.pin_threads || !config_.excluded_cores.empty()) &&
+        allowed_cores_.empty()) {
+      return false;
+    }
+
+    size_t num_workers = config_.num_workers;
+    if (num_workers == 0) {
+      num_workers = std::max<size_t>(1, allowed_cores_.size());
+    }
+
+    workers_.clear();
+    workers_.reserve(num_workers);
+    for (size_t i = 0; i < num_workers; ++i) {
+      workers_.push_back(std::make_unique<Worker>());
+    }
+
+    running_.store(true, std::memory_order_release);
+    for (size_t i = 0; i < num_workers; ++i) {
+      workers_[i]->thread = std::thread(&WorkStealingPool::worker_loop, this, i);
+    }
+
+    return true;
+  }
+
+  // Stops the workers. Tasks still queued are discarded without running, so
+  // submit() and wait() must not race with stop().
+  void stop() {
+    if (!running_.load(std::memory_order_acquire)) {
+      return;
+    }
+
+    running_.store(false, std::memory_order_release);
+    for (auto &worker : workers_) {
+      if (worker->thread.joinable()) {
+        worker->thread.join();
+      }
+    }
+
+    for (auto &worker : workers_) {
+      Task *task = nullptr;
+      while (worker->deque.try_pop(task)) {
+        delete task;
+      }
+      while (worker->inbox.try_pop(task)) {
+        delete task;
+      }
+    }
+  }
+
+  bool is_running() const { return running_.load(std::memory_order_acquire); }
+
+  size_t worker_count() const { return workers_.size(); }
+
+  // Index of the calling worker in this pool, or NO_AFFINITY if the caller is
+  // not one of its workers.
+  size_t current_worker_index() const {
+    return tls_pool_ == this ? tls_worker_index_ : NO_AFFINITY;
+  }
+
+  // Fire-and-forget submission. affinity is a hint naming the preferred
+  // worker; other workers may still steal the task when it is idle. Fails
+  // only when stopped or, from outside the pool, when the inbox is full.
+  bool submit(std::function<void()> fn, size_t affinity = NO_AFFINITY) {
+    return enqueue(new Task{std::move(fn), nullptr}, affinity);
+  }
+
+  bool submit(TaskGroup &group, std::function<void()> fn,
+              size_t affinity = NO_AFFINITY) {
+    group.pending_.fetch_add(1, std::memory_order_relaxed);
+    if (!enqueue(new Task{std::move(fn), &group}, affinity)) {
+      group.pending_.fetch_sub(1, std::memory_order_relaxed);
+      return false;
+    }
+    return true;
+  }
+
+  // Runs queued tasks on the calling thread until the group completes. Safe
+  // to call from inside a task (nested fork/join).
+  void wait(TaskGroup &group) {
+    const size_t self = current_worker_index();
+    uint32_t idle = 0;
+
+    while (!group.done()) {
+      Task *task = nullptr;
+      bool found = self != NO_AFFINITY ? find_task(self, task)
+                                       : steal_task(workers_.size(), task);
+      if (found) {
+        run_task(self, task);
+        idle = 0;
+      } else if (++idle > config_.idle_spin_count) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  Statistics get_statistics() const {
+    Statistics stats;
+    stats.tasks_executed = external_executed_.load(std::memory_order_relaxed);
+    for (const auto &worker : workers_) {
+      stats.tasks_executed +=
+          worker->tasks_executed.load(std::memory_order_relaxed);
+      stats.tasks_stolen += worker->tasks_stolen.load(std::memory_order_relaxed);
+    }
+    stats.tasks_submitted = tasks_submitted_.load(std::memory_order_relaxed);
+    stats.submit_failures = submit_failures_.load(std::memory_order_relaxed);
+    return stats;
+  }
+
+  // Cores the workers may run on: the process's cpuset (all online cores if
+  // it cannot be read) minus the excluded ones
+  static std::vector<int>
+  compute_allowed_cores(const std::vector<int> &excluded_cores) {
+    cpu_set_t process_cores;
+    CPU_ZERO(&process_cores);
+    if (sched_getaffinity(0, sizeof(cpu_set_t), &process_cores) != 0) {
+      const int num_cores = static_cast<int>(std::thread::hardware_concurrency());
+      for (int core = 0; core < num_cores && core < CPU_SETSIZE; ++core) {
+        CPU_SET(static_cast<size_t>(core), &process_cores);
+      }
+    }
+
+    std::vector<int> result;
+    for (int core = 0; core < CPU_SETSIZE; ++core) {
+      if (CPU_ISSET(static_cast<size_t>(core), &process_cores) &&
+          std::find(excluded_cores.begin(), excluded_cores.end(), core) ==
+              excluded_cores.end()) {
+        result.push_back(core);
+      }
+    }
+    return result;
+  }
+
+private:
+  struct Task {
+    std::function<void()> fn;
+    TaskGroup *group;
+  };
+
+  struct alignas(64) Worker {
+    ChaseLevDeque<Task *, DEQUE_CAPACITY> deque;
+    MpmcRing<Task *, INBOX_CAPACITY> inbox;
+    std::atomic<uint64_t> tasks_executed{0};
+    std::atomic<uint64_t> tasks_stolen{0};
+    std::thread thread;
+  };
+
+  bool enqueue(Task *task, size_t affinity) {
+    if (!running_.load(std::memory_order_acquire) || workers_.empty()) {
+      delete task;
+      submit_failures_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    const size_t self = current_worker_index();
+    bool pushed;
+    if (affinity == NO_AFFINITY && self != NO_AFFINITY) {
+      pushed = workers_[self]->deque.try_push(task);
+    } else {
+      size_t target = affinity;
+      if (target == NO_AFFINITY) {
+        target = next_inbox_.fetch_add(1, std::memory_order_relaxed);
+      }
+      pushed = workers_[target % workers_.size()]->inbox.try_push(task);
+    }
+
+    if (!pushed && self != NO_AFFINITY) {
+      // A worker's spawns never fail: past a full queue they go to its own
+      // inbox, and past that they run right here
+      if (!workers_[self]->inbox.try_push(task)) {
+        tasks_submitted_.fetch_add(1, std::memory_order_relaxed);
+        run_task(self, task);
+        return true;
+      }
+      pushed = true;
+    }
+
+    if (!pushed) {
+      delete task;
+      submit_failures_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    tasks_submitted_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  bool find_task(size_t self, Task *&task) {
+    Worker &worker = *workers_[self];
+    if (worker.deque.try_pop(task) || worker.inbox.try_pop(task)) {
+      return true;
+    }
+    if (steal_task(self, task)) {
+      worker.tasks_stolen.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+    return false;
+  }
+
+  // Tries every other worker once, starting from a pseudo-random victim
+  bool steal_task(size_t self, Task *&task) {
+    const size_t num_workers = workers_.size();
+    thread_local uint64_t steal_rng_state = 88172645463325252ull;
+    steal_rng_state ^= steal_rng_state << 13;
+    steal_rng_state ^= steal_rng_state >> 7;
+    steal_rng_state ^= steal_rng_state << 17;
+    const size_t start = static_cast<size_t>(steal_rng_state % num_workers);
+
+    for (size_t i = 0; i < num_workers; ++i) {
+      const size_t victim = (start + i) % num_workers;
+      if (victim == self) {
+        continue;
+      }
+      Worker &worker = *workers_[victim];
+      if (worker.deque.try_steal(task) || worker.inbox.try_pop(task)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void run_task(size_t self, Task *task) {
+    task->fn();
+    if (task->group != nullptr) {
+      task->group->pending_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+    delete task;
+    if (self != NO_AFFINITY) {
+      workers_[self]->tasks_executed.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      external_executed_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  void worker_loop(size_t index) {
+    // Set before the first task, so no task runs on an excluded core
+    if (config_.pin_threads) {
+      restrict_to_cores(&allowed_cores_[index % allowed_cores_.size()], 1);
+    } else if (!config_.excluded_cores.empty()) {
+      restrict_to_cores(allowed_cores_.data(), allowed_cores_.size());
+    }
+    tls_pool_ = this;
+    tls_worker_index_ = index;
+    uint32_t idle = 0;
+
+    while (running_.load(std::memory_order_acquire)) {
+      Task *task = nullptr;
+      if (find_task(index, task)) {
+        run_task(index, task);
+        idle = 0;
+        continue;
+      }
+
+      if (++idle <= config_.idle_spin_count) {
+        std::this_thread::yield();
+      } else if (config_.idle_sleep_us > 0) {
+        std::this_thread::sleep_for(
+            std::chrono::microseconds(config_.idle_sleep_us));
+      }
+    }
+
+    tls_pool_ = nullptr;
+    tls_worker_index_ = NO_AFFINITY;
+  }
+
+  // Calling thread only
+  static bool restrict_to_cores(const int *cores, size_t count) {
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    for (size_t i = 0; i < count; ++i) {
+      CPU_SET(static_cast<size_t>(cores[i]), &cpuset);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset) == 0;
+  }
+
+  static inline thread_local const WorkStealingPool *tls_pool_ = nullptr;
+  static inline thread_local size_t tls_worker_index_ = NO_AFFINITY;
+
+  Config config_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::vector<int> allowed_cores_;
+  std::atomic<bool> running_{false};
+  std::atomic<size_t> next_inbox_{0};
+  std::atomic<uint64_t> tasks_submitted_{0};
+  std::atomic<uint64_t> submit_failures_{0};
+  std::atomic<uint64_t> external_executed_{0};
+};
+
+} // namespace mini_mart::common
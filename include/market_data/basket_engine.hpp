@@ -0,0 +1,354 @@
+#pragma once
+
+#include "market_data/security_store.hpp"
+#include "market_data/symbol_table.hpp"
+#include "types/fixed_point.hpp"
+#include "types/messages.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace mini_mart::market_data {
+
+// Units of a constituent per basket unit (shares per creation unit, or an
+// index weight); 6 decimals keeps fractional index weights exact
+using BasketWeight = types::FixedPoint<6>;
+
+struct BasketComponent {
+  SecurityId security_id;
+  BasketWeight weight;
+};
+
+// Index levels and ETF indicative NAVs maintained incrementally from
+// constituent ticks:
+//
+//   level = (sum of weight_i x price_i + cash) / divisor
+//
+// kept per side, from the constituents' best bids and best asks. Each
+// constituent slot of the store has a dense list of (basket, weight)
+// memberships; a tick applies weight x (new - old price) to each basket it
+// belongs to, so its cost is its membership count, never a basket's size.
+// Sums are exact 128-bit integers, so deltas never drift.
+//
+// Changed baskets are written back into the store as synthetic securities
+// (one level per side) by flush(). Attached as a SharedObserver to a
+// FanoutSink whose primary is the same store, flush() runs just before
+// each commit, so a basket and the ticks that moved it commit together.
+// Everything runs on the store's writer thread; other threads read the
+// synthetic securities from the store.
+template <typename Store = SecurityStore> class BasketEngine {
+public:
+  static constexpr size_t NOT_FOUND = SIZE_MAX;
+
+  // publish_interval_ns > 0 conflates: a basket is written back at most
+  // once per interval of tick time, and otherwise stays pending
+  explicit BasketEngine(std::shared_ptr<Store> store, uint64_t publish_interval_ns = 0)
+      : store_(std::move(store)), publish_interval_ns_(publish_interval_ns),
+        bids_(Store::MAX_SECURITIES, 0),
+        asks_(Store::MAX_SECURITIES, 0), offsets_(Store::MAX_SECURITIES + 1, 0) {}
+
+  BasketEngine(const BasketEngine &) = delete;
+  BasketEngine &operator=(const BasketEngine &) = delete;
+
+  // Setup. Adds synthetic_id to the store and returns the basket's index,
+  // or NOT_FOUND if a constituent is not in the store, the synthetic cannot
+  // be added or the divisor is zero. Constituents start from their current
+  // book in the store.
+  size_t add_basket(const SecurityId &synthetic_id, const BasketComponent *components,
+                    size_t count, BasketWeight divisor, Price cash = Price{}) {
+    if (divisor.is_zero()) {
+      return NOT_FOUND;
+    }
+    std::vector<uint32_t> slots(count);
+    for (size_t i = 0; i < count; ++i) {
+      slots[i] = resolve_slot(components[i].security_id);
+      if (slots[i] == NO_SLOT) {
+        return NOT_FOUND;
+      }
+    }
+    if (!store_->add_security(synthetic_id)) {
+      return NOT_FOUND;
+    }
+
+    const size_t index = baskets_.size();
+    Basket basket{};
+    basket.synthetic_slot = static_cast<uint32_t>(store_->slot_of(synthetic_id));
+    basket.divisor = divisor.raw();
+    basket.cash = static_cast<types::int128_t>(cash.raw()) * BasketWeight::ONE;
+    for (size_t i = 0; i < count; ++i) {
+      const uint32_t slot = slots[i];
+      const uint64_t weight = components[i].weight.raw();
+      basket.bid_sum += static_cast<types::int128_t>(weight) * static_cast<int64_t>(bids_[slot]);
+      basket.ask_sum += static_cast<types::int128_t>(weight) * static_cast<int64_t>(asks_[slot]);
+      basket.missing_bids += bids_[slot] == 0 ? 1u : 0u;
+      basket.missing_asks += asks_[slot] == 0 ? 1u : 0u;
+      pending_.push_back(Membership{slot, static_cast<uint32_t>(index), weight});
+    }
+    baskets_.push_back(basket);
+    dirty_.reserve(baskets_.size());
+    layout_stale_ = true;
+    mark_dirty(index);
+    return index;
+  }
+
+  // Top of book of a constituent (already applied to the store); false for
+  // securities in no basket
+  bool on_message(const MarketDataL2Message &message) {
+    const uint32_t slot = lookup(symbol_key(message.security_id));
+    if (slot == NO_SLOT) {
+      return false;
+    }
+    const uint64_t bid = message.num_bid_levels > 0 ? message.bids[0].price.raw() : bids_[slot];
+    const uint64_t ask = message.num_ask_levels > 0 ? message.asks[0].price.raw() : asks_[slot];
+    on_slot_update(slot, Price{bid}, Price{ask}, message.timestamp_ns);
+    return true;
+  }
+
+  // Book delta of a constituent (already applied to the store). Only a
+  // level-0 SET or DELETE moves the touch, which is re-read from the store;
+  // false for deeper levels and securities in no basket
+  bool on_message(const BookDeltaMessage &delta) {
+    if (delta.level_index != 0) {
+      return false;
+    }
+    const uint32_t slot = lookup(symbol_key(delta.security_id));
+    if (slot == NO_SLOT) {
+      return false;
+    }
+    Price bid;
+    Price ask;
+    store_->touch_of_slot(slot, bid, ask);
+    on_slot_update(slot, bid, ask, delta.timestamp_ns);
+    return true;
+  }
+
+  // Tick for a caller that already knows the store slot
+  void on_slot_update(size_t slot, Price bid, Price ask, uint64_t timestamp_ns) {
+    if (layout_stale_) {
+      rebuild();
+    }
+    const uint64_t old_bid = bids_[slot];
+    const uint64_t old_ask = asks_[slot];
+    bids_[slot] = bid.raw();
+    asks_[slot] = ask.raw();
+    latest_ns_ = timestamp_ns > latest_ns_ ? timestamp_ns : latest_ns_;
+
+    const int64_t bid_delta = static_cast<int64_t>(bid.raw() - old_bid);
+    const int64_t ask_delta = static_cast<int64_t>(ask.raw() - old_ask);
+    const int32_t bid_missing = (bid.is_zero() ? 1 : 0) - (old_bid == 0 ? 1 : 0);
+    const int32_t ask_missing = (ask.is_zero() ? 1 : 0) - (old_ask == 0 ? 1 : 0);
+
+    const uint32_t begin = offsets_[slot];
+    const uint32_t end = offsets_[slot + 1];
+    for (uint32_t i = begin; i < end; ++i) {
+      const uint32_t index = member_baskets_[i];
+      Basket &basket = baskets_[index];
+      const auto weight = static_cast<types::int128_t>(member_weights_[i]);
+      basket.bid_sum += weight * bid_delta;
+      basket.ask_sum += weight * ask_delta;
+      basket.missing_bids = static_cast<uint32_t>(static_cast<int32_t>(basket.missing_bids) + bid_missing);
+      basket.missing_asks = static_cast<uint32_t>(static_cast<int32_t>(basket.missing_asks) + ask_missing);
+      mark_dirty(index);
+    }
+    ticks_.fetch_add(1, std::memory_order_relaxed);
+    memberships_applied_.fetch_add(end - begin, std::memory_order_relaxed);
+  }
+
+  // Writes every basket changed since the last flush (and due, with a
+  // publish interval) into the store; a side is published only once all
+  // its constituents have a price
+  void flush() {
+    size_t kept = 0;
+    for (const uint32_t index : dirty_) {
+      Basket &basket = baskets_[index];
+      if (publish_interval_ns_ != 0 && basket.published_ns != 0 &&
+          latest_ns_ - basket.published_ns < publish_interval_ns_) {
+        dirty_[kept++] = index;
+        continue;
+      }
+      basket.dirty = false;
+      basket.published_ns = latest_ns_;
+      MarketDataL2Message message{};
+      message.timestamp_ns = latest_ns_;
+      if (basket.missing_bids == 0) {
+        message.bids[0].price = bid_level(index);
+        message.num_bid_levels = 1;
+      }
+      if (basket.missing_asks == 0) {
+        message.asks[0].price = ask_level(index);
+        message.num_ask_levels = 1;
+      }
+      store_->update_slot_from_l2(basket.synthetic_slot, message);
+    }
+    published_.fetch_add(dirty_.size() - kept, std::memory_order_relaxed);
+    dirty_.resize(kept);
+  }
+
+  // Writer thread only; readers elsewhere use the synthetic security
+  Price bid_level(size_t basket) const { return level(baskets_[basket].bid_sum, baskets_[basket]); }
+  Price ask_level(size_t basket) const { return level(baskets_[basket].ask_sum, baskets_[basket]); }
+  bool complete(size_t basket) const {
+    return baskets_[basket].missing_bids == 0 && baskets_[basket].missing_asks == 0;
+  }
+
+  size_t basket_count() const { return baskets_.size(); }
+  size_t pending_flush() const { return dirty_.size(); }
+
+  uint64_t ticks() const { return ticks_.load(std::memory_order_relaxed); }
+  uint64_t memberships_applied() const {
+    return memberships_applied_.load(std::memory_order_relaxed);
+  }
+  uint64_t baskets_published() const { return published_.load(std::memory_order_relaxed); }
+
+private:
+  static constexpr uint32_t NO_SLOT = UINT32_MAX;
+
+  struct Basket {
+    types::int128_t bid_sum; // weight raw x price raw: scale 10^10
+    types::int128_t ask_sum;
+    types::int128_t cash;    // same scale
+    uint64_t divisor;        // BasketWeight raw
+    uint32_t synthetic_slot;
+    uint32_t missing_bids;   // constituents without a price on the side
+    uint32_t missing_asks;
+    uint64_t published_ns;   // tick time of the last write-back
+    bool dirty;
+  };
+
+  struct Membership {
+    uint32_t slot;
+    uint32_t basket;
+    uint64_t weight;
+  };
+
+  static Price level(types::int128_t sum, const Basket &basket) {
+    const types::int128_t total = sum + basket.cash;
+    if (total <= 0) {
+      return Price{};
+    }
+    // Scale 10^10 over the divisor's 10^6 leaves Price's 10^4
+    return Price{static_cast<uint64_t>(static_cast<types::uint128_t>(total) / basket.divisor)};
+  }
+
+  void mark_dirty(size_t index) {
+    Basket &basket = baskets_[index];
+    if (!basket.dirty) {
+      basket.dirty = true;
+      dirty_.push_back(static_cast<uint32_t>(index));
+    }
+  }
+
+  // Constituent slots are cached in an open-addressed table so ticks do not
+  // scan the store's keys, and setup asks the store once per symbol
+  static size_t home(uint64_t key, size_t mask) {
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+  }
+
+  uint32_t lookup(uint64_t key) const {
+    if (table_keys_.empty()) {
+      return NO_SLOT;
+    }
+    const size_t mask = table_keys_.size() - 1;
+    for (size_t i = home(key, mask);; i = (i + 1) & mask) {
+      if (table_keys_[i] == key) {
+        return table_slots_[i];
+      }
+      if (table_keys_[i] == 0) {
+        return NO_SLOT;
+      }
+    }
+  }
+
+  void insert(uint64_t key, uint32_t slot) {
+    if ((table_count_ + 1) * 2 > table_keys_.size()) {
+      grow();
+    }
+    const size_t mask = table_keys_.size() - 1;
+    size_t i = home(key, mask);
+    while (table_keys_[i] != 0) {
+      i = (i + 1) & mask;
+    }
+    table_keys_[i] = key;
+    table_slots_[i] = slot;
+    ++table_count_;
+  }
+
+  void grow() {
+    std::vector<uint64_t> keys(table_keys_.empty() ? 64 : table_keys_.size() * 2, 0);
+    std::vector<uint32_t> slots(keys.size(), NO_SLOT);
+    keys.swap(table_keys_);
+    slots.swap(table_slots_);
+    table_count_ = 0;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      if (keys[i] != 0) {
+        insert(keys[i], slots[i]);
+      }
+    }
+  }
+
+  // Slot of a constituent, caching it and seeding its prices from the store
+  uint32_t resolve_slot(const SecurityId &security_id) {
+    const uint64_t key = symbol_key(security_id);
+    const uint32_t cached = lookup(key);
+    if (cached != NO_SLOT) {
+      return cached;
+    }
+    typename Store::SecuritySnapshot snapshot;
+    if (key == 0 || !store_->get_security_snapshot(security_id, snapshot)) {
+      return NO_SLOT;
+    }
+    const auto slot = static_cast<uint32_t>(store_->slot_of(security_id));
+    bids_[slot] = snapshot.best_bid.raw();
+    asks_[slot] = snapshot.best_ask.raw();
+    insert(key, slot);
+    return slot;
+  }
+
+  // Counting sort of the memberships into per-slot runs (setup only)
+  void rebuild() {
+    std::fill(offsets_.begin(), offsets_.end(), 0);
+    for (const Membership &membership : pending_) {
+      ++offsets_[membership.slot + 1];
+    }
+    for (size_t slot = 0; slot < Store::MAX_SECURITIES; ++slot) {
+      offsets_[slot + 1] += offsets_[slot];
+    }
+    member_baskets_.resize(pending_.size());
+    member_weights_.resize(pending_.size());
+    std::vector<uint32_t> cursor(offsets_.begin(), offsets_.end() - 1);
+    for (const Membership &membership : pending_) {
+      const uint32_t at = cursor[membership.slot]++;
+      member_baskets_[at] = membership.basket;
+      member_weights_[at] = membership.weight;
+    }
+    layout_stale_ = false;
+  }
+
+  std::shared_ptr<Store> store_;
+  const uint64_t publish_interval_ns_;
+
+  // Dense by store slot
+  std::vector<uint64_t> bids_; // Price raw last applied
+  std::vector<uint64_t> asks_;
+  std::vector<uint32_t> offsets_; // memberships of slot s: [offsets_[s], offsets_[s + 1])
+  std::vector<uint32_t> member_baskets_;
+  std::vector<uint64_t> member_weights_;
+
+  std::vector<Basket> baskets_;
+  std::vector<uint32_t> dirty_;
+  std::vector<Membership> pending_; // every membership, in add order
+  bool layout_stale_{false};
+  uint64_t latest_ns_{0};
+
+  std::vector<uint64_t> table_keys_; // 0: empty (the empty symbol)
+  std::vector<uint32_t> table_slots_;
+  size_t table_count_{0};
+
+  std::atomic<uint64_t> ticks_{0};
+  std::atomic<uint64_t> memberships_applied_{0};
+  std::atomic<uint64_t> published_{0};
+};
+
+} // namespace mini_mart::market_data
@@ -0,0 +1,310 @@
+#pragma once
+
+#include "common/work_stealing_pool.hpp"
+#include "market_data/symbol_table.hpp"
+#include "types/messages.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace mini_mart::market_data {
+
+// Live exponentially weighted covariance and correlation of log mid
+// returns across every security added, fed tick by tick from the consumer.
+//
+// Ticks are asynchronous, so returns are paired Hayashi-Yoshida style:
+// each tick of security i closes one of its return intervals (its log mid
+// change d_i) and updates row i only, pairing d_i with every other
+// security j's closed moves since i's previous tick (e_j, read against a
+// per-row anchor of the mids then). Each overlapping pair of intervals is
+// counted once, by whichever closes last, so cov(i, j) is row i's decayed
+// sum of d_i x e_j plus row j's of d_j x e_i. Sums decay by exp(-dt / half
+// life x ln 2) per tick of the row's security, so a tick costs one O(n)
+// pass over two contiguous rows that the compiler vectorizes, and quiet
+// securities cost nothing. Covariance is scaled by the decay rate, i.e.
+// per second, as of each row's last tick; correlation divides it by the
+// two securities' variances.
+//
+// publish() derives the matrices into the back one of two buffers and
+// flips it to the front. It recomputes only the rows whose securities
+// ticked since that buffer was written, and their columns; when more than
+// a quarter did, it refreshes the whole buffer row by row instead (no
+// strided column writes), in blocks spread over the WorkStealingPool if
+// one was given. Readers on any thread copy from the front
+// buffer under its seqlock. Attached as a SharedObserver, publish()
+// runs from the FanoutSink's flush at most once per publish_interval_ns;
+// on a feed with book deltas, wrap that in DeltaAsSnapshot so a change to
+// the touch ticks the security.
+template <typename Index = DynamicSecurityIndex> class EwmaCovarianceMatrix {
+public:
+  static constexpr size_t MAX_SECURITIES = Index::CAPACITY;
+  static constexpr size_t NOT_FOUND = DenseSecurityMap<Index>::NOT_FOUND;
+
+  // publish_interval_ns 0: publish() only when called
+  EwmaCovarianceMatrix(uint64_t half_life_ns, uint64_t publish_interval_ns = 0,
+                       common::WorkStealingPool *pool = nullptr)
+      : decay_per_ns_(std::log(2.0) / static_cast<double>(half_life_ns > 0 ? half_life_ns : 1)),
+        covariance_scale_(decay_per_ns_ * 1e9),
+        publish_interval_ns_(publish_interval_ns), pool_(pool), log_mids_(MAX_SECURITIES, 0.0),
+        last_tick_ns_(MAX_SECURITIES, 0), row_versions_(MAX_SECURITIES, 0),
+        anchors_(MAX_SECURITIES * MAX_SECURITIES, 0.0), cross_(MAX_SECURITIES * MAX_SECURITIES, 0.0),
+        inverse_deviations_(MAX_SECURITIES, 0.0) {
+    for (Buffer &buffer : buffers_) {
+      buffer.correlation = std::make_unique<std::atomic<double>[]>(MAX_SECURITIES * MAX_SECURITIES);
+      buffer.covariance = std::make_unique<std::atomic<double>[]>(MAX_SECURITIES * MAX_SECURITIES);
+      buffer.row_versions.assign(MAX_SECURITIES, 0);
+    }
+  }
+
+  EwmaCovarianceMatrix(const EwmaCovarianceMatrix &) = delete;
+  EwmaCovarianceMatrix &operator=(const EwmaCovarianceMatrix &) = delete;
+
+  // Setup; NOT_FOUND if already added, full or unknown to a static index
+  size_t add_security(const SecurityId &security_id) { return securities_.add(security_id); }
+  size_t find(const SecurityId &security_id) const { return securities_.find(security_id); }
+
+  // Consumer thread. False for securities not added and one-sided books.
+  bool on_message(const MarketDataL2Message &message) {
+    const size_t index = securities_.find(message.security_id);
+    if (index == NOT_FOUND || message.num_bid_levels == 0 || message.num_ask_levels == 0) {
+      return false;
+    }
+    const uint64_t mid = (message.bids[0].price.raw() + message.asks[0].price.raw()) / 2;
+    update(index, Price{mid}, message.timestamp_ns);
+    return true;
+  }
+
+  // Consumer thread
+  void update(size_t index, Price mid, uint64_t timestamp_ns) {
+    if (mid.is_zero()) {
+      return;
+    }
+    const size_t n = securities_.size();
+    const double log_mid = std::log(static_cast<double>(mid.raw()));
+
+    if (last_tick_ns_[index] == 0) {
+      // First tick: start every row's view of this security from here
+      log_mids_[index] = log_mid;
+      for (size_t row = 0; row < n; ++row) {
+        anchors_[row * MAX_SECURITIES + index] = log_mid;
+      }
+      std::copy_n(log_mids_.begin(), n, anchors_.begin() + static_cast<std::ptrdiff_t>(index * MAX_SECURITIES));
+    } else {
+      const double move = log_mid - log_mids_[index];
+      log_mids_[index] = log_mid;
+      const double elapsed = static_cast<double>(timestamp_ns - std::min(timestamp_ns, last_tick_ns_[index]));
+      const double decay = std::exp(-elapsed * decay_per_ns_);
+      const double *__restrict log_mids = log_mids_.data();
+      double *__restrict anchors = &anchors_[index * MAX_SECURITIES];
+      double *__restrict cross = &cross_[index * MAX_SECURITIES];
+      for (size_t j = 0; j < n; ++j) {
+        cross[j] = cross[j] * decay + move * (log_mids[j] - anchors[j]);
+        anchors[j] = log_mids[j];
+      }
+      ++row_versions_[index];
+    }
+    last_tick_ns_[index] = timestamp_ns > 0 ? timestamp_ns : 1;
+    last_update_ns_ = std::max(last_update_ns_, timestamp_ns);
+    updates_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Consumer thread (or whichever thread owns updates). Brings the back
+  // buffer up to date as of now_ns and makes it the front; returns the
+  // number of rows recomputed.
+  size_t publish(uint64_t now_ns) {
+    const size_t n = securities_.size();
+    const size_t back = 1 - front_.load(std::memory_order_relaxed);
+    Buffer &buffer = buffers_[back];
+
+    changed_.clear();
+    for (size_t i = 0; i < n; ++i) {
+      if (buffer.row_versions[i] != row_versions_[i]) {
+        changed_.push_back(static_cast<uint32_t>(i));
+      }
+    }
+
+    begin_write(buffer);
+    buffer.count.store(n, std::memory_order_relaxed);
+    buffer.as_of_ns.store(now_ns, std::memory_order_relaxed);
+    for (size_t i = 0; i < n; ++i) {
+      const double variance = cross_[i * MAX_SECURITIES + i];
+      inverse_deviations_[i] = variance > 0 ? 1.0 / std::sqrt(variance) : 0.0;
+    }
+    const bool full = changed_.size() * 4 > n;
+    if (full) {
+      refresh_all(buffer, n);
+    } else {
+      for (const uint32_t row : changed_) {
+        derive_row(buffer, row, n, true);
+      }
+    }
+    for (const uint32_t row : changed_) {
+      buffer.row_versions[row] = row_versions_[row];
+    }
+    end_write(buffer);
+    front_.store(back, std::memory_order_release);
+    last_publish_ns_ = now_ns;
+    full_refreshes_.fetch_add(full ? 1 : 0, std::memory_order_relaxed);
+    return full ? n : changed_.size();
+  }
+
+  // Publishes when publish_interval_ns of feed time has passed
+  void flush() {
+    if (publish_interval_ns_ != 0 && last_update_ns_ >= last_publish_ns_ + publish_interval_ns_) {
+      publish(last_update_ns_);
+    }
+  }
+
+  // Any thread, from the latest published matrices. 0 for pairs without
+  // enough ticks yet.
+  double correlation(size_t i, size_t j) const { return read_entry(&Buffer::correlation, i, j); }
+  double covariance(size_t i, size_t j) const { return read_entry(&Buffer::covariance, i, j); }
+
+  // Any thread. Copies row i of the published correlation matrix into out
+  // (security_count() entries as of publication); returns that count.
+  size_t correlation_row(size_t i, double *out) const {
+    for (;;) {
+      const Buffer &buffer = buffers_[front_.load(std::memory_order_acquire)];
+      const uint64_t seq_before = buffer.sequence.load(std::memory_order_acquire);
+      if (seq_before & 1) {
+        continue;
+      }
+      const size_t count = buffer.count.load(std::memory_order_relaxed);
+      for (size_t j = 0; j < count; ++j) {
+        out[j] = buffer.correlation[i * MAX_SECURITIES + j].load(std::memory_order_relaxed);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (buffer.sequence.load(std::memory_order_relaxed) == seq_before) {
+        return count;
+      }
+    }
+  }
+
+  uint64_t published_as_of_ns() const {
+    return read_field([](const Buffer &buffer) { return buffer.as_of_ns.load(std::memory_order_relaxed); });
+  }
+
+  size_t security_count() const { return securities_.size(); }
+  SecurityId security_id(size_t index) const { return securities_.security_id(index); }
+  uint64_t updates() const { return updates_.load(std::memory_order_relaxed); }
+  uint64_t full_refreshes() const { return full_refreshes_.load(std::memory_order_relaxed); }
+
+private:
+  static constexpr size_t REFRESH_ROWS_PER_TASK = 16;
+
+  // Relaxed atomics so readers racing a write stay defined; the seqlock
+  // discards what they copied
+  using Entries = std::unique_ptr<std::atomic<double>[]>;
+
+  struct Buffer {
+    std::atomic<uint64_t> sequence{0}; // odd while publish() writes
+    std::atomic<size_t> count{0};
+    std::atomic<uint64_t> as_of_ns{0};
+    Entries correlation;
+    Entries covariance;
+    std::vector<uint64_t> row_versions; // owner only
+  };
+
+  // Entries (row, j) for every j, and their mirrors (j, row) when asked
+  void derive_row(Buffer &buffer, size_t row, size_t n, bool mirror) const {
+    const double row_variance = cross_[row * MAX_SECURITIES + row];
+    const double row_inverse_deviation = inverse_deviations_[row];
+    for (size_t j = 0; j < n; ++j) {
+      const double sum =
+          j == row ? row_variance : cross_[row * MAX_SECURITIES + j] + cross_[j * MAX_SECURITIES + row];
+      const double correlation = std::clamp(sum * row_inverse_deviation * inverse_deviations_[j], -1.0, 1.0);
+      const double covariance = sum * covariance_scale_;
+      buffer.correlation[row * MAX_SECURITIES + j].store(correlation, std::memory_order_relaxed);
+      buffer.covariance[row * MAX_SECURITIES + j].store(covariance, std::memory_order_relaxed);
+      if (mirror) {
+        buffer.correlation[j * MAX_SECURITIES + row].store(correlation, std::memory_order_relaxed);
+        buffer.covariance[j * MAX_SECURITIES + row].store(covariance, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Every row, in blocks over the pool if running; this thread helps
+  // until done
+  void refresh_all(Buffer &buffer, size_t n) {
+    if (pool_ == nullptr || !pool_->is_running()) {
+      for (size_t row = 0; row < n; ++row) {
+        derive_row(buffer, row, n, false);
+      }
+      return;
+    }
+    common::WorkStealingPool::TaskGroup group;
+    for (size_t begin = 0; begin < n; begin += REFRESH_ROWS_PER_TASK) {
+      const size_t end = std::min(n, begin + REFRESH_ROWS_PER_TASK);
+      const auto block = [this, &buffer, begin, end, n] {
+        for (size_t row = begin; row < end; ++row) {
+          derive_row(buffer, row, n, false);
+        }
+      };
+      if (!pool_->submit(group, block)) {
+        block();
+      }
+    }
+    pool_->wait(group);
+  }
+
+  static void begin_write(Buffer &buffer) {
+    const uint64_t seq = buffer.sequence.load(std::memory_order_relaxed);
+    buffer.sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+
+  static void end_write(Buffer &buffer) {
+    const uint64_t seq = buffer.sequence.load(std::memory_order_relaxed);
+    buffer.sequence.store(seq + 1, std::memory_order_release);
+  }
+
+  template <typename Read> auto read_field(Read read) const {
+    for (;;) {
+      const Buffer &buffer = buffers_[front_.load(std::memory_order_acquire)];
+      const uint64_t seq_before = buffer.sequence.load(std::memory_order_acquire);
+      if (seq_before & 1) {
+        continue;
+      }
+      const auto value = read(buffer);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (buffer.sequence.load(std::memory_order_relaxed) == seq_before) {
+        return value;
+      }
+    }
+  }
+
+  double read_entry(Entries Buffer::*matrix, size_t i, size_t j) const {
+    return read_field([matrix, i, j](const Buffer &buffer) {
+      const size_t count = buffer.count.load(std::memory_order_relaxed);
+      return i < count && j < count ? (buffer.*matrix)[i * MAX_SECURITIES + j].load(std::memory_order_relaxed) : 0.0;
+    });
+  }
+
+  const double decay_per_ns_;
+  const double covariance_scale_; // decayed sum -> per second
+  const uint64_t publish_interval_ns_;
+  common::WorkStealingPool *pool_;
+  DenseSecurityMap<Index> securities_;
+
+  // Owner thread; matrices are MAX_SECURITIES x MAX_SECURITIES, row-major
+  std::vector<double> log_mids_;
+  std::vector<uint64_t> last_tick_ns_; // 0: no tick yet
+  std::vector<uint64_t> row_versions_; // bumped per row update
+  std::vector<double> anchors_;        // [i][j]: log mid of j at i's last tick
+  std::vector<double> cross_;          // [i][j]: decayed sum of d_i x e_j
+  std::vector<uint32_t> changed_;
+  std::vector<double> inverse_deviations_; // 1 / sqrt(variance), 0 without one
+  uint64_t last_update_ns_{0};
+  uint64_t last_publish_ns_{0};
+
+  std::array<Buffer, 2> buffers_;
+  std::atomic<size_t> front_{0};
+  std::atomic<uint64_t> updates_{0};
+  std::atomic<uint64_t> full_refreshes_{0};
+};
+
+} // namespace mini_mart::market_data
@@ -0,0 +1,553 @@
+#pragma once
+
+#include "common/event_notifier.hpp"
+#include "common/spsc_ring.hpp"
+#include "common/time_utils.hpp"
+#include "market_data/latency_monitor.hpp"
+#include "types/message_envelope.hpp"
+#include "types/messages.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <memory>
+#include <thread>
+#include <tuple>
+
+namespace mini_mart::market_data {
+
+using namespace mini_mart::types;
+
+// Policies for BasicMarketDataFeed. Every policy is constructed from the
+// feed's FeedConfig (and may ignore it); a policy whose work is compiled
+// out reports so through a constexpr member, so the feed's hot path
+// contains no branch for it.
+
+// Priority class of a security for load shedding; lower sheds last
+enum class SymbolPriority : uint8_t { HIGH = 0, NORMAL = 1, LOW = 2, COUNT = 3 };
+
+inline constexpr size_t SYMBOL_PRIORITY_COUNT =
+    static_cast<size_t>(SymbolPriority::COUNT);
+
+// What happens to a shed class's messages. L2 messages carry the full top
+// of book, so conflating keeps only the newest per security and delivers it
+// once the ring drains; sampling forwards every Nth and drops the rest.
+enum class ShedAction : uint8_t { CONFLATE = 0, SAMPLE = 1 };
+
+// A class is shed while ring occupancy is at or above occupancy_pct
+// (100 = never shed)
+struct ShedRule {
+  uint32_t occupancy_pct;
+  ShedAction action;
+};
+
+struct FeedConfig {
+  uint32_t consumer_yield_us;
+  bool enable_statistics;
+  // Per-stage latency SLOs (indexed by FeedStage; 0 = unchecked) and the
+  // window over which stage percentiles are computed
+  std::array<LatencyBudget, FEED_STAGE_COUNT> latency_budgets;
+  uint32_t latency_window_ms;
+  // Load shedding (PriorityLoadShedder), indexed by SymbolPriority
+  std::array<ShedRule, SYMBOL_PRIORITY_COUNT> shed_rules;
+  SymbolPriority default_priority; // for securities never given one
+  uint32_t shed_sample_interval;
+  // Most updates the consumer groups into one store commit; it also commits
+  // whenever the ring runs dry (see BasicSecurityStore::commit)
+  uint32_t store_commit_batch;
+
+  FeedConfig()
+      : consumer_yield_us(1), enable_statistics(true), latency_budgets{},
+        latency_window_ms(1000),
+        shed_rules{{{100, ShedAction::CONFLATE},
+                    {75, ShedAction::CONFLATE},
+                    {50, ShedAction::CONFLATE}}},
+        default_priority(SymbolPriority::NORMAL), shed_sample_interval(8),
+        store_commit_batch(16) {}
+};
+
+struct FeedStatistics {
+  std::atomic<uint64_t> messages_produced{0};
+  std::atomic<uint64_t> messages_consumed{0};
+  std::atomic<uint64_t> ring_full_events{0};
+  std::atomic<uint64_t> ring_empty_events{0};
+  std::atomic<uint64_t> consumer_yields{0};
+  std::atomic<uint64_t> total_latency_ns{0};
+  std::atomic<uint64_t> max_latency_ns{0};
+  // Load shedding: superseded by a newer update / dropped by sampling
+  std::atomic<uint64_t> messages_conflated{0};
+  std::atomic<uint64_t> messages_sampled_out{0};
+  // Dequeued but of a type the sink has no handler for (e.g. heartbeats
+  // into a StoreSink), so never counted as consumed
+  std::atomic<uint64_t> messages_skipped{0};
+  // Handled but refused by the sink (unknown security, quarantined quote,
+  // invalid delta). produced = consumed + skipped + rejected once drained.
+  std::atomic<uint64_t> messages_rejected{0};
+  // Per-stage rolling percentiles and SLO alarms
+  LatencyMonitor latency;
+
+  FeedStatistics() = default;
+  FeedStatistics(const FeedStatistics &) = delete;
+  FeedStatistics &operator=(const FeedStatistics &) = delete;
+  FeedStatistics(FeedStatistics &&) = delete;
+  FeedStatistics &operator=(FeedStatistics &&) = delete;
+
+  double get_average_latency_ns() const {
+    uint64_t consumed = messages_consumed.load(std::memory_order_relaxed);
+    if (consumed == 0)
+      return 0.0;
+    return static_cast<double>(
+               total_latency_ns.load(std::memory_order_relaxed)) /
+           static_cast<double>(consumed);
+  }
+
+  void reset() {
+    messages_produced.store(0, std::memory_order_relaxed);
+    messages_consumed.store(0, std::memory_order_relaxed);
+    ring_full_events.store(0, std::memory_order_relaxed);
+    ring_empty_events.store(0, std::memory_order_relaxed);
+    consumer_yields.store(0, std::memory_order_relaxed);
+    total_latency_ns.store(0, std::memory_order_relaxed);
+    max_latency_ns.store(0, std::memory_order_relaxed);
+    messages_conflated.store(0, std::memory_order_relaxed);
+    messages_sampled_out.store(0, std::memory_order_relaxed);
+    messages_skipped.store(0, std::memory_order_relaxed);
+    messages_rejected.store(0, std::memory_order_relaxed);
+    latency.reset();
+  }
+};
+
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+// ---------------------------------------------------------------------------
+// Wait strategies: what the consumer does when the ring is empty. idle()
+// returns true when it gave up the CPU (counted as a consumer yield);
+// reset() is called after every message.
+
+// Sleeps consumer_yield_us, or yields when it is 0 (the original behaviour)
+class ConfiguredWait {
+public:
+  explicit ConfiguredWait(const FeedConfig &config)
+      : yield_us_(config.consumer_yield_us) {}
+
+  bool idle() {
+    if (yield_us_ > 0) {
+      std::this_thread::sleep_for(std::chrono::microseconds(yield_us_));
+      return true;
+    }
+    std::this_thread::yield();
+    return false;
+  }
+  void reset() {}
+
+private:
+  uint32_t yield_us_;
+};
+
+// Busy-polls with a pause instruction; for a consumer on an isolated core
+class SpinWait {
+public:
+  explicit SpinWait(const FeedConfig &) {}
+  bool idle() {
+    cpu_relax();
+    return false;
+  }
+  void reset() {}
+};
+
+class YieldWait {
+public:
+  explicit YieldWait(const FeedConfig &) {}
+  bool idle() {
+    std::this_thread::yield();
+    return false;
+  }
+  void reset() {}
+};
+
+// Spins, then yields, then sleeps consumer_yield_us: low wake-up latency
+// during bursts without burning a core when the feed is quiet
+class BackoffWait {
+public:
+  static constexpr uint32_t SPIN_LIMIT = 256;
+  static constexpr uint32_t YIELD_LIMIT = 512;
+
+  explicit BackoffWait(const FeedConfig &config)
+      : sleep_us_(config.consumer_yield_us > 0 ? config.consumer_yield_us : 1) {}
+
+  bool idle() {
+    if (idle_count_ < SPIN_LIMIT) {
+      ++idle_count_;
+      cpu_relax();
+      return false;
+    }
+    if (idle_count_ < YIELD_LIMIT) {
+      ++idle_count_;
+      std::this_thread::yield();
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(sleep_us_));
+    return true;
+  }
+  void reset() { idle_count_ = 0; }
+
+private:
+  uint32_t sleep_us_;
+  uint32_t idle_count_{0};
+};
+
+// No consumer thread: the caller's event loop waits on the feed's
+// notification_fd() (an eventfd, signalled only when the ring turns
+// non-empty) together with its sockets and calls poll() when it is ready
+class EventfdWait {
+public:
+  explicit EventfdWait(const FeedConfig &) : open_error_(notifier_.open()) {}
+  bool idle() { return false; }
+  void reset() {}
+
+  common::EventNotifier &notifier() { return notifier_; }
+  const common::EventNotifier &notifier() const { return notifier_; }
+  int open_error() const { return open_error_; } // -errno from eventfd
+
+private:
+  common::EventNotifier notifier_;
+  int open_error_;
+};
+
+template <typename Wait>
+concept ExternalConsumerWait = requires(Wait &wait) { wait.notifier(); };
+
+// ---------------------------------------------------------------------------
+// Clocks used to stamp messages on arrival and measure queueing latency
+
+struct HighResolutionClock {
+  static uint64_t now_ns() { return common::time_utils::now_ns(); }
+};
+
+struct SteadyClock {
+  static uint64_t now_ns() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+  }
+};
+
+// ---------------------------------------------------------------------------
+// Statistics policies. active() gates timestamping and counting; NoStatistics
+// makes it a constant false so the feed compiles all of it out.
+
+namespace detail {
+inline void configure_latency(FeedStatistics &stats, const FeedConfig &config) {
+  stats.latency.configure(uint64_t{config.latency_window_ms} * 1000000,
+                          config.latency_budgets);
+}
+
+// Provider stamps from another clock domain (or none) are skipped
+inline void record_enqueue(FeedStatistics &stats, uint64_t generated_ns,
+                           uint64_t enqueued_ns) {
+  if (generated_ns != 0 && generated_ns <= enqueued_ns) {
+    stats.latency.record(FeedStage::GENERATE_TO_RING, enqueued_ns - generated_ns,
+                         enqueued_ns);
+  }
+}
+
+inline void record_consume(FeedStatistics &stats, uint64_t enqueued_ns,
+                           uint64_t dequeued_ns, uint64_t applied_ns) {
+  stats.latency.record(FeedStage::RING_WAIT, dequeued_ns - enqueued_ns, dequeued_ns);
+  stats.latency.record(FeedStage::STORE_APPLY, applied_ns - dequeued_ns, applied_ns);
+
+  const uint64_t latency = applied_ns - enqueued_ns;
+  stats.messages_consumed.fetch_add(1, std::memory_order_relaxed);
+  stats.total_latency_ns.fetch_add(latency, std::memory_order_relaxed);
+  uint64_t current_max = stats.max_latency_ns.load(std::memory_order_relaxed);
+  while (latency > current_max) {
+    if (stats.max_latency_ns.compare_exchange_weak(current_max, latency,
+                                                   std::memory_order_relaxed)) {
+      break;
+    }
+  }
+}
+} // namespace detail
+
+// Switched on/off by FeedConfig::enable_statistics (the original behaviour)
+class RuntimeStatistics {
+public:
+  explicit RuntimeStatistics(const FeedConfig &config)
+      : enabled_(config.enable_statistics) {
+    detail::configure_latency(stats_, config);
+  }
+
+  bool active() const { return enabled_; }
+  void reset() { stats_.reset(); }
+  void on_produced(uint64_t generated_ns, uint64_t enqueued_ns) {
+    stats_.messages_produced.fetch_add(1, std::memory_order_relaxed);
+    detail::record_enqueue(stats_, generated_ns, enqueued_ns);
+  }
+  void on_ring_full() { stats_.ring_full_events.fetch_add(1, std::memory_order_relaxed); }
+  void on_ring_empty() { stats_.ring_empty_events.fetch_add(1, std::memory_order_relaxed); }
+  void on_yield() { stats_.consumer_yields.fetch_add(1, std::memory_order_relaxed); }
+  void on_conflated() { stats_.messages_conflated.fetch_add(1, std::memory_order_relaxed); }
+  void on_sampled_out() {
+    stats_.messages_sampled_out.fetch_add(1, std::memory_order_relaxed);
+  }
+  void on_skipped() { stats_.messages_skipped.fetch_add(1, std::memory_order_relaxed); }
+  void on_rejected() { stats_.messages_rejected.fetch_add(1, std::memory_order_relaxed); }
+  void on_consumed(uint64_t enqueued_ns, uint64_t dequeued_ns, uint64_t applied_ns) {
+    detail::record_consume(stats_, enqueued_ns, dequeued_ns, applied_ns);
+  }
+  const FeedStatistics &get() const { return stats_; }
+
+private:
+  bool enabled_;
+  FeedStatistics stats_;
+};
+
+// Always on, no runtime flag
+class AtomicStatistics {
+public:
+  explicit AtomicStatistics(const FeedConfig &config) {
+    detail::configure_latency(stats_, config);
+  }
+
+  static constexpr bool active() { return true; }
+  void reset() { stats_.reset(); }
+  void on_produced(uint64_t generated_ns, uint64_t enqueued_ns) {
+    stats_.messages_produced.fetch_add(1, std::memory_order_relaxed);
+    detail::record_enqueue(stats_, generated_ns, enqueued_ns);
+  }
+  void on_ring_full() { stats_.ring_full_events.fetch_add(1, std::memory_order_relaxed); }
+  void on_ring_empty() { stats_.ring_empty_events.fetch_add(1, std::memory_order_relaxed); }
+  void on_yield() { stats_.consumer_yields.fetch_add(1, std::memory_order_relaxed); }
+  void on_conflated() { stats_.messages_conflated.fetch_add(1, std::memory_order_relaxed); }
+  void on_sampled_out() {
+    stats_.messages_sampled_out.fetch_add(1, std::memory_order_relaxed);
+  }
+  void on_skipped() { stats_.messages_skipped.fetch_add(1, std::memory_order_relaxed); }
+  void on_rejected() { stats_.messages_rejected.fetch_add(1, std::memory_order_relaxed); }
+  void on_consumed(uint64_t enqueued_ns, uint64_t dequeued_ns, uint64_t applied_ns) {
+    detail::record_consume(stats_, enqueued_ns, dequeued_ns, applied_ns);
+  }
+  const FeedStatistics &get() const { return stats_; }
+
+private:
+  FeedStatistics stats_;
+};
+
+// Compiled out: no timestamps, no counters. get() reports zeros.
+class NoStatistics {
+public:
+  explicit NoStatistics(const FeedConfig &) {}
+
+  static constexpr bool active() { return false; }
+  void reset() {}
+  void on_produced(uint64_t, uint64_t) {}
+  void on_ring_full() {}
+  void on_ring_empty() {}
+  void on_yield() {}
+  void on_conflated() {}
+  void on_sampled_out() {}
+  void on_skipped() {}
+  void on_rejected() {}
+  void on_consumed(uint64_t, uint64_t, uint64_t) {}
+  const FeedStatistics &get() const { return stats_; }
+
+private:
+  FeedStatistics stats_;
+};
+
+// ---------------------------------------------------------------------------
+// Sinks receive every consumed message through on_message overloads, one
+// per message type they handle; with an enveloped ring, types a sink has
+// no overload for are skipped. The feed also routes subscriptions through
+// its sink, so a sink owns the set of known securities.
+
+template <typename Sink, typename Message>
+concept HandlesMessage = requires(Sink &sink, const Message &message) {
+  { sink.on_message(message) } -> std::convertible_to<bool>;
+};
+
+// Sinks that can group updates into commits (the feed calls begin_batch
+// before a run of messages and commit after it)
+template <typename Sink>
+concept BatchingSink = requires(Sink &sink) {
+  sink.begin_batch();
+  sink.commit();
+};
+
+// Observers that derive state from a batch and write it out once per
+// commit (FanoutSink calls flush() just before the primary commits)
+template <typename Observer>
+concept FlushingObserver = requires(Observer &observer) { observer.flush(); };
+
+// Applies messages to a security store (BasicSecurityStore<Index>)
+template <typename Store> class StoreSink {
+public:
+  StoreSink(std::shared_ptr<Store> store) : store_(std::move(store)) {}
+
+  bool on_message(const MarketDataL2Message &message) {
+    return store_->update_from_l2(message);
+  }
+  bool on_message(const TradeMessage &message) { return store_->apply_trade(message); }
+  bool on_message(const BookDeltaMessage &message) {
+    return store_->apply_book_delta(message);
+  }
+  void begin_batch() { store_->begin_batch(); }
+  void commit() { store_->commit(); }
+  bool add_security(const SecurityId &id) { return store_->add_security(id); }
+  bool remove_security(const SecurityId &id) { return store_->remove_security(id); }
+  bool contains(const SecurityId &id) const { return store_->contains(id); }
+
+  Store &store() const { return *store_; }
+
+private:
+  std::shared_ptr<Store> store_;
+};
+
+// FanoutSink observer driving an engine shared with its readers (e.g.
+// RollingWindowEngine, BasketEngine): forwards every on_message() overload
+// T has, and flush() when T has one
+template <typename T> class SharedObserver {
+public:
+  explicit SharedObserver(std::shared_ptr<T> target) : target_(std::move(target)) {}
+
+  template <typename Message>
+    requires HandlesMessage<T, Message>
+  bool on_message(const Message &message) {
+    return target_->on_message(message);
+  }
+  void flush()
+    requires FlushingObserver<T>
+  {
+    target_->flush();
+  }
+
+  T &target() const { return *target_; }
+
+private:
+  std::shared_ptr<T> target_;
+};
+
+// Observer adapter for engines that read only L2 snapshots. Messages the
+// observer handles are forwarded; a book delta that changes the best level
+// (level 0) becomes an L2 snapshot of the security's book as the store
+// holds it after the delta, so the engine never keeps a stale touch.
+// Deeper deltas do not reach the observer.
+template <typename Observer, typename Store> class DeltaAsSnapshot {
+public:
+  DeltaAsSnapshot(Observer observer, std::shared_ptr<const Store> store)
+      : observer_(std::move(observer)), store_(std::move(store)) {}
+
+  template <typename Message>
+    requires HandlesMessage<Observer, Message>
+  bool on_message(const Message &message) {
+    return observer_.on_message(message);
+  }
+  bool on_message(const BookDeltaMessage &delta)
+    requires(!HandlesMessage<Observer, BookDeltaMessage>)
+  {
+    typename Store::SecuritySnapshot snapshot;
+    if (delta.level_index != 0 || !store_->get_security_snapshot(delta.security_id, snapshot)) {
+      return false;
+    }
+    MarketDataL2Message message{};
+    message.security_id = delta.security_id;
+    message.timestamp_ns = delta.timestamp_ns;
+    message.num_bid_levels = snapshot.num_bid_levels;
+    message.num_ask_levels = snapshot.num_ask_levels;
+    std::copy_n(snapshot.bids, snapshot.num_bid_levels, message.bids.begin());
+    std::copy_n(snapshot.asks, snapshot.num_ask_levels, message.asks.begin());
+    return observer_.on_message(message);
+  }
+  void flush()
+    requires FlushingObserver<Observer>
+  {
+    observer_.flush();
+  }
+
+  Observer &observer() { return observer_; }
+
+private:
+  Observer observer_;
+  std::shared_ptr<const Store> store_;
+};
+
+// Primary sink (store, subscriptions) plus observers that see every message
+// the primary accepted. Observers need only the on_message() overloads for
+// the types they care about; those with flush() are flushed before each
+// commit, so what they write lands in the same commit as their inputs.
+template <typename Primary, typename... Observers> class FanoutSink {
+public:
+  FanoutSink(Primary primary, Observers... observers)
+      : primary_(std::move(primary)), observers_(std::move(observers)...) {}
+
+  template <typename Message>
+    requires HandlesMessage<Primary, Message>
+  bool on_message(const Message &message) {
+    if (!primary_.on_message(message)) {
+      return false;
+    }
+    std::apply(
+        [&message](auto &...observer) {
+          const auto notify = [&message](auto &one) {
+            if constexpr (HandlesMessage<decltype(one), Message>) {
+              one.on_message(message);
+            }
+          };
+          (notify(observer), ...);
+        },
+        observers_);
+    return true;
+  }
+  void begin_batch()
+    requires BatchingSink<Primary>
+  {
+    primary_.begin_batch();
+  }
+  void commit()
+    requires BatchingSink<Primary>
+  {
+    std::apply(
+        [](auto &...observer) {
+          const auto flush = [](auto &one) {
+            if constexpr (FlushingObserver<decltype(one)>) {
+              one.flush();
+            }
+          };
+          (flush(observer), ...);
+        },
+        observers_);
+    primary_.commit();
+  }
+  bool add_security(const SecurityId &id) { return primary_.add_security(id); }
+  bool remove_security(const SecurityId &id) { return primary_.remove_security(id); }
+  bool contains(const SecurityId &id) const { return primary_.contains(id); }
+
+  Primary &primary() { return primary_; }
+  template <size_t I> auto &observer() { return std::get<I>(observers_); }
+
+private:
+  Primary primary_;
+  std::tuple<Observers...> observers_;
+};
+
+// ---------------------------------------------------------------------------
+// Overload policies decide, on the provider thread, whether a message goes
+// into the ring. NoLoadShedding admits everything (a full ring drops);
+// PriorityLoadShedder (load_shedder.hpp) sheds low-priority securities first.
+
+class NoLoadShedding {
+public:
+  static constexpr bool ENABLED = false;
+
+  explicit NoLoadShedding(const FeedConfig &) {}
+  bool set_priority(const SecurityId &, SymbolPriority) { return false; }
+};
+
+} // namespace mini_mart::market_data
@@ -0,0 +1,361 @@
+#pragma once
+
+#include "common/mpmc_ring.hpp"
+#include "market_data/symbol_table.hpp"
+#include "types/fixed_point.hpp"
+#include "types/messages.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace mini_mart::market_data {
+
+// Cross rates are carried at 8 decimals. A product of two 4-decimal feed
+// prices is exact; an inverse is not, and keeps fewer significant digits
+// the larger the rate (1/USDJPY about 6). Bids are rounded down and asks
+// up, so rounding only widens an implied quote and cannot by itself make
+// it cross the direct book.
+using CrossRate = types::FixedPoint<8>;
+
+struct FxQuote {
+  CrossRate bid;
+  CrossRate ask;
+  bool valid; // both sides present
+};
+
+enum class FxArbitrageKind : uint8_t {
+  IMPLIED_BID_OVER_DIRECT_ASK = 0, // buy the cross direct, sell it through the legs
+  IMPLIED_ASK_UNDER_DIRECT_BID = 1 // buy through the legs, sell the cross direct
+};
+
+struct FxArbitrageAlert {
+  uint64_t timestamp_ns;
+  SecurityId cross;
+  SecurityId first_leg;
+  SecurityId second_leg;
+  FxQuote implied;
+  FxQuote direct;
+  FxArbitrageKind kind;
+};
+
+// One way to synthesize cross = base/quote: base -> via through first_leg,
+// then via -> quote through second_leg. A leg is inverted when the pair is
+// quoted the other way round (EURGBP via GBPUSD uses USD->GBP = 1/GBPUSD).
+struct FxTriangle {
+  uint16_t cross;
+  uint16_t first_leg;
+  uint16_t second_leg;
+  bool first_inverted;
+  bool second_inverted;
+  bool in_arbitrage;
+  FxQuote implied;
+};
+
+// Implied FX cross rates and triangular arbitrage detection. Pairs are
+// 6-letter symbols (EURUSD); adding one rebuilds the dependency graph of
+// every triangle whose three pairs are all registered. An update to a
+// pair then recomputes only the triangles it is a leg of and re-checks
+// only those it is the cross of, via a per-pair dependency list.
+//
+// A triangle alerts once when its implied quote crosses the direct book
+// (implied bid > direct ask or implied ask < direct bid) and re-arms when
+// it uncrosses. Alerts go to a lock-free ring any thread may drain.
+//
+// Setup (add_pair) and updates run on one thread, e.g. the feed's consumer
+// through a SharedObserver; counters and alerts are safe to read from
+// others. The engine reads L2 snapshots only: on a feed that carries book
+// deltas, wrap the observer in DeltaAsSnapshot so a delta that moves a
+// pair's touch reaches it.
+class FxTriangulationEngine {
+public:
+  static constexpr size_t MAX_PAIRS = 64;
+  static constexpr size_t MAX_TRIANGLES = 1024;
+  static constexpr size_t ALERT_RING_SIZE = 256;
+  static constexpr size_t NOT_FOUND = MAX_PAIRS;
+
+  FxTriangulationEngine() = default;
+  FxTriangulationEngine(const FxTriangulationEngine &) = delete;
+  FxTriangulationEngine &operator=(const FxTriangulationEngine &) = delete;
+
+  // False for a malformed symbol, a duplicate, or when the pair or the
+  // triangles it completes would exceed capacity
+  bool add_pair(const SecurityId &pair) {
+    uint32_t base = 0;
+    uint32_t quote = 0;
+    if (!parse_pair(pair, base, quote) || pair_count_ == MAX_PAIRS ||
+        find_pair(pair) != NOT_FOUND) {
+      return false;
+    }
+    Pair &added = pairs_[pair_count_];
+    added = Pair{};
+    added.id = pair;
+    added.base = base;
+    added.quote = quote;
+    keys_[pair_count_] = symbol_key(pair);
+    ++pair_count_;
+    if (!rebuild()) {
+      --pair_count_;
+      rebuild();
+      return false;
+    }
+    return true;
+  }
+
+  size_t find_pair(const SecurityId &pair) const {
+    const uint64_t key = symbol_key(pair);
+    for (size_t i = 0; i < pair_count_; ++i) {
+      if (keys_[i] == key) {
+        return i;
+      }
+    }
+    return NOT_FOUND;
+  }
+
+  // Top of book of a registered pair; false for other securities
+  bool on_message(const MarketDataL2Message &message) {
+    const size_t index = find_pair(message.security_id);
+    if (index == NOT_FOUND) {
+      return false;
+    }
+    const Price bid = message.num_bid_levels > 0 ? message.bids[0].price : Price{};
+    const Price ask = message.num_ask_levels > 0 ? message.asks[0].price : Price{};
+    update(index, bid, ask, message.timestamp_ns);
+    return true;
+  }
+
+  // A zero side marks the quote invalid, which suspends its triangles
+  void update(size_t index, Price bid, Price ask, uint64_t timestamp_ns) {
+    Pair &pair = pairs_[index];
+    pair.direct.bid = types::fixed_point_cast<CrossRate>(bid);
+    pair.direct.ask = types::fixed_point_cast<CrossRate>(ask);
+    pair.direct.valid = !bid.is_zero() && !ask.is_zero();
+    if (pair.direct.valid) {
+      // 1 / price at CrossRate's scale is 10^(8 + 4) / raw: one 64-bit
+      // divide, rounded up for the ask
+      pair.inverted.bid = CrossRate{INVERSE_NUMERATOR / ask.raw()};
+      pair.inverted.ask = CrossRate{(INVERSE_NUMERATOR + bid.raw() - 1) / bid.raw()};
+    }
+    pair.inverted.valid = pair.direct.valid;
+
+    uint64_t recomputed = 0;
+    for (uint32_t i = dependency_offsets_[index]; i < dependency_offsets_[index + 1]; ++i) {
+      FxTriangle &triangle = triangles_[dependencies_[i]];
+      if (triangle.cross != index) {
+        recompute(triangle);
+        ++recomputed;
+      }
+      check(triangle, timestamp_ns);
+    }
+    updates_.fetch_add(1, std::memory_order_relaxed);
+    triangles_recomputed_.fetch_add(recomputed, std::memory_order_relaxed);
+  }
+
+  // Best implied quote for a registered cross over all its triangles
+  // (highest bid, lowest ask); invalid if no triangle has both legs
+  FxQuote implied_quote(size_t cross) const {
+    FxQuote best{};
+    for (uint32_t i = dependency_offsets_[cross]; i < dependency_offsets_[cross + 1]; ++i) {
+      const FxTriangle &triangle = triangles_[dependencies_[i]];
+      if (triangle.cross != cross || !triangle.implied.valid) {
+        continue;
+      }
+      if (!best.valid || triangle.implied.bid > best.bid) {
+        best.bid = triangle.implied.bid;
+      }
+      if (!best.valid || triangle.implied.ask < best.ask) {
+        best.ask = triangle.implied.ask;
+      }
+      best.valid = true;
+    }
+    return best;
+  }
+
+  FxQuote direct_quote(size_t index) const { return pairs_[index].direct; }
+
+  size_t pair_count() const { return pair_count_; }
+  size_t triangle_count() const { return triangle_count_; }
+  const FxTriangle &triangle(size_t index) const { return triangles_[index]; }
+  const SecurityId &pair_id(size_t index) const { return pairs_[index].id; }
+
+  bool pop_alert(FxArbitrageAlert &alert) const { return alerts_.try_pop(alert); }
+
+  uint64_t updates() const { return updates_.load(std::memory_order_relaxed); }
+  uint64_t triangles_recomputed() const {
+    return triangles_recomputed_.load(std::memory_order_relaxed);
+  }
+  uint64_t alerts_raised() const { return alerts_raised_.load(std::memory_order_relaxed); }
+  uint64_t alerts_dropped() const { return alerts_dropped_.load(std::memory_order_relaxed); }
+
+private:
+  static constexpr uint64_t INVERSE_NUMERATOR = CrossRate::ONE * Price::ONE;
+
+  struct Pair {
+    SecurityId id{};
+    uint32_t base{0};  // 3 letters packed
+    uint32_t quote{0};
+    FxQuote direct{};   // quote currency per base
+    FxQuote inverted{}; // base per quote
+  };
+
+  static bool parse_pair(const SecurityId &pair, uint32_t &base, uint32_t &quote) {
+    for (size_t i = 0; i < 6; ++i) {
+      if (pair[i] < 'A' || pair[i] > 'Z') {
+        return false;
+      }
+    }
+    if (pair[6] != '\0' || pair[7] != '\0') {
+      return false;
+    }
+    base = pack_currency(&pair[0]);
+    quote = pack_currency(&pair[3]);
+    return base != quote;
+  }
+
+  static uint32_t pack_currency(const char *code) {
+    return static_cast<uint32_t>(static_cast<uint8_t>(code[0])) << 16 |
+           static_cast<uint32_t>(static_cast<uint8_t>(code[1])) << 8 |
+           static_cast<uint32_t>(static_cast<uint8_t>(code[2]));
+  }
+
+  // Leg taking `from` to the other currency of pair, if pair touches it
+  static bool leg_from(const Pair &pair, uint32_t from, uint32_t &to, bool &inverted) {
+    if (pair.base == from) {
+      to = pair.quote;
+      inverted = false;
+      return true;
+    }
+    if (pair.quote == from) {
+      to = pair.base;
+      inverted = true;
+      return true;
+    }
+    return false;
+  }
+
+  // Enumerates every (cross, first leg, second leg) among the registered
+  // pairs and lays out each pair's dependent triangles contiguously.
+  // Setup only; quotes already received are kept.
+  bool rebuild() {
+    triangle_count_ = 0;
+    for (size_t cross = 0; cross < pair_count_; ++cross) {
+      const Pair &target = pairs_[cross];
+      for (size_t first = 0; first < pair_count_; ++first) {
+        uint32_t via = 0;
+        bool first_inverted = false;
+        if (first == cross || !leg_from(pairs_[first], target.base, via, first_inverted) ||
+            via == target.quote) {
+          continue;
+        }
+        for (size_t second = 0; second < pair_count_; ++second) {
+          uint32_t to = 0;
+          bool second_inverted = false;
+          if (second == cross || second == first ||
+              !leg_from(pairs_[second], via, to, second_inverted) || to != target.quote) {
+            continue;
+          }
+          if (triangle_count_ == MAX_TRIANGLES) {
+            return false;
+          }
+          FxTriangle &triangle = triangles_[triangle_count_++];
+          triangle = FxTriangle{};
+          triangle.cross = static_cast<uint16_t>(cross);
+          triangle.first_leg = static_cast<uint16_t>(first);
+          triangle.second_leg = static_cast<uint16_t>(second);
+          triangle.first_inverted = first_inverted;
+          triangle.second_inverted = second_inverted;
+          recompute(triangle);
+        }
+      }
+    }
+
+    // Counting sort of (pair, triangle) edges into dependency lists
+    std::array<uint32_t, MAX_PAIRS + 1> counts{};
+    for (size_t t = 0; t < triangle_count_; ++t) {
+      ++counts[triangles_[t].cross];
+      ++counts[triangles_[t].first_leg];
+      ++counts[triangles_[t].second_leg];
+    }
+    dependency_offsets_[0] = 0;
+    for (size_t p = 0; p < MAX_PAIRS; ++p) {
+      dependency_offsets_[p + 1] = dependency_offsets_[p] + counts[p];
+    }
+    std::array<uint32_t, MAX_PAIRS> cursor{};
+    for (size_t p = 0; p < MAX_PAIRS; ++p) {
+      cursor[p] = dependency_offsets_[p];
+    }
+    for (size_t t = 0; t < triangle_count_; ++t) {
+      const FxTriangle &triangle = triangles_[t];
+      dependencies_[cursor[triangle.cross]++] = static_cast<uint16_t>(t);
+      dependencies_[cursor[triangle.first_leg]++] = static_cast<uint16_t>(t);
+      dependencies_[cursor[triangle.second_leg]++] = static_cast<uint16_t>(t);
+    }
+    return true;
+  }
+
+  const FxQuote &leg_quote(uint16_t pair, bool inverted) const {
+    return inverted ? pairs_[pair].inverted : pairs_[pair].direct;
+  }
+
+  void recompute(FxTriangle &triangle) {
+    const FxQuote &first = leg_quote(triangle.first_leg, triangle.first_inverted);
+    const FxQuote &second = leg_quote(triangle.second_leg, triangle.second_inverted);
+    triangle.implied.valid = first.valid && second.valid;
+    if (triangle.implied.valid) {
+      triangle.implied.bid = types::fixed_multiply<CrossRate>(first.bid, second.bid);
+      triangle.implied.ask = multiply_rounding_up(first.ask, second.ask);
+    }
+  }
+
+  // fixed_multiply truncates; an ask must not round below its exact value
+  static CrossRate multiply_rounding_up(CrossRate a, CrossRate b) {
+    const types::uint128_t product = static_cast<types::uint128_t>(a.raw()) * b.raw();
+    const types::uint128_t quotient = types::divide_pow10<CrossRate::SCALE>(product);
+    return CrossRate{static_cast<uint64_t>(quotient + (quotient * CrossRate::ONE != product ? 1 : 0))};
+  }
+
+  void check(FxTriangle &triangle, uint64_t timestamp_ns) {
+    const FxQuote &direct = pairs_[triangle.cross].direct;
+    const FxQuote &implied = triangle.implied;
+    if (!direct.valid || !implied.valid) {
+      triangle.in_arbitrage = false;
+      return;
+    }
+    const bool bid_over = implied.bid > direct.ask;
+    const bool ask_under = implied.ask < direct.bid;
+    const bool crossed = bid_over || ask_under;
+    if (crossed && !triangle.in_arbitrage) {
+      raise(FxArbitrageAlert{timestamp_ns, pairs_[triangle.cross].id,
+                             pairs_[triangle.first_leg].id, pairs_[triangle.second_leg].id,
+                             implied, direct,
+                             bid_over ? FxArbitrageKind::IMPLIED_BID_OVER_DIRECT_ASK
+                                      : FxArbitrageKind::IMPLIED_ASK_UNDER_DIRECT_BID});
+    }
+    triangle.in_arbitrage = crossed;
+  }
+
+  void raise(const FxArbitrageAlert &alert) {
+    alerts_raised_.fetch_add(1, std::memory_order_relaxed);
+    if (!alerts_.try_push(alert)) {
+      alerts_dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  std::array<uint64_t, MAX_PAIRS> keys_{};
+  std::array<Pair, MAX_PAIRS> pairs_{};
+  size_t pair_count_{0};
+
+  std::array<FxTriangle, MAX_TRIANGLES> triangles_{};
+  size_t triangle_count_{0};
+  // Triangles touching pair p: dependencies_[offsets[p], offsets[p + 1])
+  std::array<uint32_t, MAX_PAIRS + 1> dependency_offsets_{};
+  std::array<uint16_t, MAX_TRIANGLES * 3> dependencies_{};
+
+  std::atomic<uint64_t> updates_{0};
+  std::atomic<uint64_t> triangles_recomputed_{0};
+  mutable common::MpmcRing<FxArbitrageAlert, ALERT_RING_SIZE> alerts_;
+  std::atomic<uint64_t> alerts_raised_{0};
+  std::atomic<uint64_t> alerts_dropped_{0};
+};
+
+} // namespace mini_mart::market_data
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "types/messages.hpp"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace mini_mart::market_data {
+
+using namespace mini_mart::types;
+
+using VenueId = std::array<char, 4>;
+
+// Static reference data for one tradable instrument
+struct InstrumentInfo {
+  SecurityId security_id;
+  Price tick_size;
+  Price base_price;
+  uint32_t lot_size;
+  VenueId venue;
+};
+static_assert(sizeof(InstrumentInfo) == 32, "InstrumentInfo size is not 32 bytes");
+
+// Read-only instrument universe sorted by symbol. Lookups binary-search a
+// dense array of 8-byte keys (one SecurityId per key), so a 100k-symbol
+// directory needs ~17 probes over 800 KB of keys instead of string hashing.
+// Built once at startup by InstrumentLoader; not modified afterwards.
+class InstrumentDirectory {
+public:
+  InstrumentDirectory() = default;
+
+  InstrumentDirectory(const InstrumentDirectory &) = delete;
+  InstrumentDirectory &operator=(const InstrumentDirectory &) = delete;
+  InstrumentDirectory(InstrumentDirectory &&) = default;
+  InstrumentDirectory &operator=(InstrumentDirectory &&) = default;
+
+  // Symbols compare as big-endian integers so key order matches
+  // lexicographic symbol order
+  static uint64_t key_of(const SecurityId &security_id) {
+    uint64_t key;
+    std::memcpy(&key, security_id.data(), sizeof(key));
+    return __builtin_bswap64(key);
+  }
+
+  void reserve(size_t count) {
+    keys_.reserve(count);
+    instruments_.reserve(count);
+  }
+
+  // Appends without sorting; call build() once all instruments are added
+  void add(const InstrumentInfo &info) {
+    keys_.push_back(key_of(info.security_id));
+    instruments_.push_back(info);
+    built_ = false;
+  }
+
+  // Sorts by symbol and drops duplicates (the first occurrence wins).
+  // Returns the number of duplicates dropped.
+  size_t build() {
+    const size_t count = instruments_.size();
+    std::vector<uint32_t> order(count);
+    for (uint32_t i = 0; i < count; ++i) {
+      order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+      return keys_[a] < keys_[b];
+    });
+
+    std::vector<uint64_t> keys;
+    std::vector<InstrumentInfo> instruments;
+    keys.reserve(count);
+    instruments.reserve(count);
+    for (uint32_t index : order) {
+      if (!keys.empty() && keys.back() == keys_[index]) {
+        continue;
+      }
+      keys.push_back(keys_[index]);
+      instruments.push_back(instruments_[index]);
+    }
+
+    const size_t duplicates = count - keys.size();
+    keys_ = std::move(keys);
+    instruments_ = std::move(instruments);
+    built_ = true;
+    return duplicates;
+  }
+
+  const InstrumentInfo *find(const SecurityId &security_id) const {
+    const uint64_t key = key_of(security_id);
+    auto it = std::lower_bound(keys_.begin(), keys_.end(), key);
+    if (it == keys_.end() || *it != key) {
+      return nullptr;
+    }
+    return &instruments_[static_cast<size_t>(it - keys_.begin())];
+  }
+
+  bool contains(const SecurityId &security_id) const {
+    return find(security_id) != nullptr;
+  }
+
+  std::vector<SecurityId> get_security_ids() const {
+    std::vector<SecurityId> result;
+    result.reserve(instruments_.size());
+    for (const InstrumentInfo &info : instruments_) {
+      result.push_back(info.security_id);
+    }
+    return result;
+  }
+
+  const std::vector<InstrumentInfo> &instruments() const { return instruments_; }
+  size_t size() const { return instruments_.size(); }
+  bool empty() const { return instruments_.empty(); }
+  bool is_built() const { return built_; }
+
+  void clear() {
+    keys_.clear();
+    instruments_.clear();
+    built_ = false;
+  }
+
+private:
+  std::vector<uint64_t> keys_;
+  std::vector<InstrumentInfo> instruments_;
+  bool built_{false};
+};
+
+} // namespace mini_mart::market_data
@@ -0,0 +1,325 @@
+#pragma once
+
+#include "market_data/instrument_directory.hpp"
+#include <fcntl.h>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace mini_mart::market_data {
+
+enum class InstrumentLoadError {
+  SUCCESS = 0,
+  OPEN_FAILED,
+  READ_FAILED,
+  WRITE_FAILED,
+  BAD_FORMAT,
+  BAD_RECORD
+};
+
+// Loads the instrument universe from reference data into an
+// InstrumentDirectory.
+//
+// CSV: one instrument per line as symbol,tick_size,base_price,lot_size,venue
+// with prices in decimal dollars (up to 4 places). Blank lines, '#'
+// comments and a leading header row are skipped. The file is mmap'd and
+// parsed in place with no per-line allocation.
+//
+// Binary: a small header followed by packed InstrumentInfo records, written
+// by save_binary(). Loading is a single bulk copy.
+class InstrumentLoader {
+public:
+  static constexpr uint64_t BINARY_MAGIC = 0x5254534E494D494Dull; // "MIMINSTR"
+  static constexpr uint32_t BINARY_VERSION = 1;
+
+  struct BinaryHeader {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t record_count;
+  };
+
+  struct Result {
+    InstrumentLoadError error;
+    size_t loaded;     // instruments in the directory after build()
+    size_t duplicates; // repeated symbols dropped by build()
+    size_t line;       // CSV line of the first bad record (1-based)
+  };
+
+  static Result load_csv_file(const std::string &path,
+                              InstrumentDirectory &directory) {
+    Result result{};
+    MappedFile file;
+    if (!file.open(path, result)) {
+      return result;
+    }
+    return load_csv(file.view(), directory);
+  }
+
+  // Parses CSV text and rebuilds the directory. Stops at the first
+  // malformed record and reports its line number.
+  static Result load_csv(std::string_view text, InstrumentDirectory &directory) {
+    Result result{};
+    directory.clear();
+    directory.reserve(text.size() / 32);
+
+    const char *pos = text.data();
+    const char *const end = pos + text.size();
+    bool first_record = true;
+    size_t line = 0;
+
+    while (pos < end) {
+      ++line;
+      const char *line_end =
+          static_cast<const char *>(std::memchr(pos, '\n', static_cast<size_t>(end - pos)));
+      if (line_end == nullptr) {
+        line_end = end;
+      }
+      std::string_view row(pos, static_cast<size_t>(line_end - pos));
+      pos = line_end + 1;
+
+      if (!row.empty() && row.back() == '\r') {
+        row.remove_suffix(1);
+      }
+      if (row.empty() || row.front() == '#') {
+        continue;
+      }
+      if (first_record) {
+        first_record = false;
+        if (row.substr(0, 7) == "symbol,") {
+          continue;
+        }
+      }
+
+      InstrumentInfo info;
+      if (!parse_row(row, info)) {
+        result.error = InstrumentLoadError::BAD_RECORD;
+        result.line = line;
+        directory.clear();
+        return result;
+      }
+      directory.add(info);
+    }
+
+    result.duplicates = directory.build();
+    result.loaded = directory.size();
+    return result;
+  }
+
+  static Result load_binary_file(const std::string &path,
+                                 InstrumentDirectory &directory) {
+    Result result{};
+    MappedFile file;
+    if (!file.open(path, result)) {
+      return result;
+    }
+
+    const std::string_view data = file.view();
+    BinaryHeader header;
+    if (data.size() < sizeof(header)) {
+      result.error = InstrumentLoadError::BAD_FORMAT;
+      return result;
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (header.magic != BINARY_MAGIC || header.version != BINARY_VERSION ||
+        header.record_size != sizeof(InstrumentInfo) ||
+        header.record_count > (data.size() - sizeof(header)) / sizeof(InstrumentInfo)) {
+      result.error = InstrumentLoadError::BAD_FORMAT;
+      return result;
+    }
+
+    directory.clear();
+    directory.reserve(header.record_count);
+    const char *record = data.data() + sizeof(header);
+    for (uint64_t i = 0; i < header.record_count; ++i) {
+      InstrumentInfo info;
+      std::memcpy(&info, record, sizeof(info));
+      directory.add(info);
+      record += sizeof(info);
+    }
+
+    result.duplicates = directory.build();
+    result.loaded = directory.size();
+    return result;
+  }
+
+  static InstrumentLoadError save_binary_file(const std::string &path,
+                                              const InstrumentDirectory &directory) {
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+      return InstrumentLoadError::OPEN_FAILED;
+    }
+
+    const BinaryHeader header{BINARY_MAGIC, BINARY_VERSION, sizeof(InstrumentInfo),
+                              directory.size()};
+    const bool ok =
+        write_all(fd, &header, sizeof(header)) &&
+        write_all(fd, directory.instruments().data(),
+                  directory.size() * sizeof(InstrumentInfo));
+    ::close(fd);
+    return ok ? InstrumentLoadError::SUCCESS : InstrumentLoadError::WRITE_FAILED;
+  }
+
+  // Parses a non-negative decimal with up to 4 fractional digits into a
+  // Price (e.g. "0.01" -> 100 raw). Rejects anything else.
+  static bool parse_price(std::string_view field, Price &price) {
+    uint64_t whole = 0;
+    uint64_t fraction = 0;
+    size_t i = 0;
+    size_t digits = 0;
+    for (; i < field.size() && field[i] != '.'; ++i) {
+      if (!is_digit(field[i]) || whole > (UINT64_MAX - 9) / 10) {
+        return false;
+      }
+      whole = whole * 10 + static_cast<uint64_t>(field[i] - '0');
+      ++digits;
+    }
+    // Room for the 4 fractional digits in the raw value
+    if (whole > (UINT64_MAX - 9999) / 10000) {
+      return false;
+    }
+
+    uint64_t scale = 10000;
+    if (i < field.size()) {
+      ++i; // '.'
+      for (; i < field.size(); ++i) {
+        if (!is_digit(field[i]) || scale == 1) {
+          return false;
+        }
+        scale /= 10;
+        fraction += static_cast<uint64_t>(field[i] - '0') * scale;
+        ++digits;
+      }
+    }
+
+    if (digits == 0) {
+      return false;
+    }
+    price = price_from_raw(whole * 10000 + fraction);
+    return true;
+  }
+
+private:
+  static bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+  static bool next_field(std::string_view &row, std::string_view &field) {
+    if (row.data() == nullptr) {
+      return false;
+    }
+    const size_t comma = row.find(',');
+    if (comma == std::string_view::npos) {
+      field = row;
+      row = std::string_view();
+    } else {
+      field = row.substr(0, comma);
+      row.remove_prefix(comma + 1);
+    }
+    return true;
+  }
+
+  static bool parse_uint32(std::string_view field, uint32_t &value) {
+    if (field.empty() || field.size() > 9) {
+      return false;
+    }
+    uint32_t result = 0;
+    for (char c : field) {
+      if (!is_digit(c)) {
+        return false;
+      }
+      result = result * 10 + static_cast<uint32_t>(c - '0');
+    }
+    value = result;
+    return true;
+  }
+
+  template <size_t N>
+  static bool copy_code(std::string_view field, std::array<char, N> &code) {
+    if (field.empty() || field.size() > N) {
+      return false;
+    }
+    code.fill('\0');
+    std::memcpy(code.data(), field.data(), field.size());
+    return true;
+  }
+
+  static bool parse_row(std::string_view row, InstrumentInfo &info) {
+    std::string_view symbol, tick_size, base_price, lot_size, venue;
+    if (!next_field(row, symbol) || !next_field(row, tick_size) ||
+        !next_field(row, base_price) || !next_field(row, lot_size) ||
+        !next_field(row, venue) || row.data() != nullptr) {
+      return false;
+    }
+    return copy_code(symbol, info.security_id) &&
+           parse_price(tick_size, info.tick_size) && !info.tick_size.is_zero() &&
+           parse_price(base_price, info.base_price) &&
+           parse_uint32(lot_size, info.lot_size) && info.lot_size > 0 &&
+           copy_code(venue, info.venue);
+  }
+
+  static bool write_all(int fd, const void *data, size_t size) {
+    const char *bytes = static_cast<const char *>(data);
+    while (size > 0) {
+      const ssize_t written = ::write(fd, bytes, size);
+      if (written <= 0) {
+        return false;
+      }
+      bytes += written;
+      size -= static_cast<size_t>(written);
+    }
+    return true;
+  }
+
+  // Read-only mapping of a whole file, unmapped on destruction
+  class MappedFile {
+  public:
+    MappedFile() = default;
+    ~MappedFile() {
+      if (data_ != nullptr) {
+        ::munmap(data_, size_);
+      }
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    bool open(const std::string &path, Result &result) {
+      const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+      if (fd < 0) {
+        result.error = InstrumentLoadError::OPEN_FAILED;
+        return false;
+      }
+      struct stat st {};
+      if (::fstat(fd, &st) < 0) {
+        ::close(fd);
+        result.error = InstrumentLoadError::READ_FAILED;
+        return false;
+      }
+      size_ = static_cast<size_t>(st.st_size);
+      if (size_ > 0) {
+        void *mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+          ::close(fd);
+          result.error = InstrumentLoadError::READ_FAILED;
+          return false;
+        }
+        data_ = mapping;
+        ::madvise(data_, size_, MADV_SEQUENTIAL);
+      }
+      ::close(fd);
+      return true;
+    }
+
+    std::string_view view() const {
+      return size_ == 0 ? std::string_view()
+                        : std::string_view(static_cast<const char *>(data_), size_);
+    }
+
+  private:
+    void *data_{nullptr};
+    size_t size_{0};
+  };
+};
+
+} // namespace mini_mart::market_data
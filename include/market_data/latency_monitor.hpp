@@ -0,0 +1,202 @@
+#pragma once
+
+#include "common/log_linear_histogram.hpp"
+#include "common/mpmc_ring.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace mini_mart::market_data {
+
+// Hops of a message through MarketDataFeed, each measured separately
+enum class FeedStage : uint8_t {
+  GENERATE_TO_RING = 0, // provider timestamp -> pushed into the ring
+  RING_WAIT = 1,        // pushed -> popped by the consumer
+  STORE_APPLY = 2,      // popped -> applied to the sink/store
+  COUNT = 3
+};
+
+inline constexpr size_t FEED_STAGE_COUNT = static_cast<size_t>(FeedStage::COUNT);
+
+inline const char *feed_stage_name(FeedStage stage) {
+  switch (stage) {
+  case FeedStage::GENERATE_TO_RING:
+    return "generate->ring";
+  case FeedStage::RING_WAIT:
+    return "ring wait";
+  case FeedStage::STORE_APPLY:
+    return "store apply";
+  default:
+    return "unknown";
+  }
+}
+
+// SLO for one stage; 0 disables a check
+struct LatencyBudget {
+  uint64_t p99_ns;  // checked once per window against the window's p99
+  uint64_t max_ns;  // checked per message
+};
+
+enum class LatencyAlarmKind : uint8_t {
+  P99_OVER_BUDGET = 0,
+  MAX_OVER_BUDGET = 1
+};
+
+struct LatencyAlarm {
+  uint64_t timestamp_ns;
+  uint64_t observed_ns;
+  uint64_t budget_ns;
+  FeedStage stage;
+  LatencyAlarmKind kind;
+};
+
+// Latency histogram: exact below 16 ns, then 16 sub-buckets per power of
+// two (<= 6.25% relative error) up to ~18 minutes. The monitor publishes
+// percentiles from it once per window.
+using LatencyHistogram = common::LogLinearHistogram<4, 40>;
+
+// Per-stage rolling percentiles with SLO checks. Each stage has one writer
+// thread (GENERATE_TO_RING: the provider thread; the others: the consumer).
+// Samples go into a histogram for the current window; when a sample arrives
+// past the window end, the writer publishes p50/p99/p999/max of the closed
+// window and starts a new one. Breaches are pushed to a lock-free alarm ring
+// that any thread may drain. Per-sample cost is a bucket increment and two
+// compares.
+class LatencyMonitor {
+public:
+  static constexpr size_t ALARM_RING_SIZE = 256;
+
+  struct StageSnapshot {
+    uint64_t window_end_ns;
+    uint64_t samples; // in the last closed window
+    uint64_t p50_ns;
+    uint64_t p99_ns;
+    uint64_t p999_ns;
+    uint64_t max_ns;
+    uint64_t breaches; // cumulative samples over max budget
+  };
+
+  LatencyMonitor() = default;
+  LatencyMonitor(const LatencyMonitor &) = delete;
+  LatencyMonitor &operator=(const LatencyMonitor &) = delete;
+
+  // Not thread-safe; call before the writers start
+  void configure(uint64_t window_ns,
+                 const std::array<LatencyBudget, FEED_STAGE_COUNT> &budgets) {
+    window_ns_ = window_ns > 0 ? window_ns : 1;
+    for (size_t i = 0; i < FEED_STAGE_COUNT; ++i) {
+      stages_[i].budget = budgets[i];
+    }
+  }
+
+  // Not thread-safe; call while the writers are stopped
+  void reset() {
+    for (Stage &stage : stages_) {
+      stage.histogram.clear();
+      stage.window_end_ns = 0;
+      stage.max_alarm_window_end_ns = 0;
+      stage.published_window_end.store(0, std::memory_order_relaxed);
+      stage.published_samples.store(0, std::memory_order_relaxed);
+      stage.published_p50.store(0, std::memory_order_relaxed);
+      stage.published_p99.store(0, std::memory_order_relaxed);
+      stage.published_p999.store(0, std::memory_order_relaxed);
+      stage.published_max.store(0, std::memory_order_relaxed);
+      stage.breaches.store(0, std::memory_order_relaxed);
+    }
+    LatencyAlarm alarm;
+    while (alarms_.try_pop(alarm)) {
+    }
+    alarms_raised_.store(0, std::memory_order_relaxed);
+    alarms_dropped_.store(0, std::memory_order_relaxed);
+  }
+
+  // Records latency_ns for stage, observed at now_ns (closes the window)
+  void record(FeedStage stage_id, uint64_t latency_ns, uint64_t now_ns) {
+    Stage &stage = stages_[static_cast<size_t>(stage_id)];
+    if (now_ns >= stage.window_end_ns) {
+      roll_window(stage_id, stage, now_ns);
+    }
+    stage.histogram.record(latency_ns);
+
+    if (stage.budget.max_ns != 0 && latency_ns > stage.budget.max_ns) {
+      stage.breaches.fetch_add(1, std::memory_order_relaxed);
+      // At most one max alarm per stage per window
+      if (stage.max_alarm_window_end_ns != stage.window_end_ns) {
+        stage.max_alarm_window_end_ns = stage.window_end_ns;
+        raise({now_ns, latency_ns, stage.budget.max_ns, stage_id,
+               LatencyAlarmKind::MAX_OVER_BUDGET});
+      }
+    }
+  }
+
+  StageSnapshot get_snapshot(FeedStage stage_id) const {
+    const Stage &stage = stages_[static_cast<size_t>(stage_id)];
+    return {stage.published_window_end.load(std::memory_order_acquire),
+            stage.published_samples.load(std::memory_order_relaxed),
+            stage.published_p50.load(std::memory_order_relaxed),
+            stage.published_p99.load(std::memory_order_relaxed),
+            stage.published_p999.load(std::memory_order_relaxed),
+            stage.published_max.load(std::memory_order_relaxed),
+            stage.breaches.load(std::memory_order_relaxed)};
+  }
+
+  // Const so alarms can be drained through a read-only statistics view
+  bool pop_alarm(LatencyAlarm &alarm) const { return alarms_.try_pop(alarm); }
+
+  uint64_t alarms_raised() const {
+    return alarms_raised_.load(std::memory_order_relaxed);
+  }
+  uint64_t alarms_dropped() const {
+    return alarms_dropped_.load(std::memory_order_relaxed);
+  }
+  uint64_t window_ns() const { return window_ns_; }
+
+private:
+  struct alignas(64) Stage {
+    LatencyHistogram histogram;
+    LatencyBudget budget{0, 0};
+    uint64_t window_end_ns{0};
+    uint64_t max_alarm_window_end_ns{0};
+    std::atomic<uint64_t> published_window_end{0};
+    std::atomic<uint64_t> published_samples{0};
+    std::atomic<uint64_t> published_p50{0};
+    std::atomic<uint64_t> published_p99{0};
+    std::atomic<uint64_t> published_p999{0};
+    std::atomic<uint64_t> published_max{0};
+    std::atomic<uint64_t> breaches{0};
+  };
+
+  void roll_window(FeedStage stage_id, Stage &stage, uint64_t now_ns) {
+    if (stage.histogram.count() > 0) {
+      const uint64_t p99 = stage.histogram.percentile(0.99);
+      stage.published_samples.store(stage.histogram.count(), std::memory_order_relaxed);
+      stage.published_p50.store(stage.histogram.percentile(0.50), std::memory_order_relaxed);
+      stage.published_p99.store(p99, std::memory_order_relaxed);
+      stage.published_p999.store(stage.histogram.percentile(0.999), std::memory_order_relaxed);
+      stage.published_max.store(stage.histogram.max(), std::memory_order_relaxed);
+      stage.published_window_end.store(stage.window_end_ns, std::memory_order_release);
+
+      if (stage.budget.p99_ns != 0 && p99 > stage.budget.p99_ns) {
+        raise({stage.window_end_ns, p99, stage.budget.p99_ns, stage_id,
+               LatencyAlarmKind::P99_OVER_BUDGET});
+      }
+      stage.histogram.clear();
+    }
+    stage.window_end_ns = now_ns + window_ns_;
+  }
+
+  void raise(const LatencyAlarm &alarm) {
+    alarms_raised_.fetch_add(1, std::memory_order_relaxed);
+    if (!alarms_.try_push(alarm)) {
+      alarms_dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  std::array<Stage, FEED_STAGE_COUNT> stages_;
+  uint64_t window_ns_{1000000000};
+  mutable common::MpmcRing<LatencyAlarm, ALARM_RING_SIZE> alarms_;
+  std::atomic<uint64_t> alarms_raised_{0};
+  std::atomic<uint64_t> alarms_dropped_{0};
+};
+
+} // namespace mini_mart::market_data
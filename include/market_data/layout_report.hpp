@@ -0,0 +1,101 @@
+#pragma once
+
+#include "market_data/instrument_directory.hpp"
+#include "market_data/load_shedder.hpp"
+#include "market_data/market_data_feed.hpp"
+#include "market_data/random_market_data_provider.hpp"
+#include "market_data/security_store_checkpoint.hpp"
+#include <array>
+#include <iomanip>
+#include <ostream>
+
+namespace mini_mart::market_data {
+
+// Memory footprint of the core structures and the cache lines each hot
+// operation touches, derived from sizeof/alignof so it tracks the code.
+// Printed by main at startup; bench_cache_misses measures the same
+// operations with hardware counters.
+
+inline constexpr size_t CACHE_LINE_SIZE = 64;
+
+// Lines spanned by an object of this size starting on a line boundary
+constexpr size_t cache_lines(size_t bytes) {
+  return (bytes + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE;
+}
+
+struct TypeLayout {
+  const char *name;
+  size_t size;
+  size_t alignment;
+  size_t lines;
+};
+
+template <typename T> constexpr TypeLayout layout_of(const char *name) {
+  return {name, sizeof(T), alignof(T), cache_lines(sizeof(T))};
+}
+
+struct OperationFootprint {
+  const char *name;
+  size_t lines;
+  const char *breakdown;
+};
+
+inline constexpr std::array<TypeLayout, 13> CORE_TYPE_LAYOUTS = {{
+    layout_of<PriceLevel>("PriceLevel"),
+    layout_of<MarketDataL2Message>("MarketDataL2Message"),
+    layout_of<SecurityStore::SecurityData>("SecurityStore::SecurityData"),
+    layout_of<SecurityStore::SecuritySnapshot>("SecurityStore::SecuritySnapshot"),
+    layout_of<SecurityStore>("SecurityStore"),
+    layout_of<SpscRing<MarketDataL2Message, 1024>>("SpscRing<L2, 1024>"),
+    layout_of<FeedStatistics>("FeedStatistics"),
+    layout_of<LatencyMonitor>("LatencyMonitor"),
+    layout_of<MarketDataFeed>("MarketDataFeed"),
+    layout_of<PriorityLoadShedder>("PriorityLoadShedder"),
+    layout_of<RandomMarketDataProvider>("RandomMarketDataProvider"),
+    layout_of<SecurityStoreCheckpointer::Record>("Checkpoint Record"),
+    layout_of<InstrumentInfo>("InstrumentInfo"),
+}};
+
+// Estimates for the default MarketDataFeed/SecurityStore with
+// active_securities subscribed (dynamic index: lookups scan the dense slot
+// keys in insertion order, 8 keys per line)
+inline std::array<OperationFootprint, 8> operation_footprints(size_t active_securities) {
+  constexpr size_t message = cache_lines(sizeof(MarketDataL2Message));
+  constexpr size_t security = cache_lines(sizeof(SecurityStore::SecurityData));
+  const size_t average_probe = cache_lines((active_securities + 1) / 2 * sizeof(uint64_t));
+  return {{
+      {"ring push (provider)", message + 2, "message slot + tail + head"},
+      {"ring pop (consumer)", message + 2, "message slot + head + tail"},
+      {"statistics per message", 1 + 2 * 3, "counters + 3 stages x (stage, bucket)"},
+      {"store update, dynamic index", average_probe + security,
+       "avg key probe + SecurityData"},
+      {"store update, static index", 3 + security,
+       "slot map + table key + store key + SecurityData"},
+      {"store update, unknown symbol", cache_lines(SecurityStore::MAX_SECURITIES * sizeof(uint64_t)),
+       "dynamic index scans every key"},
+      {"store snapshot read", average_probe + security, "avg key probe + SecurityData"},
+      {"load shedder admit (overloaded)", 3 + message,
+       "ring indices + entry key + held copy"},
+  }};
+}
+
+inline void print_layout_report(std::ostream &out, size_t active_securities) {
+  out << "Memory layout (cache line = " << CACHE_LINE_SIZE << " bytes)\n";
+  out << "  " << std::left << std::setw(34) << "type" << std::right << std::setw(12)
+      << "bytes" << std::setw(7) << "align" << std::setw(8) << "lines" << '\n';
+  for (const TypeLayout &layout : CORE_TYPE_LAYOUTS) {
+    out << "  " << std::left << std::setw(34) << layout.name << std::right
+        << std::setw(12) << layout.size << std::setw(7) << layout.alignment
+        << std::setw(8) << layout.lines << '\n';
+  }
+
+  out << "Cache lines touched per operation (" << active_securities
+      << " active securities)\n";
+  for (const OperationFootprint &op : operation_footprints(active_securities)) {
+    out << "  " << std::left << std::setw(34) << op.name << std::right << std::setw(5)
+        << op.lines << "  " << op.breakdown << '\n';
+  }
+  out << std::flush;
+}
+
+} // namespace mini_mart::market_data
@@ -0,0 +1,205 @@
+#pragma once
+
+#include "market_data/feed_policies.hpp"
+#include "market_data/symbol_table.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace mini_mart::market_data {
+
+// Overload policy that sheds by security priority. While the ring is below
+// every class's threshold it costs one occupancy compare per message. Past
+// a class's threshold its messages are conflated (the newest per security
+// is held and delivered once occupancy falls below all thresholds) or
+// sampled (every shed_sample_interval-th is forwarded), so under a spike the
+// ring is kept short for the high-priority securities instead of filling up
+// and dropping at random.
+//
+// Priorities may be set from any thread; everything else runs on the
+// provider thread. Held updates are flushed on the next provider callback
+// after the ring drains.
+class PriorityLoadShedder {
+public:
+  static constexpr bool ENABLED = true;
+  static constexpr size_t TABLE_SIZE = 512; // securities tracked, open addressing
+
+  explicit PriorityLoadShedder(const FeedConfig &config)
+      : rules_(config.shed_rules), default_priority_(config.default_priority),
+        sample_interval_(config.shed_sample_interval > 0 ? config.shed_sample_interval : 1) {
+    min_shed_pct_ = rules_[0].occupancy_pct;
+    for (const ShedRule &rule : rules_) {
+      if (rule.occupancy_pct < min_shed_pct_) {
+        min_shed_pct_ = rule.occupancy_pct;
+      }
+    }
+  }
+
+  PriorityLoadShedder(const PriorityLoadShedder &) = delete;
+  PriorityLoadShedder &operator=(const PriorityLoadShedder &) = delete;
+
+  bool set_priority(const SecurityId &security_id, SymbolPriority priority) {
+    if (priority >= SymbolPriority::COUNT) {
+      return false;
+    }
+    Entry *entry = find_or_insert(symbol_key(security_id));
+    if (entry == nullptr) {
+      return false;
+    }
+    entry->priority.store(static_cast<uint8_t>(priority), std::memory_order_relaxed);
+    return true;
+  }
+
+  SymbolPriority get_priority(const SecurityId &security_id) const {
+    const Entry *entry = find(symbol_key(security_id));
+    return entry ? priority_of(*entry) : default_priority_;
+  }
+
+  // Provider thread. Returns true when message should be pushed now. push
+  // (bool(const MarketDataL2Message &)) is used to deliver held updates
+  // ahead of it; stats receives on_conflated()/on_sampled_out().
+  template <typename Push, typename Stats>
+  bool admit(const MarketDataL2Message &message, size_t occupancy, size_t capacity,
+             Push &&push, Stats &stats) {
+    const uint64_t scaled = uint64_t{occupancy} * 100;
+    const bool below_all = scaled < uint64_t{min_shed_pct_} * capacity;
+    if (below_all) {
+      if (queued_count_ == 0) {
+        return true;
+      }
+      flush(push);
+    }
+
+    Entry *entry = find_or_insert(symbol_key(message.security_id));
+    if (entry == nullptr) {
+      return true; // table full: never shed what we cannot track
+    }
+
+    const ShedRule &rule = rules_[static_cast<size_t>(priority_of(*entry))];
+    if (below_all || scaled < uint64_t{rule.occupancy_pct} * capacity) {
+      discard_held(*entry, stats);
+      return true;
+    }
+
+    if (rule.action == ShedAction::SAMPLE) {
+      if (entry->sample_count++ % sample_interval_ == 0) {
+        discard_held(*entry, stats);
+        return true;
+      }
+      stats.on_sampled_out();
+      return false;
+    }
+
+    discard_held(*entry, stats);
+    entry->held = message;
+    entry->has_held = true;
+    if (!entry->queued) {
+      entry->queued = true;
+      queue_[queued_count_++] = static_cast<uint16_t>(entry - table_.data());
+    }
+    return false;
+  }
+
+  // Updates held for conflation, not yet delivered (provider thread)
+  size_t held_count() const {
+    size_t count = 0;
+    for (size_t i = 0; i < queued_count_; ++i) {
+      count += table_[queue_[i]].has_held ? 1u : 0u;
+    }
+    return count;
+  }
+
+private:
+  static constexpr uint64_t EMPTY_KEY = 0; // the empty symbol
+  static constexpr uint8_t UNSET_PRIORITY = UINT8_MAX;
+
+  struct Entry {
+    std::atomic<uint64_t> key{EMPTY_KEY};
+    std::atomic<uint8_t> priority{UNSET_PRIORITY};
+    // Provider thread only
+    bool has_held{false};
+    bool queued{false};
+    uint32_t sample_count{0};
+    MarketDataL2Message held{};
+  };
+
+  static size_t home_slot(uint64_t key) {
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 55) & (TABLE_SIZE - 1);
+  }
+
+  SymbolPriority priority_of(const Entry &entry) const {
+    const uint8_t priority = entry.priority.load(std::memory_order_relaxed);
+    return priority == UNSET_PRIORITY ? default_priority_
+                                      : static_cast<SymbolPriority>(priority);
+  }
+
+  const Entry *find(uint64_t key) const {
+    for (size_t probe = 0, slot = home_slot(key); probe < TABLE_SIZE;
+         ++probe, slot = (slot + 1) & (TABLE_SIZE - 1)) {
+      const uint64_t current = table_[slot].key.load(std::memory_order_acquire);
+      if (current == key) {
+        return &table_[slot];
+      }
+      if (current == EMPTY_KEY) {
+        return nullptr;
+      }
+    }
+    return nullptr;
+  }
+
+  Entry *find_or_insert(uint64_t key) {
+    if (key == EMPTY_KEY) {
+      return nullptr;
+    }
+    for (size_t probe = 0, slot = home_slot(key); probe < TABLE_SIZE;
+         ++probe, slot = (slot + 1) & (TABLE_SIZE - 1)) {
+      uint64_t current = table_[slot].key.load(std::memory_order_acquire);
+      if (current == EMPTY_KEY &&
+          table_[slot].key.compare_exchange_strong(current, key,
+                                                   std::memory_order_acq_rel)) {
+        return &table_[slot];
+      }
+      if (current == key) {
+        return &table_[slot];
+      }
+    }
+    return nullptr;
+  }
+
+  template <typename Stats> void discard_held(Entry &entry, Stats &stats) {
+    if (entry.has_held) {
+      entry.has_held = false;
+      stats.on_conflated();
+    }
+  }
+
+  // Delivers held updates in the order their securities were first held;
+  // stops at the first failed push and keeps the rest
+  template <typename Push> void flush(Push &push) {
+    size_t done = 0;
+    for (; done < queued_count_; ++done) {
+      Entry &entry = table_[queue_[done]];
+      if (entry.has_held) {
+        if (!push(entry.held)) {
+          break;
+        }
+        entry.has_held = false;
+      }
+      entry.queued = false;
+    }
+    for (size_t i = done; i < queued_count_; ++i) {
+      queue_[i - done] = queue_[i];
+    }
+    queued_count_ -= done;
+  }
+
+  std::array<Entry, TABLE_SIZE> table_;
+  std::array<uint16_t, TABLE_SIZE> queue_{};
+  size_t queued_count_{0};
+  std::array<ShedRule, SYMBOL_PRIORITY_COUNT> rules_;
+  SymbolPriority default_priority_;
+  uint32_t sample_interval_;
+  uint32_t min_shed_pct_;
+};
+
+} // namespace mini_mart::market_data
@@ -1,97 +1,87 @@
 #pragma once
 
 #include "common/spsc_ring.hpp"
+#include "market_data/feed_policies.hpp"
 #include "market_data/market_data_provider.hpp"
 #include "market_data/security_store.hpp"
 #include <atomic>
 #include <chrono>
 #include <memory>
 #include <thread>
+#include <type_traits>
 
 namespace mini_mart::market_data {
 
 using namespace mini_mart::types;
 using namespace mini_mart::common;
 
-// Lock-free market data feed using SPSC ring buffer
-class MarketDataFeed {
+// Lock-free market data feed: the provider thread pushes into Ring, a
+// consumer thread pops into Sink. Each stage is a policy (see
+// feed_policies.hpp) so disabled features compile to nothing and every
+// combination can be benchmarked. MarketDataFeed below is the
+// runtime-configured default. With EventfdWait there is no consumer thread;
+// the caller's epoll loop drives poll(). A Ring of MarketDataEnvelope
+// carries a mixed stream (trades, deltas, heartbeats from the provider's
+// message callback), each routed to the sink's overload for its type.
+template <typename Ring = SpscRing<MarketDataL2Message, 1024>,
+          typename Wait = ConfiguredWait, typename Clock = HighResolutionClock,
+          typename Stats = RuntimeStatistics,
+          typename Sink = StoreSink<SecurityStore>,
+          typename Overload = NoLoadShedding>
+class BasicMarketDataFeed {
 public:
-  static constexpr size_t DEFAULT_RING_SIZE = 1024;
-
-  struct Config {
-    uint32_t consumer_yield_us;
-    bool enable_statistics;
-
-    Config() : consumer_yield_us(1), enable_statistics(true) {}
-  };
-
-  struct Statistics {
-    std::atomic<uint64_t> messages_produced{0};
-    std::atomic<uint64_t> messages_consumed{0};
-    std::atomic<uint64_t> ring_full_events{0};
-    std::atomic<uint64_t> ring_empty_events{0};
-    std::atomic<uint64_t> consumer_yields{0};
-    std::atomic<uint64_t> total_latency_ns{0};
-    std::atomic<uint64_t> max_latency_ns{0};
-
-    Statistics() = default;
-    Statistics(const Statistics &) = delete;
-    Statistics &operator=(const Statistics &) = delete;
-    Statistics(Statistics &&) = delete;
-    Statistics &operator=(Statistics &&) = delete;
-
-    double get_average_latency_ns() const {
-      uint64_t consumed = messages_consumed.load(std::memory_order_relaxed);
-      if (consumed == 0)
-        return 0.0;
-      return static_cast<double>(
-                 total_latency_ns.load(std::memory_order_relaxed)) /
-             static_cast<double>(consumed);
-    }
-
-    void reset() {
-      messages_produced.store(0, std::memory_order_relaxed);
-      messages_consumed.store(0, std::memory_order_relaxed);
-      ring_full_events.store(0, std::memory_order_relaxed);
-      ring_empty_events.store(0, std::memory_order_relaxed);
-      consumer_yields.store(0, std::memory_order_relaxed);
-      total_latency_ns.store(0, std::memory_order_relaxed);
-      max_latency_ns.store(0, std::memory_order_relaxed);
-    }
-  };
-
-  explicit MarketDataFeed(std::shared_ptr<MarketDataProvider> provider,
-                          std::shared_ptr<SecurityStore> store,
-                          const Config &config = Config())
-      : provider_(std::move(provider)), store_(std::move(store)),
-        config_(config) {
+  static constexpr size_t DEFAULT_RING_SIZE = Ring::get_capacity();
+  using RingMessage = typename Ring::value_type;
+  static constexpr bool ENVELOPED = is_message_envelope_v<RingMessage>;
+
+  using Config = FeedConfig;
+  using Statistics = FeedStatistics;
+
+  explicit BasicMarketDataFeed(std::shared_ptr<MarketDataProvider> provider,
+                               Sink sink, const Config &config = Config())
+      : provider_(std::move(provider)), sink_(std::move(sink)), wait_(config),
+        stats_(config), overload_(config),
+        commit_batch_(config.store_commit_batch > 0 ? config.store_commit_batch : 1) {
     provider_->set_callback([this](const MarketDataL2Message &message) {
       this->on_market_data_received(message);
     });
+    if constexpr (ENVELOPED) {
+      provider_->set_message_callback([this](const MarketDataEnvelope &message) {
+        this->on_message_received(message);
+      });
+    }
   }
 
-  ~MarketDataFeed() { stop(); }
+  ~BasicMarketDataFeed() { stop(); }
 
-  MarketDataFeed(const MarketDataFeed &) = delete;
-  MarketDataFeed &operator=(const MarketDataFeed &) = delete;
-  MarketDataFeed(MarketDataFeed &&) = delete;
-  MarketDataFeed &operator=(MarketDataFeed &&) = delete;
+  BasicMarketDataFeed(const BasicMarketDataFeed &) = delete;
+  BasicMarketDataFeed &operator=(const BasicMarketDataFeed &) = delete;
+  BasicMarketDataFeed(BasicMarketDataFeed &&) = delete;
+  BasicMarketDataFeed &operator=(BasicMarketDataFeed &&) = delete;
 
   bool start() {
     if (running_.load(std::memory_order_acquire)) {
       return false;
     }
 
-    if (config_.enable_statistics) {
+    if (stats_.active()) {
       stats_.reset();
     }
 
+    if constexpr (ExternalConsumerWait<Wait>) {
+      if (wait_.open_error() != 0) {
+        return false;
+      }
+    }
+
     if (!provider_->start()) {
       return false;
     }
 
     running_.store(true, std::memory_order_release);
-    consumer_thread_ = std::thread(&MarketDataFeed::consumer_thread_func, this);
+    if constexpr (!ExternalConsumerWait<Wait>) {
+      consumer_thread_ = std::thread(&BasicMarketDataFeed::consumer_thread_func, this);
+    }
 
     return true;
   }
@@ -112,12 +102,17 @@ public:
   bool is_running() const { return running_.load(std::memory_order_acquire); }
 
   bool subscribe(const SecurityId &security_id) {
-    if (!store_->add_security(security_id)) {
+    // A security restored from a checkpoint is already in the store; it
+    // still needs a provider subscription to start receiving live updates
+    const bool added = sink_.add_security(security_id);
+    if (!added && !sink_.contains(security_id)) {
       return false;
     }
 
     if (!provider_->subscribe(security_id)) {
-      store_->remove_security(security_id);
+      if (added) {
+        sink_.remove_security(security_id);
+      }
       return false;
     }
 
@@ -126,11 +121,16 @@ public:
 
   bool unsubscribe(const SecurityId &security_id) {
     bool provider_result = provider_->unsubscribe(security_id);
-    bool store_result = store_->remove_security(security_id);
+    bool store_result = sink_.remove_security(security_id);
     return provider_result && store_result;
   }
 
-  const Statistics &get_statistics() const { return stats_; }
+  // Priority class for load shedding; false when Overload does not shed
+  bool set_priority(const SecurityId &security_id, SymbolPriority priority) {
+    return overload_.set_priority(security_id, priority);
+  }
+
+  const Statistics &get_statistics() const { return stats_.get(); }
 
   double get_ring_utilization() const {
     return static_cast<double>(ring_buffer_.size()) /
@@ -141,84 +141,231 @@ public:
     return provider_->get_subscribed_securities();
   }
 
+  Sink &get_sink() { return sink_; }
+
+  // Enveloped rings only: enqueues a message from inside a provider
+  // callback, e.g. an adapter that decodes several messages from one
+  // packet; false if dropped. Providers normally deliver trades, deltas
+  // and heartbeats through their message callback instead. The ring has a
+  // single producer, so this is refused on any thread but the one of the
+  // latest provider callback, and before the first.
+  template <typename Message>
+    requires(ENVELOPED && RingMessage::template holds<Message>)
+  bool publish(const Message &message) {
+    if (!running_.load(std::memory_order_acquire) ||
+        producer_thread_.load(std::memory_order_relaxed) != std::this_thread::get_id()) {
+      return false;
+    }
+    return enqueue(message);
+  }
+
+  // EventfdWait only: readable (level-triggered) while poll() has work
+  int notification_fd() const
+    requires ExternalConsumerWait<Wait>
+  {
+    return wait_.notifier().fd();
+  }
+
+  // EventfdWait only: eventfd writes so far (at most one per empty ring)
+  uint64_t notifications_sent() const
+    requires ExternalConsumerWait<Wait>
+  {
+    return wait_.notifier().signals_sent();
+  }
+
+  // EventfdWait only: consumes up to max_messages on the calling thread
+  // (one thread at a time). Leaves the fd readable if messages remain,
+  // otherwise armed so the next push signals it.
+  size_t poll(size_t max_messages = DEFAULT_RING_SIZE)
+    requires ExternalConsumerWait<Wait>
+  {
+    EventNotifier &notifier = wait_.notifier();
+    notifier.drain();
+    size_t consumed = 0;
+    for (;;) {
+      while (consumed < max_messages && consume_one()) {
+        ++consumed;
+      }
+      commit_batch();
+      if (consumed == max_messages && !ring_buffer_.empty()) {
+        notifier.signal();
+        return consumed;
+      }
+      notifier.arm();
+      if (ring_buffer_.empty()) {
+        if (stats_.active()) {
+          stats_.on_ring_empty();
+        }
+        return consumed;
+      }
+      // A push raced with arm(): keep consuming
+      notifier.disarm();
+    }
+  }
+
 private:
   void on_market_data_received(const MarketDataL2Message &message) {
     if (!running_.load(std::memory_order_acquire)) {
       return;
     }
 
-    MarketDataL2Message timestamped_message = message;
-    if (config_.enable_statistics) {
-      timestamped_message.timestamp_ns = get_current_time_ns();
+    if constexpr (ENVELOPED) {
+      note_producer_thread();
     }
 
-    if (ring_buffer_.try_push(std::move(timestamped_message))) {
-      if (config_.enable_statistics) {
-        stats_.messages_produced.fetch_add(1, std::memory_order_relaxed);
+    if constexpr (Overload::ENABLED) {
+      auto push = [this](const MarketDataL2Message &held) { return enqueue(held); };
+      if (!overload_.admit(message, ring_buffer_.size(), DEFAULT_RING_SIZE, push,
+                           stats_)) {
+        return;
       }
-    } else {
-      if (config_.enable_statistics) {
-        stats_.ring_full_events.fetch_add(1, std::memory_order_relaxed);
+    }
+    enqueue(message);
+  }
+
+  // Provider's message callback; types the ring does not hold are dropped
+  void on_message_received(const MarketDataEnvelope &message) {
+    if (!running_.load(std::memory_order_acquire)) {
+      return;
+    }
+    message.visit([this](const auto &held) {
+      using Message = std::decay_t<decltype(held)>;
+      if constexpr (std::is_same_v<Message, MarketDataL2Message>) {
+        on_market_data_received(held);
+      } else if constexpr (RingMessage::template holds<Message>) {
+        note_producer_thread();
+        enqueue(held);
       }
+    });
+  }
+
+  void note_producer_thread() {
+    // A restarted provider may call back on a new thread
+    const std::thread::id caller = std::this_thread::get_id();
+    if (producer_thread_.load(std::memory_order_relaxed) != caller) {
+      producer_thread_.store(caller, std::memory_order_relaxed);
     }
   }
 
-  void consumer_thread_func() {
-    MarketDataL2Message message;
+  template <typename Message> bool enqueue(const Message &message) {
+    // The provider's timestamp is replaced by the enqueue time, which the
+    // consumer uses to measure the ring wait
+    Message timestamped_message = message;
+    uint64_t generated_ns = 0;
+    uint64_t enqueued_ns = 0;
+    if (stats_.active()) {
+      enqueued_ns = Clock::now_ns();
+      generated_ns = enqueued_ns;
+      if constexpr (TimestampedMessage<Message>) {
+        generated_ns = message.timestamp_ns;
+        timestamped_message.timestamp_ns = enqueued_ns;
+      }
+    }
 
-    while (running_.load(std::memory_order_acquire)) {
-      if (ring_buffer_.try_pop(message)) {
-        bool updated = store_->update_from_l2(message);
+    if (ring_buffer_.try_push(RingMessage(timestamped_message))) {
+      if constexpr (ExternalConsumerWait<Wait>) {
+        wait_.notifier().notify();
+      }
+      if (stats_.active()) {
+        stats_.on_produced(generated_ns, enqueued_ns);
+      }
+      return true;
+    }
+    if (stats_.active()) {
+      stats_.on_ring_full();
+    }
+    return false;
+  }
 
-        if (config_.enable_statistics && updated) {
-          stats_.messages_consumed.fetch_add(1, std::memory_order_relaxed);
+  // Pops one message into the sink; false when the ring is empty
+  bool consume_one() {
+    RingMessage message;
+    if (!ring_buffer_.try_pop(message)) {
+      return false;
+    }
+    uint64_t dequeued_ns = 0;
+    if (stats_.active()) {
+      dequeued_ns = Clock::now_ns();
+    }
+    if constexpr (ENVELOPED) {
+      message.visit([this, dequeued_ns](const auto &typed) { apply(typed, dequeued_ns); });
+    } else {
+      apply(message, dequeued_ns);
+    }
+    return true;
+  }
 
-          uint64_t current_time = get_current_time_ns();
-          uint64_t latency = current_time - message.timestamp_ns;
+  template <typename Message> void apply(const Message &message, uint64_t dequeued_ns) {
+    if constexpr (BatchingSink<Sink>) {
+      if (batched_ == 0) {
+        sink_.begin_batch();
+      }
+    }
+    bool updated = false;
+    if constexpr (HandlesMessage<Sink, Message>) {
+      updated = sink_.on_message(message);
+      if (!updated && stats_.active()) {
+        stats_.on_rejected();
+      }
+    } else if (stats_.active()) {
+      stats_.on_skipped();
+    }
+    if constexpr (BatchingSink<Sink>) {
+      if (++batched_ == commit_batch_) {
+        commit_batch();
+      }
+    }
 
-          stats_.total_latency_ns.fetch_add(latency, std::memory_order_relaxed);
+    if (stats_.active() && updated) {
+      uint64_t enqueued_ns = dequeued_ns;
+      if constexpr (TimestampedMessage<Message>) {
+        enqueued_ns = message.timestamp_ns;
+      }
+      stats_.on_consumed(enqueued_ns, dequeued_ns, Clock::now_ns());
+    }
+  }
 
-          uint64_t current_max =
-              stats_.max_latency_ns.load(std::memory_order_relaxed);
-          while (latency > current_max) {
-            if (stats_.max_latency_ns.compare_exchange_weak(
-                    current_max, latency, std::memory_order_relaxed)) {
-              break;
-            }
-          }
-        }
+  void consumer_thread_func() {
+    while (running_.load(std::memory_order_acquire)) {
+      if (consume_one()) {
+        wait_.reset();
       } else {
-        if (config_.enable_statistics) {
-          stats_.ring_empty_events.fetch_add(1, std::memory_order_relaxed);
+        commit_batch();
+        if (stats_.active()) {
+          stats_.on_ring_empty();
         }
 
-        if (config_.consumer_yield_us > 0) {
-          std::this_thread::sleep_for(
-              std::chrono::microseconds(config_.consumer_yield_us));
-          if (config_.enable_statistics) {
-            stats_.consumer_yields.fetch_add(1, std::memory_order_relaxed);
-          }
-        } else {
-          std::this_thread::yield();
+        if (wait_.idle() && stats_.active()) {
+          stats_.on_yield();
         }
       }
     }
+    commit_batch();
   }
 
-  uint64_t get_current_time_ns() const {
-    auto now = std::chrono::high_resolution_clock::now();
-    auto duration = now.time_since_epoch();
-    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration)
-        .count());
+  void commit_batch() {
+    if constexpr (BatchingSink<Sink>) {
+      if (batched_ != 0) {
+        sink_.commit();
+        batched_ = 0;
+      }
+    }
   }
 
   std::shared_ptr<MarketDataProvider> provider_;
-  std::shared_ptr<SecurityStore> store_;
-  Config config_;
-  SpscRing<MarketDataL2Message, DEFAULT_RING_SIZE> ring_buffer_;
+  Sink sink_;
+  Wait wait_;
+  Ring ring_buffer_;
   std::atomic<bool> running_{false};
+  // Thread of the latest provider callback, the only one publish() accepts
+  std::atomic<std::thread::id> producer_thread_{};
   std::thread consumer_thread_;
-  mutable Statistics stats_;
+  Stats stats_;
+  Overload overload_;
+  const uint32_t commit_batch_;
+  uint32_t batched_ = 0; // consumer only: updates in the open commit
 };
 
+using MarketDataFeed = BasicMarketDataFeed<>;
+
 } // namespace mini_mart::market_data
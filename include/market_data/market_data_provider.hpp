@@ -1,5 +1,6 @@
 #pragma once
 
+#include "types/message_envelope.hpp"
 #include "types/messages.hpp"
 #include <functional>
 #include <memory>
@@ -15,6 +16,12 @@ using namespace mini_mart::types;
  */
 using MarketDataCallback = std::function<void(const MarketDataL2Message &)>;
 
+/**
+ * @brief Callback function type for the rest of the stream
+ * @param message Envelope holding one trade, book delta or heartbeat
+ */
+using MarketDataMessageCallback = std::function<void(const MarketDataEnvelope &)>;
+
 /**
  * @brief Abstract interface for market data providers
  *
@@ -62,6 +69,16 @@ public:
    */
   virtual void set_callback(MarketDataCallback callback) = 0;
 
+  /**
+   * @brief Set the callback function for trades, book deltas and heartbeats
+   *
+   * Providers must invoke it on the thread that invokes the L2 callback:
+   * the feed's ring has a single producer. The default discards it, for
+   * providers that only produce L2 snapshots.
+   * @param callback The callback function to be called on each message
+   */
+  virtual void set_message_callback(MarketDataMessageCallback callback) { (void)callback; }
+
   /**
    * @brief Get the list of currently subscribed securities
    * @return Vector of subscribed security IDs
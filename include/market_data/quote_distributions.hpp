@@ -0,0 +1,206 @@
+#pragma once
+
+#include "common/log_linear_histogram.hpp"
+#include "market_data/symbol_table.hpp"
+#include "types/messages.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace mini_mart::market_data {
+
+// What QuoteDistributionTracker measures on every L2 update
+enum class QuoteMetric : uint8_t {
+  SPREAD = 0,     // best ask - best bid, Price raw (two-sided books only)
+  TOP_SIZE = 1,   // best bid and best ask quantity, one sample per side
+  UPDATE_GAP = 2, // ns since the security's previous update
+  COUNT = 3
+};
+
+inline constexpr size_t QUOTE_METRIC_COUNT = static_cast<size_t>(QuoteMetric::COUNT);
+
+inline const char *quote_metric_name(QuoteMetric metric) {
+  switch (metric) {
+  case QuoteMetric::SPREAD:
+    return "spread";
+  case QuoteMetric::TOP_SIZE:
+    return "top size";
+  case QuoteMetric::UPDATE_GAP:
+    return "update gap";
+  default:
+    return "unknown";
+  }
+}
+
+// 8 sub-buckets per power of two (<= 12.5% relative error) up to 2^37:
+// $13M spreads, 137 s gaps. ~1.1 KB.
+using QuoteSketch = common::LogLinearHistogram<3, 36>;
+
+// One security's sketches for an interval, or a merge of several
+struct QuoteDistributions {
+  std::array<QuoteSketch, QUOTE_METRIC_COUNT> sketches;
+
+  QuoteSketch &operator[](QuoteMetric metric) { return sketches[static_cast<size_t>(metric)]; }
+  const QuoteSketch &operator[](QuoteMetric metric) const {
+    return sketches[static_cast<size_t>(metric)];
+  }
+
+  void merge(const QuoteDistributions &other) {
+    for (size_t i = 0; i < QUOTE_METRIC_COUNT; ++i) {
+      sketches[i].merge(other.sketches[i]);
+    }
+  }
+
+  void clear() {
+    for (QuoteSketch &sketch : sketches) {
+      sketch.clear();
+    }
+  }
+};
+
+// Per-security distributions of spread, top-of-book size and update gap,
+// recorded by the feed consumer (through a SharedObserver) without
+// keeping samples. Time is cut into intervals of interval_ns of feed time;
+// each security holds its open interval and the one before it (~7 KB).
+// A security's generation is cleared lazily, under a seqlock, on its first
+// update of a new interval, so the consumer never pays for idle symbols.
+//
+// Stats threads copy closed intervals out with merge_closed() without
+// blocking the consumer, and combine them across trackers (one per feed
+// shard) and intervals into longer views.
+//
+// On a feed with book deltas, attach it through DeltaAsSnapshot: a delta
+// to the best level records like a snapshot, deeper deltas are not
+// updates, so the gap is between changes to the touch.
+template <typename Index = DynamicSecurityIndex> class QuoteDistributionTracker {
+public:
+  static constexpr size_t MAX_SECURITIES = Index::CAPACITY;
+  static constexpr size_t NOT_FOUND = DenseSecurityMap<Index>::NOT_FOUND;
+
+  explicit QuoteDistributionTracker(uint64_t interval_ns)
+      : interval_ns_(interval_ns > 0 ? interval_ns : 1), interval_end_ns_(interval_ns_),
+        states_(std::make_unique<SecurityState[]>(MAX_SECURITIES)) {}
+
+  QuoteDistributionTracker(const QuoteDistributionTracker &) = delete;
+  QuoteDistributionTracker &operator=(const QuoteDistributionTracker &) = delete;
+
+  // Setup; NOT_FOUND if already added, full or unknown to a static index
+  size_t add_security(const SecurityId &security_id) { return securities_.add(security_id); }
+  size_t find(const SecurityId &security_id) const { return securities_.find(security_id); }
+
+  // Consumer thread. False for securities not added.
+  bool on_message(const MarketDataL2Message &message) {
+    const size_t index = securities_.find(message.security_id);
+    if (index == NOT_FOUND) {
+      return false;
+    }
+    record(index, message);
+    return true;
+  }
+
+  // on_message for a caller that already holds the index
+  void record(size_t index, const MarketDataL2Message &message) {
+    SecurityState &state = states_[index];
+    QuoteDistributions &open = open_generation(state, message.timestamp_ns);
+    const bool has_bid = message.num_bid_levels > 0;
+    const bool has_ask = message.num_ask_levels > 0;
+    if (has_bid && has_ask) {
+      const uint64_t bid = message.bids[0].price.raw();
+      const uint64_t ask = message.asks[0].price.raw();
+      open[QuoteMetric::SPREAD].record(ask > bid ? ask - bid : 0);
+    }
+    if (has_bid) {
+      open[QuoteMetric::TOP_SIZE].record(message.bids[0].quantity);
+    }
+    if (has_ask) {
+      open[QuoteMetric::TOP_SIZE].record(message.asks[0].quantity);
+    }
+    if (state.last_update_ns != 0 && message.timestamp_ns >= state.last_update_ns) {
+      open[QuoteMetric::UPDATE_GAP].record(message.timestamp_ns - state.last_update_ns);
+    }
+    state.last_update_ns = message.timestamp_ns;
+    updates_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Interval the consumer is recording into; every earlier one is closed
+  uint64_t current_interval() const { return current_interval_.load(std::memory_order_acquire); }
+  uint64_t interval_ns() const { return interval_ns_; }
+
+  // Any thread. Adds security index's sketches for a closed interval to
+  // into; a security without updates in it adds nothing. False if the
+  // interval is still open or no longer retained (only the last closed
+  // interval is guaranteed).
+  bool merge_closed(size_t index, uint64_t interval, QuoteDistributions &into) const {
+    if (interval >= current_interval()) {
+      return false;
+    }
+    const SecurityState &state = states_[index];
+    const Generation &generation = state.generations[interval & 1];
+    QuoteDistributions copy;
+    for (;;) {
+      const uint64_t seq_before = state.sequence.load(std::memory_order_acquire);
+      if (seq_before & 1) {
+        continue;
+      }
+      const uint64_t tag = generation.interval.load(std::memory_order_relaxed);
+      if (tag != interval) {
+        // Never touched since, or already reused for a later interval
+        return tag == NO_INTERVAL || tag < interval;
+      }
+      std::memcpy(static_cast<void *>(&copy), &generation.distributions, sizeof(QuoteDistributions));
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (state.sequence.load(std::memory_order_relaxed) == seq_before) {
+        into.merge(copy);
+        return true;
+      }
+    }
+  }
+
+  size_t security_count() const { return securities_.size(); }
+  SecurityId security_id(size_t index) const { return securities_.security_id(index); }
+  uint64_t updates() const { return updates_.load(std::memory_order_relaxed); }
+
+private:
+  static constexpr uint64_t NO_INTERVAL = UINT64_MAX;
+
+  struct Generation {
+    std::atomic<uint64_t> interval{NO_INTERVAL}; // what distributions holds
+    QuoteDistributions distributions{};
+  };
+
+  struct SecurityState {
+    std::atomic<uint64_t> sequence{0}; // odd while a generation is reset
+    uint64_t last_update_ns{0};
+    std::array<Generation, 2> generations; // by interval parity
+  };
+
+  QuoteDistributions &open_generation(SecurityState &state, uint64_t timestamp_ns) {
+    if (timestamp_ns >= interval_end_ns_) {
+      const uint64_t interval = timestamp_ns / interval_ns_;
+      interval_end_ns_ = (interval + 1) * interval_ns_;
+      current_interval_.store(interval, std::memory_order_release);
+    }
+    const uint64_t interval = current_interval_.load(std::memory_order_relaxed);
+    Generation &generation = state.generations[interval & 1];
+    if (generation.interval.load(std::memory_order_relaxed) != interval) {
+      const uint64_t seq = state.sequence.load(std::memory_order_relaxed);
+      state.sequence.store(seq + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      generation.distributions.clear();
+      generation.interval.store(interval, std::memory_order_relaxed);
+      state.sequence.store(seq + 2, std::memory_order_release);
+    }
+    return generation.distributions;
+  }
+
+  const uint64_t interval_ns_;
+  uint64_t interval_end_ns_;
+  std::atomic<uint64_t> current_interval_{0};
+  DenseSecurityMap<Index> securities_;
+  std::unique_ptr<SecurityState[]> states_;
+  std::atomic<uint64_t> updates_{0};
+};
+
+} // namespace mini_mart::market_data
@@ -0,0 +1,352 @@
+#pragma once
+
+#include "common/mpmc_ring.hpp"
+#include "common/single_writer_counter.hpp"
+#include "market_data/symbol_table.hpp"
+#include "types/message_envelope.hpp"
+#include "types/messages.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+
+namespace mini_mart::market_data {
+
+// Why a quote was quarantined; a message may have several (bit i of a
+// defect mask is QuoteDefect i)
+enum class QuoteDefect : uint8_t {
+  LEVEL_COUNT = 0,   // more than 5 levels on a side
+  ZERO_PRICE = 1,    // a live level priced 0
+  ZERO_QUANTITY = 2, // a live level with no quantity
+  UNSORTED_BIDS = 3, // bids not strictly descending
+  UNSORTED_ASKS = 4, // asks not strictly ascending
+  CROSSED = 5,       // best bid above best ask (locked is allowed)
+  PRICE_JUMP = 6,    // mid moved too far from the security's last good one
+  COUNT = 7
+};
+
+inline constexpr size_t QUOTE_DEFECT_COUNT = static_cast<size_t>(QuoteDefect::COUNT);
+
+inline constexpr uint16_t defect_bit(QuoteDefect defect) {
+  return static_cast<uint16_t>(1u << static_cast<unsigned>(defect));
+}
+
+inline const char *quote_defect_name(QuoteDefect defect) {
+  switch (defect) {
+  case QuoteDefect::LEVEL_COUNT:
+    return "level count";
+  case QuoteDefect::ZERO_PRICE:
+    return "zero price";
+  case QuoteDefect::ZERO_QUANTITY:
+    return "zero quantity";
+  case QuoteDefect::UNSORTED_BIDS:
+    return "unsorted bids";
+  case QuoteDefect::UNSORTED_ASKS:
+    return "unsorted asks";
+  case QuoteDefect::CROSSED:
+    return "crossed";
+  case QuoteDefect::PRICE_JUMP:
+    return "price jump";
+  default:
+    return "unknown";
+  }
+}
+
+namespace detail {
+
+// Every defect of a book already known to have one (or more than 5 levels)
+inline uint16_t classify_book_levels(const MarketDataL2Message &message) {
+  constexpr size_t LEVELS = 5;
+  const size_t bid_levels = message.num_bid_levels;
+  const size_t ask_levels = message.num_ask_levels;
+  if (bid_levels > LEVELS || ask_levels > LEVELS) {
+    return defect_bit(QuoteDefect::LEVEL_COUNT);
+  }
+  uint16_t defects = 0;
+  for (size_t i = 0; i < bid_levels; ++i) {
+    if (message.bids[i].price.raw() == 0) {
+      defects |= defect_bit(QuoteDefect::ZERO_PRICE);
+    }
+    if (message.bids[i].quantity == 0) {
+      defects |= defect_bit(QuoteDefect::ZERO_QUANTITY);
+    }
+    if (i > 0 && message.bids[i - 1].price.raw() <= message.bids[i].price.raw()) {
+      defects |= defect_bit(QuoteDefect::UNSORTED_BIDS);
+    }
+  }
+  for (size_t i = 0; i < ask_levels; ++i) {
+    if (message.asks[i].price.raw() == 0) {
+      defects |= defect_bit(QuoteDefect::ZERO_PRICE);
+    }
+    if (message.asks[i].quantity == 0) {
+      defects |= defect_bit(QuoteDefect::ZERO_QUANTITY);
+    }
+    if (i > 0 && message.asks[i - 1].price.raw() >= message.asks[i].price.raw()) {
+      defects |= defect_bit(QuoteDefect::UNSORTED_ASKS);
+    }
+  }
+  if (bid_levels > 0 && ask_levels > 0 && message.bids[0].price.raw() > message.asks[0].price.raw()) {
+    defects |= defect_bit(QuoteDefect::CROSSED);
+  }
+  return defects;
+}
+
+} // namespace detail
+
+// Structural checks of an L2 snapshot's levels; 0 when sound. Clean books
+// take one pass per side that folds every check into a single flag (a
+// descending bid ladder with a zero price can't pass, asks start above 0);
+// only a failed book is walked again to name its defects.
+inline uint16_t check_book_levels(const MarketDataL2Message &message) {
+  const size_t bid_levels = message.num_bid_levels;
+  const size_t ask_levels = message.num_ask_levels;
+  if (bid_levels > 5 || ask_levels > 5) {
+    return defect_bit(QuoteDefect::LEVEL_COUNT);
+  }
+  bool sound = true;
+  uint64_t above = UINT64_MAX;
+  for (size_t i = 0; i < bid_levels; ++i) {
+    const uint64_t price = message.bids[i].price.raw();
+    sound &= (price < above) & (price != 0) & (message.bids[i].quantity != 0);
+    above = price;
+  }
+  uint64_t below = 0;
+  for (size_t i = 0; i < ask_levels; ++i) {
+    const uint64_t price = message.asks[i].price.raw();
+    sound &= (price > below) & (message.asks[i].quantity != 0);
+    below = price;
+  }
+  sound &= bid_levels == 0 || ask_levels == 0 || message.bids[0].price.raw() <= message.asks[0].price.raw();
+  return sound ? 0 : detail::classify_book_levels(message);
+}
+
+// Checks of a book delta against the touch it would change; 0 when sound.
+// A SET must carry a live level, and a SET of the best level may lock but
+// not cross the opposite touch (0 when that side is empty). A DELETE
+// carries no level; the store rejects one for a level it does not have.
+inline uint16_t check_book_delta(const BookDeltaMessage &delta, Price best_bid, Price best_ask) {
+  if (delta.action != DeltaAction::SET) {
+    return 0;
+  }
+  const uint64_t price = delta.level.price.raw();
+  uint16_t defects = 0;
+  if (price == 0) {
+    defects |= defect_bit(QuoteDefect::ZERO_PRICE);
+  }
+  if (delta.level.quantity == 0) {
+    defects |= defect_bit(QuoteDefect::ZERO_QUANTITY);
+  }
+  if (delta.level_index == 0 && price != 0) {
+    const bool crossed = delta.side == Side::BID ? best_ask.raw() != 0 && price > best_ask.raw()
+                                                 : price < best_bid.raw();
+    if (crossed) {
+      defects |= defect_bit(QuoteDefect::CROSSED);
+    }
+  }
+  return defects;
+}
+
+// Jump filter limits, as relative mid moves from the last good quote
+struct QuoteValidatorConfig {
+  double max_jump = 0.5;            // always a jump; the only limit while warming up
+  double jump_floor = 0.05;         // never a jump
+  double jump_multiple = 10.0;      // x the security's average move, between the two
+  double move_smoothing = 1.0 / 32; // weight of each move in that average
+  uint32_t warmup_quotes = 32;      // good quotes before the average is used
+  uint32_t reanchor_after = 16;     // jumps in a row after which the next is taken
+                                    // as the new level and warm-up restarts
+};
+
+// A snapshot or book delta kept out of the store, with its defect mask
+struct QuarantinedQuote {
+  types::MessageEnvelope<MarketDataL2Message, BookDeltaMessage> message;
+  uint16_t defects;
+};
+
+// Validation stage for L2 snapshots ahead of the store. Each message gets
+// check_book_levels() and, when sound and two-sided, a per-security jump
+// filter: its mid is compared with the last good mid against a limit
+// scaled from the security's exponentially averaged move (between
+// jump_floor and max_jump). Quotes with any defect are counted per defect
+// and pushed to a quarantine ring that any thread may drain; a full ring
+// drops them (counted). A clean quote costs the level checks, one
+// division and a few loads and stores of the security's 32-byte state.
+// Book deltas get check_book_delta() against the stored touch and share
+// the counters and ring; they do not feed the jump filter.
+//
+// validate() and reset() run on the consumer thread, indexed by the
+// store's slot (see ValidatingStoreSink); counters and the ring may be
+// read from any thread.
+template <typename Index = DynamicSecurityIndex> class QuoteValidator {
+public:
+  static constexpr size_t MAX_SECURITIES = Index::CAPACITY;
+  static constexpr size_t QUARANTINE_RING_SIZE = 256;
+
+  explicit QuoteValidator(const QuoteValidatorConfig &config = QuoteValidatorConfig{})
+      : config_(config), states_(std::make_unique<JumpState[]>(MAX_SECURITIES)) {}
+
+  QuoteValidator(const QuoteValidator &) = delete;
+  QuoteValidator &operator=(const QuoteValidator &) = delete;
+
+  // Consumer thread. Defect mask of message for the security in slot; 0
+  // means it may be applied.
+  uint16_t validate(size_t slot, const MarketDataL2Message &message) {
+    common::bump(validated_);
+    uint16_t defects = check_book_levels(message);
+    if (defects == 0) {
+      defects = check_jump(states_[slot], message);
+    }
+    if (defects != 0) {
+      quarantine(message, defects);
+    }
+    return defects;
+  }
+
+  // Consumer thread. Defect mask of delta given its security's current
+  // touch in the store; 0 means it may be applied.
+  uint16_t validate(const BookDeltaMessage &delta, Price best_bid, Price best_ask) {
+    common::bump(validated_);
+    const uint16_t defects = check_book_delta(delta, best_bid, best_ask);
+    if (defects != 0) {
+      quarantine(delta, defects);
+    }
+    return defects;
+  }
+
+  // Consumer thread. Forgets slot's history, e.g. when the security in it
+  // changes.
+  void reset(size_t slot) { states_[slot] = JumpState{}; }
+
+  bool pop_quarantined(QuarantinedQuote &quote) const { return quarantine_.try_pop(quote); }
+
+  uint64_t validated() const { return validated_.load(std::memory_order_relaxed); }
+  uint64_t rejected() const { return rejected_.load(std::memory_order_relaxed); }
+  uint64_t rejected(QuoteDefect defect) const {
+    return by_defect_[static_cast<size_t>(defect)].load(std::memory_order_relaxed);
+  }
+  uint64_t quarantine_dropped() const { return quarantine_dropped_.load(std::memory_order_relaxed); }
+  uint64_t reanchored() const { return reanchored_.load(std::memory_order_relaxed); }
+
+private:
+  struct JumpState {
+    double reference_mid{0}; // last good mid; 0 before the first
+    double average_move{0};  // EW average relative move
+    uint32_t good_quotes{0}; // since the reference was (re)set
+    uint32_t jumps_in_a_row{0};
+    uint64_t padding{0};
+  };
+  static_assert(sizeof(JumpState) == 32);
+
+  uint16_t check_jump(JumpState &state, const MarketDataL2Message &message) {
+    if (message.num_bid_levels == 0 || message.num_ask_levels == 0) {
+      return 0;
+    }
+    const double mid = (static_cast<double>(message.bids[0].price.raw()) +
+                        static_cast<double>(message.asks[0].price.raw())) * 0.5;
+    if (state.reference_mid == 0) {
+      state.reference_mid = mid;
+      return 0;
+    }
+    const double move = std::abs(mid - state.reference_mid) / state.reference_mid;
+    const double limit = state.good_quotes < config_.warmup_quotes
+                             ? config_.max_jump
+                             : std::clamp(config_.jump_multiple * state.average_move, config_.jump_floor,
+                                          config_.max_jump);
+    if (move > limit) {
+      if (state.jumps_in_a_row < config_.reanchor_after) {
+        ++state.jumps_in_a_row;
+        return defect_bit(QuoteDefect::PRICE_JUMP);
+      }
+      // Persistent: a new level rather than bad prints
+      state = JumpState{};
+      state.reference_mid = mid;
+      common::bump(reanchored_);
+      return 0;
+    }
+    state.average_move += (move - state.average_move) * config_.move_smoothing;
+    state.reference_mid = mid;
+    ++state.good_quotes;
+    state.jumps_in_a_row = 0;
+    return 0;
+  }
+
+  template <typename Message> void quarantine(const Message &message, uint16_t defects) {
+    common::bump(rejected_);
+    for (size_t i = 0; i < QUOTE_DEFECT_COUNT; ++i) {
+      if (defects & (1u << i)) {
+        common::bump(by_defect_[i]);
+      }
+    }
+    if (!quarantine_.try_push(QuarantinedQuote{message, defects})) {
+      common::bump(quarantine_dropped_);
+    }
+  }
+
+  const QuoteValidatorConfig config_;
+  std::unique_ptr<JumpState[]> states_;
+  mutable common::MpmcRing<QuarantinedQuote, QUARANTINE_RING_SIZE> quarantine_;
+  std::atomic<uint64_t> validated_{0};
+  std::atomic<uint64_t> rejected_{0};
+  std::array<std::atomic<uint64_t>, QUOTE_DEFECT_COUNT> by_defect_{};
+  std::atomic<uint64_t> quarantine_dropped_{0};
+  std::atomic<uint64_t> reanchored_{0};
+};
+
+// StoreSink that validates L2 snapshots and book deltas before applying
+// them. Rejected messages return false, so a FanoutSink around it never
+// passes them to its observers. The security's slot is looked up once, for
+// both the validator's state and the store update. Trades are applied
+// unchecked.
+template <typename Store, typename Validator = QuoteValidator<>> class ValidatingStoreSink {
+public:
+  static_assert(Validator::MAX_SECURITIES >= Store::MAX_SECURITIES,
+                "validator must have a state per store slot");
+
+  ValidatingStoreSink(std::shared_ptr<Store> store, std::shared_ptr<Validator> validator)
+      : store_(std::move(store)), validator_(std::move(validator)) {}
+
+  bool on_message(const MarketDataL2Message &message) {
+    const size_t slot = store_->slot_of(message.security_id);
+    if (slot == Store::NO_SLOT || validator_->validate(slot, message) != 0) {
+      return false;
+    }
+    store_->update_slot_from_l2(slot, message);
+    return true;
+  }
+  bool on_message(const TradeMessage &message) { return store_->apply_trade(message); }
+  bool on_message(const BookDeltaMessage &message) {
+    const size_t slot = store_->slot_of(message.security_id);
+    if (slot == Store::NO_SLOT) {
+      return false;
+    }
+    Price best_bid;
+    Price best_ask;
+    store_->touch_of_slot(slot, best_bid, best_ask);
+    if (validator_->validate(message, best_bid, best_ask) != 0) {
+      return false;
+    }
+    return store_->apply_book_delta(message);
+  }
+  void begin_batch() { store_->begin_batch(); }
+  void commit() { store_->commit(); }
+  bool add_security(const SecurityId &id) {
+    if (!store_->add_security(id)) {
+      return false;
+    }
+    validator_->reset(store_->slot_of(id));
+    return true;
+  }
+  bool remove_security(const SecurityId &id) { return store_->remove_security(id); }
+  bool contains(const SecurityId &id) const { return store_->contains(id); }
+
+  Store &store() const { return *store_; }
+  Validator &validator() const { return *validator_; }
+
+private:
+  std::shared_ptr<Store> store_;
+  std::shared_ptr<Validator> validator_;
+};
+
+} // namespace mini_mart::market_data
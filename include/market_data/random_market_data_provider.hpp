@@ -2,6 +2,7 @@
 
 #include "market_data_provider.hpp"
 #include "security_seeder.hpp"
+#include "symbol_table.hpp"
 #include <array>
 #include <atomic>
 #include <chrono>
@@ -13,10 +14,12 @@ namespace mini_mart::market_data {
 
 using namespace mini_mart::types;
 
-// Lock-free random market data provider for simulation and testing
-class RandomMarketDataProvider : public MarketDataProvider {
+// Lock-free random market data provider for simulation and testing. Index
+// selects slot lookup the same way as BasicSecurityStore.
+template <typename Index = DynamicSecurityIndex>
+class BasicRandomMarketDataProvider : public MarketDataProvider {
 public:
-  static constexpr size_t MAX_SECURITIES = 256;
+  static constexpr size_t MAX_SECURITIES = Index::CAPACITY;
 
   struct Config {
     double base_price;
@@ -30,18 +33,21 @@ public:
     uint32_t spike_probability;
     uint32_t spike_multiplier;
     uint32_t spike_duration_us;
+    // Heartbeat through the message callback this often; 0 for none
+    uint32_t heartbeat_interval_us;
 
     Config()
         : base_price(150.0), volatility(0.02), spread_bps(2.0),
           update_interval_us(10), max_quantity(1000), min_quantity(100),
           messages_per_burst(5), enable_activity_spikes(false),
-          spike_probability(5), spike_multiplier(10), spike_duration_us(1000) {}
+          spike_probability(5), spike_multiplier(10), spike_duration_us(1000),
+          heartbeat_interval_us(0) {}
   };
 
-  explicit RandomMarketDataProvider(const Config &config = Config())
+  explicit BasicRandomMarketDataProvider(const Config &config = Config())
       : config_(config) {}
 
-  ~RandomMarketDataProvider() override { stop(); }
+  ~BasicRandomMarketDataProvider() override { stop(); }
   bool start() override {
     if (running_.load()) {
       return false;
@@ -49,7 +55,7 @@ public:
 
     running_.store(true);
     market_data_thread_ =
-        std::thread(&RandomMarketDataProvider::market_data_thread, this);
+        std::thread(&BasicRandomMarketDataProvider::market_data_thread, this);
     return true;
   }
 
@@ -71,6 +77,17 @@ public:
       return false;
     }
 
+    if constexpr (Index::FIXED_SLOTS) {
+      const uint32_t index = Index::slot_of(security_id);
+      if (index == Index::NOT_FOUND) {
+        return false;
+      }
+      securities_[index].initialize(security_id,
+                                    get_security_base_price(security_id));
+      active_count_.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+
     for (size_t i = 0; i < MAX_SECURITIES; ++i) {
       SecuritySlot &slot = securities_[i];
       bool expected = false;
@@ -100,6 +117,10 @@ public:
     callback_ = std::move(callback);
   }
 
+  void set_message_callback(MarketDataMessageCallback callback) override {
+    message_callback_ = std::move(callback);
+  }
+
   std::vector<SecurityId> get_subscribed_securities() const override {
     std::vector<SecurityId> result;
     result.reserve(active_count_.load(std::memory_order_relaxed));
@@ -150,11 +171,19 @@ private:
   };
 
   double get_security_base_price(const SecurityId &security_id) const {
-    std::string symbol = SecuritySeeder::security_id_to_string(security_id);
-    return SecuritySeeder::get_base_price(symbol, config_.base_price);
+    return SecuritySeeder::get_base_price(security_id, config_.base_price);
   }
 
   SecuritySlot *find_security_slot(const SecurityId &security_id) const {
+    if constexpr (Index::FIXED_SLOTS) {
+      const uint32_t index = Index::slot_of(security_id);
+      if (index == Index::NOT_FOUND) {
+        return nullptr;
+      }
+      SecuritySlot &slot = const_cast<SecuritySlot &>(securities_[index]);
+      return slot.active.load(std::memory_order_acquire) ? &slot : nullptr;
+    }
+
     for (size_t i = 0; i < MAX_SECURITIES; ++i) {
       SecuritySlot &slot = const_cast<SecuritySlot &>(securities_[i]);
       if (slot.matches(security_id)) {
@@ -167,6 +196,7 @@ private:
   void market_data_thread() {
     static thread_local uint64_t spike_rng_state = 12345;
     auto spike_end_time = std::chrono::steady_clock::now();
+    auto next_heartbeat = spike_end_time;
     bool in_spike = false;
     
     while (running_.load()) {
@@ -193,6 +223,15 @@ private:
         }
       }
 
+      if (config_.heartbeat_interval_us > 0 && message_callback_ &&
+          start_time >= next_heartbeat) {
+        HeartbeatMessage heartbeat{};
+        heartbeat.header.length = sizeof(HeartbeatMessage);
+        heartbeat.header.type = static_cast<uint16_t>(MessageType::HEARTBEAT);
+        message_callback_(MarketDataEnvelope(heartbeat));
+        next_heartbeat = start_time + std::chrono::microseconds(config_.heartbeat_interval_us);
+      }
+
       // Generate messages with potential spike multiplier
       for (size_t i = 0; i < MAX_SECURITIES; ++i) {
         SecuritySlot &slot = securities_[i];
@@ -303,8 +342,11 @@ private:
   std::atomic<bool> running_{false};
   std::thread market_data_thread_;
   MarketDataCallback callback_;
+  MarketDataMessageCallback message_callback_;
   std::array<SecuritySlot, MAX_SECURITIES> securities_;
   std::atomic<size_t> active_count_{0};
 };
 
+using RandomMarketDataProvider = BasicRandomMarketDataProvider<>;
+
 } // namespace mini_mart::market_data
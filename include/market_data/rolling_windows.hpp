@@ -0,0 +1,146 @@
+#pragma once
+
+#include "common/rolling_window.hpp"
+#include "market_data/symbol_table.hpp"
+#include "types/messages.hpp"
+#include "types/price.hpp"
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace mini_mart::market_data {
+
+// One window's view of a security's mid
+struct RollingStats {
+  size_t samples;      // mids inside the window
+  Price low;
+  Price high;
+  double mean;         // dollars
+  double stddev;       // dollars, population
+  double realized_vol; // sqrt of the summed squared mid-to-mid returns, not annualized
+};
+
+// Rolling windows over each security's mid (e.g. 5-second high/low,
+// 1-minute realized vol), driven by the feed consumer through
+// a SharedObserver. Every security added gets preallocated min/max deques
+// and prefix-sum rings for mids and returns, each shared by all WINDOWS
+// lengths, so an update is O(WINDOWS) amortized and never allocates.
+//
+// Lookups by SecurityId follow the store's Index policy: a scan of the
+// dense keys, or StaticSecurityIndex's perfect hash. Callers that keep the
+// index from add_security() can update() directly. Consumer thread only;
+// updates() may be read from anywhere. On a feed with book deltas, attach
+// it through DeltaAsSnapshot so a change to the touch moves the mid.
+template <size_t WINDOWS = 2, size_t CAPACITY = 1024, typename Index = DynamicSecurityIndex>
+class RollingWindowEngine {
+public:
+  static constexpr size_t MAX_SECURITIES = Index::CAPACITY;
+  static constexpr size_t NOT_FOUND = DenseSecurityMap<Index>::NOT_FOUND;
+  // Returns are kept as int64 in units of 1e-8; exact for moves under
+  // ~$9M per tick
+  static constexpr int64_t RETURN_SCALE = 100000000;
+
+  explicit RollingWindowEngine(const std::array<uint64_t, WINDOWS> &lengths_ns) : lengths_(lengths_ns) {
+    series_.reserve(MAX_SECURITIES);
+  }
+
+  RollingWindowEngine(const RollingWindowEngine &) = delete;
+  RollingWindowEngine &operator=(const RollingWindowEngine &) = delete;
+
+  // Setup. Index of the security's windows, or NOT_FOUND if it is already
+  // added, the engine is full or a static index does not know it.
+  size_t add_security(const SecurityId &security_id) {
+    const size_t index = securities_.add(security_id);
+    if (index != NOT_FOUND) {
+      series_.emplace_back(lengths_);
+    }
+    return index;
+  }
+
+  size_t find(const SecurityId &security_id) const { return securities_.find(security_id); }
+
+  // Mid of the top of book; false for unknown securities and one-sided books
+  bool on_message(const MarketDataL2Message &message) {
+    const size_t index = find(message.security_id);
+    if (index == NOT_FOUND || message.num_bid_levels == 0 || message.num_ask_levels == 0) {
+      return false;
+    }
+    const uint64_t mid = (message.bids[0].price.raw() + message.asks[0].price.raw()) / 2;
+    update(index, Price{mid}, message.timestamp_ns);
+    return true;
+  }
+
+  void update(size_t index, Price mid, uint64_t timestamp_ns) {
+    Series &series = series_[index];
+    const auto value = static_cast<int64_t>(mid.raw());
+    series.low.push(timestamp_ns, mid.raw());
+    series.high.push(timestamp_ns, mid.raw());
+    series.mids.push(timestamp_ns, value);
+    if (series.last_mid != 0) {
+      series.returns.push(timestamp_ns, (value - series.last_mid) * RETURN_SCALE / series.last_mid);
+    } else {
+      series.returns.expire(timestamp_ns);
+    }
+    series.last_mid = value;
+    updates_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Ages a security's windows to now_ns; a quiet security's windows
+  // otherwise end at its last update
+  void expire(size_t index, uint64_t now_ns) {
+    Series &series = series_[index];
+    series.low.expire(now_ns);
+    series.high.expire(now_ns);
+    series.mids.expire(now_ns);
+    series.returns.expire(now_ns);
+  }
+
+  RollingStats stats(size_t index, size_t window) const {
+    const Series &series = series_[index];
+    RollingStats stats{};
+    stats.samples = series.mids.count(window);
+    stats.low = Price{series.low.value(window)};
+    stats.high = Price{series.high.value(window)};
+    stats.mean = series.mids.mean(window) / static_cast<double>(Price::ONE);
+    stats.stddev = std::sqrt(series.mids.variance(window)) / static_cast<double>(Price::ONE);
+    stats.realized_vol =
+        std::sqrt(static_cast<double>(series.returns.sum_squares(window))) / static_cast<double>(RETURN_SCALE);
+    return stats;
+  }
+
+  size_t security_count() const { return series_.size(); }
+  uint64_t length_ns(size_t window) const { return lengths_[window]; }
+  uint64_t updates() const { return updates_.load(std::memory_order_relaxed); }
+
+  // Samples dropped before leaving their window because CAPACITY was too
+  // small for the update rate (consumer thread)
+  uint64_t truncated() const {
+    uint64_t total = 0;
+    for (const Series &series : series_) {
+      total += series.mids.truncated();
+    }
+    return total;
+  }
+
+private:
+  struct Series {
+    explicit Series(const std::array<uint64_t, WINDOWS> &lengths_ns)
+        : low(lengths_ns), high(lengths_ns), mids(lengths_ns), returns(lengths_ns) {}
+
+    common::RollingMin<uint64_t, CAPACITY, WINDOWS> low;
+    common::RollingMax<uint64_t, CAPACITY, WINDOWS> high;
+    common::RollingMoments<CAPACITY, WINDOWS> mids;    // Price raw
+    common::RollingMoments<CAPACITY, WINDOWS> returns; // RETURN_SCALE units
+    int64_t last_mid{0};
+  };
+
+  const std::array<uint64_t, WINDOWS> lengths_;
+  DenseSecurityMap<Index> securities_;
+  std::vector<Series> series_; // reserved up front, never reallocated
+  std::atomic<uint64_t> updates_{0};
+};
+
+} // namespace mini_mart::market_data
@@ -1,9 +1,11 @@
 #pragma once
 
+#include "market_data/symbol_table.hpp"
 #include "types/messages.hpp"
 #include <algorithm>
 #include <cstring>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -25,35 +27,77 @@ public:
     double base_price;
   };
 
+  struct EquityEntry {
+    std::string_view symbol;
+    std::string_view name;
+    double base_price;
+  };
+
+  static constexpr std::array<EquityEntry, 20> MAJOR_US_EQUITIES = {{
+      {"AAPL", "Apple Inc.", 175.0},
+      {"MSFT", "Microsoft Corporation", 350.0},
+      {"GOOGL", "Alphabet Inc.", 2800.0},
+      {"AMZN", "Amazon.com Inc.", 3200.0},
+      {"TSLA", "Tesla Inc.", 250.0},
+      {"META", "Meta Platforms Inc.", 320.0},
+      {"NVDA", "NVIDIA Corporation", 450.0},
+      {"JPM", "JPMorgan Chase & Co.", 145.0},
+      {"JNJ", "Johnson & Johnson", 165.0},
+      {"V", "Visa Inc.", 240.0},
+      {"PG", "Procter & Gamble Co.", 140.0},
+      {"UNH", "UnitedHealth Group Inc.", 520.0},
+      {"HD", "Home Depot Inc.", 330.0},
+      {"MA", "Mastercard Inc.", 380.0},
+      {"BAC", "Bank of America Corp.", 32.0},
+      {"XOM", "Exxon Mobil Corporation", 110.0},
+      {"DIS", "Walt Disney Co.", 95.0},
+      {"ADBE", "Adobe Inc.", 480.0},
+      {"CRM", "Salesforce Inc.", 220.0},
+      {"NFLX", "Netflix Inc.", 450.0}}};
+
+  /**
+   * @brief Perfect-hash table over MAJOR_US_EQUITIES (index = array index)
+   */
+  static constexpr auto EQUITY_SYMBOLS = [] {
+    std::array<std::string_view, MAJOR_US_EQUITIES.size()> symbols{};
+    for (size_t i = 0; i < symbols.size(); ++i) {
+      symbols[i] = MAJOR_US_EQUITIES[i].symbol;
+    }
+    return StaticSymbolTable<MAJOR_US_EQUITIES.size()>(symbols);
+  }();
+  static_assert(EQUITY_SYMBOLS.valid(), "equity symbols need a perfect hash");
+
   /**
    * @brief Get centralized equity information
    * @return Map of symbol to equity information
    */
   static const std::unordered_map<std::string, EquityInfo> &get_equity_info() {
-    static const std::unordered_map<std::string, EquityInfo> equity_data = {
-        {"AAPL", {"AAPL", "Apple Inc.", 175.0}},
-        {"MSFT", {"MSFT", "Microsoft Corporation", 350.0}},
-        {"GOOGL", {"GOOGL", "Alphabet Inc.", 2800.0}},
-        {"AMZN", {"AMZN", "Amazon.com Inc.", 3200.0}},
-        {"TSLA", {"TSLA", "Tesla Inc.", 250.0}},
-        {"META", {"META", "Meta Platforms Inc.", 320.0}},
-        {"NVDA", {"NVDA", "NVIDIA Corporation", 450.0}},
-        {"JPM", {"JPM", "JPMorgan Chase & Co.", 145.0}},
-        {"JNJ", {"JNJ", "Johnson & Johnson", 165.0}},
-        {"V", {"V", "Visa Inc.", 240.0}},
-        {"PG", {"PG", "Procter & Gamble Co.", 140.0}},
-        {"UNH", {"UNH", "UnitedHealth Group Inc.", 520.0}},
-        {"HD", {"HD", "Home Depot Inc.", 330.0}},
-        {"MA", {"MA", "Mastercard Inc.", 380.0}},
-        {"BAC", {"BAC", "Bank of America Corp.", 32.0}},
-        {"XOM", {"XOM", "Exxon Mobil Corporation", 110.0}},
-        {"DIS", {"DIS", "Walt Disney Co.", 95.0}},
-        {"ADBE", {"ADBE", "Adobe Inc.", 480.0}},
-        {"CRM", {"CRM", "Salesforce Inc.", 220.0}},
-        {"NFLX", {"NFLX", "Netflix Inc.", 450.0}}};
+    static const std::unordered_map<std::string, EquityInfo> equity_data = [] {
+      std::unordered_map<std::string, EquityInfo> data;
+      for (const EquityEntry &entry : MAJOR_US_EQUITIES) {
+        data.emplace(std::string(entry.symbol),
+                     EquityInfo{std::string(entry.symbol),
+                                std::string(entry.name), entry.base_price});
+      }
+      return data;
+    }();
     return equity_data;
   }
 
+  /**
+   * @brief Get base price for a security without building a string
+   * @param security_id The security
+   * @param default_price Default price if the security is not a known equity
+   * @return Base price for the security
+   */
+  static double get_base_price(const SecurityId &security_id,
+                               double default_price = 150.0) {
+    const uint32_t index = EQUITY_SYMBOLS.find(security_id);
+    return index != EQUITY_SYMBOLS.NOT_FOUND
+               ? MAJOR_US_EQUITIES[index].base_price
+               : default_price;
+  }
+
   /**
    * @brief Get base price for a security symbol
    * @param symbol The security symbol
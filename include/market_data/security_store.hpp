@@ -1,23 +1,60 @@
 #pragma once
 
+#include "common/futex.hpp"
+#include "market_data/symbol_table.hpp"
 #include "types/messages.hpp"
+#include <algorithm>
 #include <array>
+#include <bit>
 #include <atomic>
 #include <chrono>
 #include <cstring>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 namespace mini_mart::market_data {
 
 using namespace mini_mart::types;
 
-// Lock-free security store for single producer, multiple readers
-class SecurityStore {
+// Lock-free security store for single producer, multiple readers. Index
+// selects how securities map to slots: DynamicSecurityIndex scans up to 256
+// slots, StaticSecurityIndex<TABLE> perfect-hashes a compile-time universe.
+// Slot identity (keys_) is kept apart from the book data the consumer
+// writes, so updates never invalidate the lines lookups scan.
+//
+// Every write belongs to a commit: a single update commits on its own, or
+// the consumer groups updates with begin_batch()/commit(). Each security
+// records the commit that last wrote it, which lets get_consistent_snapshots
+// read several securities as of exactly one commit without a global lock.
+//
+// HISTORY_DEPTH > 0 additionally keeps, per security, a ring of the last
+// HISTORY_DEPTH book versions (top HISTORY_LEVELS levels), sized at compile
+// time and read lock-free with get_history_since.
+//
+// Readers that are not latency critical can sleep instead of polling: a
+// wait group names up to MAX_WAIT_SECURITIES securities and
+// wait_for_update blocks on a futex until one of them is committed. The
+// consumer only ORs each slot's registered groups into a pending mask, so
+// with no waiters an update costs one load from a line it already owns.
+template <typename Index = DynamicSecurityIndex, size_t HISTORY_DEPTH = 0>
+class BasicSecurityStore {
 public:
-  static constexpr size_t MAX_SECURITIES = 256;
-
+  static constexpr size_t MAX_SECURITIES = Index::CAPACITY;
+  static constexpr size_t HISTORY_LEVELS = 3;
+  static_assert((HISTORY_DEPTH & (HISTORY_DEPTH - 1)) == 0,
+                "HISTORY_DEPTH must be zero or a power of 2");
+  static constexpr size_t WAIT_GROUPS = 64;
+  static constexpr size_t MAX_WAIT_SECURITIES = 16;
+  static constexpr size_t NO_WAIT_GROUP = WAIT_GROUPS;
+  static constexpr size_t NO_SLOT = MAX_SECURITIES;
+
+  // Mutable book state of one slot; its identity lives in keys_
   struct alignas(64) SecurityData {
-    std::atomic<bool> active{false};
-    SecurityId security_id{};
+    // Seqlock: odd while the consumer is writing the fields below
+    std::atomic<uint64_t> sequence{0};
+    // Set for state restored from a checkpoint until the first live update
+    std::atomic<bool> stale{false};
     std::atomic<Price> best_bid{Price{0.0}};
     std::atomic<Price> best_ask{Price{0.0}};
     std::atomic<Price> last_trade_price{Price{0.0}};
@@ -32,11 +69,14 @@ public:
     OrderBookSide asks;
     std::atomic<uint64_t> update_count{0};
     std::atomic<uint64_t> total_volume{0};
+    // Commit that last wrote this slot (0: none since it was claimed)
+    std::atomic<uint64_t> commit_sequence{0};
+    // Bit per wait group watching this slot
+    std::atomic<uint64_t> wait_groups{0};
 
     SecurityData() = default;
 
-    void initialize(const SecurityId &id) {
-      security_id = id;
+    void reset() {
       best_bid.store(Price{0.0}, std::memory_order_relaxed);
       best_ask.store(Price{0.0}, std::memory_order_relaxed);
       last_trade_price.store(Price{0.0}, std::memory_order_relaxed);
@@ -45,13 +85,9 @@ public:
       total_volume.store(0, std::memory_order_relaxed);
       bids.num_levels.store(0, std::memory_order_relaxed);
       asks.num_levels.store(0, std::memory_order_relaxed);
-      active.store(true, std::memory_order_release);
-    }
-
-    void deactivate() { active.store(false, std::memory_order_release); }
-
-    bool matches(const SecurityId &id) const {
-      return active.load(std::memory_order_acquire) && (security_id == id);
+      stale.store(false, std::memory_order_relaxed);
+      commit_sequence.store(0, std::memory_order_relaxed);
+      wait_groups.store(0, std::memory_order_relaxed);
     }
 
     SecurityData(const SecurityData &) = delete;
@@ -72,6 +108,8 @@ public:
     PriceLevel asks[5];
     uint64_t update_count;
     uint64_t total_volume;
+    bool stale; // last-known state from a checkpoint, not yet refreshed
+    uint64_t commit_sequence; // commit that last wrote this security
 
     SecuritySnapshot() = default;
 
@@ -98,25 +136,60 @@ public:
     }
   };
 
-  SecurityStore() = default;
-  ~SecurityStore() = default;
+  // Compact book state recorded in the history on every write
+  struct BookVersion {
+    uint64_t version; // per-security write number, starting at 1
+    uint64_t timestamp_ns;
+    uint8_t num_bid_levels;
+    uint8_t num_ask_levels;
+    bool stale; // written by restore_security
+    PriceLevel bids[HISTORY_LEVELS];
+    PriceLevel asks[HISTORY_LEVELS];
+  };
+
+  // Versions newer than the requested one, oldest first
+  struct HistoryRange {
+    std::array<BookVersion, HISTORY_DEPTH> versions;
+    size_t count;
+    uint64_t latest_version;
+    // Some requested versions were already overwritten (or were being
+    // overwritten while read) and are missing from versions
+    bool missed_versions;
+  };
+
+  BasicSecurityStore() = default;
+  ~BasicSecurityStore() = default;
+
+  BasicSecurityStore(const BasicSecurityStore &) = delete;
+  BasicSecurityStore &operator=(const BasicSecurityStore &) = delete;
+  BasicSecurityStore(BasicSecurityStore &&) = delete;
+  BasicSecurityStore &operator=(BasicSecurityStore &&) = delete;
+
+  enum class ConsistentRead : uint8_t {
+    SUCCESS = 0,
+    UNKNOWN_SECURITY = 1,
+    RETRIES_EXHAUSTED = 2 // the securities kept changing; try again later
+  };
+
+  enum class WaitResult : uint8_t { UPDATED = 0, TIMED_OUT = 1, INTERRUPTED = 2 };
 
-  SecurityStore(const SecurityStore &) = delete;
-  SecurityStore &operator=(const SecurityStore &) = delete;
-  SecurityStore(SecurityStore &&) = delete;
-  SecurityStore &operator=(SecurityStore &&) = delete;
   bool add_security(const SecurityId &security_id) {
-    if (find_security_data(security_id) != nullptr) {
+    const uint64_t key = symbol_key(security_id);
+    if (key == FREE_KEY || key == CLAIMED_KEY ||
+        find_slot(security_id) != NO_SLOT) {
       return false;
     }
 
+    if constexpr (Index::FIXED_SLOTS) {
+      const uint32_t slot = Index::slot_of(security_id);
+      if (slot == Index::NOT_FOUND) {
+        return false;
+      }
+      return claim_slot(slot, key);
+    }
+
     for (size_t i = 0; i < MAX_SECURITIES; ++i) {
-      SecurityData &slot = securities[i];
-      bool expected = false;
-      if (slot.active.compare_exchange_strong(expected, false,
-                                              std::memory_order_acquire)) {
-        slot.initialize(security_id);
-        active_count.fetch_add(1, std::memory_order_relaxed);
+      if (claim_slot(i, key)) {
         return true;
       }
     }
@@ -125,22 +198,52 @@ public:
   }
 
   bool remove_security(const SecurityId &security_id) {
-    SecurityData *data = find_security_data(security_id);
-    if (!data) {
+    const size_t slot = find_slot(security_id);
+    if (slot == NO_SLOT) {
       return false;
     }
 
-    data->deactivate();
+    keys_[slot].store(FREE_KEY, std::memory_order_release);
     active_count.fetch_sub(1, std::memory_order_relaxed);
     return true;
   }
 
   bool update_from_l2(const MarketDataL2Message &message) {
-    SecurityData *data = find_security_data(message.security_id);
-    if (!data) {
+    const size_t slot = find_slot(message.security_id);
+    if (slot == NO_SLOT) {
       return false;
     }
+    update_slot_from_l2(slot, message);
+    return true;
+  }
+
+  // Dense slot of a security, stable until it is removed, or NO_SLOT. Lets
+  // per-security side tables be plain arrays indexed like the store.
+  size_t slot_of(const SecurityId &security_id) const { return find_slot(security_id); }
+
+  // Best bid and ask of the security in slot (from slot_of), read together
+  // under its seqlock; Price 0 for an empty side
+  void touch_of_slot(size_t slot, Price &best_bid, Price &best_ask) const {
+    const SecurityData &data = securities[slot];
+    for (;;) {
+      const uint64_t seq_before = data.sequence.load(std::memory_order_acquire);
+      if (seq_before & 1) {
+        continue;
+      }
+      best_bid = data.best_bid.load(std::memory_order_relaxed);
+      best_ask = data.best_ask.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (data.sequence.load(std::memory_order_relaxed) == seq_before) {
+        return;
+      }
+    }
+  }
 
+  // update_from_l2 for a caller that already holds the slot (from slot_of);
+  // message.security_id is not looked up again
+  void update_slot_from_l2(size_t slot, const MarketDataL2Message &message) {
+    SecurityData *data = &securities[slot];
+    begin_write(*data);
     data->last_update_ns.store(message.timestamp_ns, std::memory_order_release);
 
     if (message.num_bid_levels > 0) {
@@ -155,10 +258,135 @@ public:
     update_order_book_side(data->asks, message.asks.data(),
                            message.num_ask_levels);
     data->update_count.fetch_add(1, std::memory_order_relaxed);
+    data->stale.store(false, std::memory_order_relaxed);
+    data->commit_sequence.store(pending_commit_, std::memory_order_relaxed);
+    end_write(*data);
+    record_history(*data, message.timestamp_ns, message.bids.data(),
+                   message.num_bid_levels, message.asks.data(), message.num_ask_levels,
+                   false);
+    written(*data);
+  }
+
+  // Last sale: price and cumulative volume; the book is untouched
+  bool apply_trade(const TradeMessage &trade) {
+    SecurityData *data = find_security_data(trade.security_id);
+    if (!data) {
+      return false;
+    }
+
+    begin_write(*data);
+    data->last_update_ns.store(trade.timestamp_ns, std::memory_order_relaxed);
+    data->last_trade_price.store(trade.price, std::memory_order_relaxed);
+    data->total_volume.fetch_add(trade.quantity, std::memory_order_relaxed);
+    data->update_count.fetch_add(1, std::memory_order_relaxed);
+    data->stale.store(false, std::memory_order_relaxed);
+    data->commit_sequence.store(pending_commit_, std::memory_order_relaxed);
+    end_write(*data);
+    written(*data);
 
     return true;
   }
 
+  // Sets or deletes one of the top 5 levels of a side. Levels stay
+  // contiguous: a SET may replace a level or append the next one, not
+  // leave a gap. A DELETE of a level the side does not have is rejected.
+  bool apply_book_delta(const BookDeltaMessage &delta) {
+    if (delta.level_index >= 5) {
+      return false;
+    }
+    SecurityData *data = find_security_data(delta.security_id);
+    if (!data) {
+      return false;
+    }
+
+    const bool bid = delta.side == Side::BID;
+    auto &side = bid ? data->bids : data->asks;
+    uint8_t num_levels = side.num_levels.load(std::memory_order_relaxed);
+    if (delta.action == DeltaAction::SET ? delta.level_index > num_levels
+                                         : delta.level_index >= num_levels) {
+      return false;
+    }
+    begin_write(*data);
+    data->last_update_ns.store(delta.timestamp_ns, std::memory_order_relaxed);
+    if (delta.action == DeltaAction::SET) {
+      side.levels[delta.level_index] = delta.level;
+      num_levels = std::max(num_levels, static_cast<uint8_t>(delta.level_index + 1));
+    } else {
+      for (uint8_t i = delta.level_index; i + 1 < num_levels; ++i) {
+        side.levels[i] = side.levels[i + 1];
+      }
+      side.levels[--num_levels] = PriceLevel{};
+    }
+    side.num_levels.store(num_levels, std::memory_order_relaxed);
+    (bid ? data->best_bid : data->best_ask)
+        .store(num_levels > 0 ? side.levels[0].price : Price{0.0}, std::memory_order_relaxed);
+    data->update_count.fetch_add(1, std::memory_order_relaxed);
+    data->stale.store(false, std::memory_order_relaxed);
+    data->commit_sequence.store(pending_commit_, std::memory_order_relaxed);
+    end_write(*data);
+    record_history(*data, delta.timestamp_ns, data->bids.levels,
+                   data->bids.num_levels.load(std::memory_order_relaxed), data->asks.levels,
+                   data->asks.num_levels.load(std::memory_order_relaxed), false);
+    written(*data);
+
+    return true;
+  }
+
+  // Installs last-known state (e.g. from a checkpoint) for a security,
+  // adding it if needed. The security reads as stale until its next update.
+  bool restore_security(const SecuritySnapshot &snapshot) {
+    SecurityData *data = find_security_data(snapshot.security_id);
+    if (!data) {
+      if (!add_security(snapshot.security_id)) {
+        return false;
+      }
+      data = find_security_data(snapshot.security_id);
+      if (!data) {
+        return false;
+      }
+    }
+
+    begin_write(*data);
+    data->last_update_ns.store(snapshot.last_update_ns,
+                               std::memory_order_relaxed);
+    data->best_bid.store(snapshot.best_bid, std::memory_order_relaxed);
+    data->best_ask.store(snapshot.best_ask, std::memory_order_relaxed);
+    data->last_trade_price.store(snapshot.last_trade_price,
+                                 std::memory_order_relaxed);
+    data->update_count.store(snapshot.update_count, std::memory_order_relaxed);
+    data->total_volume.store(snapshot.total_volume, std::memory_order_relaxed);
+    update_order_book_side(data->bids, snapshot.bids, snapshot.num_bid_levels);
+    update_order_book_side(data->asks, snapshot.asks, snapshot.num_ask_levels);
+    data->stale.store(true, std::memory_order_relaxed);
+    data->commit_sequence.store(pending_commit_, std::memory_order_relaxed);
+    end_write(*data);
+    record_history(*data, snapshot.last_update_ns, snapshot.bids, snapshot.num_bid_levels,
+                   snapshot.asks, snapshot.num_ask_levels, true);
+    written(*data);
+
+    return true;
+  }
+
+  // Writer only. Updates until the next commit() become visible to
+  // get_consistent_snapshots together, as one commit.
+  void begin_batch() { batch_open_ = true; }
+
+  // Writer only. Publishes the open batch, if it wrote anything, and returns
+  // the latest commit sequence.
+  uint64_t commit() {
+    batch_open_ = false;
+    if (batch_dirty_) {
+      batch_dirty_ = false;
+      publish_commit();
+    }
+    return committed_.load(std::memory_order_relaxed);
+  }
+
+  // Latest fully applied commit; 0 before the first write
+  uint64_t committed_sequence() const {
+    return committed_.load(std::memory_order_acquire);
+  }
+
   bool get_security_snapshot(const SecurityId &security_id,
                              SecuritySnapshot &snapshot) const {
     const SecurityData *data = find_security_data(security_id);
@@ -166,35 +394,200 @@ public:
       return false;
     }
 
-    snapshot.security_id = data->security_id;
-    snapshot.last_update_ns =
-        data->last_update_ns.load(std::memory_order_acquire);
-    snapshot.best_bid = data->best_bid.load(std::memory_order_relaxed);
-    snapshot.best_ask = data->best_ask.load(std::memory_order_relaxed);
-    snapshot.last_trade_price =
-        data->last_trade_price.load(std::memory_order_relaxed);
-    snapshot.update_count = data->update_count.load(std::memory_order_relaxed);
-    snapshot.total_volume = data->total_volume.load(std::memory_order_relaxed);
+    snapshot.security_id = security_id;
+    read_consistent(*data, snapshot);
+    return true;
+  }
 
-    snapshot.num_bid_levels =
-        data->bids.num_levels.load(std::memory_order_relaxed);
-    snapshot.num_ask_levels =
-        data->asks.num_levels.load(std::memory_order_relaxed);
+  // Snapshots of count securities all as of the same commit, reported in
+  // commit_out. Never blocks the writer: a security written after the
+  // commit was sampled restarts the read, up to max_attempts times.
+  ConsistentRead get_consistent_snapshots(const SecurityId *security_ids, size_t count,
+                                          SecuritySnapshot *snapshots,
+                                          uint64_t *commit_out = nullptr,
+                                          uint32_t max_attempts = 64) const {
+    for (uint32_t attempt = 0; attempt < max_attempts; ++attempt) {
+      const uint64_t commit = committed_.load(std::memory_order_acquire);
+      size_t i = 0;
+      for (; i < count; ++i) {
+        const SecurityData *data = find_security_data(security_ids[i]);
+        if (!data) {
+          return ConsistentRead::UNKNOWN_SECURITY;
+        }
+        read_consistent(*data, snapshots[i]);
+        if (snapshots[i].commit_sequence > commit) {
+          break;
+        }
+        snapshots[i].security_id = security_ids[i];
+      }
+      if (i == count) {
+        if (commit_out) {
+          *commit_out = commit;
+        }
+        return ConsistentRead::SUCCESS;
+      }
+    }
+    return ConsistentRead::RETRIES_EXHAUSTED;
+  }
 
-    std::memcpy(snapshot.bids, data->bids.levels, sizeof(PriceLevel) * 5);
-    std::memcpy(snapshot.asks, data->asks.levels, sizeof(PriceLevel) * 5);
+  // Book versions of a security written after since_version (0: all that
+  // are retained). Lock-free; a version the writer overwrites mid-read is
+  // reported through missed_versions rather than retried.
+  bool get_history_since(const SecurityId &security_id, uint64_t since_version,
+                         HistoryRange &range) const
+    requires(HISTORY_DEPTH > 0)
+  {
+    range.count = 0;
+    range.missed_versions = false;
+    const size_t slot = find_slot(security_id);
+    if (slot == NO_SLOT) {
+      range.latest_version = 0;
+      return false;
+    }
+
+    const SymbolHistory &history = history_[slot];
+    const uint64_t latest = history.latest.load(std::memory_order_acquire);
+    range.latest_version = latest;
+    uint64_t first = since_version + 1;
+    if (latest >= HISTORY_DEPTH && first <= latest - HISTORY_DEPTH) {
+      range.missed_versions = true;
+      first = latest - HISTORY_DEPTH + 1;
+    }
 
+    for (uint64_t version = first; version <= latest; ++version) {
+      const HistoryEntry &entry = history.entries[version & (HISTORY_DEPTH - 1)];
+      BookVersion &out = range.versions[range.count];
+      if (entry.version.load(std::memory_order_acquire) == version) {
+        std::memcpy(&out, &entry.book, sizeof(BookVersion));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (entry.version.load(std::memory_order_relaxed) == version) {
+          ++range.count;
+          continue;
+        }
+      }
+      range.missed_versions = true;
+    }
     return true;
   }
 
+  // Latest version recorded in a security's history (0: none)
+  uint64_t history_version(const SecurityId &security_id) const
+    requires(HISTORY_DEPTH > 0)
+  {
+    const size_t slot = find_slot(security_id);
+    return slot == NO_SLOT ? 0 : history_[slot].latest.load(std::memory_order_acquire);
+  }
+
+  // Opens a wait group on count (<= MAX_WAIT_SECURITIES) securities.
+  // Returns NO_WAIT_GROUP if one is unknown or all groups are in use. A
+  // group must be waited on by one thread at a time.
+  size_t open_wait_group(const SecurityId *security_ids, size_t count) {
+    if (count == 0 || count > MAX_WAIT_SECURITIES) {
+      return NO_WAIT_GROUP;
+    }
+    std::array<size_t, MAX_WAIT_SECURITIES> slots;
+    for (size_t i = 0; i < count; ++i) {
+      slots[i] = find_slot(security_ids[i]);
+      if (slots[i] == NO_SLOT) {
+        return NO_WAIT_GROUP;
+      }
+    }
+
+    for (size_t index = 0; index < WAIT_GROUPS; ++index) {
+      WaitGroup &group = wait_groups_[index];
+      bool expected = false;
+      if (!group.in_use.compare_exchange_strong(expected, true,
+                                                std::memory_order_acquire)) {
+        continue;
+      }
+      group.count = count;
+      for (size_t i = 0; i < count; ++i) {
+        group.slots[i] = slots[i];
+        group.keys[i] = symbol_key(security_ids[i]);
+        securities[slots[i]].wait_groups.fetch_or(uint64_t{1} << index,
+                                                  std::memory_order_seq_cst);
+      }
+      // After this the consumer either sees the group bit or its earlier
+      // writes are visible to the first wait_for_update check. Such a write
+      // may still sit in an open batch; the waiter spins until it commits,
+      // since that commit will not wake the group.
+      common::heavy_barrier();
+      return index;
+    }
+    return NO_WAIT_GROUP;
+  }
+
+  void close_wait_group(size_t index) {
+    if (index >= WAIT_GROUPS) {
+      return;
+    }
+    WaitGroup &group = wait_groups_[index];
+    for (size_t i = 0; i < group.count; ++i) {
+      securities[group.slots[i]].wait_groups.fetch_and(~(uint64_t{1} << index),
+                                                       std::memory_order_relaxed);
+    }
+    group.count = 0;
+    group.in_use.store(false, std::memory_order_release);
+  }
+
+  // Blocks until a security of the group is written by a commit after
+  // since_commit (start from committed_sequence()), then advances
+  // since_commit to the commit that was observed.
+  WaitResult wait_for_update(size_t index, uint64_t &since_commit,
+                             std::chrono::nanoseconds timeout) const {
+    const WaitGroup &group = wait_groups_[index];
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    for (;;) {
+      const uint32_t sequence = group.sequence.load(std::memory_order_acquire);
+      const uint64_t commit = committed_.load(std::memory_order_acquire);
+      const GroupState state = group_state(group, since_commit, commit);
+      if (state == GroupState::UPDATED) {
+        since_commit = commit;
+        return WaitResult::UPDATED;
+      }
+
+      const auto now = std::chrono::steady_clock::now();
+      if (now >= deadline) {
+        return WaitResult::TIMED_OUT;
+      }
+      if (state == GroupState::PENDING) {
+        std::this_thread::yield();
+        continue;
+      }
+      group.sleepers.fetch_add(1, std::memory_order_seq_cst);
+      const int result = common::futex_wait(
+          group.sequence, sequence,
+          static_cast<uint64_t>(
+              std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now).count()));
+      group.sleepers.fetch_sub(1, std::memory_order_relaxed);
+      if (result == -EINTR) {
+        return WaitResult::INTERRUPTED;
+      }
+    }
+  }
+
+  // Consistent per-symbol snapshot of every active security. Never blocks
+  // the consumer: each read retries only while that one slot is mid-update.
+  template <typename Fn> void for_each_snapshot(Fn &&fn) const {
+    SecuritySnapshot snapshot;
+    for (size_t i = 0; i < MAX_SECURITIES; ++i) {
+      const uint64_t key = keys_[i].load(std::memory_order_acquire);
+      if (key != FREE_KEY && key != CLAIMED_KEY) {
+        snapshot.security_id = std::bit_cast<SecurityId>(key);
+        read_consistent(securities[i], snapshot);
+        fn(snapshot);
+      }
+    }
+  }
+
   std::vector<SecurityId> get_all_securities() const {
     std::vector<SecurityId> result;
     result.reserve(active_count.load(std::memory_order_relaxed));
 
     for (size_t i = 0; i < MAX_SECURITIES; ++i) {
-      const SecurityData &slot = securities[i];
-      if (slot.active.load(std::memory_order_acquire)) {
-        result.push_back(slot.security_id);
+      const uint64_t key = keys_[i].load(std::memory_order_acquire);
+      if (key != FREE_KEY && key != CLAIMED_KEY) {
+        result.push_back(std::bit_cast<SecurityId>(key));
       }
     }
 
@@ -209,20 +602,204 @@ public:
 
   void clear() {
     for (size_t i = 0; i < MAX_SECURITIES; ++i) {
-      securities[i].deactivate();
+      keys_[i].store(FREE_KEY, std::memory_order_release);
     }
     active_count.store(0, std::memory_order_relaxed);
   }
 
 private:
-  SecurityData *find_security_data(const SecurityId &security_id) const {
+  static constexpr uint64_t FREE_KEY = 0;             // the empty symbol
+  static constexpr uint64_t CLAIMED_KEY = UINT64_MAX; // add_security in progress
+
+  struct alignas(64) WaitGroup {
+    mutable std::atomic<uint32_t> sequence{0}; // futex word, bumped per commit
+    mutable std::atomic<uint32_t> sleepers{0};
+    std::atomic<bool> in_use{false};
+    size_t count = 0; // owner only, like slots and keys
+    std::array<size_t, MAX_WAIT_SECURITIES> slots{};
+    std::array<uint64_t, MAX_WAIT_SECURITIES> keys{};
+  };
+
+  size_t find_slot(const SecurityId &security_id) const {
+    const uint64_t key = symbol_key(security_id);
+    if constexpr (Index::FIXED_SLOTS) {
+      const uint32_t slot = Index::slot_of(security_id);
+      if (slot == Index::NOT_FOUND) {
+        return NO_SLOT;
+      }
+      return keys_[slot].load(std::memory_order_acquire) == key ? slot : NO_SLOT;
+    }
+
     for (size_t i = 0; i < MAX_SECURITIES; ++i) {
-      SecurityData &slot = const_cast<SecurityData &>(securities[i]);
-      if (slot.matches(security_id)) {
-        return &slot;
+      if (keys_[i].load(std::memory_order_acquire) == key) {
+        return i;
       }
     }
-    return nullptr;
+    return NO_SLOT;
+  }
+
+  SecurityData *find_security_data(const SecurityId &security_id) const {
+    const size_t slot = find_slot(security_id);
+    if (slot == NO_SLOT) {
+      return nullptr;
+    }
+    return const_cast<SecurityData *>(&securities[slot]);
+  }
+
+  // Book data is reset before the key is published, so a reader that
+  // finds the key never sees the previous occupant's book
+  bool claim_slot(size_t slot, uint64_t key) {
+    uint64_t expected = FREE_KEY;
+    if (!keys_[slot].compare_exchange_strong(expected, CLAIMED_KEY,
+                                             std::memory_order_acquire)) {
+      return false;
+    }
+    securities[slot].reset();
+    if constexpr (HISTORY_DEPTH > 0) {
+      history_[slot].latest.store(0, std::memory_order_relaxed);
+    }
+    keys_[slot].store(key, std::memory_order_release);
+    active_count.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  void written(const SecurityData &data) {
+    if (writer_fence_) {
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+    } else {
+      // Light side of the membarrier: keeps the compiler from hoisting the
+      // wait_groups load above end_write()
+      std::atomic_signal_fence(std::memory_order_seq_cst);
+    }
+    pending_wakeups_ |= data.wait_groups.load(std::memory_order_relaxed);
+    if (batch_open_) {
+      batch_dirty_ = true;
+    } else {
+      publish_commit();
+    }
+  }
+
+  // Every slot tagged with pending_commit_ is fully written before this
+  // release, so a reader that sees the commit sees all of its updates
+  void publish_commit() {
+    committed_.store(pending_commit_, std::memory_order_release);
+    ++pending_commit_;
+    if (pending_wakeups_ != 0) {
+      wake_waiters();
+    }
+  }
+
+  // Bumping the sequence (a full barrier) before reading sleepers pairs
+  // with the waiter registering before futex_wait re-checks the sequence
+  void wake_waiters() {
+    uint64_t groups = pending_wakeups_;
+    pending_wakeups_ = 0;
+    while (groups != 0) {
+      WaitGroup &group = wait_groups_[static_cast<size_t>(std::countr_zero(groups))];
+      groups &= groups - 1;
+      group.sequence.fetch_add(1, std::memory_order_seq_cst);
+      if (group.sleepers.load(std::memory_order_seq_cst) != 0) {
+        common::futex_wake_all(group.sequence);
+      }
+    }
+  }
+
+  // PENDING: a watched security was written after since_commit but its
+  // commit is not published yet
+  enum class GroupState : uint8_t { NOT_UPDATED = 0, PENDING = 1, UPDATED = 2 };
+
+  GroupState group_state(const WaitGroup &group, uint64_t since_commit, uint64_t commit) const {
+    GroupState state = GroupState::NOT_UPDATED;
+    for (size_t i = 0; i < group.count; ++i) {
+      const size_t slot = group.slots[i];
+      if (keys_[slot].load(std::memory_order_acquire) != group.keys[i]) {
+        continue; // removed since the group was opened
+      }
+      const uint64_t tag = securities[slot].commit_sequence.load(std::memory_order_relaxed);
+      if (tag > since_commit) {
+        if (tag <= commit) {
+          return GroupState::UPDATED;
+        }
+        state = GroupState::PENDING;
+      }
+    }
+    return state;
+  }
+
+  static void begin_write(SecurityData &data) {
+    const uint64_t seq = data.sequence.load(std::memory_order_relaxed);
+    data.sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+
+  static void end_write(SecurityData &data) {
+    const uint64_t seq = data.sequence.load(std::memory_order_relaxed);
+    data.sequence.store(seq + 1, std::memory_order_release);
+  }
+
+  static void read_consistent(const SecurityData &data,
+                              SecuritySnapshot &snapshot) {
+    for (;;) {
+      const uint64_t seq_before = data.sequence.load(std::memory_order_acquire);
+      if (seq_before & 1) {
+        continue;
+      }
+
+      snapshot.last_update_ns =
+          data.last_update_ns.load(std::memory_order_relaxed);
+      snapshot.best_bid = data.best_bid.load(std::memory_order_relaxed);
+      snapshot.best_ask = data.best_ask.load(std::memory_order_relaxed);
+      snapshot.last_trade_price =
+          data.last_trade_price.load(std::memory_order_relaxed);
+      snapshot.update_count = data.update_count.load(std::memory_order_relaxed);
+      snapshot.total_volume = data.total_volume.load(std::memory_order_relaxed);
+      snapshot.stale = data.stale.load(std::memory_order_relaxed);
+      snapshot.commit_sequence = data.commit_sequence.load(std::memory_order_relaxed);
+
+      snapshot.num_bid_levels =
+          data.bids.num_levels.load(std::memory_order_relaxed);
+      snapshot.num_ask_levels =
+          data.asks.num_levels.load(std::memory_order_relaxed);
+
+      std::memcpy(snapshot.bids, data.bids.levels, sizeof(PriceLevel) * 5);
+      std::memcpy(snapshot.asks, data.asks.levels, sizeof(PriceLevel) * 5);
+
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (data.sequence.load(std::memory_order_relaxed) == seq_before) {
+        return;
+      }
+    }
+  }
+
+  // Entry version is 0 while the writer fills it, then the version number:
+  // a reader that sees the same version before and after copying has it whole
+  void record_history(const SecurityData &data, uint64_t timestamp_ns,
+                      const PriceLevel *bids, uint8_t num_bids, const PriceLevel *asks,
+                      uint8_t num_asks, bool stale) {
+    if constexpr (HISTORY_DEPTH > 0) {
+      SymbolHistory &history = history_[static_cast<size_t>(&data - securities.data())];
+      const uint64_t version = history.latest.load(std::memory_order_relaxed) + 1;
+      HistoryEntry &entry = history.entries[version & (HISTORY_DEPTH - 1)];
+      entry.version.store(0, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+
+      BookVersion &book = entry.book;
+      book.version = version;
+      book.timestamp_ns = timestamp_ns;
+      book.num_bid_levels = std::min(num_bids, static_cast<uint8_t>(HISTORY_LEVELS));
+      book.num_ask_levels = std::min(num_asks, static_cast<uint8_t>(HISTORY_LEVELS));
+      book.stale = stale;
+      for (size_t i = 0; i < HISTORY_LEVELS; ++i) {
+        book.bids[i] = i < book.num_bid_levels ? bids[i] : PriceLevel{};
+        book.asks[i] = i < book.num_ask_levels ? asks[i] : PriceLevel{};
+      }
+
+      entry.version.store(version, std::memory_order_release);
+      history.latest.store(version, std::memory_order_release);
+    } else {
+      (void)data, (void)timestamp_ns, (void)bids, (void)num_bids;
+      (void)asks, (void)num_asks, (void)stale;
+    }
   }
 
   void update_order_book_side(SecurityData::OrderBookSide &side,
@@ -237,8 +814,38 @@ private:
     side.num_levels.store(copy_count, std::memory_order_release);
   }
 
+  struct alignas(64) HistoryEntry {
+    std::atomic<uint64_t> version{0};
+    BookVersion book{};
+  };
+
+  struct SymbolHistory {
+    alignas(64) std::atomic<uint64_t> latest{0};
+    std::array<HistoryEntry, HISTORY_DEPTH> entries;
+  };
+
+  struct NoHistory {};
+
+  // Read by every lookup, written only by add/remove: 8 keys per line
+  alignas(64) std::array<std::atomic<uint64_t>, MAX_SECURITIES> keys_{};
   std::array<SecurityData, MAX_SECURITIES> securities;
   std::atomic<size_t> active_count{0};
+  [[no_unique_address]] std::conditional_t<HISTORY_DEPTH != 0,
+                                           std::array<SymbolHistory, MAX_SECURITIES>, NoHistory>
+      history_;
+  std::array<WaitGroup, WAIT_GROUPS> wait_groups_;
+
+  // Polled by consistent readers; written once per commit
+  alignas(64) std::atomic<uint64_t> committed_{0};
+  // Writer only
+  alignas(64) uint64_t pending_commit_{1};
+  uint64_t pending_wakeups_{0}; // wait groups touched by the open commit
+  bool batch_open_{false};
+  bool batch_dirty_{false};
+  // Without membarrier the consumer pays the StoreLoad fence itself
+  const bool writer_fence_{!common::heavy_barrier_available()};
 };
 
+using SecurityStore = BasicSecurityStore<>;
+
 } // namespace mini_mart::market_data
@@ -0,0 +1,349 @@
+#pragma once
+
+#include "market_data/security_store.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+namespace mini_mart::market_data {
+
+using namespace mini_mart::types;
+
+enum class CheckpointError {
+  SUCCESS = 0,
+  OPEN_FAILED,
+  RESIZE_FAILED,
+  MMAP_FAILED,
+  BAD_FORMAT
+};
+
+// Periodically persists a SecurityStore to a memory-mapped file so a
+// restarted process can show last-known books immediately instead of
+// waiting for every symbol to tick.
+//
+// The file holds two record regions. Each checkpoint fills the inactive
+// region and then flips the header's active index, so a crash mid-write
+// leaves the previous checkpoint intact. Store reads use the per-symbol
+// seqlock, so the consumer thread is never blocked.
+class SecurityStoreCheckpointer {
+public:
+  static constexpr uint64_t FILE_MAGIC = 0x54504B434D4D494Dull; // "MIMMCKPT"
+  static constexpr uint32_t FILE_VERSION = 1;
+
+  struct Config {
+    std::string path;
+    uint32_t interval_ms;
+    bool sync_to_disk; // msync after each checkpoint (survives power loss)
+
+    Config() : interval_ms(1000), sync_to_disk(false) {}
+  };
+
+  struct Record {
+    SecurityId security_id;
+    Price best_bid;
+    Price best_ask;
+    Price last_trade_price;
+    uint64_t last_update_ns;
+    uint64_t update_count;
+    uint64_t total_volume;
+    PriceLevel bids[5];
+    PriceLevel asks[5];
+    uint8_t num_bid_levels;
+    uint8_t num_ask_levels;
+    uint8_t padding[6];
+  };
+  static_assert(sizeof(Record) == 224, "Record size is not 224 bytes");
+
+  struct Header {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t record_size;
+    uint32_t max_records;
+    uint32_t active_region; // 0 or 1; the region readers should load
+    uint32_t record_count[2];
+    uint64_t sequence[2];
+    uint64_t written_ns[2];
+  };
+
+  static constexpr size_t REGION_SIZE =
+      sizeof(Record) * SecurityStore::MAX_SECURITIES;
+  static constexpr size_t FILE_SIZE = sizeof(Header) + 2 * REGION_SIZE;
+
+  SecurityStoreCheckpointer(std::shared_ptr<SecurityStore> store,
+                            const Config &config)
+      : store_(std::move(store)), config_(config) {}
+
+  ~SecurityStoreCheckpointer() {
+    stop();
+    unmap();
+  }
+
+  SecurityStoreCheckpointer(const SecurityStoreCheckpointer &) = delete;
+  SecurityStoreCheckpointer &operator=(const SecurityStoreCheckpointer &) = delete;
+  SecurityStoreCheckpointer(SecurityStoreCheckpointer &&) = delete;
+  SecurityStoreCheckpointer &operator=(SecurityStoreCheckpointer &&) = delete;
+
+  bool start() {
+    if (running_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    {
+      std::lock_guard<std::mutex> lock(write_mutex_);
+      if (!map_file()) {
+        return false;
+      }
+    }
+
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread(&SecurityStoreCheckpointer::checkpoint_thread, this);
+    return true;
+  }
+
+  // Stops the background thread after writing a final checkpoint
+  void stop() {
+    if (!running_.load(std::memory_order_acquire)) {
+      return;
+    }
+
+    running_.store(false, std::memory_order_release);
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+    checkpoint_now();
+  }
+
+  bool is_running() const { return running_.load(std::memory_order_acquire); }
+
+  // Writes one checkpoint synchronously on the calling thread. Serialized
+  // with the background thread's checkpoints, so safe to call while running.
+  bool checkpoint_now() {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    if (header_ == nullptr && !map_file()) {
+      return false;
+    }
+
+    const uint32_t region = header_->active_region ^ 1u;
+    Record *records = region_records(region);
+    uint32_t count = 0;
+
+    store_->for_each_snapshot(
+        [&](const SecurityStore::SecuritySnapshot &snapshot) {
+          if (count < SecurityStore::MAX_SECURITIES) {
+            to_record(snapshot, records[count++]);
+          }
+        });
+
+    const uint64_t sequence = ++sequence_;
+    header_->record_count[region] = count;
+    header_->sequence[region] = sequence;
+    header_->written_ns[region] = now_ns();
+    std::atomic_thread_fence(std::memory_order_release);
+    if (config_.sync_to_disk) {
+      ::msync(mapping_, FILE_SIZE, MS_SYNC);
+    }
+    header_->active_region = region;
+    if (config_.sync_to_disk) {
+      ::msync(mapping_, sizeof(Header), MS_SYNC);
+    }
+
+    checkpoints_written_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  uint64_t checkpoints_written() const {
+    return checkpoints_written_.load(std::memory_order_relaxed);
+  }
+
+  CheckpointError last_error() const { return error_; }
+
+  // Loads the latest checkpoint into the store. Restored securities read as
+  // stale until their first live update. Returns the number restored, or -1
+  // on error (missing file, bad format).
+  static int restore(SecurityStore &store, const std::string &path,
+                     CheckpointError *error = nullptr) {
+    auto fail = [error](CheckpointError code) {
+      if (error != nullptr) {
+        *error = code;
+      }
+      return -1;
+    };
+
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      return fail(CheckpointError::OPEN_FAILED);
+    }
+
+    struct stat st {};
+    if (::fstat(fd, &st) < 0 || static_cast<size_t>(st.st_size) < FILE_SIZE) {
+      ::close(fd);
+      return fail(CheckpointError::BAD_FORMAT);
+    }
+
+    void *mapping = ::mmap(nullptr, FILE_SIZE, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+      return fail(CheckpointError::MMAP_FAILED);
+    }
+
+    const auto *header = static_cast<const Header *>(mapping);
+    const uint32_t region = header->active_region;
+    if (header->magic != FILE_MAGIC || header->version != FILE_VERSION ||
+        header->record_size != sizeof(Record) ||
+        header->max_records != SecurityStore::MAX_SECURITIES || region > 1 ||
+        header->record_count[region] > SecurityStore::MAX_SECURITIES) {
+      ::munmap(mapping, FILE_SIZE);
+      return fail(CheckpointError::BAD_FORMAT);
+    }
+
+    const auto *records = reinterpret_cast<const Record *>(
+        static_cast<const std::byte *>(mapping) + sizeof(Header) +
+        region * REGION_SIZE);
+    int restored = 0;
+    for (uint32_t i = 0; i < header->record_count[region]; ++i) {
+      if (store.restore_security(from_record(records[i]))) {
+        ++restored;
+      }
+    }
+
+    ::munmap(mapping, FILE_SIZE);
+    if (error != nullptr) {
+      *error = CheckpointError::SUCCESS;
+    }
+    return restored;
+  }
+
+private:
+  bool map_file() {
+    if (header_ != nullptr) {
+      return true;
+    }
+
+    const int fd = ::open(config_.path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+      error_ = CheckpointError::OPEN_FAILED;
+      return false;
+    }
+
+    struct stat st {};
+    const bool fresh = ::fstat(fd, &st) < 0 ||
+                       static_cast<size_t>(st.st_size) != FILE_SIZE;
+    if (fresh && ::ftruncate(fd, static_cast<off_t>(FILE_SIZE)) < 0) {
+      ::close(fd);
+      error_ = CheckpointError::RESIZE_FAILED;
+      return false;
+    }
+
+    void *mapping =
+        ::mmap(nullptr, FILE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+      error_ = CheckpointError::MMAP_FAILED;
+      return false;
+    }
+
+    mapping_ = mapping;
+    header_ = static_cast<Header *>(mapping);
+    if (fresh || header_->magic != FILE_MAGIC ||
+        header_->version != FILE_VERSION || header_->active_region > 1) {
+      std::memset(mapping_, 0, FILE_SIZE);
+      header_->version = FILE_VERSION;
+      header_->record_size = sizeof(Record);
+      header_->max_records = SecurityStore::MAX_SECURITIES;
+      header_->active_region = 0;
+      header_->magic = FILE_MAGIC;
+    }
+    sequence_ = std::max(header_->sequence[0], header_->sequence[1]);
+    error_ = CheckpointError::SUCCESS;
+    return true;
+  }
+
+  void unmap() {
+    if (mapping_ != nullptr) {
+      ::munmap(mapping_, FILE_SIZE);
+      mapping_ = nullptr;
+      header_ = nullptr;
+    }
+  }
+
+  Record *region_records(uint32_t region) const {
+    return reinterpret_cast<Record *>(static_cast<std::byte *>(mapping_) +
+                                      sizeof(Header) + region * REGION_SIZE);
+  }
+
+  static void to_record(const SecurityStore::SecuritySnapshot &snapshot,
+                        Record &record) {
+    record = Record{};
+    record.security_id = snapshot.security_id;
+    record.best_bid = snapshot.best_bid;
+    record.best_ask = snapshot.best_ask;
+    record.last_trade_price = snapshot.last_trade_price;
+    record.last_update_ns = snapshot.last_update_ns;
+    record.update_count = snapshot.update_count;
+    record.total_volume = snapshot.total_volume;
+    record.num_bid_levels = snapshot.num_bid_levels;
+    record.num_ask_levels = snapshot.num_ask_levels;
+    std::memcpy(record.bids, snapshot.bids, sizeof(record.bids));
+    std::memcpy(record.asks, snapshot.asks, sizeof(record.asks));
+  }
+
+  static SecurityStore::SecuritySnapshot from_record(const Record &record) {
+    SecurityStore::SecuritySnapshot snapshot{};
+    snapshot.security_id = record.security_id;
+    snapshot.best_bid = record.best_bid;
+    snapshot.best_ask = record.best_ask;
+    snapshot.last_trade_price = record.last_trade_price;
+    snapshot.last_update_ns = record.last_update_ns;
+    snapshot.update_count = record.update_count;
+    snapshot.total_volume = record.total_volume;
+    snapshot.num_bid_levels = std::min<uint8_t>(record.num_bid_levels, 5);
+    snapshot.num_ask_levels = std::min<uint8_t>(record.num_ask_levels, 5);
+    std::memcpy(snapshot.bids, record.bids, sizeof(snapshot.bids));
+    std::memcpy(snapshot.asks, record.asks, sizeof(snapshot.asks));
+    snapshot.stale = true;
+    return snapshot;
+  }
+
+  void checkpoint_thread() {
+    auto next_checkpoint = std::chrono::steady_clock::now();
+    while (running_.load(std::memory_order_acquire)) {
+      const auto now = std::chrono::steady_clock::now();
+      if (now >= next_checkpoint) {
+        checkpoint_now();
+        next_checkpoint = now + std::chrono::milliseconds(config_.interval_ms);
+      }
+      // Short sleeps keep stop() responsive with long intervals
+      std::this_thread::sleep_for(std::chrono::milliseconds(
+          std::min<uint32_t>(config_.interval_ms, 10)));
+    }
+  }
+
+  static uint64_t now_ns() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count());
+  }
+
+  std::shared_ptr<SecurityStore> store_;
+  Config config_;
+  std::atomic<bool> running_{false};
+  std::thread thread_;
+  // Guards the mapping and the inactive region between writers
+  std::mutex write_mutex_;
+  void *mapping_{nullptr};
+  Header *header_{nullptr};
+  uint64_t sequence_{0};
+  std::atomic<uint64_t> checkpoints_written_{0};
+  CheckpointError error_{CheckpointError::SUCCESS};
+};
+
+} // namespace mini_mart::market_data
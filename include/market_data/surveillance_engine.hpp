@@ -0,0 +1,368 @@
+#pragma once
+
+#include "common/rolling_window.hpp"
+#include "common/single_writer_counter.hpp"
+#include "common/spsc_ring.hpp"
+#include "types/messages.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace mini_mart::market_data {
+
+enum class SurveillanceAlertKind : uint8_t {
+  ORDER_TO_TRADE = 0, // orders per execution over the window too high
+  RAPID_CANCELS = 1,  // too many near-touch orders cancelled soon after entry
+  LAYERING = 2,       // fill on one side while resting on several levels of the other
+  COUNT = 3
+};
+
+inline constexpr size_t SURVEILLANCE_ALERT_KIND_COUNT = static_cast<size_t>(SurveillanceAlertKind::COUNT);
+
+inline const char *surveillance_alert_name(SurveillanceAlertKind kind) {
+  switch (kind) {
+  case SurveillanceAlertKind::ORDER_TO_TRADE:
+    return "order-to-trade";
+  case SurveillanceAlertKind::RAPID_CANCELS:
+    return "rapid cancels";
+  case SurveillanceAlertKind::LAYERING:
+    return "layering";
+  default:
+    return "unknown";
+  }
+}
+
+struct SurveillanceAlert {
+  uint64_t timestamp_ns;
+  SecurityId security_id; // of the event that tripped it
+  uint32_t participant_id;
+  SurveillanceAlertKind kind;
+  uint64_t observed;  // ratio, cancel count or layered levels
+  uint64_t threshold; // what it was compared with
+};
+
+// Thresholds; windows are window_ns of event time, per participant
+struct SurveillanceConfig {
+  uint64_t window_ns = 1000000000;
+  uint32_t min_orders_for_ratio = 100;    // adds + cancels before the ratio counts
+  uint32_t max_orders_per_execution = 20; // order-to-trade limit
+  uint64_t rapid_cancel_ns = 10000000;    // cancelled this soon after entry...
+  uint64_t near_touch_raw = 200;          // ...within this of its side's best (Price raw)
+  uint32_t max_rapid_cancels = 20;        // per window
+  uint32_t layering_min_levels = 3;       // resting price levels on the opposite side
+  Quantity layering_min_quantity = 1000;  // and their total quantity
+};
+
+// Surveillance of order-level event streams for manipulation patterns,
+// on one thread (e.g. a replay of recorded venue data):
+//
+// - Order-to-trade ratio: each participant's adds and cancels against its
+//   executions over the window.
+// - Rapid cancels: orders entered at or within near_touch_raw of their
+//   side's best (read from the SecurityStore when added) and fully
+//   cancelled within rapid_cancel_ns, counted over the window.
+// - Layering: a participant's order filling on one side of a security
+//   while it rests on at least layering_min_levels price levels on the
+//   other.
+//
+// All state is fixed-size: participants are indexed directly by id (ids
+// at or past MAX_PARTICIPANTS are ignored and counted), each with its
+// window counts on a time wheel of WINDOW_BUCKETS buckets and up to
+// LAYER_SLOTS resting price levels; live orders sit in an open-addressed
+// table of ORDER_CAPACITY (adds beyond 3/4 full are dropped and counted,
+// and their later cancels and fills only update counts). Each pattern
+// alerts at most once per participant per window, into an SpscRing that
+// one other thread drains with pop_alert(); a full ring drops (counted).
+template <typename Store, size_t MAX_PARTICIPANTS = 1024, size_t ORDER_CAPACITY = 65536>
+class SurveillanceEngine {
+  static_assert(ORDER_CAPACITY > 1 && (ORDER_CAPACITY & (ORDER_CAPACITY - 1)) == 0,
+                "ORDER_CAPACITY must be a power of 2");
+
+public:
+  static constexpr size_t WINDOW_BUCKETS = 16;
+  static constexpr size_t LAYER_SLOTS = 8;
+  static constexpr size_t ALERT_RING_SIZE = 1024;
+
+  // Per-participant counts over the current window
+  enum Activity : size_t { ADDS = 0, CANCELS = 1, EXECUTIONS = 2, RAPID_CANCELS = 3, ACTIVITY_FIELDS = 4 };
+
+  // store may be null: no order is then near the touch
+  explicit SurveillanceEngine(std::shared_ptr<const Store> store,
+                              const SurveillanceConfig &config = SurveillanceConfig{})
+      : config_(config),
+        bucket_ns_(std::max<uint64_t>(1, config.window_ns / (WINDOW_BUCKETS - 1))),
+        store_(std::move(store)), participants_(std::make_unique<Participant[]>(MAX_PARTICIPANTS)),
+        orders_(std::make_unique<Order[]>(ORDER_CAPACITY)) {}
+
+  SurveillanceEngine(const SurveillanceEngine &) = delete;
+  SurveillanceEngine &operator=(const SurveillanceEngine &) = delete;
+
+  // Event thread. False for ignored participants. Cancels and fills of a
+  // live order count against its owner, whoever the event names.
+  bool on_message(const OrderEventMessage &event) {
+    const size_t index = event.action == OrderAction::ADD ? ORDER_CAPACITY : find_order(event.order_id);
+    const uint32_t participant_id = index == ORDER_CAPACITY ? event.participant_id : orders_[index].participant_id;
+    if (participant_id >= MAX_PARTICIPANTS) {
+      common::bump(ignored_);
+      return false;
+    }
+    Participant &participant = participants_[participant_id];
+    participant.activity.advance_to(event.timestamp_ns / bucket_ns_);
+    common::bump(events_);
+    if (event.action == OrderAction::ADD) {
+      on_add(participant, event);
+    } else {
+      on_remove(participant, event, index);
+    }
+    check_order_to_trade(participant, participant_id, event);
+    return true;
+  }
+
+  // Event thread. Window count of field for participant_id (< MAX_PARTICIPANTS).
+  uint32_t activity(uint32_t participant_id, Activity field) const {
+    return participants_[participant_id].activity.total(field);
+  }
+
+  // Event thread
+  size_t open_orders() const { return open_orders_; }
+
+  // One alert-reading thread
+  bool pop_alert(SurveillanceAlert &alert) const { return alerts_.try_pop(alert); }
+
+  // Any thread
+  uint64_t events() const { return events_.load(std::memory_order_relaxed); }
+  uint64_t alerts_raised() const { return alerts_raised_.load(std::memory_order_relaxed); }
+  uint64_t alerts_dropped() const { return alerts_dropped_.load(std::memory_order_relaxed); }
+  uint64_t ignored_events() const { return ignored_.load(std::memory_order_relaxed); }
+  uint64_t orders_dropped() const { return orders_dropped_.load(std::memory_order_relaxed); }
+  uint64_t unmatched_events() const { return unmatched_.load(std::memory_order_relaxed); }
+
+private:
+  static constexpr size_t ORDER_MASK = ORDER_CAPACITY - 1;
+  static constexpr size_t MAX_OPEN_ORDERS = ORDER_CAPACITY / 4 * 3;
+
+  // Resting quantity of one participant at one price of a book side
+  struct Layer {
+    SecurityId security_id{};
+    Price price{};
+    Quantity quantity{0};
+    uint32_t orders{0}; // 0: free
+    Side side{Side::BID};
+  };
+
+  struct Participant {
+    common::TimeWheelCounts<ACTIVITY_FIELDS, WINDOW_BUCKETS> activity;
+    std::array<Layer, LAYER_SLOTS> layers{};
+    std::array<uint64_t, SURVEILLANCE_ALERT_KIND_COUNT> next_alert_bucket{};
+  };
+
+  struct Order {
+    uint64_t order_id{0}; // 0: empty slot
+    SecurityId security_id{};
+    Price price{};
+    Quantity remaining{0};
+    uint64_t added_ns{0};
+    uint32_t participant_id{0};
+    Side side{Side::BID};
+    bool near_touch{false};
+  };
+
+  void on_add(Participant &participant, const OrderEventMessage &event) {
+    participant.activity.add(ADDS);
+    Order *order = insert_order(event.order_id);
+    if (order == nullptr) {
+      common::bump(orders_dropped_);
+      return;
+    }
+    *order = Order{event.order_id, event.security_id, event.price, event.quantity, event.timestamp_ns,
+                   event.participant_id, event.side, near_touch(event)};
+    Layer *layer = find_layer(participant, event.security_id, event.side, event.price);
+    if (layer != nullptr) {
+      layer->quantity += event.quantity;
+      ++layer->orders;
+    }
+  }
+
+  // index: the order's entry, ORDER_CAPACITY when it is not live;
+  // owner: its owner's state, else that of the participant the event names
+  void on_remove(Participant &owner, const OrderEventMessage &event, size_t index) {
+    const bool executed = event.action == OrderAction::EXECUTE;
+    owner.activity.add(executed ? EXECUTIONS : CANCELS);
+    if (index == ORDER_CAPACITY) {
+      common::bump(unmatched_);
+      return;
+    }
+    Order &order = orders_[index];
+    const Quantity removed = event.quantity == 0 && !executed ? order.remaining
+                                                               : std::min(event.quantity, order.remaining);
+    order.remaining -= removed;
+    const bool gone = order.remaining == 0;
+    Layer *layer = find_layer(owner, order.security_id, order.side, order.price, false);
+    if (layer != nullptr) {
+      layer->quantity -= std::min(removed, layer->quantity);
+      layer->orders -= gone ? 1u : 0u;
+    }
+    if (executed) {
+      check_layering(owner, order, event.timestamp_ns);
+    } else if (gone && order.near_touch && event.timestamp_ns - order.added_ns <= config_.rapid_cancel_ns) {
+      owner.activity.add(RAPID_CANCELS);
+      const uint32_t rapid = owner.activity.total(RAPID_CANCELS);
+      if (rapid >= config_.max_rapid_cancels) {
+        raise(owner, order.participant_id, SurveillanceAlertKind::RAPID_CANCELS, event, rapid,
+              config_.max_rapid_cancels);
+      }
+    }
+    if (gone) {
+      erase_order(index);
+    }
+  }
+
+  void check_order_to_trade(Participant &participant, uint32_t participant_id, const OrderEventMessage &event) {
+    const uint32_t orders = participant.activity.total(ADDS) + participant.activity.total(CANCELS);
+    const uint32_t executions = std::max<uint32_t>(1, participant.activity.total(EXECUTIONS));
+    if (orders >= config_.min_orders_for_ratio &&
+        orders > static_cast<uint64_t>(config_.max_orders_per_execution) * executions) {
+      raise(participant, participant_id, SurveillanceAlertKind::ORDER_TO_TRADE, event, orders / executions,
+            config_.max_orders_per_execution);
+    }
+  }
+
+  // After a fill of order: does its owner rest on enough levels opposite?
+  void check_layering(Participant &owner, const Order &order, uint64_t timestamp_ns) {
+    uint32_t levels = 0;
+    Quantity quantity = 0;
+    for (const Layer &layer : owner.layers) {
+      if (layer.orders > 0 && layer.side != order.side && layer.security_id == order.security_id) {
+        ++levels;
+        quantity += layer.quantity;
+      }
+    }
+    if (levels >= config_.layering_min_levels && quantity >= config_.layering_min_quantity) {
+      OrderEventMessage event{};
+      event.security_id = order.security_id;
+      event.timestamp_ns = timestamp_ns;
+      raise(owner, order.participant_id, SurveillanceAlertKind::LAYERING, event, levels, config_.layering_min_levels);
+    }
+  }
+
+  void raise(Participant &participant, uint32_t participant_id, SurveillanceAlertKind kind,
+             const OrderEventMessage &event, uint64_t observed, uint64_t threshold) {
+    uint64_t &next = participant.next_alert_bucket[static_cast<size_t>(kind)];
+    const uint64_t bucket = participant.activity.current_bucket();
+    if (bucket < next) {
+      return;
+    }
+    next = bucket + WINDOW_BUCKETS;
+    common::bump(alerts_raised_);
+    if (!alerts_.try_push(SurveillanceAlert{event.timestamp_ns, event.security_id, participant_id, kind, observed,
+                                            threshold})) {
+      common::bump(alerts_dropped_);
+    }
+  }
+
+  bool near_touch(const OrderEventMessage &event) const {
+    if (!store_) {
+      return false;
+    }
+    const size_t slot = store_->slot_of(event.security_id);
+    if (slot == Store::NO_SLOT) {
+      return false;
+    }
+    Price best_bid;
+    Price best_ask;
+    store_->touch_of_slot(slot, best_bid, best_ask);
+    const uint64_t price = event.price.raw();
+    if (event.side == Side::BID) {
+      return !best_bid.is_zero() && price + config_.near_touch_raw >= best_bid.raw();
+    }
+    return !best_ask.is_zero() && price <= best_ask.raw() + config_.near_touch_raw;
+  }
+
+  // The participant's layer for a price, claiming a free one if asked (and
+  // nullptr when all are taken: the level goes untracked)
+  static Layer *find_layer(Participant &participant, const SecurityId &security_id, Side side, Price price,
+                           bool claim = true) {
+    Layer *free = nullptr;
+    for (Layer &layer : participant.layers) {
+      if (layer.orders == 0) {
+        free = free == nullptr ? &layer : free;
+      } else if (layer.price == price && layer.side == side && layer.security_id == security_id) {
+        return &layer;
+      }
+    }
+    if (claim && free != nullptr) {
+      *free = Layer{security_id, price, 0, 0, side};
+      return free;
+    }
+    return nullptr;
+  }
+
+  static size_t home_of(uint64_t order_id) {
+    return static_cast<size_t>((order_id * 0x9E3779B97F4A7C15ull) >> 32) & ORDER_MASK;
+  }
+
+  // Index of order_id's entry, or ORDER_CAPACITY
+  size_t find_order(uint64_t order_id) const {
+    if (order_id == 0) {
+      return ORDER_CAPACITY;
+    }
+    for (size_t i = home_of(order_id);; i = (i + 1) & ORDER_MASK) {
+      if (orders_[i].order_id == order_id) {
+        return i;
+      }
+      if (orders_[i].order_id == 0) {
+        return ORDER_CAPACITY;
+      }
+    }
+  }
+
+  // nullptr when full, for order id 0 and for ids already live
+  Order *insert_order(uint64_t order_id) {
+    if (order_id == 0 || open_orders_ >= MAX_OPEN_ORDERS) {
+      return nullptr;
+    }
+    for (size_t i = home_of(order_id);; i = (i + 1) & ORDER_MASK) {
+      if (orders_[i].order_id == order_id) {
+        return nullptr;
+      }
+      if (orders_[i].order_id == 0) {
+        ++open_orders_;
+        return &orders_[i];
+      }
+    }
+  }
+
+  // Backward-shift deletion: later entries of the probe run move up so
+  // lookups never need tombstones
+  void erase_order(size_t index) {
+    size_t hole = index;
+    for (size_t i = (index + 1) & ORDER_MASK; orders_[i].order_id != 0; i = (i + 1) & ORDER_MASK) {
+      const size_t home = home_of(orders_[i].order_id);
+      // Move it if its home is not within (hole, i]
+      if (((i - home) & ORDER_MASK) >= ((i - hole) & ORDER_MASK)) {
+        orders_[hole] = orders_[i];
+        hole = i;
+      }
+    }
+    orders_[hole] = Order{};
+    --open_orders_;
+  }
+
+  const SurveillanceConfig config_;
+  const uint64_t bucket_ns_;
+  std::shared_ptr<const Store> store_;
+  std::unique_ptr<Participant[]> participants_;
+  std::unique_ptr<Order[]> orders_;
+  size_t open_orders_{0};
+  mutable common::SpscRing<SurveillanceAlert, ALERT_RING_SIZE> alerts_;
+  std::atomic<uint64_t> events_{0};
+  std::atomic<uint64_t> alerts_raised_{0};
+  std::atomic<uint64_t> alerts_dropped_{0};
+  std::atomic<uint64_t> ignored_{0};
+  std::atomic<uint64_t> orders_dropped_{0};
+  std::atomic<uint64_t> unmatched_{0};
+};
+
+} // namespace mini_mart::market_data
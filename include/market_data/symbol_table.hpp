@@ -0,0 +1,226 @@
+#pragma once
+
+#include "types/messages.hpp"
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <string_view>
+
+namespace mini_mart::market_data {
+
+using namespace mini_mart::types;
+
+// SecurityId as one 64-bit word (native byte order, same as a raw load)
+constexpr uint64_t symbol_key(const SecurityId &security_id) {
+  return std::bit_cast<uint64_t>(security_id);
+}
+
+// Compile-time SecurityId construction (truncates to 8 characters)
+constexpr SecurityId make_security_id(std::string_view symbol) {
+  SecurityId security_id{};
+  for (size_t i = 0; i < symbol.size() && i < security_id.size(); ++i) {
+    security_id[i] = symbol[i];
+  }
+  return security_id;
+}
+
+// Smallest table (in bits) that makes a random multiply-shift perfect hash
+// of N keys likely: ~N^2 slots, capped at 64K slots of 2 bytes each.
+constexpr uint32_t default_symbol_table_bits(size_t n) {
+  uint32_t bits = 4;
+  while (bits < 16 && (size_t{1} << bits) < n * n) {
+    ++bits;
+  }
+  return bits;
+}
+
+// Perfect hash over a fixed symbol universe, built at compile time.
+//
+// The constructor searches for an odd multiplier M such that
+// (key * M) >> (64 - TableBits) is collision-free over the N symbols. Each
+// table slot holds a dense symbol index; lookup is one multiply, one shift,
+// one slot load and one key compare, with no probing and no branches on
+// the hit path. Meant for deployments whose symbol list is known at build
+// time (up to 256 symbols); larger universes use InstrumentDirectory.
+// Empty slots point at a sentinel key of all-0xFF bytes, which is not a
+// valid symbol.
+//
+//   inline constexpr auto UNIVERSE = make_symbol_table({"AAPL", "MSFT", "SPY"});
+//   static_assert(UNIVERSE.valid());
+template <size_t N, uint32_t TableBits = default_symbol_table_bits(N)>
+class StaticSymbolTable {
+public:
+  static_assert(N > 0 && N <= 256, "StaticSymbolTable supports 1..256 symbols");
+  static_assert(TableBits >= 1 && TableBits <= 16, "TableBits must be 1..16");
+
+  static constexpr uint32_t NOT_FOUND = UINT32_MAX;
+  static constexpr size_t TABLE_SIZE = size_t{1} << TableBits;
+  static constexpr uint32_t SHIFT = 64 - TableBits;
+  static constexpr uint32_t MAX_ATTEMPTS = 4096;
+
+  constexpr explicit StaticSymbolTable(const std::array<std::string_view, N> &symbols)
+      : keys_{}, slots_{}, multiplier_(0) {
+    keys_[N] = SENTINEL_KEY;
+    for (size_t i = 0; i < N; ++i) {
+      keys_[i] = symbol_key(make_security_id(symbols[i]));
+      for (size_t j = 0; j < i; ++j) {
+        if (keys_[j] == keys_[i]) {
+          return; // duplicate symbol: leave invalid
+        }
+      }
+    }
+
+    // Deterministic multiplier candidates from a splitmix64 sequence. Slots
+    // are stamped with the attempt number so the table is never re-cleared.
+    std::array<uint16_t, TABLE_SIZE> stamp{};
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    for (uint16_t attempt = 1; attempt <= MAX_ATTEMPTS; ++attempt) {
+      const uint64_t candidate = next_candidate(state) | 1u;
+      bool collision = false;
+      for (size_t i = 0; i < N && !collision; ++i) {
+        const size_t slot = static_cast<size_t>((keys_[i] * candidate) >> SHIFT);
+        collision = stamp[slot] == attempt;
+        stamp[slot] = attempt;
+      }
+      if (!collision) {
+        multiplier_ = candidate;
+        break;
+      }
+    }
+    if (multiplier_ == 0) {
+      return;
+    }
+
+    for (size_t slot = 0; slot < TABLE_SIZE; ++slot) {
+      slots_[slot] = static_cast<uint16_t>(N);
+    }
+    for (size_t i = 0; i < N; ++i) {
+      slots_[slot_of(keys_[i])] = static_cast<uint16_t>(i);
+    }
+  }
+
+  // Dense index in [0, N) of the symbol, or NOT_FOUND
+  constexpr uint32_t find(const SecurityId &security_id) const {
+    const uint64_t key = symbol_key(security_id);
+    const uint32_t index = slots_[slot_of(key)];
+    return keys_[index] == key ? index : NOT_FOUND;
+  }
+
+  constexpr bool contains(const SecurityId &security_id) const {
+    return find(security_id) != NOT_FOUND;
+  }
+
+  constexpr SecurityId symbol(uint32_t index) const {
+    return std::bit_cast<SecurityId>(keys_[index]);
+  }
+
+  // False if the symbols had duplicates or no multiplier was found (raise
+  // TableBits)
+  constexpr bool valid() const { return multiplier_ != 0; }
+  constexpr uint64_t multiplier() const { return multiplier_; }
+  static constexpr size_t size() { return N; }
+
+private:
+  static constexpr uint64_t SENTINEL_KEY = UINT64_MAX;
+
+  static constexpr uint64_t next_candidate(uint64_t &state) {
+    state += 0x9E3779B97F4A7C15ull;
+    uint64_t z = state;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+  }
+
+  constexpr size_t slot_of(uint64_t key) const {
+    return static_cast<size_t>((key * multiplier_) >> SHIFT);
+  }
+
+  std::array<uint64_t, N + 1> keys_; // [N] is the sentinel
+  std::array<uint16_t, TABLE_SIZE> slots_;
+  uint64_t multiplier_;
+};
+
+template <size_t N>
+constexpr StaticSymbolTable<N> make_symbol_table(const std::string_view (&symbols)[N]) {
+  return StaticSymbolTable<N>(std::to_array(symbols));
+}
+
+// Index policies for SecurityStore and RandomMarketDataProvider.
+//
+// DynamicSecurityIndex: any symbol may be added at runtime, up to CAPACITY;
+// lookups scan the slots.
+struct DynamicSecurityIndex {
+  static constexpr size_t CAPACITY = 256;
+  static constexpr bool FIXED_SLOTS = false;
+};
+
+// StaticSecurityIndex: only symbols in Table may be added, each in its own
+// pre-assigned slot found by perfect hash.
+template <const auto &Table> struct StaticSecurityIndex {
+  static_assert(Table.valid(), "symbol table has duplicates or no perfect hash");
+
+  static constexpr size_t CAPACITY = Table.size();
+  static constexpr bool FIXED_SLOTS = true;
+  static constexpr uint32_t NOT_FOUND = UINT32_MAX;
+
+  static uint32_t slot_of(const SecurityId &security_id) {
+    return Table.find(security_id);
+  }
+};
+
+// Dense numbering 0, 1, 2... of the securities an engine tracks, found the
+// way the store's Index finds slots: a scan of the dense keys, or the
+// static table's perfect hash. Setup (add) and lookups on one thread.
+template <typename Index> class DenseSecurityMap {
+public:
+  static constexpr size_t CAPACITY = Index::CAPACITY;
+  static constexpr size_t NOT_FOUND = SIZE_MAX;
+
+  DenseSecurityMap() { dense_of_slot_.fill(NO_INDEX); }
+
+  // Next index, or NOT_FOUND if already added, full, or unknown to a
+  // static index
+  size_t add(const SecurityId &security_id) {
+    if (size_ == CAPACITY || find(security_id) != NOT_FOUND) {
+      return NOT_FOUND;
+    }
+    if constexpr (Index::FIXED_SLOTS) {
+      const uint32_t slot = Index::slot_of(security_id);
+      if (slot == Index::NOT_FOUND) {
+        return NOT_FOUND;
+      }
+      dense_of_slot_[slot] = static_cast<uint32_t>(size_);
+    }
+    keys_[size_] = symbol_key(security_id);
+    return size_++;
+  }
+
+  size_t find(const SecurityId &security_id) const {
+    if constexpr (Index::FIXED_SLOTS) {
+      const uint32_t slot = Index::slot_of(security_id);
+      if (slot == Index::NOT_FOUND || dense_of_slot_[slot] == NO_INDEX) {
+        return NOT_FOUND;
+      }
+      return dense_of_slot_[slot];
+    }
+    const uint64_t key = symbol_key(security_id);
+    for (size_t i = 0; i < size_; ++i) {
+      if (keys_[i] == key) {
+        return i;
+      }
+    }
+    return NOT_FOUND;
+  }
+
+  SecurityId security_id(size_t index) const { return std::bit_cast<SecurityId>(keys_[index]); }
+  size_t size() const { return size_; }
+
+private:
+  static constexpr uint32_t NO_INDEX = UINT32_MAX;
+
+  std::array<uint64_t, CAPACITY> keys_{};
+  std::array<uint32_t, CAPACITY> dense_of_slot_{}; // static index slot -> dense index
+  size_t size_{0};
+};
+
+} // namespace mini_mart::market_data
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "server/io_context.hpp"
+#include "server/udp_socket.hpp"
+
+namespace mini_mart::server {
+
+// UdpSocket driven by an IoContext. Takes ownership of the socket and puts
+// it in non-blocking mode; check is_valid() after construction.
+class AsyncUdpSocket {
+public:
+  AsyncUdpSocket(IoContext &context, UdpSocket socket);
+
+  AsyncUdpSocket(const AsyncUdpSocket &) = delete;
+  AsyncUdpSocket &operator=(const AsyncUdpSocket &) = delete;
+
+  bool is_valid() const { return socket_.is_valid() && fd_.is_registered(); }
+  UdpSocket &socket() { return socket_; }
+
+  // Return bytes transferred or -errno
+  Task<ssize_t> recv_from(void *buffer, size_t length, sockaddr_in *src);
+  Task<ssize_t> send_to(const void *data, size_t length, sockaddr_in dst);
+
+private:
+  static UdpSocket make_nonblocking(UdpSocket socket) {
+    socket.set_nonblocking();
+    return socket;
+  }
+
+  UdpSocket socket_;
+  AsyncFd fd_;
+};
+
+} // namespace mini_mart::server
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "server/io_context.hpp"
+
+#include <coroutine>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace mini_mart::server {
+
+// Bounded channel between coroutines on the same IoContext. Suspended
+// senders and receivers are linked through their awaiter objects, which live
+// in the awaiting coroutine's frame, so blocking never allocates.
+template <typename T, size_t N> class Channel {
+
+  static_assert(N > 0, "N must be greater than 0");
+  static_assert(std::is_default_constructible_v<T>,
+                "T must be default constructible");
+
+public:
+  explicit Channel(IoContext &context) : context_(context) {}
+
+  Channel(const Channel &) = delete;
+  Channel &operator=(const Channel &) = delete;
+
+  size_t size() const { return count_; }
+  bool empty() const { return count_ == 0; }
+  bool is_closed() const { return closed_; }
+  static inline constexpr size_t get_capacity() { return N; }
+
+  class SendAwaiter {
+  public:
+    SendAwaiter(Channel &channel, T value)
+        : channel_(channel), value_(std::move(value)) {}
+
+    bool await_ready() noexcept {
+      if (channel_.closed_) {
+        result_ = false;
+        return true;
+      }
+      if (channel_.receivers_.head != nullptr) {
+        RecvAwaiter *receiver = channel_.receivers_.pop();
+        receiver->result_ = std::move(value_);
+        channel_.context_.post(receiver->handle_);
+        return true;
+      }
+      if (channel_.count_ < N) {
+        channel_.push_buffer(std::move(value_));
+        return true;
+      }
+      return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) noexcept {
+      handle_ = handle;
+      channel_.senders_.push(this);
+    }
+
+    // false if the channel was closed before the value was accepted
+    bool await_resume() const noexcept { return result_; }
+
+  private:
+    friend class Channel;
+    Channel &channel_;
+    T value_;
+    bool result_{true};
+    std::coroutine_handle<> handle_;
+    SendAwaiter *next_{nullptr};
+  };
+
+  class RecvAwaiter {
+  public:
+    explicit RecvAwaiter(Channel &channel) : channel_(channel) {}
+
+    bool await_ready() noexcept {
+      if (channel_.count_ > 0) {
+        result_ = channel_.pop_buffer();
+        if (channel_.senders_.head != nullptr) {
+          SendAwaiter *sender = channel_.senders_.pop();
+          channel_.push_buffer(std::move(sender->value_));
+          channel_.context_.post(sender->handle_);
+        }
+        return true;
+      }
+      return channel_.closed_;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) noexcept {
+      handle_ = handle;
+      channel_.receivers_.push(this);
+    }
+
+    // nullopt once the channel is closed and drained
+    std::optional<T> await_resume() noexcept { return std::move(result_); }
+
+  private:
+    friend class Channel;
+    Channel &channel_;
+    std::optional<T> result_;
+    std::coroutine_handle<> handle_;
+    RecvAwaiter *next_{nullptr};
+  };
+
+  SendAwaiter send(T value) { return SendAwaiter{*this, std::move(value)}; }
+  RecvAwaiter recv() { return RecvAwaiter{*this}; }
+
+  // Wakes all waiters: pending sends fail, pending receives get nullopt.
+  // Values already buffered can still be received.
+  void close() {
+    closed_ = true;
+    while (SendAwaiter *sender = senders_.pop()) {
+      sender->result_ = false;
+      context_.post(sender->handle_);
+    }
+    while (RecvAwaiter *receiver = receivers_.pop()) {
+      context_.post(receiver->handle_);
+    }
+  }
+
+private:
+  template <typename Awaiter> struct WaitList {
+    Awaiter *head{nullptr};
+    Awaiter *tail{nullptr};
+
+    void push(Awaiter *awaiter) {
+      awaiter->next_ = nullptr;
+      if (tail != nullptr) {
+        tail->next_ = awaiter;
+      } else {
+        head = awaiter;
+      }
+      tail = awaiter;
+    }
+
+    Awaiter *pop() {
+      Awaiter *awaiter = head;
+      if (awaiter != nullptr) {
+        head = awaiter->next_;
+        if (head == nullptr) {
+          tail = nullptr;
+        }
+      }
+      return awaiter;
+    }
+  };
+
+  void push_buffer(T value) {
+    buffer_[(head_ + count_) % N] = std::move(value);
+    ++count_;
+  }
+
+  T pop_buffer() {
+    T value = std::move(buffer_[head_]);
+    head_ = (head_ + 1) % N;
+    --count_;
+    return value;
+  }
+
+  IoContext &context_;
+  T buffer_[N];
+  size_t head_{0};
+  size_t count_{0};
+  bool closed_{false};
+  WaitList<SendAwaiter> senders_;
+  WaitList<RecvAwaiter> receivers_;
+};
+
+} // namespace mini_mart::server
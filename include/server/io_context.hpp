@@ -0,0 +1,177 @@
+#pragma once
+
+#include "server/task.hpp"
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <netinet/in.h>
+#include <sys/types.h>
+#include <vector>
+
+namespace mini_mart::server {
+
+class AsyncFd;
+
+// Single-threaded epoll-backed coroutine runtime. Run one IoContext per
+// thread (per core); everything spawned on a context is resumed only by the
+// thread inside run(), so coroutines on the same context need no locking.
+//
+// Asynchronous operations return -errno on failure rather than throwing.
+class IoContext {
+public:
+  IoContext();
+  ~IoContext();
+
+  IoContext(const IoContext &) = delete;
+  IoContext &operator=(const IoContext &) = delete;
+  IoContext(IoContext &&) = delete;
+  IoContext &operator=(IoContext &&) = delete;
+
+  bool is_valid() const {
+    return epoll_fd_ >= 0 && wake_fd_ >= 0 && timer_fd_ >= 0;
+  }
+
+  // Starts a detached coroutine on the next loop iteration. Its frame is
+  // freed when it finishes.
+  void spawn(Task<void> task);
+
+  // Queues a suspended coroutine for resumption on this context
+  void post(std::coroutine_handle<> handle) { ready_.push_back(handle); }
+
+  // Runs until stop() is called or no spawned task is left
+  void run();
+
+  // Safe to call from any thread
+  void stop();
+
+  bool is_running() const { return running_; }
+  size_t outstanding_tasks() const { return outstanding_; }
+
+  // Monotonic clock used for timers
+  static uint64_t now_ns();
+
+  struct TimerAwaiter {
+    IoContext &context;
+    uint64_t deadline_ns;
+
+    bool await_ready() const noexcept { return deadline_ns <= now_ns(); }
+    void await_suspend(std::coroutine_handle<> handle) {
+      context.add_timer(deadline_ns, handle);
+    }
+    void await_resume() const noexcept {}
+  };
+
+  TimerAwaiter sleep_for_ns(uint64_t duration_ns) {
+    return TimerAwaiter{*this, now_ns() + duration_ns};
+  }
+
+  TimerAwaiter sleep_until_ns(uint64_t deadline_ns) {
+    return TimerAwaiter{*this, deadline_ns};
+  }
+
+private:
+  friend class AsyncFd;
+
+  struct DetachedTask;
+  struct DetachedPromise;
+  static DetachedTask run_detached(IoContext &context, Task<void> task);
+
+  struct Timer {
+    uint64_t deadline_ns;
+    uint64_t sequence; // FIFO among equal deadlines
+    std::coroutine_handle<> handle;
+
+    bool operator>(const Timer &other) const {
+      return deadline_ns != other.deadline_ns
+                 ? deadline_ns > other.deadline_ns
+                 : sequence > other.sequence;
+    }
+  };
+
+  void add_timer(uint64_t deadline_ns, std::coroutine_handle<> handle);
+  void fire_expired_timers();
+  void arm_timer_fd(uint64_t deadline_ns);
+  void drain_ready();
+  void link_detached(DetachedPromise *promise);
+  void unlink_detached(DetachedPromise *promise);
+
+  static constexpr size_t MAX_EVENTS = 256;
+  static constexpr size_t INITIAL_QUEUE_CAPACITY = 1024;
+
+  int epoll_fd_{-1};
+  int wake_fd_{-1};  // eventfd, wakes epoll_wait for cross-thread stop()
+  int timer_fd_{-1}; // timerfd armed to the earliest timer deadline
+  bool running_{false};
+  std::atomic<bool> stop_requested_{false};
+  size_t outstanding_{0};
+  uint64_t timer_sequence_{0};
+  uint64_t armed_deadline_ns_{0};
+  DetachedPromise *detached_head_{nullptr}; // live spawned frames
+  std::vector<std::coroutine_handle<>> ready_;
+  std::vector<std::coroutine_handle<>> running_batch_;
+  std::vector<Timer> timers_; // min-heap on deadline
+};
+
+// Registers a non-blocking descriptor with an IoContext (edge-triggered) and
+// provides readiness awaitables. Does not own the descriptor.
+class AsyncFd {
+public:
+  AsyncFd(IoContext &context, int fd);
+  ~AsyncFd();
+
+  AsyncFd(const AsyncFd &) = delete;
+  AsyncFd &operator=(const AsyncFd &) = delete;
+  AsyncFd(AsyncFd &&) = delete;
+  AsyncFd &operator=(AsyncFd &&) = delete;
+
+  int fd() const { return fd_; }
+  bool is_registered() const { return registered_; }
+  IoContext &context() const { return context_; }
+
+  struct ReadinessAwaiter {
+    AsyncFd &owner;
+    bool for_write;
+
+    bool await_ready() const noexcept {
+      bool &flag = for_write ? owner.write_ready_ : owner.read_ready_;
+      if (flag) {
+        flag = false;
+        return true;
+      }
+      return false;
+    }
+    void await_suspend(std::coroutine_handle<> handle) noexcept {
+      (for_write ? owner.writer_ : owner.reader_) = handle;
+    }
+    void await_resume() const noexcept {}
+  };
+
+  ReadinessAwaiter readable() { return ReadinessAwaiter{*this, false}; }
+  ReadinessAwaiter writable() { return ReadinessAwaiter{*this, true}; }
+
+private:
+  friend class IoContext;
+  void on_events(uint32_t events);
+
+  IoContext &context_;
+  int fd_;
+  bool registered_{false};
+  bool read_ready_{false};
+  bool write_ready_{false};
+  std::coroutine_handle<> reader_;
+  std::coroutine_handle<> writer_;
+};
+
+// Async operations. Each retries the syscall and suspends on EAGAIN.
+Task<int> async_accept(AsyncFd &listener);
+Task<int> async_connect(AsyncFd &socket, sockaddr_in address);
+Task<ssize_t> async_read(AsyncFd &socket, void *buffer, size_t length);
+Task<ssize_t> async_write(AsyncFd &socket, const void *buffer, size_t length);
+
+// Non-blocking TCP helpers. Return the descriptor or -errno.
+int open_tcp_listener(uint16_t port, int backlog, uint16_t *bound_port);
+int open_tcp_socket();
+
+} // namespace mini_mart::server
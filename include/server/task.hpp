@@ -0,0 +1,223 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <new>
+#include <utility>
+
+namespace mini_mart::server {
+
+// Thread-local free lists for coroutine frames, bucketed in 64-byte classes.
+// Each runtime thread recycles its own frames, so steady-state awaits of
+// Task-returning operations never touch the global heap.
+class FramePool {
+public:
+  static constexpr size_t SIZE_CLASS = 64;
+  static constexpr size_t NUM_CLASSES = 32; // frames up to 2 KiB are pooled
+
+  static void *allocate(size_t size) {
+    const size_t cls = (size + SIZE_CLASS - 1) / SIZE_CLASS;
+    if (cls >= NUM_CLASSES) {
+      ++lists().heap_allocations;
+      return ::operator new(size);
+    }
+
+    FreeNode *&head = lists().heads[cls];
+    if (head != nullptr) {
+      FreeNode *node = head;
+      head = node->next;
+      return node;
+    }
+
+    ++lists().heap_allocations;
+    return ::operator new(cls * SIZE_CLASS);
+  }
+
+  static void deallocate(void *ptr, size_t size) {
+    const size_t cls = (size + SIZE_CLASS - 1) / SIZE_CLASS;
+    if (cls >= NUM_CLASSES) {
+      ::operator delete(ptr);
+      return;
+    }
+
+    auto *node = static_cast<FreeNode *>(ptr);
+    node->next = lists().heads[cls];
+    lists().heads[cls] = node;
+  }
+
+  // Frames obtained from the global heap on this thread (pool misses)
+  static uint64_t heap_allocations() { return lists().heap_allocations; }
+
+private:
+  struct FreeNode {
+    FreeNode *next;
+  };
+
+  struct FreeLists {
+    FreeNode *heads[NUM_CLASSES] = {};
+    uint64_t heap_allocations = 0;
+
+    ~FreeLists() {
+      for (FreeNode *&head : heads) {
+        while (head != nullptr) {
+          FreeNode *next = head->next;
+          ::operator delete(head);
+          head = next;
+        }
+      }
+    }
+  };
+
+  static FreeLists &lists() {
+    thread_local FreeLists free_lists;
+    return free_lists;
+  }
+};
+
+template <typename T = void> class Task;
+
+namespace detail {
+
+struct TaskPromiseBase {
+  std::coroutine_handle<> continuation{std::noop_coroutine()};
+
+  static void *operator new(size_t size) { return FramePool::allocate(size); }
+  static void operator delete(void *ptr, size_t size) {
+    FramePool::deallocate(ptr, size);
+  }
+
+  struct FinalAwaiter {
+    bool await_ready() const noexcept { return false; }
+
+    template <typename Promise>
+    std::coroutine_handle<>
+    await_suspend(std::coroutine_handle<Promise> handle) const noexcept {
+      return handle.promise().continuation;
+    }
+
+    void await_resume() const noexcept {}
+  };
+
+  std::suspend_always initial_suspend() const noexcept { return {}; }
+  FinalAwaiter final_suspend() const noexcept { return {}; }
+  void unhandled_exception() const noexcept { std::terminate(); }
+};
+
+} // namespace detail
+
+// Lazily-started coroutine. Awaiting a Task starts it and resumes the awaiter
+// by symmetric transfer when it completes, so chains of awaits do not grow
+// the stack. Results must be default constructible.
+template <typename T> class Task {
+public:
+  struct promise_type : detail::TaskPromiseBase {
+    T value{};
+
+    Task get_return_object() noexcept {
+      return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+    }
+
+    void return_value(T result) noexcept { value = std::move(result); }
+  };
+
+  Task() = default;
+  explicit Task(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+  ~Task() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+  Task(const Task &) = delete;
+  Task &operator=(const Task &) = delete;
+  Task(Task &&other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+  Task &operator=(Task &&other) noexcept {
+    if (this != &other) {
+      if (handle_) {
+        handle_.destroy();
+      }
+      handle_ = std::exchange(other.handle_, {});
+    }
+    return *this;
+  }
+
+  bool done() const { return !handle_ || handle_.done(); }
+
+  auto operator co_await() noexcept {
+    struct Awaiter {
+      std::coroutine_handle<promise_type> handle;
+
+      bool await_ready() const noexcept { return !handle || handle.done(); }
+
+      std::coroutine_handle<>
+      await_suspend(std::coroutine_handle<> awaiting) const noexcept {
+        handle.promise().continuation = awaiting;
+        return handle;
+      }
+
+      T await_resume() const noexcept { return std::move(handle.promise().value); }
+    };
+    return Awaiter{handle_};
+  }
+
+private:
+  std::coroutine_handle<promise_type> handle_;
+};
+
+template <> class Task<void> {
+public:
+  struct promise_type : detail::TaskPromiseBase {
+    Task get_return_object() noexcept {
+      return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+    }
+
+    void return_void() const noexcept {}
+  };
+
+  Task() = default;
+  explicit Task(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+  ~Task() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+  Task(const Task &) = delete;
+  Task &operator=(const Task &) = delete;
+  Task(Task &&other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+  Task &operator=(Task &&other) noexcept {
+    if (this != &other) {
+      if (handle_) {
+        handle_.destroy();
+      }
+      handle_ = std::exchange(other.handle_, {});
+    }
+    return *this;
+  }
+
+  bool done() const { return !handle_ || handle_.done(); }
+
+  auto operator co_await() noexcept {
+    struct Awaiter {
+      std::coroutine_handle<promise_type> handle;
+
+      bool await_ready() const noexcept { return !handle || handle.done(); }
+
+      std::coroutine_handle<>
+      await_suspend(std::coroutine_handle<> awaiting) const noexcept {
+        handle.promise().continuation = awaiting;
+        return handle;
+      }
+
+      void await_resume() const noexcept {}
+    };
+    return Awaiter{handle_};
+  }
+
+private:
+  std::coroutine_handle<promise_type> handle_;
+};
+
+} // namespace mini_mart::server
@@ -3,6 +3,7 @@
 #include <arpa/inet.h>
 #include <netinet/in.h>
 #include <sys/socket.h>
+#include <sys/types.h>
 #include <unistd.h>
 
 namespace mini_mart::server {
@@ -34,6 +35,12 @@ public:
   bool set_destination(const char *host, int port, sockaddr_in &out_dst);
   bool enable_reuseaddr();
   bool bind_any(int port);
+  bool set_nonblocking();
+  int local_port() const;
+
+  // Return bytes transferred or -errno; do not touch last_error()
+  ssize_t send_to(const void *data, size_t length, const sockaddr_in &dst);
+  ssize_t recv_from(void *buffer, size_t length, sockaddr_in *src);
 
 private:
   int fd_{-1};
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+namespace mini_mart::types {
+
+// 128-bit intermediates for notional and cross-scale arithmetic
+__extension__ typedef __int128 int128_t;
+__extension__ typedef unsigned __int128 uint128_t;
+
+constexpr uint64_t power_of_ten(unsigned exponent) noexcept {
+    uint64_t result = 1;
+    for (unsigned i = 0; i < exponent; ++i) {
+        result *= 10;
+    }
+    return result;
+}
+
+// Exact floor(value / 10^N) for a 128-bit value. The divisor is a
+// compile-time constant below 2^32, so the long division runs in three
+// 64-bit steps (high word, then two 32-bit digits) that the compiler
+// lowers to multiply-and-shift instead of calling the 128-bit divide.
+template <unsigned N> constexpr uint128_t divide_pow10(uint128_t value) noexcept {
+    if constexpr (N == 0) {
+        return value;
+    } else if constexpr (N > 9) {
+        return divide_pow10<N - 9>(divide_pow10<9>(value));
+    } else {
+        constexpr uint64_t DIVISOR = power_of_ten(N);
+        const auto high = static_cast<uint64_t>(value >> 64);
+        const auto low = static_cast<uint64_t>(value);
+
+        const uint64_t quotient_high = high / DIVISOR;
+        uint64_t remainder = high % DIVISOR;
+        const uint64_t middle = (remainder << 32) | (low >> 32);
+        const uint64_t quotient_middle = middle / DIVISOR;
+        remainder = middle % DIVISOR;
+        const uint64_t bottom = (remainder << 32) | (low & 0xffffffffu);
+        const uint64_t quotient_low = bottom / DIVISOR;
+
+        return (static_cast<uint128_t>(quotient_high) << 64) |
+               (static_cast<uint128_t>(quotient_middle) << 32) | quotient_low;
+    }
+}
+
+// Decimal fixed-point number: value = raw / 10^Scale. Price is
+// FixedPoint<4>; FX and crypto use other scales (see aliases below).
+// UNSAFE/FAST like Price: no overflow or underflow checks, fail fast.
+template <unsigned Scale, typename Rep = uint64_t> class FixedPoint {
+    static_assert(std::is_integral_v<Rep> && sizeof(Rep) <= 8, "Rep must be a 64-bit or narrower integer");
+    static_assert(Scale <= 18, "10^Scale must fit in 64 bits");
+
+    Rep value_;
+
+public:
+    using rep = Rep;
+    static constexpr unsigned SCALE = Scale;
+    static constexpr Rep ONE = static_cast<Rep>(power_of_ten(Scale)); // raw value of 1.0
+
+    // Constructors
+    constexpr FixedPoint() noexcept : value_(0) {}
+    constexpr FixedPoint(Rep raw) noexcept : value_(raw) {}
+    constexpr FixedPoint(double value) noexcept : value_(static_cast<Rep>(value * static_cast<double>(ONE))) {}
+
+    // ULTRA-FAST arithmetic - no bounds checking, no branches
+    constexpr FixedPoint operator+(FixedPoint rhs) const noexcept { return FixedPoint{static_cast<Rep>(value_ + rhs.value_)}; }
+    constexpr FixedPoint operator-(FixedPoint rhs) const noexcept { return FixedPoint{static_cast<Rep>(value_ - rhs.value_)}; }
+    constexpr FixedPoint operator+(Rep offset) const noexcept { return FixedPoint{static_cast<Rep>(value_ + offset)}; }
+    constexpr FixedPoint operator-(Rep offset) const noexcept { return FixedPoint{static_cast<Rep>(value_ - offset)}; }
+
+    // ULTRA-FAST assignment operators
+    constexpr FixedPoint& operator+=(FixedPoint rhs) noexcept { value_ += rhs.value_; return *this; }
+    constexpr FixedPoint& operator-=(FixedPoint rhs) noexcept { value_ -= rhs.value_; return *this; }
+    constexpr FixedPoint& operator+=(Rep offset) noexcept { value_ += offset; return *this; }
+    constexpr FixedPoint& operator-=(Rep offset) noexcept { value_ -= offset; return *this; }
+
+    // Scaling by plain integers (fixed x fixed goes through fixed_multiply)
+    constexpr FixedPoint operator*(Rep multiplier) const noexcept { return FixedPoint{static_cast<Rep>(value_ * multiplier)}; }
+    constexpr FixedPoint operator/(Rep divisor) const noexcept { return FixedPoint{static_cast<Rep>(value_ / divisor)}; }
+    constexpr FixedPoint& operator*=(Rep multiplier) noexcept { value_ *= multiplier; return *this; }
+    constexpr FixedPoint& operator/=(Rep divisor) noexcept { value_ /= divisor; return *this; }
+
+    // Comparison operators (zero-cost)
+    constexpr bool operator==(FixedPoint rhs) const noexcept { return value_ == rhs.value_; }
+    constexpr bool operator!=(FixedPoint rhs) const noexcept { return value_ != rhs.value_; }
+    constexpr bool operator<(FixedPoint rhs) const noexcept { return value_ < rhs.value_; }
+    constexpr bool operator<=(FixedPoint rhs) const noexcept { return value_ <= rhs.value_; }
+    constexpr bool operator>(FixedPoint rhs) const noexcept { return value_ > rhs.value_; }
+    constexpr bool operator>=(FixedPoint rhs) const noexcept { return value_ >= rhs.value_; }
+
+    // Comparison with raw values (for literals)
+    constexpr bool operator==(Rep rhs) const noexcept { return value_ == rhs; }
+    constexpr bool operator!=(Rep rhs) const noexcept { return value_ != rhs; }
+    constexpr bool operator<(Rep rhs) const noexcept { return value_ < rhs; }
+    constexpr bool operator<=(Rep rhs) const noexcept { return value_ <= rhs; }
+    constexpr bool operator>(Rep rhs) const noexcept { return value_ > rhs; }
+    constexpr bool operator>=(Rep rhs) const noexcept { return value_ >= rhs; }
+
+    // Conversions (inlined)
+    constexpr Rep raw() const noexcept { return value_; }
+    constexpr double to_double() const noexcept { return static_cast<double>(value_) / static_cast<double>(ONE); }
+    constexpr double dollars() const noexcept { return to_double(); }
+
+    // Explicit conversion to the raw representation for backward compatibility
+    constexpr explicit operator Rep() const noexcept { return value_; }
+
+    // Utility methods
+    constexpr bool is_zero() const noexcept { return value_ == 0; }
+    constexpr FixedPoint abs_diff(FixedPoint other) const noexcept {
+        return value_ >= other.value_ ? FixedPoint{static_cast<Rep>(value_ - other.value_)}
+                                      : FixedPoint{static_cast<Rep>(other.value_ - value_)};
+    }
+
+    // Reverse operations (Rep op FixedPoint); hidden friends so literals of
+    // other integer types still convert
+    friend constexpr FixedPoint operator+(Rep lhs, FixedPoint rhs) noexcept { return FixedPoint{lhs} + rhs; }
+    friend constexpr FixedPoint operator-(Rep lhs, FixedPoint rhs) noexcept { return FixedPoint{lhs} - rhs; }
+    friend constexpr FixedPoint operator*(Rep lhs, FixedPoint rhs) noexcept { return rhs * lhs; }
+};
+
+namespace detail {
+
+template <typename Rep> using wide_t = std::conditional_t<std::is_signed_v<Rep>, int128_t, uint128_t>;
+
+// raw * 10^To / 10^From in 128 bits, truncating toward zero
+template <unsigned From, unsigned To, typename Wide> constexpr Wide rescale_raw(Wide raw) noexcept {
+    if constexpr (To >= From) {
+        Wide factor = 1;
+        for (unsigned i = From; i < To; ++i) {
+            factor *= 10;
+        }
+        return raw * factor;
+    } else if constexpr (static_cast<Wide>(-1) < 0) { // is_signed_v is false for __int128 in strict mode
+        const auto magnitude = static_cast<uint128_t>(raw < 0 ? -raw : raw);
+        const auto quotient = static_cast<Wide>(divide_pow10<From - To>(magnitude));
+        return raw < 0 ? -quotient : quotient;
+    } else {
+        return divide_pow10<From - To>(raw);
+    }
+}
+
+} // namespace detail
+
+// Cross-scale conversion, truncating toward zero like duration_cast
+template <typename To, unsigned Scale, typename Rep>
+constexpr To fixed_point_cast(FixedPoint<Scale, Rep> from) noexcept {
+    using Wide = detail::wide_t<typename To::rep>;
+    return To{static_cast<typename To::rep>(
+        detail::rescale_raw<Scale, To::SCALE>(static_cast<Wide>(from.raw())))};
+}
+
+// a * b at the result's scale with a 128-bit intermediate, so a price times
+// a quantity (or two 8-decimal crypto values) cannot overflow mid-way
+template <typename Result, unsigned ScaleA, typename RepA, unsigned ScaleB, typename RepB>
+constexpr Result fixed_multiply(FixedPoint<ScaleA, RepA> a, FixedPoint<ScaleB, RepB> b) noexcept {
+    using Wide = detail::wide_t<typename Result::rep>;
+    const Wide product = static_cast<Wide>(a.raw()) * static_cast<Wide>(b.raw());
+    return Result{static_cast<typename Result::rep>(detail::rescale_raw<ScaleA + ScaleB, Result::SCALE>(product))};
+}
+
+// a / b at the result's scale with a 128-bit intermediate (truncates);
+// b must be non-zero
+template <typename Result, unsigned ScaleA, typename RepA, unsigned ScaleB, typename RepB>
+constexpr Result fixed_divide(FixedPoint<ScaleA, RepA> a, FixedPoint<ScaleB, RepB> b) noexcept {
+    using Wide = detail::wide_t<typename Result::rep>;
+    // a / b = (raw_a / raw_b) * 10^(ScaleB - ScaleA); scale up before dividing
+    const Wide numerator = detail::rescale_raw<0, Result::SCALE + ScaleB>(static_cast<Wide>(a.raw()));
+    const Wide denominator = static_cast<Wide>(b.raw()) * static_cast<Wide>(power_of_ten(ScaleA));
+    return Result{static_cast<typename Result::rep>(numerator / denominator)};
+}
+
+// Common instrument scales
+using FxRate = FixedPoint<5>;         // EUR/USD 1.08515
+using JpyFxRate = FixedPoint<3>;      // USD/JPY 151.234
+using CryptoPrice = FixedPoint<8>;    // BTC/USD to the satoshi
+using CryptoQuantity = FixedPoint<8>; // fractional coin amounts
+using SignedAmount = FixedPoint<4, int64_t>;
+
+} // namespace mini_mart::types
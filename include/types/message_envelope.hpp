@@ -0,0 +1,150 @@
+#pragma once
+
+#include "types/messages.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace mini_mart::types {
+
+// Fixed-size slot holding any one message of Ts, keyed by header.type, so
+// a single ring can carry a mixed stream. Every message type starts with a
+// MessageHeader and names its MessageType in TYPE. visit() routes to a
+// handler through a compare chain folded over the type list at compile
+// time, which the compiler lowers like a switch with the handlers inlined
+// (a function-pointer table measured no faster than virtual calls).
+template <typename... Ts> class MessageEnvelope {
+  static_assert(sizeof...(Ts) > 0, "an envelope needs at least one message type");
+  static_assert((std::is_trivially_copyable_v<Ts> && ...),
+                "messages are copied as bytes");
+  static_assert(((offsetof(Ts, header) == 0) && ...),
+                "messages must start with their MessageHeader");
+
+public:
+  static constexpr size_t SIZE = std::max({sizeof(Ts)...});
+  static constexpr size_t ALIGNMENT = std::max({alignof(Ts)...});
+  // Largest MessageType held; sizes the per-type SIZES array
+  static constexpr size_t MAX_TYPE = std::max({static_cast<size_t>(Ts::TYPE)...});
+
+  template <typename T>
+  static constexpr bool holds = (std::is_same_v<T, Ts> || ...);
+
+  // Only the header is cleared: reads as no message, without zeroing the slot
+  MessageEnvelope() noexcept { std::memset(storage_, 0, sizeof(MessageHeader)); }
+
+  template <typename T>
+    requires holds<T>
+  MessageEnvelope(const T &message) noexcept {
+    store(message);
+  }
+
+  // Copies message in and stamps header.type/length
+  template <typename T>
+    requires holds<T>
+  void store(const T &message) noexcept {
+    std::memcpy(storage_, &message, sizeof(T));
+    MessageHeader &header = mutable_header();
+    header.type = static_cast<uint16_t>(T::TYPE);
+    header.length = static_cast<uint16_t>(sizeof(T));
+  }
+
+  // Decodes a message received as bytes; false if its type is not in Ts or
+  // the length does not match
+  bool assign(const void *bytes, size_t length) {
+    if (length < sizeof(MessageHeader)) {
+      return false;
+    }
+    MessageHeader header;
+    std::memcpy(&header, bytes, sizeof(header));
+    if (!known_type(header.type) || header.length != length ||
+        length != SIZES[header.type]) {
+      return false;
+    }
+    std::memcpy(storage_, bytes, length);
+    return true;
+  }
+
+  const MessageHeader &header() const {
+    return *std::launder(reinterpret_cast<const MessageHeader *>(storage_));
+  }
+
+  MessageType type() const { return static_cast<MessageType>(header().type); }
+
+  template <typename T>
+    requires holds<T>
+  bool is() const {
+    return type() == T::TYPE;
+  }
+
+  // Caller must have checked is<T>()
+  template <typename T>
+    requires holds<T>
+  const T &as() const {
+    return *std::launder(reinterpret_cast<const T *>(storage_));
+  }
+
+  template <typename T>
+    requires holds<T>
+  T &as() {
+    return *std::launder(reinterpret_cast<T *>(storage_));
+  }
+
+  // Calls fn(as<T>()) for the held T. fn must accept every T in Ts and
+  // return the same type for all of them; an envelope that was never
+  // assigned returns a value-initialized result.
+  template <typename Fn> decltype(auto) visit(Fn &&fn) const {
+    using Result = std::invoke_result_t<Fn &, const FirstType &>;
+    const uint16_t type = header().type;
+    if constexpr (std::is_void_v<Result>) {
+      (void)((type == static_cast<uint16_t>(Ts::TYPE) ? (fn(as<Ts>()), true) : false) ||
+             ...);
+    } else {
+      Result result{};
+      (void)((type == static_cast<uint16_t>(Ts::TYPE) ? (result = fn(as<Ts>()), true)
+                                                      : false) ||
+             ...);
+      return result;
+    }
+  }
+
+private:
+  using FirstType = std::tuple_element_t<0, std::tuple<Ts...>>;
+
+  static constexpr auto SIZES = [] {
+    std::array<size_t, MAX_TYPE + 1> sizes{};
+    ((sizes[static_cast<size_t>(Ts::TYPE)] = sizeof(Ts)), ...);
+    return sizes;
+  }();
+
+  static constexpr bool known_type(size_t type) {
+    return type <= MAX_TYPE && SIZES[type] != 0;
+  }
+
+  MessageHeader &mutable_header() {
+    return *std::launder(reinterpret_cast<MessageHeader *>(storage_));
+  }
+
+  alignas(ALIGNMENT) std::byte storage_[SIZE];
+};
+
+// Everything the market data feed carries; same 192-byte slot as a bare
+// MarketDataL2Message
+using MarketDataEnvelope =
+    MessageEnvelope<MarketDataL2Message, TradeMessage, BookDeltaMessage, HeartbeatMessage>;
+static_assert(sizeof(MarketDataEnvelope) == sizeof(MarketDataL2Message),
+              "MarketDataEnvelope must not grow the ring slot");
+
+// Messages carrying an event time (heartbeats do not)
+template <typename M>
+concept TimestampedMessage = requires(const M &message) { message.timestamp_ns; };
+
+template <typename T> inline constexpr bool is_message_envelope_v = false;
+template <typename... Ts>
+inline constexpr bool is_message_envelope_v<MessageEnvelope<Ts...>> = true;
+
+} // namespace mini_mart::types
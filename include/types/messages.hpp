@@ -8,6 +8,10 @@ namespace mini_mart::types {
 
 enum class MessageType : uint16_t {
   MARKET_DATA_L2 = 1,
+  HEARTBEAT = 2,
+  TRADE = 3,
+  BOOK_DELTA = 4,
+  ORDER_EVENT = 5,
 };
 
 enum class Side : uint8_t {
@@ -35,6 +39,7 @@ struct MessageHeader {
 static_assert(sizeof(MessageHeader) == 8, "MessageHeader size is not 8 bytes");
 
 struct HeartbeatMessage {
+  static constexpr MessageType TYPE = MessageType::HEARTBEAT;
   MessageHeader header;
 };
 static_assert(sizeof(HeartbeatMessage) == 8,
@@ -42,6 +47,7 @@ static_assert(sizeof(HeartbeatMessage) == 8,
 
 // L2 Market Data Message - contains top 5 levels for both sides
 struct MarketDataL2Message {
+  static constexpr MessageType TYPE = MessageType::MARKET_DATA_L2;
   MessageHeader header;
   SecurityId security_id;
   uint64_t timestamp_ns;          // nanoseconds since epoch
@@ -54,4 +60,64 @@ struct MarketDataL2Message {
 static_assert(sizeof(MarketDataL2Message) == 192,
               "MarketDataL2Message size is not 192 bytes");
 
-} // namespace mini_mart::types
\ No newline at end of file
+// Last-sale print
+struct TradeMessage {
+  static constexpr MessageType TYPE = MessageType::TRADE;
+  MessageHeader header;
+  SecurityId security_id;
+  uint64_t timestamp_ns;
+  Price price;
+  Quantity quantity;
+  Side aggressor;
+  uint8_t padding[7];
+};
+static_assert(sizeof(TradeMessage) == 48, "TradeMessage size is not 48 bytes");
+
+enum class DeltaAction : uint8_t {
+  SET = 0,    // replace the level at level_index
+  DELETE = 1, // remove it, shifting deeper levels up
+};
+
+// Incremental change to one of the top 5 levels of a book side
+struct BookDeltaMessage {
+  static constexpr MessageType TYPE = MessageType::BOOK_DELTA;
+  MessageHeader header;
+  SecurityId security_id;
+  uint64_t timestamp_ns;
+  PriceLevel level;
+  Side side;
+  uint8_t level_index; // 0 = best
+  DeltaAction action;
+  uint8_t padding[5];
+};
+static_assert(sizeof(BookDeltaMessage) == 48,
+              "BookDeltaMessage size is not 48 bytes");
+
+// An order is gone once cancels and fills leave nothing of it
+enum class OrderAction : uint8_t {
+  ADD = 0,     // new resting order
+  CANCEL = 1,  // quantity withdrawn by its owner
+  EXECUTE = 2, // quantity filled
+};
+
+// Order-level (L3) event attributed to a participant, e.g. replayed from
+// recorded venue data. participant_id is the owner of order_id, on an
+// EXECUTE too: the resting side, not the aggressor (consumers that track
+// the order, like SurveillanceEngine, go by its owner when they differ).
+struct OrderEventMessage {
+  static constexpr MessageType TYPE = MessageType::ORDER_EVENT;
+  MessageHeader header;
+  SecurityId security_id;
+  uint64_t timestamp_ns;
+  uint64_t order_id;
+  Price price;
+  Quantity quantity; // added, cancelled or executed; 0 cancels all that is left
+  uint32_t participant_id;
+  Side side;
+  OrderAction action;
+  uint8_t padding[2];
+};
+static_assert(sizeof(OrderEventMessage) == 56,
+              "OrderEventMessage size is not 56 bytes");
+
+} // namespace mini_mart::types
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "types/fixed_point.hpp"
+#include "types/messages.hpp"
+#include "types/price.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace mini_mart::types {
+
+// Sum of price x quantity at Price's scale, held in 128 bits so a day of
+// volume on any symbol cannot wrap (Price * uint64_t silently does).
+class Notional {
+  uint128_t value_;
+
+public:
+  static constexpr unsigned SCALE = Price::SCALE;
+
+  constexpr Notional() noexcept : value_(0) {}
+  constexpr explicit Notional(uint128_t raw) noexcept : value_(raw) {}
+
+  // One 64x64->128 multiply
+  static constexpr Notional of(Price price, Quantity quantity) noexcept {
+    return Notional{static_cast<uint128_t>(price.raw()) * quantity};
+  }
+
+  constexpr Notional operator+(Notional rhs) const noexcept { return Notional{value_ + rhs.value_}; }
+  constexpr Notional operator-(Notional rhs) const noexcept { return Notional{value_ - rhs.value_}; }
+  constexpr Notional &operator+=(Notional rhs) noexcept {
+    value_ += rhs.value_;
+    return *this;
+  }
+  constexpr Notional &operator-=(Notional rhs) noexcept {
+    value_ -= rhs.value_;
+    return *this;
+  }
+
+  constexpr bool operator==(Notional rhs) const noexcept { return value_ == rhs.value_; }
+  constexpr bool operator!=(Notional rhs) const noexcept { return value_ != rhs.value_; }
+  constexpr bool operator<(Notional rhs) const noexcept { return value_ < rhs.value_; }
+  constexpr bool operator<=(Notional rhs) const noexcept { return value_ <= rhs.value_; }
+  constexpr bool operator>(Notional rhs) const noexcept { return value_ > rhs.value_; }
+  constexpr bool operator>=(Notional rhs) const noexcept { return value_ >= rhs.value_; }
+
+  constexpr uint128_t raw() const noexcept { return value_; }
+  constexpr bool is_zero() const noexcept { return value_ == 0; }
+
+  // Truncated to whole dollars
+  constexpr uint128_t whole_dollars() const noexcept { return divide_pow10<SCALE>(value_); }
+
+  // At another (coarser or finer) fixed-point scale, truncating; the caller
+  // must know the result fits To's representation
+  template <typename To> constexpr To to_fixed() const noexcept {
+    if constexpr (To::SCALE <= SCALE) {
+      return To{static_cast<typename To::rep>(divide_pow10<SCALE - To::SCALE>(value_))};
+    } else {
+      return To{static_cast<typename To::rep>(value_ * power_of_ten(To::SCALE - SCALE))};
+    }
+  }
+
+  // Reporting only: loses precision past 2^53 raw units
+  constexpr double to_double() const noexcept {
+    return static_cast<double>(value_) / static_cast<double>(Price::ONE);
+  }
+
+  // Notional / quantity as a Price, truncated (VWAP, average fill price).
+  // quantity must be non-zero.
+  constexpr Price per_unit(uint64_t quantity) const noexcept {
+    // 64-bit divide when the sum still fits, which is the common case
+    if ((value_ >> 64) == 0) {
+      return Price{static_cast<uint64_t>(value_) / quantity};
+    }
+    return Price{static_cast<uint64_t>(value_ / quantity)};
+  }
+};
+
+// Running volume-weighted average price; exact, no floating point
+class VwapAccumulator {
+public:
+  constexpr void add(Price price, Quantity quantity) noexcept {
+    notional_ += Notional::of(price, quantity);
+    volume_ += quantity;
+  }
+
+  // Batch form for book levels or a block of prints. Sums raw products
+  // directly so the loop is one mul and an add/adc pair per level.
+  constexpr void add(const PriceLevel *levels, size_t count) noexcept {
+    uint128_t notional = 0;
+    uint64_t volume = 0;
+    for (size_t i = 0; i < count; ++i) {
+      notional += static_cast<uint128_t>(levels[i].price.raw()) * levels[i].quantity;
+      volume += levels[i].quantity;
+    }
+    notional_ += Notional{notional};
+    volume_ += volume;
+  }
+
+  constexpr void merge(const VwapAccumulator &other) noexcept {
+    notional_ += other.notional_;
+    volume_ += other.volume_;
+  }
+
+  constexpr void reset() noexcept {
+    notional_ = Notional{};
+    volume_ = 0;
+  }
+
+  // Zero until something with non-zero quantity has been added
+  constexpr Price vwap() const noexcept { return volume_ == 0 ? Price{} : notional_.per_unit(volume_); }
+  constexpr Notional notional() const noexcept { return notional_; }
+  constexpr uint64_t volume() const noexcept { return volume_; }
+
+private:
+  Notional notional_{};
+  uint64_t volume_{0};
+};
+
+// Time-weighted average price: each sample's price is weighted by how long
+// it stood, i.e. until the next sample. The last sample carries no weight
+// until a later sample (or close()) ends its interval.
+class TwapAccumulator {
+public:
+  constexpr void sample(Price price, uint64_t timestamp_ns) noexcept {
+    if (has_sample_) {
+      const uint64_t elapsed = timestamp_ns - last_timestamp_ns_;
+      weighted_ += static_cast<uint128_t>(last_price_.raw()) * elapsed;
+      duration_ns_ += elapsed;
+    }
+    last_price_ = price;
+    last_timestamp_ns_ = timestamp_ns;
+    has_sample_ = true;
+  }
+
+  // Batch form: levels[i].price (e.g. the best bid) observed at
+  // timestamps_ns[i], timestamps non-decreasing
+  constexpr void sample(const PriceLevel *levels, const uint64_t *timestamps_ns, size_t count) noexcept {
+    if (count == 0) {
+      return;
+    }
+    sample(levels[0].price, timestamps_ns[0]);
+    uint128_t weighted = 0;
+    for (size_t i = 1; i < count; ++i) {
+      weighted += static_cast<uint128_t>(levels[i - 1].price.raw()) * (timestamps_ns[i] - timestamps_ns[i - 1]);
+    }
+    weighted_ += weighted;
+    duration_ns_ += timestamps_ns[count - 1] - timestamps_ns[0];
+    last_price_ = levels[count - 1].price;
+    last_timestamp_ns_ = timestamps_ns[count - 1];
+  }
+
+  // Ends the open interval at timestamp_ns (e.g. the window end); nothing
+  // to end before the first sample
+  constexpr void close(uint64_t timestamp_ns) noexcept {
+    if (has_sample_) {
+      sample(last_price_, timestamp_ns);
+    }
+  }
+
+  constexpr void reset() noexcept { *this = TwapAccumulator{}; }
+
+  // Zero until two samples at different times have been seen
+  constexpr Price twap() const noexcept {
+    return duration_ns_ == 0 ? Price{} : Notional{weighted_}.per_unit(duration_ns_);
+  }
+  constexpr uint64_t duration_ns() const noexcept { return duration_ns_; }
+
+private:
+  uint128_t weighted_{0}; // sum of price raw x ns
+  uint64_t duration_ns_{0};
+  uint64_t last_timestamp_ns_{0};
+  Price last_price_{};
+  bool has_sample_{false};
+};
+
+} // namespace mini_mart::types
@@ -1,72 +1,14 @@
 #pragma once
 
+#include "types/fixed_point.hpp"
 #include <cstdint>
 
 namespace mini_mart::types {
 
-// Ultra-fast Price type for USD securities (4 decimal places)
-// UNSAFE/FAST: No underflow protection - fail fast for logic errors
-class Price {
-    uint64_t value_;
-    
-public:
-    // Constructors
-    constexpr Price() noexcept : value_(0) {}
-    constexpr Price(uint64_t raw) noexcept : value_(raw) {}
-    constexpr Price(double dollars) noexcept : value_(static_cast<uint64_t>(dollars * 10000.0)) {}
-    
-    // ULTRA-FAST arithmetic - no bounds checking, no branches
-    constexpr Price operator+(Price rhs) const noexcept { return Price{value_ + rhs.value_}; }
-    constexpr Price operator-(Price rhs) const noexcept { return Price{value_ - rhs.value_}; }
-    constexpr Price operator+(uint64_t offset) const noexcept { return Price{value_ + offset}; }
-    constexpr Price operator-(uint64_t offset) const noexcept { return Price{value_ - offset}; }
-    
-    // ULTRA-FAST assignment operators
-    constexpr Price& operator+=(Price rhs) noexcept { value_ += rhs.value_; return *this; }
-    constexpr Price& operator-=(Price rhs) noexcept { value_ -= rhs.value_; return *this; }
-    constexpr Price& operator+=(uint64_t offset) noexcept { value_ += offset; return *this; }
-    constexpr Price& operator-=(uint64_t offset) noexcept { value_ -= offset; return *this; }
-    
-    // Multiplication and division for calculations
-    constexpr Price operator*(uint64_t multiplier) const noexcept { return Price{value_ * multiplier}; }
-    constexpr Price operator/(uint64_t divisor) const noexcept { return Price{value_ / divisor}; }
-    constexpr Price& operator*=(uint64_t multiplier) noexcept { value_ *= multiplier; return *this; }
-    constexpr Price& operator/=(uint64_t divisor) noexcept { value_ /= divisor; return *this; }
-    
-    // Comparison operators (zero-cost)
-    constexpr bool operator==(Price rhs) const noexcept { return value_ == rhs.value_; }
-    constexpr bool operator!=(Price rhs) const noexcept { return value_ != rhs.value_; }
-    constexpr bool operator<(Price rhs) const noexcept { return value_ < rhs.value_; }
-    constexpr bool operator<=(Price rhs) const noexcept { return value_ <= rhs.value_; }
-    constexpr bool operator>(Price rhs) const noexcept { return value_ > rhs.value_; }
-    constexpr bool operator>=(Price rhs) const noexcept { return value_ >= rhs.value_; }
-    
-    // Comparison with raw values (for literals)
-    constexpr bool operator==(uint64_t rhs) const noexcept { return value_ == rhs; }
-    constexpr bool operator!=(uint64_t rhs) const noexcept { return value_ != rhs; }
-    constexpr bool operator<(uint64_t rhs) const noexcept { return value_ < rhs; }
-    constexpr bool operator<=(uint64_t rhs) const noexcept { return value_ <= rhs; }
-    constexpr bool operator>(uint64_t rhs) const noexcept { return value_ > rhs; }
-    constexpr bool operator>=(uint64_t rhs) const noexcept { return value_ >= rhs; }
-    
-    // Conversions (inlined)
-    constexpr uint64_t raw() const noexcept { return value_; }
-    constexpr double dollars() const noexcept { return static_cast<double>(value_) / 10000.0; }
-    
-    // Explicit conversion to uint64_t for backward compatibility
-    constexpr explicit operator uint64_t() const noexcept { return value_; }
-    
-    // Utility methods
-    constexpr bool is_zero() const noexcept { return value_ == 0; }
-    constexpr Price abs_diff(Price other) const noexcept { 
-        return value_ >= other.value_ ? Price{value_ - other.value_} : Price{other.value_ - value_}; 
-    }
-};
-
-// Free functions for reverse operations (uint64_t op Price)
-constexpr Price operator+(uint64_t lhs, Price rhs) noexcept { return Price{lhs} + rhs; }
-constexpr Price operator-(uint64_t lhs, Price rhs) noexcept { return Price{lhs} - rhs; }
-constexpr Price operator*(uint64_t lhs, Price rhs) noexcept { return rhs * lhs; }
+// Ultra-fast Price type for USD securities (4 decimal places); a plain
+// alias so every Price operation compiles exactly as before
+using Price = FixedPoint<4, uint64_t>;
+static_assert(sizeof(Price) == sizeof(uint64_t), "Price must stay a bare uint64_t");
 
 // Factory functions to avoid constructor ambiguity
 constexpr Price price_from_raw(uint64_t raw) noexcept { return Price{raw}; }
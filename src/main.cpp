@@ -1,6 +1,8 @@
+#include "market_data/layout_report.hpp"
 #include "market_data/market_data_feed.hpp"
 #include "market_data/random_market_data_provider.hpp"
 #include "market_data/security_seeder.hpp"
+#include "market_data/security_store_checkpoint.hpp"
 #include "common/time_utils.hpp"
 #include <chrono>
 #include <csignal>
@@ -21,6 +23,7 @@ void signal_handler(int signal) {
 }
 
 int main() {
+  mini_mart::market_data::print_layout_report(std::cout, 8);
 
   // HFT STRESS TEST configuration: Simulate wild market activity spikes
   mini_mart::market_data::RandomMarketDataProvider::Config hft_config;
@@ -38,8 +41,26 @@ int main() {
       std::make_shared<mini_mart::market_data::RandomMarketDataProvider>(
           hft_config);
   auto store = std::make_shared<mini_mart::market_data::SecurityStore>();
-  g_feed =
-      std::make_unique<mini_mart::market_data::MarketDataFeed>(provider, store);
+
+  // Warm start: serve last-known (stale) books until live updates arrive
+  mini_mart::market_data::SecurityStoreCheckpointer::Config checkpoint_config;
+  checkpoint_config.path = "mini_mart.checkpoint";
+  const int restored = mini_mart::market_data::SecurityStoreCheckpointer::restore(
+      *store, checkpoint_config.path);
+  if (restored > 0) {
+    std::cout << "Restored " << restored << " securities from checkpoint"
+              << std::endl;
+  }
+  mini_mart::market_data::SecurityStoreCheckpointer checkpointer(
+      store, checkpoint_config);
+  // Latency SLOs per feed stage (p99 over each 1s window, per-message max)
+  mini_mart::market_data::MarketDataFeed::Config feed_config;
+  feed_config.latency_budgets[static_cast<size_t>(
+      mini_mart::market_data::FeedStage::RING_WAIT)] = {50000, 1000000};
+  feed_config.latency_budgets[static_cast<size_t>(
+      mini_mart::market_data::FeedStage::STORE_APPLY)] = {2000, 100000};
+  g_feed = std::make_unique<mini_mart::market_data::MarketDataFeed>(
+      provider, store, feed_config);
 
   // Register signal handlers for graceful shutdown
   std::signal(SIGINT, signal_handler);  // Ctrl+C
@@ -61,6 +82,10 @@ int main() {
   g_feed->subscribe(mini_mart::market_data::SecuritySeeder::create_security_id("NVDA"));
   g_feed->subscribe(mini_mart::market_data::SecuritySeeder::create_security_id("NFLX"));
 
+  if (!checkpointer.start()) {
+    std::cerr << "Failed to start checkpointer" << std::endl;
+  }
+
   while (g_feed->is_running()) {
     std::this_thread::sleep_for(std::chrono::seconds(1));
 
@@ -80,9 +105,28 @@ int main() {
               << std::endl;
     std::cout << "Max latency: " << stats.max_latency_ns.load() << " ns"
               << std::endl;
+
+    for (size_t i = 0; i < mini_mart::market_data::FEED_STAGE_COUNT; ++i) {
+      const auto stage = static_cast<mini_mart::market_data::FeedStage>(i);
+      const auto snapshot = stats.latency.get_snapshot(stage);
+      std::cout << "  " << mini_mart::market_data::feed_stage_name(stage)
+                << ": p50 " << snapshot.p50_ns << " ns, p99 " << snapshot.p99_ns
+                << " ns, p99.9 " << snapshot.p999_ns << " ns, max "
+                << snapshot.max_ns << " ns" << std::endl;
+    }
+    mini_mart::market_data::LatencyAlarm alarm;
+    while (stats.latency.pop_alarm(alarm)) {
+      std::cout << "  SLO breach: " << mini_mart::market_data::feed_stage_name(alarm.stage)
+                << (alarm.kind == mini_mart::market_data::LatencyAlarmKind::P99_OVER_BUDGET
+                        ? " p99 "
+                        : " max ")
+                << alarm.observed_ns << " ns > " << alarm.budget_ns << " ns"
+                << std::endl;
+    }
   }
 
-  // Clean shutdown
+  // Clean shutdown (writes a final checkpoint)
+  checkpointer.stop();
   std::cout << "Market data feed stopped. Goodbye!" << std::endl;
   return 0;
 }
\ No newline at end of file
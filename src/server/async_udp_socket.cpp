@@ -0,0 +1,36 @@
+#include "server/async_udp_socket.hpp"
+#include <cerrno>
+
+namespace mini_mart::server {
+
+AsyncUdpSocket::AsyncUdpSocket(IoContext &context, UdpSocket socket)
+    : socket_(make_nonblocking(std::move(socket))),
+      fd_(context, socket_.fd()) {}
+
+Task<ssize_t> AsyncUdpSocket::recv_from(void *buffer, size_t length,
+                                        sockaddr_in *src) {
+  for (;;) {
+    const ssize_t n = socket_.recv_from(buffer, length, src);
+    if (n >= 0 || (n != -EAGAIN && n != -EWOULDBLOCK && n != -EINTR)) {
+      co_return n;
+    }
+    if (n != -EINTR) {
+      co_await fd_.readable();
+    }
+  }
+}
+
+Task<ssize_t> AsyncUdpSocket::send_to(const void *data, size_t length,
+                                      sockaddr_in dst) {
+  for (;;) {
+    const ssize_t n = socket_.send_to(data, length, dst);
+    if (n >= 0 || (n != -EAGAIN && n != -EWOULDBLOCK && n != -EINTR)) {
+      co_return n;
+    }
+    if (n != -EINTR) {
+      co_await fd_.writable();
+    }
+  }
+}
+
+} // namespace mini_mart::server
@@ -0,0 +1,345 @@
+#include "server/io_context.hpp"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace mini_mart::server {
+
+struct IoContext::DetachedPromise {
+  IoContext *context{nullptr};
+  DetachedPromise *prev{nullptr};
+  DetachedPromise *next{nullptr};
+
+  static void *operator new(size_t size) { return FramePool::allocate(size); }
+  static void operator delete(void *ptr, size_t size) {
+    FramePool::deallocate(ptr, size);
+  }
+
+  DetachedTask get_return_object() noexcept;
+  std::suspend_always initial_suspend() const noexcept { return {}; }
+  std::suspend_never final_suspend() const noexcept { return {}; }
+  void return_void() noexcept {
+    context->unlink_detached(this);
+    --context->outstanding_;
+  }
+  void unhandled_exception() const noexcept { std::terminate(); }
+};
+
+struct IoContext::DetachedTask {
+  using promise_type = DetachedPromise;
+  std::coroutine_handle<DetachedPromise> handle;
+};
+
+IoContext::DetachedTask IoContext::DetachedPromise::get_return_object() noexcept {
+  return DetachedTask{
+      std::coroutine_handle<DetachedPromise>::from_promise(*this)};
+}
+
+IoContext::DetachedTask IoContext::run_detached(IoContext &, Task<void> task) {
+  co_await task;
+}
+
+namespace {
+// Sentinel epoll tags for the context's own descriptors
+int wake_tag;
+int timer_tag;
+} // namespace
+
+IoContext::IoContext() {
+  epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+  wake_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  timer_fd_ = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  if (!is_valid()) {
+    return;
+  }
+
+  epoll_event event{};
+  event.events = EPOLLIN;
+  event.data.ptr = &wake_tag;
+  ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &event);
+  event.data.ptr = &timer_tag;
+  ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, timer_fd_, &event);
+
+  ready_.reserve(INITIAL_QUEUE_CAPACITY);
+  running_batch_.reserve(INITIAL_QUEUE_CAPACITY);
+  timers_.reserve(INITIAL_QUEUE_CAPACITY);
+}
+
+IoContext::~IoContext() {
+  // Frames of tasks that never finished (e.g. blocked on a socket)
+  while (detached_head_ != nullptr) {
+    DetachedPromise *promise = detached_head_;
+    unlink_detached(promise);
+    std::coroutine_handle<DetachedPromise>::from_promise(*promise).destroy();
+  }
+
+  for (int fd : {timer_fd_, wake_fd_, epoll_fd_}) {
+    if (fd >= 0) {
+      ::close(fd);
+    }
+  }
+}
+
+void IoContext::spawn(Task<void> task) {
+  DetachedTask detached = run_detached(*this, std::move(task));
+  DetachedPromise &promise = detached.handle.promise();
+  promise.context = this;
+  link_detached(&promise);
+  ++outstanding_;
+  post(detached.handle);
+}
+
+void IoContext::run() {
+  running_ = true;
+  epoll_event events[MAX_EVENTS];
+
+  while (!stop_requested_.load(std::memory_order_acquire)) {
+    drain_ready();
+    if (outstanding_ == 0) {
+      break;
+    }
+
+    const int timeout_ms = ready_.empty() ? -1 : 0;
+    const int count = ::epoll_wait(epoll_fd_, events,
+                                   static_cast<int>(MAX_EVENTS), timeout_ms);
+    for (int i = 0; i < count; ++i) {
+      void *tag = events[i].data.ptr;
+      if (tag == &wake_tag) {
+        uint64_t value;
+        [[maybe_unused]] ssize_t rc = ::read(wake_fd_, &value, sizeof(value));
+      } else if (tag == &timer_tag) {
+        uint64_t expirations;
+        [[maybe_unused]] ssize_t rc =
+            ::read(timer_fd_, &expirations, sizeof(expirations));
+        fire_expired_timers();
+      } else {
+        static_cast<AsyncFd *>(tag)->on_events(events[i].events);
+      }
+    }
+  }
+
+  stop_requested_.store(false, std::memory_order_relaxed);
+  running_ = false;
+}
+
+void IoContext::stop() {
+  stop_requested_.store(true, std::memory_order_release);
+  const uint64_t one = 1;
+  [[maybe_unused]] ssize_t rc = ::write(wake_fd_, &one, sizeof(one));
+}
+
+uint64_t IoContext::now_ns() {
+  timespec ts;
+  ::clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull +
+         static_cast<uint64_t>(ts.tv_nsec);
+}
+
+void IoContext::add_timer(uint64_t deadline_ns,
+                          std::coroutine_handle<> handle) {
+  timers_.push_back(Timer{deadline_ns, timer_sequence_++, handle});
+  std::push_heap(timers_.begin(), timers_.end(), std::greater<Timer>{});
+  if (armed_deadline_ns_ == 0 || deadline_ns < armed_deadline_ns_) {
+    arm_timer_fd(deadline_ns);
+  }
+}
+
+void IoContext::fire_expired_timers() {
+  const uint64_t now = now_ns();
+  while (!timers_.empty() && timers_.front().deadline_ns <= now) {
+    std::pop_heap(timers_.begin(), timers_.end(), std::greater<Timer>{});
+    post(timers_.back().handle);
+    timers_.pop_back();
+  }
+  arm_timer_fd(timers_.empty() ? 0 : timers_.front().deadline_ns);
+}
+
+void IoContext::arm_timer_fd(uint64_t deadline_ns) {
+  armed_deadline_ns_ = deadline_ns;
+  itimerspec spec{};
+  if (deadline_ns != 0) {
+    spec.it_value.tv_sec = static_cast<time_t>(deadline_ns / 1000000000ull);
+    spec.it_value.tv_nsec = static_cast<long>(deadline_ns % 1000000000ull);
+  }
+  ::timerfd_settime(timer_fd_, TFD_TIMER_ABSTIME, &spec, nullptr);
+}
+
+void IoContext::drain_ready() {
+  running_batch_.swap(ready_);
+  for (std::coroutine_handle<> handle : running_batch_) {
+    handle.resume();
+  }
+  running_batch_.clear();
+}
+
+void IoContext::link_detached(DetachedPromise *promise) {
+  promise->prev = nullptr;
+  promise->next = detached_head_;
+  if (detached_head_ != nullptr) {
+    detached_head_->prev = promise;
+  }
+  detached_head_ = promise;
+}
+
+void IoContext::unlink_detached(DetachedPromise *promise) {
+  if (promise->prev != nullptr) {
+    promise->prev->next = promise->next;
+  } else {
+    detached_head_ = promise->next;
+  }
+  if (promise->next != nullptr) {
+    promise->next->prev = promise->prev;
+  }
+  promise->prev = promise->next = nullptr;
+}
+
+AsyncFd::AsyncFd(IoContext &context, int fd) : context_(context), fd_(fd) {
+  epoll_event event{};
+  event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+  event.data.ptr = this;
+  registered_ =
+      fd_ >= 0 && ::epoll_ctl(context_.epoll_fd_, EPOLL_CTL_ADD, fd_, &event) == 0;
+}
+
+AsyncFd::~AsyncFd() {
+  if (registered_) {
+    ::epoll_ctl(context_.epoll_fd_, EPOLL_CTL_DEL, fd_, nullptr);
+  }
+}
+
+void AsyncFd::on_events(uint32_t events) {
+  if (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+    if (reader_) {
+      context_.post(std::exchange(reader_, {}));
+    } else {
+      read_ready_ = true;
+    }
+  }
+  if (events & (EPOLLOUT | EPOLLHUP | EPOLLERR)) {
+    if (writer_) {
+      context_.post(std::exchange(writer_, {}));
+    } else {
+      write_ready_ = true;
+    }
+  }
+}
+
+Task<int> async_accept(AsyncFd &listener) {
+  for (;;) {
+    const int fd = ::accept4(listener.fd(), nullptr, nullptr,
+                             SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd >= 0) {
+      co_return fd;
+    }
+    if (errno == EINTR) {
+      continue;
+    }
+    if (errno != EAGAIN && errno != EWOULDBLOCK) {
+      co_return -errno;
+    }
+    co_await listener.readable();
+  }
+}
+
+Task<int> async_connect(AsyncFd &socket, sockaddr_in address) {
+  if (::connect(socket.fd(), reinterpret_cast<sockaddr *>(&address),
+                sizeof(address)) == 0) {
+    co_return 0;
+  }
+  if (errno != EINPROGRESS) {
+    co_return -errno;
+  }
+
+  co_await socket.writable();
+
+  int error = 0;
+  socklen_t length = sizeof(error);
+  if (::getsockopt(socket.fd(), SOL_SOCKET, SO_ERROR, &error, &length) < 0) {
+    co_return -errno;
+  }
+  co_return -error;
+}
+
+Task<ssize_t> async_read(AsyncFd &socket, void *buffer, size_t length) {
+  for (;;) {
+    const ssize_t n = ::recv(socket.fd(), buffer, length, 0);
+    if (n >= 0) {
+      co_return n;
+    }
+    if (errno == EINTR) {
+      continue;
+    }
+    if (errno != EAGAIN && errno != EWOULDBLOCK) {
+      co_return -errno;
+    }
+    co_await socket.readable();
+  }
+}
+
+Task<ssize_t> async_write(AsyncFd &socket, const void *buffer, size_t length) {
+  const auto *bytes = static_cast<const char *>(buffer);
+  size_t written = 0;
+
+  while (written < length) {
+    const ssize_t n =
+        ::send(socket.fd(), bytes + written, length - written, MSG_NOSIGNAL);
+    if (n >= 0) {
+      written += static_cast<size_t>(n);
+      continue;
+    }
+    if (errno == EINTR) {
+      continue;
+    }
+    if (errno != EAGAIN && errno != EWOULDBLOCK) {
+      co_return -errno;
+    }
+    co_await socket.writable();
+  }
+
+  co_return static_cast<ssize_t>(written);
+}
+
+int open_tcp_listener(uint16_t port, int backlog, uint16_t *bound_port) {
+  const int fd =
+      ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    return -errno;
+  }
+
+  int opt = 1;
+  ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons(port);
+  if (::bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0 ||
+      ::listen(fd, backlog) < 0) {
+    const int error = errno;
+    ::close(fd);
+    return -error;
+  }
+
+  if (bound_port != nullptr) {
+    socklen_t length = sizeof(addr);
+    ::getsockname(fd, reinterpret_cast<sockaddr *>(&addr), &length);
+    *bound_port = ntohs(addr.sin_port);
+  }
+  return fd;
+}
+
+int open_tcp_socket() {
+  const int fd =
+      ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  return fd >= 0 ? fd : -errno;
+}
+
+} // namespace mini_mart::server
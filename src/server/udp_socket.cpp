@@ -1,6 +1,7 @@
 #include "server/udp_socket.hpp"
 #include <cerrno>
 #include <cstring>
+#include <fcntl.h>
 #include <netdb.h>
 
 namespace mini_mart::server {
@@ -112,4 +113,45 @@ bool UdpSocket::bind_any(int port) {
   return true;
 }
 
-} // namespace mini_mart::server
\ No newline at end of file
+bool UdpSocket::set_nonblocking() {
+  if (fd_ < 0) {
+    error_ = SocketError::INVALID_SOCKET;
+    return false;
+  }
+  const int flags = ::fcntl(fd_, F_GETFL, 0);
+  if (flags < 0 || ::fcntl(fd_, F_SETFL, flags | O_NONBLOCK) < 0) {
+    error_ = SocketError::SETSOCKOPT_FAILED;
+    return false;
+  }
+  return true;
+}
+
+int UdpSocket::local_port() const {
+  if (fd_ < 0) {
+    return -1;
+  }
+  sockaddr_in addr{};
+  socklen_t length = sizeof(addr);
+  if (::getsockname(fd_, reinterpret_cast<sockaddr *>(&addr), &length) < 0) {
+    return -1;
+  }
+  return ntohs(addr.sin_port);
+}
+
+ssize_t UdpSocket::send_to(const void *data, size_t length,
+                           const sockaddr_in &dst) {
+  const ssize_t n =
+      ::sendto(fd_, data, length, 0, reinterpret_cast<const sockaddr *>(&dst),
+               sizeof(dst));
+  return n >= 0 ? n : -errno;
+}
+
+ssize_t UdpSocket::recv_from(void *buffer, size_t length, sockaddr_in *src) {
+  socklen_t addr_length = sizeof(sockaddr_in);
+  const ssize_t n = ::recvfrom(fd_, buffer, length, 0,
+                               reinterpret_cast<sockaddr *>(src),
+                               src != nullptr ? &addr_length : nullptr);
+  return n >= 0 ? n : -errno;
+}
+
+} // namespace mini_mart::server
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "market_data/symbol_table.hpp"
+#include "types/messages.hpp"
+#include <cstdint>
+
+namespace mini_mart::test {
+
+// One-level L2 snapshot: best bid and ask (Price raw) with their sizes
+inline types::MarketDataL2Message top_of_book(const types::SecurityId &security_id, uint64_t bid_raw,
+                                              uint64_t ask_raw, uint64_t timestamp_ns = 1,
+                                              types::Quantity bid_size = 100, types::Quantity ask_size = 100) {
+  types::MarketDataL2Message message{};
+  message.security_id = security_id;
+  message.timestamp_ns = timestamp_ns;
+  message.bids[0] = {types::Price{bid_raw}, bid_size};
+  message.asks[0] = {types::Price{ask_raw}, ask_size};
+  message.num_bid_levels = 1;
+  message.num_ask_levels = 1;
+  return message;
+}
+
+inline types::MarketDataL2Message top_of_book(const char *symbol, uint64_t bid_raw, uint64_t ask_raw,
+                                              uint64_t timestamp_ns = 1, types::Quantity bid_size = 100,
+                                              types::Quantity ask_size = 100) {
+  return top_of_book(market_data::make_security_id(symbol), bid_raw, ask_raw, timestamp_ns, bid_size, ask_size);
+}
+
+} // namespace mini_mart::test
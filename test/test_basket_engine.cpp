@@ -0,0 +1,208 @@
+#include "l2_test_messages.hpp"
+#include "market_data/basket_engine.hpp"
+#include "market_data/feed_policies.hpp"
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace mini_mart::market_data;
+using namespace mini_mart::types;
+using namespace mini_mart::test;
+
+namespace {
+
+BasketWeight weight(double units) { return BasketWeight{units}; }
+
+} // namespace
+
+class BasketEngineTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    store = std::make_shared<SecurityStore>();
+    engine = std::make_shared<BasketEngine<SecurityStore>>(store);
+    for (const char *symbol : {"AAPL", "MSFT", "NVDA", "SPY"}) {
+      ASSERT_TRUE(store->add_security(make_security_id(symbol)));
+    }
+  }
+
+  // Both sides through the store, as the feed's StoreSink would
+  void tick(const char *symbol, uint64_t bid_raw, uint64_t ask_raw, uint64_t timestamp_ns = 1) {
+    const MarketDataL2Message message = top_of_book(symbol, bid_raw, ask_raw, timestamp_ns);
+    ASSERT_TRUE(store->update_from_l2(message));
+    engine->on_message(message);
+  }
+
+  std::shared_ptr<SecurityStore> store;
+  std::shared_ptr<BasketEngine<SecurityStore>> engine;
+};
+
+TEST_F(BasketEngineTest, RejectsUnknownConstituentsAndZeroDivisor) {
+  const BasketComponent unknown[] = {{make_security_id("AAPL"), weight(1)},
+                                     {make_security_id("TSLA"), weight(1)}};
+  EXPECT_EQ(engine->add_basket(make_security_id("X1"), unknown, 2, weight(1)),
+            BasketEngine<SecurityStore>::NOT_FOUND);
+  const BasketComponent known[] = {{make_security_id("AAPL"), weight(1)}};
+  EXPECT_EQ(engine->add_basket(make_security_id("X2"), known, 1, BasketWeight{}),
+            BasketEngine<SecurityStore>::NOT_FOUND);
+  EXPECT_FALSE(store->contains(make_security_id("X1")));
+  EXPECT_EQ(engine->basket_count(), 0u);
+}
+
+TEST_F(BasketEngineTest, LevelsFollowConstituentsAndPublishIntoTheStore) {
+  tick("AAPL", 1500000, 1500100); // $150.00 / $150.01, before the basket exists
+
+  // 2 AAPL + 0.5 MSFT + $100 cash, over a divisor of 2
+  const BasketComponent components[] = {{make_security_id("AAPL"), weight(2)},
+                                        {make_security_id("MSFT"), weight(0.5)}};
+  const SecurityId etf = make_security_id("ETF1");
+  const size_t basket = engine->add_basket(etf, components, 2, weight(2), price_from_dollars(100.0));
+  ASSERT_NE(basket, BasketEngine<SecurityStore>::NOT_FOUND);
+  EXPECT_FALSE(engine->complete(basket)); // MSFT has no price yet
+
+  SecurityStore::SecuritySnapshot snapshot;
+  engine->flush();
+  ASSERT_TRUE(store->get_security_snapshot(etf, snapshot));
+  EXPECT_EQ(snapshot.num_bid_levels, 0u);
+
+  tick("MSFT", 4000000, 4000200, 7); // $400.00 / $400.02
+  EXPECT_TRUE(engine->complete(basket));
+  // (2 x 150 + 0.5 x 400 + 100) / 2 = 300
+  EXPECT_EQ(engine->bid_level(basket), price_from_dollars(300.0));
+  EXPECT_EQ(engine->ask_level(basket).raw(), (2 * 1500100u + 4000200u / 2 + 1000000u) / 2);
+
+  engine->flush();
+  ASSERT_TRUE(store->get_security_snapshot(etf, snapshot));
+  EXPECT_EQ(snapshot.best_bid, price_from_dollars(300.0));
+  EXPECT_EQ(snapshot.best_ask, engine->ask_level(basket));
+  EXPECT_EQ(snapshot.last_update_ns, 7u);
+  EXPECT_EQ(engine->pending_flush(), 0u);
+
+  // Unrelated securities neither move nor dirty the basket
+  tick("NVDA", 9000000, 9000100);
+  EXPECT_EQ(engine->pending_flush(), 0u);
+}
+
+TEST_F(BasketEngineTest, DeltaUpdatesStayExactAndTouchOnlyMemberships) {
+  const SecurityId ids[] = {make_security_id("AAPL"), make_security_id("MSFT"),
+                            make_security_id("NVDA")};
+  const BasketComponent first[] = {{ids[0], weight(3)}, {ids[1], weight(1.25)}};
+  const BasketComponent second[] = {{ids[1], weight(7)}, {ids[2], weight(0.001)}};
+  const size_t a = engine->add_basket(make_security_id("IDX1"), first, 2, weight(1));
+  const size_t b = engine->add_basket(make_security_id("IDX2"), second, 2, weight(3.5));
+
+  std::mt19937_64 rng(11);
+  std::vector<uint64_t> bids(3);
+  for (int i = 0; i < 5000; ++i) {
+    const size_t which = rng() % 3;
+    bids[which] = 100000 + rng() % 10000000;
+    tick(which == 0 ? "AAPL" : which == 1 ? "MSFT" : "NVDA", bids[which], bids[which] + 100);
+  }
+
+  // Re-summed from scratch, the way the delta path must agree
+  const auto full = [](std::initializer_list<std::pair<uint64_t, uint64_t>> terms, uint64_t divisor) {
+    uint128_t sum = 0;
+    for (const auto &[weight_raw, price_raw] : terms) {
+      sum += static_cast<uint128_t>(weight_raw) * price_raw;
+    }
+    return static_cast<uint64_t>(sum / divisor);
+  };
+  EXPECT_EQ(engine->bid_level(a).raw(), full({{3000000, bids[0]}, {1250000, bids[1]}}, 1000000));
+  EXPECT_EQ(engine->bid_level(b).raw(), full({{7000000, bids[1]}, {1000, bids[2]}}, 3500000));
+
+  // AAPL is in one basket, MSFT in two
+  const uint64_t before = engine->memberships_applied();
+  tick("AAPL", 1000000, 1000100);
+  EXPECT_EQ(engine->memberships_applied() - before, 1u);
+  tick("MSFT", 1000000, 1000100);
+  EXPECT_EQ(engine->memberships_applied() - before, 3u);
+  tick("SPY", 1000000, 1000100);
+  EXPECT_EQ(engine->memberships_applied() - before, 3u);
+}
+
+TEST_F(BasketEngineTest, PublishIntervalConflatesWriteBacks) {
+  engine = std::make_shared<BasketEngine<SecurityStore>>(store, 1000);
+  const BasketComponent components[] = {{make_security_id("AAPL"), weight(1)}};
+  const SecurityId etf = make_security_id("ETF1");
+  ASSERT_NE(engine->add_basket(etf, components, 1, weight(1)), BasketEngine<SecurityStore>::NOT_FOUND);
+
+  tick("AAPL", 1000000, 1000100, 5000);
+  engine->flush();
+  EXPECT_EQ(engine->baskets_published(), 1u);
+
+  // Within the interval: held back, still pending
+  tick("AAPL", 1010000, 1010100, 5500);
+  engine->flush();
+  EXPECT_EQ(engine->baskets_published(), 1u);
+  EXPECT_EQ(engine->pending_flush(), 1u);
+
+  // Due: the latest level goes out
+  tick("AAPL", 1020000, 1020100, 6000);
+  engine->flush();
+  EXPECT_EQ(engine->baskets_published(), 2u);
+  SecurityStore::SecuritySnapshot snapshot;
+  ASSERT_TRUE(store->get_security_snapshot(etf, snapshot));
+  EXPECT_EQ(snapshot.best_bid.raw(), 1020000u);
+}
+
+TEST_F(BasketEngineTest, FanoutSinkFlushesBasketsIntoTheSameCommit) {
+  const BasketComponent components[] = {{make_security_id("AAPL"), weight(1)},
+                                        {make_security_id("MSFT"), weight(1)}};
+  const SecurityId etf = make_security_id("ETF1");
+  ASSERT_NE(engine->add_basket(etf, components, 2, weight(1)), BasketEngine<SecurityStore>::NOT_FOUND);
+
+  using Observer = SharedObserver<BasketEngine<SecurityStore>>;
+  FanoutSink<StoreSink<SecurityStore>, Observer> sink{StoreSink<SecurityStore>(store), Observer(engine)};
+  sink.begin_batch();
+  EXPECT_TRUE(sink.on_message(top_of_book("AAPL", 1500000, 1500100, 5)));
+  EXPECT_TRUE(sink.on_message(top_of_book("MSFT", 4000000, 4000200, 6)));
+  sink.commit();
+
+  SecurityStore::SecuritySnapshot constituent;
+  SecurityStore::SecuritySnapshot basket;
+  ASSERT_TRUE(store->get_security_snapshot(make_security_id("MSFT"), constituent));
+  ASSERT_TRUE(store->get_security_snapshot(etf, basket));
+  EXPECT_EQ(basket.best_bid, price_from_dollars(550.0));
+  EXPECT_EQ(basket.commit_sequence, constituent.commit_sequence);
+  EXPECT_EQ(store->committed_sequence(), constituent.commit_sequence);
+  EXPECT_EQ(engine->baskets_published(), 1u);
+}
+
+TEST_F(BasketEngineTest, TopLevelBookDeltasMoveTheBasket) {
+  const BasketComponent components[] = {{make_security_id("AAPL"), weight(1)},
+                                        {make_security_id("MSFT"), weight(1)}};
+  const SecurityId etf = make_security_id("ETF1");
+  ASSERT_NE(engine->add_basket(etf, components, 2, weight(1)), BasketEngine<SecurityStore>::NOT_FOUND);
+
+  using Observer = SharedObserver<BasketEngine<SecurityStore>>;
+  FanoutSink<StoreSink<SecurityStore>, Observer> sink{StoreSink<SecurityStore>(store), Observer(engine)};
+  sink.begin_batch();
+  EXPECT_TRUE(sink.on_message(top_of_book("AAPL", 1500000, 1500100, 5)));
+  EXPECT_TRUE(sink.on_message(top_of_book("MSFT", 4000000, 4000200, 6)));
+  sink.commit();
+
+  // A new best bid for AAPL arrives as a delta, not a snapshot
+  BookDeltaMessage delta{};
+  delta.security_id = make_security_id("AAPL");
+  delta.timestamp_ns = 7;
+  delta.side = Side::BID;
+  delta.action = DeltaAction::SET;
+  delta.level = {price_from_dollars(151.0), 100};
+  sink.begin_batch();
+  EXPECT_TRUE(sink.on_message(delta));
+  sink.commit();
+
+  SecurityStore::SecuritySnapshot basket;
+  ASSERT_TRUE(store->get_security_snapshot(etf, basket));
+  EXPECT_EQ(basket.best_bid, price_from_dollars(551.0));
+  EXPECT_EQ(basket.best_ask, price_from_dollars(550.03));
+
+  // Deleting the only bid level leaves the side, and the basket bid, empty
+  delta.action = DeltaAction::DELETE;
+  sink.begin_batch();
+  EXPECT_TRUE(sink.on_message(delta));
+  sink.commit();
+  ASSERT_TRUE(store->get_security_snapshot(etf, basket));
+  EXPECT_EQ(basket.num_bid_levels, 0u);
+  EXPECT_FALSE(engine->complete(0));
+}
@@ -0,0 +1,193 @@
+#include "l2_test_messages.hpp"
+#include "market_data/covariance_matrix.hpp"
+#include "market_data/feed_policies.hpp"
+#include "market_data/security_store.hpp"
+#include <atomic>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace mini_mart::common;
+using namespace mini_mart::market_data;
+using namespace mini_mart::types;
+using namespace mini_mart::test;
+
+namespace {
+
+constexpr uint64_t MS = 1000000;
+
+// Random walks ticking every millisecond in turn: B repeats A's move 0.25 ms
+// later, C mirrors it, D moves on its own
+struct Walks {
+  std::mt19937_64 rng{23};
+  std::normal_distribution<double> step{0.0, 0.0005};
+  double a = 100.0, b = 50.0, c = 80.0, d = 20.0;
+
+  template <typename Engine> void run(Engine &engine, size_t ticks, uint64_t start_ns = MS) {
+    for (size_t i = 0; i < ticks; ++i) {
+      const uint64_t t = start_ns + i * MS;
+      const double move = step(rng);
+      a *= std::exp(move);
+      b *= std::exp(move);
+      c *= std::exp(-move);
+      d *= std::exp(step(rng));
+      engine.update(0, price_from_dollars(a), t);
+      engine.update(1, price_from_dollars(b), t + MS / 4);
+      engine.update(2, price_from_dollars(c), t + MS / 2);
+      engine.update(3, price_from_dollars(d), t + 3 * MS / 4);
+    }
+  }
+};
+
+template <typename Engine> void add_walk_securities(Engine &engine) {
+  for (const char *symbol : {"A", "B", "C", "D"}) {
+    engine.add_security(make_security_id(symbol));
+  }
+}
+
+} // namespace
+
+TEST(EwmaCovarianceMatrixTest, RecoversCorrelationSignsAndVarianceRate) {
+  EwmaCovarianceMatrix<> matrix(2000 * MS);
+  add_walk_securities(matrix);
+  EXPECT_EQ(matrix.add_security(make_security_id("A")), EwmaCovarianceMatrix<>::NOT_FOUND);
+  Walks walks;
+  walks.run(matrix, 20000);
+  EXPECT_EQ(matrix.publish(20000 * MS), 4u);
+
+  EXPECT_NEAR(matrix.correlation(0, 0), 1.0, 1e-12);
+  EXPECT_NEAR(matrix.correlation(0, 1), 1.0, 0.02);
+  EXPECT_NEAR(matrix.correlation(0, 2), -1.0, 0.02);
+  EXPECT_NEAR(matrix.correlation(1, 2), -1.0, 0.02);
+  EXPECT_NEAR(matrix.correlation(0, 3), 0.0, 0.1);
+  EXPECT_EQ(matrix.correlation(1, 0), matrix.correlation(0, 1));
+
+  // Variance of 0.0005 per 1 ms tick: 2.5e-4 per second (price rounding
+  // adds a little)
+  EXPECT_NEAR(matrix.covariance(0, 0), 2.5e-4, 0.4e-4);
+  EXPECT_NEAR(matrix.covariance(0, 2), -2.5e-4, 0.4e-4);
+  EXPECT_EQ(matrix.published_as_of_ns(), 20000 * MS);
+  EXPECT_EQ(matrix.updates(), 80000u);
+}
+
+TEST(EwmaCovarianceMatrixTest, IncrementalPublishesMatchAPooledFullRefresh) {
+  WorkStealingPool::Config config;
+  config.num_workers = 2;
+  WorkStealingPool pool(config);
+  ASSERT_TRUE(pool.start());
+
+  EwmaCovarianceMatrix<> incremental(500 * MS);
+  EwmaCovarianceMatrix<> refreshed(500 * MS, 0, &pool);
+  add_walk_securities(incremental);
+  add_walk_securities(refreshed);
+  Walks first;
+  Walks second;
+
+  // Only A ticks at first
+  for (uint64_t t = 1; t <= 50; ++t) {
+    incremental.update(0, price_from_dollars(100.0 + static_cast<double>(t % 7)), t * MS);
+    refreshed.update(0, price_from_dollars(100.0 + static_cast<double>(t % 7)), t * MS);
+  }
+  for (size_t round = 0; round < 40; ++round) {
+    first.run(incremental, 50, (100 + round * 50) * MS);
+    second.run(refreshed, 50, (100 + round * 50) * MS);
+    EXPECT_EQ(incremental.publish(round), 4u); // both buffers, full refreshes
+    EXPECT_EQ(incremental.publish(round), 4u);
+    // Only C ticks: each buffer recomputes C's row and column
+    incremental.update(2, price_from_dollars(first.c * 1.001), (100 + round * 50 + 49) * MS + 900000);
+    refreshed.update(2, price_from_dollars(second.c * 1.001), (100 + round * 50 + 49) * MS + 900000);
+    EXPECT_EQ(incremental.publish(round), 1u);
+    EXPECT_EQ(incremental.publish(round), 1u);
+  }
+  EXPECT_EQ(incremental.publish(0), 0u); // nothing changed since
+  EXPECT_EQ(incremental.full_refreshes(), 80u);
+  EXPECT_EQ(refreshed.publish(0), 4u);
+  EXPECT_EQ(refreshed.full_refreshes(), 1u);
+
+  for (size_t i = 0; i < 4; ++i) {
+    for (size_t j = 0; j < 4; ++j) {
+      EXPECT_DOUBLE_EQ(incremental.correlation(i, j), refreshed.correlation(i, j)) << i << "," << j;
+      EXPECT_DOUBLE_EQ(incremental.covariance(i, j), refreshed.covariance(i, j)) << i << "," << j;
+    }
+  }
+  pool.stop();
+}
+
+TEST(EwmaCovarianceMatrixTest, ReadersSeeWholePublishedMatrices) {
+  EwmaCovarianceMatrix<> matrix(100 * MS);
+  add_walk_securities(matrix);
+  std::atomic<bool> done{false};
+  std::atomic<uint64_t> inconsistent{0};
+  std::thread reader([&] {
+    double row[4];
+    while (!done.load(std::memory_order_acquire)) {
+      const size_t count = matrix.correlation_row(1, row);
+      // Every publish below follows ticks of all four walks
+      if (count == 4 && row[1] != 1.0 && std::abs(row[1] - 1.0) > 1e-12) {
+        inconsistent.fetch_add(1);
+      }
+    }
+  });
+  Walks walks;
+  for (size_t round = 0; round < 500; ++round) {
+    walks.run(matrix, 4, (1 + round * 4) * MS);
+    matrix.publish(round);
+  }
+  done.store(true, std::memory_order_release);
+  reader.join();
+  EXPECT_EQ(inconsistent.load(), 0u);
+}
+
+TEST(EwmaCovarianceMatrixTest, PublishesFromFanoutSinkFlush) {
+  using Matrix = EwmaCovarianceMatrix<>;
+  auto matrix = std::make_shared<Matrix>(100 * MS, 10 * MS);
+  matrix->add_security(make_security_id("SPY"));
+  auto store = std::make_shared<SecurityStore>();
+  static_assert(FlushingObserver<SharedObserver<Matrix>>);
+  FanoutSink<StoreSink<SecurityStore>, SharedObserver<Matrix>> sink{StoreSink<SecurityStore>(store),
+                                                                    SharedObserver<Matrix>(matrix)};
+  sink.add_security(make_security_id("SPY"));
+
+  auto tick = [&sink](uint64_t bid_raw, uint64_t timestamp_ns) {
+    sink.begin_batch();
+    EXPECT_TRUE(sink.on_message(top_of_book("SPY", bid_raw, bid_raw + 100, timestamp_ns)));
+    sink.commit();
+  };
+  tick(5000000, 1 * MS);
+  tick(5010000, 5 * MS);
+  EXPECT_EQ(matrix->published_as_of_ns(), 0u); // not due yet
+  tick(4990000, 12 * MS);
+  EXPECT_EQ(matrix->published_as_of_ns(), 12 * MS);
+  EXPECT_NEAR(matrix->correlation(0, 0), 1.0, 1e-12);
+  EXPECT_GT(matrix->covariance(0, 0), 0.0);
+}
+
+TEST(EwmaCovarianceMatrixTest, TopOfBookDeltasTickTheSecurity) {
+  using Matrix = EwmaCovarianceMatrix<>;
+  auto matrix = std::make_shared<Matrix>(100 * MS, 10 * MS);
+  matrix->add_security(make_security_id("SPY"));
+  auto store = std::make_shared<SecurityStore>();
+  using Observer = DeltaAsSnapshot<SharedObserver<Matrix>, SecurityStore>;
+  static_assert(FlushingObserver<Observer>);
+  FanoutSink<StoreSink<SecurityStore>, Observer> sink{StoreSink<SecurityStore>(store),
+                                                      Observer(SharedObserver<Matrix>(matrix), store)};
+  sink.add_security(make_security_id("SPY"));
+  EXPECT_TRUE(sink.on_message(top_of_book("SPY", 5000000, 5000100, 1 * MS)));
+
+  BookDeltaMessage delta{};
+  delta.security_id = make_security_id("SPY");
+  delta.side = Side::BID;
+  delta.action = DeltaAction::SET;
+  for (const auto &[bid, timestamp_ns] : {std::pair{499.90, 5 * MS}, std::pair{499.95, 12 * MS}}) {
+    delta.timestamp_ns = timestamp_ns;
+    delta.level = {price_from_dollars(bid), 100};
+    sink.begin_batch();
+    EXPECT_TRUE(sink.on_message(delta));
+    sink.commit();
+  }
+  EXPECT_EQ(matrix->published_as_of_ns(), 12 * MS);
+  EXPECT_GT(matrix->covariance(0, 0), 0.0);
+}
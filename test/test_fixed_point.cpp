@@ -0,0 +1,93 @@
+#include "types/fixed_point.hpp"
+#include "types/price.hpp"
+#include <gtest/gtest.h>
+#include <type_traits>
+
+using namespace mini_mart::types;
+
+// ============================================================================
+// SCALE AND LAYOUT
+// ============================================================================
+
+static_assert(std::is_same_v<Price, FixedPoint<4, uint64_t>>);
+static_assert(sizeof(FxRate) == 8 && std::is_trivially_copyable_v<FxRate>);
+static_assert(FxRate::ONE == 100000u && JpyFxRate::ONE == 1000u && CryptoPrice::ONE == 100000000u);
+
+// Everything is usable in constant expressions
+static_assert((FxRate{108515ul} + FxRate{10ul}).raw() == 108525u);
+static_assert(fixed_point_cast<Price>(FxRate{108519ul}).raw() == 10851u);
+static_assert(fixed_multiply<Price>(Price{1500000ul}, CryptoQuantity{25000000ul}).raw() == 375000u);
+
+TEST(FixedPointTest, ConstructsAtItsOwnScale) {
+    EXPECT_EQ(FxRate{1.08515}.raw(), 108515u);
+    EXPECT_EQ(JpyFxRate{151.234}.raw(), 151234u);
+    EXPECT_EQ(CryptoPrice{0.00000001}.raw(), 1u);
+    EXPECT_DOUBLE_EQ(FxRate{108515ul}.to_double(), 1.08515);
+    EXPECT_DOUBLE_EQ(CryptoQuantity{150000000ul}.to_double(), 1.5);
+}
+
+TEST(FixedPointTest, ArithmeticMatchesPrice) {
+    FxRate bid{108510ul};
+    FxRate ask = bid + 5u;
+    EXPECT_EQ(ask.raw(), 108515u);
+    EXPECT_EQ((ask - bid).raw(), 5u);
+    EXPECT_EQ(((bid + ask) / 2u).raw(), 108512u);
+    EXPECT_EQ((2u * bid).raw(), 217020u);
+    EXPECT_TRUE(bid < ask);
+    EXPECT_TRUE(ask == 108515u);
+    EXPECT_EQ(bid.abs_diff(ask), ask.abs_diff(bid));
+
+    bid += FxRate{10ul};
+    bid -= 3u;
+    EXPECT_EQ(bid.raw(), 108517u);
+}
+
+TEST(FixedPointTest, SignedRepresentation) {
+    SignedAmount pnl{-12.5};
+    EXPECT_EQ(pnl.raw(), -125000);
+    EXPECT_LT(pnl, SignedAmount{0.0});
+    EXPECT_EQ((pnl + SignedAmount{20.0}).raw(), 75000);
+    using Cents = FixedPoint<2, int64_t>;
+    EXPECT_EQ(fixed_point_cast<Cents>(pnl).raw(), -1250);
+}
+
+// ============================================================================
+// CROSS-SCALE CONVERSION
+// ============================================================================
+
+TEST(FixedPointTest, CastWidensExactlyAndNarrowsByTruncation) {
+    const Price price{1755000ul}; // $175.50
+    EXPECT_EQ(fixed_point_cast<CryptoPrice>(price).raw(), 17550000000u);
+    EXPECT_EQ(fixed_point_cast<Price>(fixed_point_cast<CryptoPrice>(price)), price);
+
+    EXPECT_EQ(fixed_point_cast<JpyFxRate>(FxRate{15123456ul}).raw(), 151234u);
+    using SignedPrice = FixedPoint<4, int64_t>;
+    EXPECT_EQ(fixed_point_cast<SignedPrice>(FixedPoint<8, int64_t>{-123456789l}).raw(), -12345);
+}
+
+// ============================================================================
+// 128-BIT MULTIPLY AND DIVIDE
+// ============================================================================
+
+TEST(FixedPointTest, NotionalDoesNotOverflowIntermediate) {
+    // 60,000 BTC/USD x 25 BTC at 8 decimals: raw product is ~1.5e20, past
+    // uint64_t, but the notional itself fits
+    const CryptoPrice price{6000000000000ul};
+    const CryptoQuantity quantity{2500000000ul};
+    EXPECT_EQ(fixed_multiply<CryptoPrice>(price, quantity).raw(), 150000000000000u);
+    EXPECT_EQ(fixed_multiply<Price>(price, quantity).raw(), 15000000000u);
+
+    // Truncates below the result scale
+    EXPECT_EQ(fixed_multiply<Price>(Price{3ul}, Price{5000ul}).raw(), 1u);
+}
+
+TEST(FixedPointTest, DivideAcrossScales) {
+    // USD/JPY from EUR/JPY / EUR/USD
+    const JpyFxRate eur_jpy{164100ul}; // 164.100
+    const FxRate eur_usd{108500ul};    // 1.08500
+    EXPECT_EQ(fixed_divide<JpyFxRate>(eur_jpy, eur_usd).raw(), 151244u);
+
+    // Quantity a notional buys
+    EXPECT_EQ(fixed_divide<CryptoQuantity>(Price{10000000ul}, CryptoPrice{6000000000000ul}).raw(), 1666666u);
+    EXPECT_EQ(fixed_divide<SignedAmount>(SignedAmount{-10.0}, SignedAmount{4.0}).raw(), -25000);
+}
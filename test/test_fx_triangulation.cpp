@@ -0,0 +1,204 @@
+#include "l2_test_messages.hpp"
+#include "market_data/feed_policies.hpp"
+#include "market_data/fx_triangulation.hpp"
+#include "market_data/security_seeder.hpp"
+#include "market_data/security_store.hpp"
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+using namespace mini_mart::market_data;
+using namespace mini_mart::types;
+using namespace mini_mart::test;
+
+namespace {
+
+Price px(double value) { return price_from_dollars(value); }
+
+size_t count_alerts_for(const FxTriangulationEngine &engine, const SecurityId &cross,
+                        FxArbitrageKind kind) {
+  size_t count = 0;
+  FxArbitrageAlert alert;
+  while (engine.pop_alert(alert)) {
+    if (alert.cross == cross && alert.kind == kind) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+} // namespace
+
+class FxTriangulationTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    engine = std::make_shared<FxTriangulationEngine>();
+    for (const char *symbol : {"EURUSD", "USDJPY", "EURJPY", "GBPUSD", "EURGBP", "AUDCAD"}) {
+      ASSERT_TRUE(engine->add_pair(make_security_id(symbol)));
+    }
+    eurusd = engine->find_pair(make_security_id("EURUSD"));
+    usdjpy = engine->find_pair(make_security_id("USDJPY"));
+    eurjpy = engine->find_pair(make_security_id("EURJPY"));
+    gbpusd = engine->find_pair(make_security_id("GBPUSD"));
+    eurgbp = engine->find_pair(make_security_id("EURGBP"));
+    audcad = engine->find_pair(make_security_id("AUDCAD"));
+  }
+
+  std::shared_ptr<FxTriangulationEngine> engine;
+  size_t eurusd{}, usdjpy{}, eurjpy{}, gbpusd{}, eurgbp{}, audcad{};
+};
+
+TEST_F(FxTriangulationTest, RejectsMalformedAndDuplicatePairs) {
+  EXPECT_FALSE(engine->add_pair(make_security_id("EURUSD")));
+  EXPECT_FALSE(engine->add_pair(make_security_id("AAPL")));
+  EXPECT_FALSE(engine->add_pair(make_security_id("EUREUR")));
+  EXPECT_FALSE(engine->add_pair(make_security_id("BTCUSDT")));
+  EXPECT_EQ(engine->find_pair(make_security_id("GBPJPY")), FxTriangulationEngine::NOT_FOUND);
+  EXPECT_EQ(engine->pair_count(), 6u);
+}
+
+TEST_F(FxTriangulationTest, BuildsTrianglesForEveryClosedCycle) {
+  // {EURUSD, USDJPY, EURJPY} and {EURUSD, GBPUSD, EURGBP}, each pair of a
+  // cycle implied from the other two; AUDCAD closes no cycle
+  EXPECT_EQ(engine->triangle_count(), 6u);
+  EXPECT_FALSE(engine->implied_quote(audcad).valid);
+}
+
+TEST_F(FxTriangulationTest, ImpliesCrossesThroughDirectAndInvertedLegs) {
+  engine->update(eurusd, px(1.0850), px(1.0852), 1);
+  EXPECT_FALSE(engine->implied_quote(eurjpy).valid);
+  engine->update(usdjpy, px(151.20), px(151.22), 2);
+
+  // EURJPY = EURUSD x USDJPY
+  FxQuote eurjpy_implied = engine->implied_quote(eurjpy);
+  ASSERT_TRUE(eurjpy_implied.valid);
+  EXPECT_EQ(eurjpy_implied.bid.raw(), 16405200000u);  // 1.0850 x 151.20
+  EXPECT_EQ(eurjpy_implied.ask.raw(), 16410394400u);  // 1.0852 x 151.22
+
+  // EURGBP = EURUSD / GBPUSD: bid over the GBPUSD ask, ask over its bid
+  engine->update(gbpusd, px(1.2500), px(1.2502), 3);
+  FxQuote eurgbp_implied = engine->implied_quote(eurgbp);
+  ASSERT_TRUE(eurgbp_implied.valid);
+  EXPECT_EQ(eurgbp_implied.bid, fixed_multiply<CrossRate>(CrossRate{108500000ul},
+                                                          fixed_divide<CrossRate>(CrossRate{100000000ul},
+                                                                                  CrossRate{125020000ul})));
+  EXPECT_NEAR(eurgbp_implied.bid.to_double(), 1.0850 / 1.2502, 1e-7);
+  EXPECT_NEAR(eurgbp_implied.ask.to_double(), 1.0852 / 1.2500, 1e-7);
+  EXPECT_LT(eurgbp_implied.bid, eurgbp_implied.ask);
+
+  // A one-sided book suspends the triangles that use it
+  engine->update(usdjpy, px(151.20), Price{}, 4);
+  EXPECT_FALSE(engine->implied_quote(eurjpy).valid);
+}
+
+TEST_F(FxTriangulationTest, UpdatesTouchOnlyDependentTriangles) {
+  const uint64_t before = engine->triangles_recomputed();
+  engine->update(usdjpy, px(151.20), px(151.22), 1);
+  // Leg of EURJPY-via-USD and EURUSD-via-JPY; cross of the third (check only)
+  EXPECT_EQ(engine->triangles_recomputed() - before, 2u);
+
+  engine->update(audcad, px(0.9000), px(0.9002), 2);
+  EXPECT_EQ(engine->triangles_recomputed() - before, 2u);
+
+  engine->update(eurusd, px(1.0850), px(1.0852), 3);
+  // Leg of four triangles across both cycles
+  EXPECT_EQ(engine->triangles_recomputed() - before, 6u);
+  EXPECT_EQ(engine->updates(), 3u);
+}
+
+TEST_F(FxTriangulationTest, AlertsOnceWhenImpliedCrossesDirectAndRearms) {
+  const SecurityId eurjpy_id = make_security_id("EURJPY");
+  engine->update(eurusd, px(1.0850), px(1.0852), 1);
+  engine->update(usdjpy, px(151.20), px(151.22), 2);
+
+  // Inside the implied 164.052/164.104: no arbitrage
+  engine->update(eurjpy, px(164.07), px(164.09), 3);
+  EXPECT_EQ(engine->alerts_raised(), 0u);
+
+  // Direct ask below the implied bid
+  engine->update(eurjpy, px(163.90), px(163.95), 4);
+  EXPECT_EQ(count_alerts_for(*engine, eurjpy_id, FxArbitrageKind::IMPLIED_BID_OVER_DIRECT_ASK), 1u);
+  const uint64_t raised = engine->alerts_raised();
+  EXPECT_GE(raised, 1u);
+
+  // Still crossed: no repeat
+  engine->update(eurjpy, px(163.91), px(163.95), 5);
+  EXPECT_EQ(engine->alerts_raised(), raised);
+
+  // Uncross, then cross the other way
+  engine->update(eurjpy, px(164.07), px(164.09), 6);
+  engine->update(eurjpy, px(164.20), px(164.25), 7);
+  EXPECT_EQ(count_alerts_for(*engine, eurjpy_id, FxArbitrageKind::IMPLIED_ASK_UNDER_DIRECT_BID), 1u);
+  EXPECT_EQ(engine->alerts_dropped(), 0u);
+}
+
+TEST_F(FxTriangulationTest, RoundingAloneNeverCrossesTheDirectBook) {
+  // The exact implied EURGBP ask is 1.5000 / 1.5000 = 1.0000, touching the
+  // direct bid. 1/1.5 does not terminate; truncated it would put the
+  // implied ask at 0.99999999, under the bid.
+  engine->update(eurusd, px(1.4998), px(1.5000), 1);
+  engine->update(gbpusd, px(1.5000), px(1.5002), 2);
+  engine->update(eurgbp, px(1.0000), px(1.0002), 3);
+
+  const FxQuote implied = engine->implied_quote(eurgbp);
+  ASSERT_TRUE(implied.valid);
+  EXPECT_EQ(implied.ask.raw(), 100000001u);
+  EXPECT_LT(implied.bid.to_double(), 1.4998 / 1.5002);
+  EXPECT_EQ(engine->alerts_raised(), 0u);
+}
+
+TEST_F(FxTriangulationTest, ObservesTheFeedThroughFanoutSink) {
+  auto store = std::make_shared<SecurityStore>();
+  using Observer = SharedObserver<FxTriangulationEngine>;
+  FanoutSink<StoreSink<SecurityStore>, Observer> sink{StoreSink<SecurityStore>(store), Observer(engine)};
+  for (const auto &id : SecuritySeeder::get_major_fx_pairs()) {
+    sink.add_security(id);
+  }
+
+  auto l2 = [](const char *symbol, double bid, double ask) {
+    return top_of_book(symbol, px(bid).raw(), px(ask).raw(), 1, 1000000, 1000000);
+  };
+  EXPECT_TRUE(sink.on_message(l2("EURUSD", 1.0850, 1.0852)));
+  EXPECT_TRUE(sink.on_message(l2("USDJPY", 151.20, 151.22)));
+  EXPECT_TRUE(sink.on_message(l2("USDCHF", 0.9000, 0.9002))); // stored, not triangulated
+  EXPECT_EQ(engine->updates(), 2u);
+  EXPECT_TRUE(engine->implied_quote(eurjpy).valid);
+}
+
+TEST_F(FxTriangulationTest, TopOfBookDeltasReachTheEngineAsSnapshots) {
+  auto store = std::make_shared<SecurityStore>();
+  using Observer = DeltaAsSnapshot<SharedObserver<FxTriangulationEngine>, SecurityStore>;
+  FanoutSink<StoreSink<SecurityStore>, Observer> sink{
+      StoreSink<SecurityStore>(store), Observer(SharedObserver<FxTriangulationEngine>(engine), store)};
+  for (const char *symbol : {"EURUSD", "USDJPY"}) {
+    sink.add_security(make_security_id(symbol));
+  }
+  EXPECT_TRUE(sink.on_message(top_of_book("EURUSD", px(1.0850).raw(), px(1.0852).raw())));
+  EXPECT_TRUE(sink.on_message(top_of_book("USDJPY", px(151.20).raw(), px(151.22).raw())));
+
+  BookDeltaMessage delta{};
+  delta.security_id = make_security_id("USDJPY");
+  delta.timestamp_ns = 2;
+  delta.side = Side::BID;
+  delta.action = DeltaAction::SET;
+  delta.level = {px(151.10), 100};
+  EXPECT_TRUE(sink.on_message(delta));
+  EXPECT_EQ(engine->implied_quote(eurjpy).bid.raw(), 16394350000u); // 1.0850 x 151.10
+
+  // A deeper level does not move the touch and is not passed on
+  delta.level_index = 1;
+  delta.level = {px(151.00), 100};
+  const uint64_t updates = engine->updates();
+  EXPECT_TRUE(sink.on_message(delta));
+  EXPECT_EQ(engine->updates(), updates);
+
+  // Deleting the best bid promotes the next level
+  delta.level_index = 0;
+  delta.action = DeltaAction::DELETE;
+  EXPECT_TRUE(sink.on_message(delta));
+  EXPECT_EQ(engine->implied_quote(eurjpy).bid.raw(), 16383500000u); // 1.0850 x 151.00
+
+  // Emptying the side suspends the triangles
+  EXPECT_TRUE(sink.on_message(delta));
+  EXPECT_FALSE(engine->implied_quote(eurjpy).valid);
+}
@@ -0,0 +1,149 @@
+#include "market_data/instrument_loader.hpp"
+#include "market_data/security_seeder.hpp"
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <string>
+#include <unistd.h>
+
+using namespace mini_mart::market_data;
+using namespace mini_mart::types;
+
+namespace {
+
+std::string make_symbol(size_t index) {
+  // Base-26 symbols: AAAAA, AAAAB, ...
+  std::string symbol(5, 'A');
+  for (size_t i = 5; i > 0; --i) {
+    symbol[i - 1] = static_cast<char>('A' + index % 26);
+    index /= 26;
+  }
+  return symbol;
+}
+
+} // namespace
+
+TEST(InstrumentLoaderTest, ParsesPrices) {
+  Price price;
+  ASSERT_TRUE(InstrumentLoader::parse_price("175", price));
+  EXPECT_EQ(price.raw(), 1750000u);
+  ASSERT_TRUE(InstrumentLoader::parse_price("0.01", price));
+  EXPECT_EQ(price.raw(), 100u);
+  ASSERT_TRUE(InstrumentLoader::parse_price("12.3456", price));
+  EXPECT_EQ(price.raw(), 123456u);
+  ASSERT_TRUE(InstrumentLoader::parse_price(".5", price));
+  EXPECT_EQ(price.raw(), 5000u);
+
+  EXPECT_FALSE(InstrumentLoader::parse_price("", price));
+  EXPECT_FALSE(InstrumentLoader::parse_price(".", price));
+  EXPECT_FALSE(InstrumentLoader::parse_price("1.23456", price));
+  EXPECT_FALSE(InstrumentLoader::parse_price("-1", price));
+  EXPECT_FALSE(InstrumentLoader::parse_price("1e3", price));
+  // Whole parts whose raw value (x 10000) would not fit
+  EXPECT_FALSE(InstrumentLoader::parse_price("1844674407370959", price));
+  EXPECT_FALSE(InstrumentLoader::parse_price("99999999999999999999999", price));
+  ASSERT_TRUE(InstrumentLoader::parse_price("1844674407370954.9999", price));
+  EXPECT_EQ(price.raw(), 18446744073709549999u);
+}
+
+TEST(InstrumentLoaderTest, LoadsCsvIntoSortedDirectory) {
+  const std::string csv = "symbol,tick_size,base_price,lot_size,venue\r\n"
+                          "# reference data snapshot\n"
+                          "MSFT,0.01,350,100,XNAS\n"
+                          "\n"
+                          "AAPL,0.01,175.25,100,XNAS\r\n"
+                          "BRK.A,1,600000,1,XNYS\n"
+                          "AAPL,0.05,999,10,BATS\n";
+
+  InstrumentDirectory directory;
+  const auto result = InstrumentLoader::load_csv(csv, directory);
+  ASSERT_EQ(result.error, InstrumentLoadError::SUCCESS);
+  EXPECT_EQ(result.loaded, 3u);
+  EXPECT_EQ(result.duplicates, 1u);
+  EXPECT_TRUE(directory.is_built());
+
+  const InstrumentInfo *aapl =
+      directory.find(SecuritySeeder::create_security_id("AAPL"));
+  ASSERT_NE(aapl, nullptr);
+  // First occurrence wins
+  EXPECT_EQ(aapl->base_price.raw(), 1752500u);
+  EXPECT_EQ(aapl->tick_size.raw(), 100u);
+  EXPECT_EQ(aapl->lot_size, 100u);
+  EXPECT_EQ(std::string(aapl->venue.data(), 4), "XNAS");
+
+  const InstrumentInfo *brk =
+      directory.find(SecuritySeeder::create_security_id("BRK.A"));
+  ASSERT_NE(brk, nullptr);
+  EXPECT_EQ(brk->lot_size, 1u);
+  EXPECT_EQ(directory.find(SecuritySeeder::create_security_id("TSLA")), nullptr);
+
+  // Sorted by symbol
+  const auto ids = directory.get_security_ids();
+  ASSERT_EQ(ids.size(), 3u);
+  EXPECT_EQ(SecuritySeeder::security_id_to_string(ids[0]), "AAPL");
+  EXPECT_EQ(SecuritySeeder::security_id_to_string(ids[1]), "BRK.A");
+  EXPECT_EQ(SecuritySeeder::security_id_to_string(ids[2]), "MSFT");
+}
+
+TEST(InstrumentLoaderTest, ReportsFirstBadRecord) {
+  InstrumentDirectory directory;
+  const char *bad_rows[] = {
+      "AAPL,0.01,175,100,XNAS\nMSFT,0.01,350,100\n",         // missing venue
+      "AAPL,0.01,175,100,XNAS\nMSFT,0,350,100,XNAS\n",       // zero tick
+      "AAPL,0.01,175,100,XNAS\nMSFT,0.01,350,0,XNAS\n",      // zero lot
+      "AAPL,0.01,175,100,XNAS\nTOOLONGSYM,0.01,1,1,XNAS\n",  // symbol > 8
+      "AAPL,0.01,175,100,XNAS\nMSFT,0.01,350,100,XNAS,x\n",  // extra field
+  };
+  for (const char *csv : bad_rows) {
+    const auto result = InstrumentLoader::load_csv(csv, directory);
+    EXPECT_EQ(result.error, InstrumentLoadError::BAD_RECORD) << csv;
+    EXPECT_EQ(result.line, 2u) << csv;
+    EXPECT_TRUE(directory.empty());
+  }
+}
+
+TEST(InstrumentLoaderTest, LargeUniverseCsvAndBinaryRoundTrip) {
+  constexpr size_t count = 100000;
+  std::string csv;
+  csv.reserve(count * 32);
+  for (size_t i = count; i > 0; --i) {
+    csv += make_symbol(i - 1);
+    csv += ",0.01,";
+    csv += std::to_string(10 + i % 500);
+    csv += ".25,100,XNAS\n";
+  }
+
+  const std::string base = "/tmp/mini_mart_instruments_" + std::to_string(::getpid());
+  const std::string csv_path = base + ".csv";
+  const std::string bin_path = base + ".bin";
+  FILE *file = std::fopen(csv_path.c_str(), "wb");
+  ASSERT_NE(file, nullptr);
+  std::fwrite(csv.data(), 1, csv.size(), file);
+  std::fclose(file);
+
+  InstrumentDirectory directory;
+  auto result = InstrumentLoader::load_csv_file(csv_path, directory);
+  ASSERT_EQ(result.error, InstrumentLoadError::SUCCESS);
+  EXPECT_EQ(result.loaded, count);
+
+  ASSERT_EQ(InstrumentLoader::save_binary_file(bin_path, directory),
+            InstrumentLoadError::SUCCESS);
+  InstrumentDirectory from_binary;
+  result = InstrumentLoader::load_binary_file(bin_path, from_binary);
+  ASSERT_EQ(result.error, InstrumentLoadError::SUCCESS);
+  ASSERT_EQ(from_binary.size(), count);
+
+  for (size_t i = 0; i < count; i += 997) {
+    const SecurityId id = SecuritySeeder::create_security_id(make_symbol(i));
+    const InstrumentInfo *info = from_binary.find(id);
+    ASSERT_NE(info, nullptr) << make_symbol(i);
+    EXPECT_EQ(info->base_price.raw(), (10 + (i + 1) % 500) * 10000 + 2500);
+  }
+
+  EXPECT_EQ(InstrumentLoader::load_binary_file(csv_path, from_binary).error,
+            InstrumentLoadError::BAD_FORMAT);
+  EXPECT_EQ(InstrumentLoader::load_csv_file(base + ".missing", from_binary).error,
+            InstrumentLoadError::OPEN_FAILED);
+
+  std::remove(csv_path.c_str());
+  std::remove(bin_path.c_str());
+}
@@ -0,0 +1,208 @@
+#include "server/async_udp_socket.hpp"
+#include "server/channel.hpp"
+#include "server/io_context.hpp"
+#include <gtest/gtest.h>
+#include <arpa/inet.h>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace mini_mart::server;
+
+namespace {
+
+sockaddr_in loopback(uint16_t port) {
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  return addr;
+}
+
+Task<int> add_later(IoContext &context, int a, int b) {
+  co_await context.sleep_for_ns(1000);
+  co_return a + b;
+}
+
+Task<void> sleeper(IoContext &context, uint64_t delay_ns, int id,
+                   std::vector<int> &order) {
+  co_await context.sleep_for_ns(delay_ns);
+  order.push_back(id);
+}
+
+} // namespace
+
+TEST(IoContextTest, RunReturnsWhenNoTasksLeft) {
+  IoContext context;
+  ASSERT_TRUE(context.is_valid());
+  context.run();
+  EXPECT_EQ(context.outstanding_tasks(), 0u);
+}
+
+TEST(IoContextTest, NestedTaskReturnsValue) {
+  IoContext context;
+  int result = 0;
+  context.spawn([](IoContext &ctx, int &out) -> Task<void> {
+    out = co_await add_later(ctx, 20, 22);
+  }(context, result));
+  context.run();
+  EXPECT_EQ(result, 42);
+}
+
+TEST(IoContextTest, TimersFireInDeadlineOrder) {
+  IoContext context;
+  std::vector<int> order;
+  context.spawn(sleeper(context, 3000000, 3, order));
+  context.spawn(sleeper(context, 1000000, 1, order));
+  context.spawn(sleeper(context, 2000000, 2, order));
+
+  const uint64_t start = IoContext::now_ns();
+  context.run();
+
+  EXPECT_EQ(order, (std::vector<int>{1, 2, 3}));
+  EXPECT_GE(IoContext::now_ns() - start, 3000000u);
+}
+
+TEST(IoContextTest, StopFromAnotherThread) {
+  IoContext context;
+  context.spawn([](IoContext &ctx) -> Task<void> {
+    co_await ctx.sleep_for_ns(60ull * 1000000000ull);
+  }(context));
+
+  std::thread stopper([&context]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    context.stop();
+  });
+  context.run();
+  stopper.join();
+
+  EXPECT_FALSE(context.is_running());
+  EXPECT_EQ(context.outstanding_tasks(), 1u); // frame freed by ~IoContext
+}
+
+TEST(IoContextTest, ChannelBackpressureAndClose) {
+  IoContext context;
+  Channel<int, 2> channel(context);
+  std::vector<int> received;
+  int failed_sends = 0;
+
+  context.spawn([](Channel<int, 2> &ch, int &failed) -> Task<void> {
+    for (int i = 0; i < 10; ++i) {
+      if (!co_await ch.send(i)) {
+        ++failed;
+      }
+    }
+    ch.close();
+  }(channel, failed_sends));
+
+  context.spawn([](Channel<int, 2> &ch, std::vector<int> &out) -> Task<void> {
+    while (auto value = co_await ch.recv()) {
+      out.push_back(*value);
+    }
+  }(channel, received));
+
+  context.run();
+
+  EXPECT_EQ(failed_sends, 0);
+  ASSERT_EQ(received.size(), 10u);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(received[static_cast<size_t>(i)], i);
+  }
+}
+
+TEST(IoContextTest, TcpAcceptReadWriteEcho) {
+  IoContext context;
+  uint16_t port = 0;
+  const int listen_fd = open_tcp_listener(0, 16, &port);
+  ASSERT_GE(listen_fd, 0);
+  const int client_fd = open_tcp_socket();
+  ASSERT_GE(client_fd, 0);
+
+  char reply[6] = {};
+  int server_accepted = -1;
+
+  context.spawn([](IoContext &ctx, int lfd, int &accepted) -> Task<void> {
+    AsyncFd listener(ctx, lfd);
+    const int conn_fd = co_await async_accept(listener);
+    accepted = conn_fd;
+    if (conn_fd < 0) {
+      co_return;
+    }
+    AsyncFd conn(ctx, conn_fd);
+    char buffer[16];
+    const ssize_t n = co_await async_read(conn, buffer, sizeof(buffer));
+    if (n > 0) {
+      co_await async_write(conn, buffer, static_cast<size_t>(n));
+    }
+    ::close(conn_fd);
+  }(context, listen_fd, server_accepted));
+
+  context.spawn([](IoContext &ctx, int cfd, uint16_t p,
+                   char *out) -> Task<void> {
+    AsyncFd client(ctx, cfd);
+    if (co_await async_connect(client, loopback(p)) != 0) {
+      co_return;
+    }
+    co_await async_write(client, "hello", 5);
+    co_await async_read(client, out, 5);
+  }(context, client_fd, port, reply));
+
+  context.run();
+  ::close(client_fd);
+  ::close(listen_fd);
+
+  EXPECT_GE(server_accepted, 0);
+  EXPECT_STREQ(reply, "hello");
+}
+
+TEST(IoContextTest, AsyncUdpSocketRoundTrip) {
+  IoContext context;
+  UdpSocket receiver_sock;
+  ASSERT_TRUE(receiver_sock.bind_any(0));
+  const int port = receiver_sock.local_port();
+  ASSERT_GT(port, 0);
+
+  AsyncUdpSocket receiver(context, std::move(receiver_sock));
+  AsyncUdpSocket sender(context, UdpSocket{});
+  ASSERT_TRUE(receiver.is_valid());
+  ASSERT_TRUE(sender.is_valid());
+
+  char received[8] = {};
+  ssize_t received_len = 0;
+
+  context.spawn([](AsyncUdpSocket &sock, char *out, ssize_t &len) -> Task<void> {
+    sockaddr_in src{};
+    len = co_await sock.recv_from(out, 7, &src);
+  }(receiver, received, received_len));
+
+  context.spawn([](IoContext &ctx, AsyncUdpSocket &sock, int p) -> Task<void> {
+    co_await ctx.sleep_for_ns(100000); // receiver suspends first
+    co_await sock.send_to("tick", 4, loopback(static_cast<uint16_t>(p)));
+  }(context, sender, port));
+
+  context.run();
+
+  EXPECT_EQ(received_len, 4);
+  EXPECT_STREQ(received, "tick");
+}
+
+TEST(IoContextTest, SteadyStateAwaitsDoNotAllocateFrames) {
+  IoContext context;
+  context.spawn([](IoContext &ctx) -> Task<void> {
+    for (int i = 0; i < 1000; ++i) {
+      co_await add_later(ctx, i, i);
+    }
+  }(context));
+  context.run();
+
+  // Warmed up: the same frame sizes now come from the pool
+  const uint64_t before = FramePool::heap_allocations();
+  context.spawn([](IoContext &ctx) -> Task<void> {
+    for (int i = 0; i < 1000; ++i) {
+      co_await add_later(ctx, i, i);
+    }
+  }(context));
+  context.run();
+
+  EXPECT_EQ(FramePool::heap_allocations(), before);
+}
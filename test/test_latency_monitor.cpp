@@ -0,0 +1,151 @@
+#include "market_data/latency_monitor.hpp"
+#include <gtest/gtest.h>
+
+using namespace mini_mart::market_data;
+
+namespace {
+
+constexpr uint64_t WINDOW_NS = 1000;
+
+std::array<LatencyBudget, FEED_STAGE_COUNT> budgets_for(FeedStage stage,
+                                                        LatencyBudget budget) {
+  std::array<LatencyBudget, FEED_STAGE_COUNT> budgets{};
+  budgets[static_cast<size_t>(stage)] = budget;
+  return budgets;
+}
+
+} // namespace
+
+TEST(LatencyHistogramTest, BucketsCoverTheirValues) {
+  for (uint64_t value = 0; value < 100000; value += 7) {
+    const uint32_t bucket = LatencyHistogram::bucket_of(value);
+    EXPECT_GE(LatencyHistogram::bucket_upper_bound(bucket), value);
+    if (bucket > 0) {
+      EXPECT_LT(LatencyHistogram::bucket_upper_bound(bucket - 1), value);
+    }
+  }
+  // Exact below 16, then at most 1/16 relative error
+  EXPECT_EQ(LatencyHistogram::bucket_upper_bound(LatencyHistogram::bucket_of(15)), 15u);
+  EXPECT_EQ(LatencyHistogram::bucket_upper_bound(LatencyHistogram::bucket_of(1000)), 1023u);
+  EXPECT_EQ(LatencyHistogram::bucket_of(UINT64_MAX), LatencyHistogram::BUCKET_COUNT - 1);
+}
+
+TEST(LatencyHistogramTest, Percentiles) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(histogram.percentile(0.99), 0u);
+
+  for (uint64_t value = 1; value <= 100; ++value) {
+    histogram.record(value);
+  }
+  EXPECT_EQ(histogram.count(), 100u);
+  EXPECT_EQ(histogram.max(), 100u);
+  // Reported as the bucket's upper bound: 50 shares a bucket with 51
+  EXPECT_EQ(histogram.percentile(0.50), 51u);
+  EXPECT_EQ(histogram.percentile(0.99), 99u);
+  EXPECT_EQ(histogram.percentile(1.0), 100u);
+  EXPECT_EQ(histogram.percentile(0.0), 1u);
+
+  histogram.clear();
+  EXPECT_EQ(histogram.count(), 0u);
+  EXPECT_EQ(histogram.max(), 0u);
+}
+
+TEST(LatencyMonitorTest, PublishesClosedWindow) {
+  LatencyMonitor monitor;
+  monitor.configure(WINDOW_NS, {});
+
+  // First sample opens the window [0, 1000)
+  for (uint64_t i = 0; i < 100; ++i) {
+    monitor.record(FeedStage::RING_WAIT, 10, i);
+  }
+  EXPECT_EQ(monitor.get_snapshot(FeedStage::RING_WAIT).samples, 0u);
+
+  monitor.record(FeedStage::RING_WAIT, 500, WINDOW_NS);
+  auto snapshot = monitor.get_snapshot(FeedStage::RING_WAIT);
+  EXPECT_EQ(snapshot.window_end_ns, WINDOW_NS);
+  EXPECT_EQ(snapshot.samples, 100u);
+  EXPECT_EQ(snapshot.p50_ns, 10u);
+  EXPECT_EQ(snapshot.p99_ns, 10u);
+  EXPECT_EQ(snapshot.max_ns, 10u);
+
+  // Other stages are independent
+  EXPECT_EQ(monitor.get_snapshot(FeedStage::STORE_APPLY).samples, 0u);
+
+  monitor.record(FeedStage::RING_WAIT, 10, 3 * WINDOW_NS);
+  snapshot = monitor.get_snapshot(FeedStage::RING_WAIT);
+  EXPECT_EQ(snapshot.samples, 1u);
+  EXPECT_EQ(snapshot.max_ns, 500u);
+
+  monitor.reset();
+  EXPECT_EQ(monitor.get_snapshot(FeedStage::RING_WAIT).samples, 0u);
+  EXPECT_EQ(monitor.get_snapshot(FeedStage::RING_WAIT).window_end_ns, 0u);
+}
+
+TEST(LatencyMonitorTest, MaxBudgetAlarmsOncePerWindow) {
+  LatencyMonitor monitor;
+  monitor.configure(WINDOW_NS, budgets_for(FeedStage::STORE_APPLY, {0, 100}));
+
+  monitor.record(FeedStage::STORE_APPLY, 100, 0); // at budget: fine
+  monitor.record(FeedStage::STORE_APPLY, 150, 1);
+  monitor.record(FeedStage::STORE_APPLY, 900, 2);
+  monitor.record(FeedStage::RING_WAIT, 900, 3); // no budget for this stage
+
+  EXPECT_EQ(monitor.get_snapshot(FeedStage::STORE_APPLY).breaches, 2u);
+  EXPECT_EQ(monitor.alarms_raised(), 1u);
+
+  LatencyAlarm alarm;
+  ASSERT_TRUE(monitor.pop_alarm(alarm));
+  EXPECT_EQ(alarm.stage, FeedStage::STORE_APPLY);
+  EXPECT_EQ(alarm.kind, LatencyAlarmKind::MAX_OVER_BUDGET);
+  EXPECT_EQ(alarm.observed_ns, 150u);
+  EXPECT_EQ(alarm.budget_ns, 100u);
+  EXPECT_EQ(alarm.timestamp_ns, 1u);
+  EXPECT_FALSE(monitor.pop_alarm(alarm));
+
+  // Next window may alarm again
+  monitor.record(FeedStage::STORE_APPLY, 200, WINDOW_NS + 5);
+  EXPECT_EQ(monitor.alarms_raised(), 2u);
+}
+
+TEST(LatencyMonitorTest, P99BudgetCheckedAtWindowClose) {
+  LatencyMonitor monitor;
+  monitor.configure(WINDOW_NS, budgets_for(FeedStage::GENERATE_TO_RING, {50, 0}));
+
+  // 2% of samples are slow: the p99 is over budget, no max budget set
+  for (uint64_t i = 0; i < 100; ++i) {
+    monitor.record(FeedStage::GENERATE_TO_RING, i < 98 ? 10 : 400, i);
+  }
+  EXPECT_EQ(monitor.alarms_raised(), 0u);
+
+  monitor.record(FeedStage::GENERATE_TO_RING, 10, WINDOW_NS);
+  LatencyAlarm alarm;
+  ASSERT_TRUE(monitor.pop_alarm(alarm));
+  EXPECT_EQ(alarm.kind, LatencyAlarmKind::P99_OVER_BUDGET);
+  EXPECT_EQ(alarm.timestamp_ns, WINDOW_NS);
+  EXPECT_GE(alarm.observed_ns, 400u);
+  EXPECT_EQ(alarm.budget_ns, 50u);
+  EXPECT_EQ(monitor.get_snapshot(FeedStage::GENERATE_TO_RING).breaches, 0u);
+
+  // A quiet window raises nothing
+  monitor.record(FeedStage::GENERATE_TO_RING, 10, 2 * WINDOW_NS + 1);
+  EXPECT_EQ(monitor.alarms_raised(), 1u);
+}
+
+TEST(LatencyMonitorTest, FullAlarmRingCountsDrops) {
+  LatencyMonitor monitor;
+  monitor.configure(WINDOW_NS, budgets_for(FeedStage::RING_WAIT, {0, 1}));
+
+  const uint64_t windows = LatencyMonitor::ALARM_RING_SIZE + 10;
+  for (uint64_t w = 0; w < windows; ++w) {
+    monitor.record(FeedStage::RING_WAIT, 5, w * WINDOW_NS);
+  }
+  EXPECT_EQ(monitor.alarms_raised(), windows);
+  EXPECT_EQ(monitor.alarms_dropped(), 10u);
+
+  LatencyAlarm alarm;
+  uint64_t popped = 0;
+  while (monitor.pop_alarm(alarm)) {
+    ++popped;
+  }
+  EXPECT_EQ(popped, LatencyMonitor::ALARM_RING_SIZE);
+}
@@ -0,0 +1,57 @@
+#include "common/perf_counters.hpp"
+#include "market_data/layout_report.hpp"
+#include <gtest/gtest.h>
+#include <sstream>
+
+using namespace mini_mart::market_data;
+using namespace mini_mart::common;
+
+static_assert(cache_lines(0) == 0);
+static_assert(cache_lines(1) == 1);
+static_assert(cache_lines(64) == 1);
+static_assert(cache_lines(65) == 2);
+static_assert(layout_of<MarketDataL2Message>("L2").lines == 3);
+
+TEST(LayoutReportTest, FootprintsFollowLayouts) {
+  const auto few = operation_footprints(8);
+  const auto many = operation_footprints(200);
+  // Ring operations touch the message plus both indices
+  EXPECT_EQ(few[0].lines, cache_lines(sizeof(MarketDataL2Message)) + 2);
+  // Dynamic-index lookups grow with the number of active securities
+  EXPECT_LT(few[3].lines, many[3].lines);
+  EXPECT_EQ(few[4].lines, many[4].lines);
+  // Unknown symbols scan every slot key, not every SecurityData
+  EXPECT_EQ(few[5].lines, SecurityStore::MAX_SECURITIES * sizeof(uint64_t) / CACHE_LINE_SIZE);
+}
+
+TEST(LayoutReportTest, PrintsEveryType) {
+  std::ostringstream out;
+  print_layout_report(out, 8);
+  const std::string report = out.str();
+  for (const TypeLayout &layout : CORE_TYPE_LAYOUTS) {
+    EXPECT_NE(report.find(layout.name), std::string::npos) << layout.name;
+  }
+  EXPECT_NE(report.find("MarketDataFeed"), std::string::npos);
+  EXPECT_NE(report.find(std::to_string(sizeof(MarketDataFeed))), std::string::npos);
+}
+
+TEST(PerfCountersTest, UnavailableCountersReadZero) {
+  PerfCounters counters;
+  const int error = counters.open();
+  EXPECT_LE(error, 0);
+  EXPECT_EQ(counters.available(), error == 0);
+  counters.start();
+  volatile uint64_t sink = 0;
+  for (uint64_t i = 0; i < 1000; ++i) {
+    sink = sink + i;
+  }
+  counters.stop();
+  const PerfCounters::Values values = counters.read();
+  if (!counters.available()) {
+    for (uint64_t value : values) {
+      EXPECT_EQ(value, 0u);
+    }
+  } else {
+    EXPECT_GT(values[PerfCounters::INSTRUCTIONS], 1000u);
+  }
+}
@@ -0,0 +1,251 @@
+#include "market_data/load_shedder.hpp"
+#include "market_data/market_data_feed.hpp"
+#include "market_data/security_seeder.hpp"
+#include <functional>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace mini_mart::market_data;
+using namespace mini_mart::types;
+
+namespace {
+
+constexpr size_t CAPACITY = 100;
+
+struct CountingStats {
+  uint64_t conflated = 0;
+  uint64_t sampled_out = 0;
+  void on_conflated() { ++conflated; }
+  void on_sampled_out() { ++sampled_out; }
+};
+
+MarketDataL2Message make_message(const SecurityId &security_id, uint64_t bid_raw) {
+  MarketDataL2Message message{};
+  message.security_id = security_id;
+  message.num_bid_levels = 1;
+  message.bids[0] = {price_from_raw(bid_raw), 100};
+  return message;
+}
+
+class LoadShedderTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    config_.shed_rules = {{{100, ShedAction::CONFLATE},
+                           {75, ShedAction::SAMPLE},
+                           {50, ShedAction::CONFLATE}}};
+    config_.shed_sample_interval = 4;
+    config_.default_priority = SymbolPriority::LOW;
+  }
+
+  bool admit(PriorityLoadShedder &shedder, const SecurityId &id, uint64_t bid_raw,
+             size_t occupancy) {
+    return shedder.admit(make_message(id, bid_raw), occupancy, CAPACITY, push_, stats_);
+  }
+
+  FeedConfig config_;
+  CountingStats stats_;
+  std::vector<MarketDataL2Message> pushed_;
+  std::function<bool(const MarketDataL2Message &)> push_ =
+      [this](const MarketDataL2Message &message) {
+        pushed_.push_back(message);
+        return true;
+      };
+
+  const SecurityId high_ = SecuritySeeder::create_security_id("AAPL");
+  const SecurityId normal_ = SecuritySeeder::create_security_id("MSFT");
+  const SecurityId low_ = SecuritySeeder::create_security_id("ZZZZ");
+};
+
+} // namespace
+
+TEST_F(LoadShedderTest, PrioritiesDefaultAndOverride) {
+  PriorityLoadShedder shedder(config_);
+  EXPECT_EQ(shedder.get_priority(high_), SymbolPriority::LOW);
+  EXPECT_TRUE(shedder.set_priority(high_, SymbolPriority::HIGH));
+  EXPECT_TRUE(shedder.set_priority(normal_, SymbolPriority::NORMAL));
+  EXPECT_FALSE(shedder.set_priority(SecurityId{}, SymbolPriority::HIGH));
+  EXPECT_FALSE(shedder.set_priority(low_, SymbolPriority::COUNT));
+  EXPECT_EQ(shedder.get_priority(high_), SymbolPriority::HIGH);
+  EXPECT_EQ(shedder.get_priority(normal_), SymbolPriority::NORMAL);
+  EXPECT_EQ(shedder.get_priority(low_), SymbolPriority::LOW);
+}
+
+TEST_F(LoadShedderTest, AdmitsEverythingBelowThresholds) {
+  PriorityLoadShedder shedder(config_);
+  for (uint64_t i = 0; i < 10; ++i) {
+    EXPECT_TRUE(admit(shedder, low_, i, 49));
+  }
+  EXPECT_EQ(stats_.conflated, 0u);
+  EXPECT_TRUE(pushed_.empty());
+}
+
+TEST_F(LoadShedderTest, ConflatesLowPriorityAndFlushesNewest) {
+  PriorityLoadShedder shedder(config_);
+  ASSERT_TRUE(shedder.set_priority(high_, SymbolPriority::HIGH));
+
+  // Over the LOW threshold: held, each newer update supersedes the last
+  for (uint64_t i = 1; i <= 5; ++i) {
+    EXPECT_FALSE(admit(shedder, low_, i, 60));
+  }
+  EXPECT_EQ(shedder.held_count(), 1u);
+  EXPECT_EQ(stats_.conflated, 4u);
+  // HIGH is never shed
+  EXPECT_TRUE(admit(shedder, high_, 100, 99));
+  EXPECT_TRUE(pushed_.empty());
+
+  // Ring drained: the held update goes in ahead of the next message
+  EXPECT_TRUE(admit(shedder, high_, 101, 10));
+  ASSERT_EQ(pushed_.size(), 1u);
+  EXPECT_EQ(pushed_[0].security_id, low_);
+  EXPECT_EQ(pushed_[0].bids[0].price, price_from_raw(5));
+  EXPECT_EQ(shedder.held_count(), 0u);
+  EXPECT_EQ(stats_.conflated, 4u);
+}
+
+TEST_F(LoadShedderTest, AdmittedUpdateSupersedesHeld) {
+  config_.shed_rules[static_cast<size_t>(SymbolPriority::NORMAL)] = {60, ShedAction::CONFLATE};
+  config_.shed_rules[static_cast<size_t>(SymbolPriority::LOW)] = {80, ShedAction::CONFLATE};
+  PriorityLoadShedder shedder(config_);
+
+  EXPECT_FALSE(admit(shedder, low_, 1, 90));
+  // Back under LOW's threshold but not under NORMAL's: no flush, the newer
+  // update replaces the held one
+  EXPECT_TRUE(admit(shedder, low_, 2, 70));
+  EXPECT_EQ(stats_.conflated, 1u);
+  EXPECT_EQ(shedder.held_count(), 0u);
+
+  EXPECT_TRUE(admit(shedder, low_, 3, 0));
+  EXPECT_TRUE(pushed_.empty());
+}
+
+TEST_F(LoadShedderTest, SamplesNormalPriority) {
+  PriorityLoadShedder shedder(config_);
+  ASSERT_TRUE(shedder.set_priority(normal_, SymbolPriority::NORMAL));
+
+  uint64_t admitted = 0;
+  for (uint64_t i = 0; i < 40; ++i) {
+    admitted += admit(shedder, normal_, i, 80) ? 1u : 0u;
+  }
+  EXPECT_EQ(admitted, 10u);
+  EXPECT_EQ(stats_.sampled_out, 30u);
+  EXPECT_EQ(shedder.held_count(), 0u);
+}
+
+TEST_F(LoadShedderTest, FailedFlushKeepsHeldUpdates) {
+  PriorityLoadShedder shedder(config_);
+  const SecurityId other = SecuritySeeder::create_security_id("YYYY");
+  EXPECT_FALSE(admit(shedder, low_, 1, 60));
+  EXPECT_FALSE(admit(shedder, other, 2, 60));
+
+  bool accept = false;
+  push_ = [&](const MarketDataL2Message &message) {
+    if (!accept) {
+      return false;
+    }
+    pushed_.push_back(message);
+    return true;
+  };
+  EXPECT_TRUE(admit(shedder, high_, 3, 0));
+  EXPECT_EQ(shedder.held_count(), 2u);
+
+  accept = true;
+  EXPECT_TRUE(admit(shedder, high_, 4, 0));
+  ASSERT_EQ(pushed_.size(), 2u);
+  EXPECT_EQ(pushed_[0].security_id, low_);
+  EXPECT_EQ(pushed_[1].security_id, other);
+}
+
+namespace {
+
+// Provider driven by the test
+class ManualProvider : public MarketDataProvider {
+public:
+  bool start() override { return true; }
+  void stop() override {}
+  bool is_running() const override { return true; }
+  bool subscribe(const SecurityId &) override { return true; }
+  bool unsubscribe(const SecurityId &) override { return true; }
+  void set_callback(MarketDataCallback callback) override { callback_ = std::move(callback); }
+  std::vector<SecurityId> get_subscribed_securities() const override { return {}; }
+
+  void publish(const SecurityId &id, uint64_t bid_raw) { callback_(make_message(id, bid_raw)); }
+
+private:
+  MarketDataCallback callback_;
+};
+
+// Blocks the consumer until opened, so the test controls ring occupancy
+struct GateSink {
+  std::shared_ptr<std::atomic<bool>> open = std::make_shared<std::atomic<bool>>(false);
+  bool on_message(const MarketDataL2Message &) {
+    while (!open->load(std::memory_order_acquire)) {
+      std::this_thread::yield();
+    }
+    return true;
+  }
+};
+
+} // namespace
+
+TEST(LoadSheddingFeedTest, HighPriorityKeepsFullRateUnderOverload) {
+  using Sink = FanoutSink<StoreSink<SecurityStore>, GateSink>;
+  using Feed = BasicMarketDataFeed<SpscRing<MarketDataL2Message, 64>, YieldWait,
+                                   HighResolutionClock, AtomicStatistics, Sink,
+                                   PriorityLoadShedder>;
+
+  auto provider = std::make_shared<ManualProvider>();
+  auto store = std::make_shared<SecurityStore>();
+  GateSink gate;
+  FeedConfig config;
+  config.default_priority = SymbolPriority::LOW; // LOW: conflated at 50%
+  Feed feed(provider, Sink(StoreSink<SecurityStore>(store), gate), config);
+
+  const SecurityId high = SecuritySeeder::create_security_id("AAPL");
+  const SecurityId low = SecuritySeeder::create_security_id("ZZZZ");
+  ASSERT_TRUE(feed.set_priority(high, SymbolPriority::HIGH));
+  ASSERT_TRUE(feed.start());
+  ASSERT_TRUE(feed.subscribe(high));
+  ASSERT_TRUE(feed.subscribe(low));
+
+  // Fill the ring past 50% with HIGH, then flood LOW
+  for (uint64_t i = 0; i < 40; ++i) {
+    provider->publish(high, 1000 + i);
+  }
+  for (uint64_t i = 0; i < 500; ++i) {
+    provider->publish(low, 5000 + i);
+  }
+  for (uint64_t i = 40; i < 60; ++i) {
+    provider->publish(high, 1000 + i);
+  }
+
+  const auto &stats = feed.get_statistics();
+  EXPECT_EQ(stats.ring_full_events.load(), 0u);
+  EXPECT_EQ(stats.messages_conflated.load(), 499u);
+
+  gate.open->store(true, std::memory_order_release);
+  while (stats.messages_consumed.load() < 60) {
+    std::this_thread::yield();
+  }
+  // The next callback after the drain delivers the held LOW update
+  provider->publish(high, 2000);
+  while (stats.messages_consumed.load() < 62) {
+    std::this_thread::yield();
+  }
+  feed.stop();
+
+  SecurityStore::SecuritySnapshot snapshot;
+  ASSERT_TRUE(store->get_security_snapshot(high, snapshot));
+  EXPECT_EQ(snapshot.update_count, 61u);
+  EXPECT_EQ(snapshot.best_bid, price_from_raw(2000));
+  ASSERT_TRUE(store->get_security_snapshot(low, snapshot));
+  EXPECT_EQ(snapshot.update_count, 1u);
+  EXPECT_EQ(snapshot.best_bid, price_from_raw(5499));
+}
+
+TEST(LoadSheddingFeedTest, NoLoadSheddingRejectsPriorities) {
+  auto provider = std::make_shared<ManualProvider>();
+  MarketDataFeed feed(provider, std::make_shared<SecurityStore>());
+  EXPECT_FALSE(feed.set_priority(SecuritySeeder::create_security_id("AAPL"),
+                                 SymbolPriority::HIGH));
+}
@@ -1,8 +1,11 @@
 #include <gtest/gtest.h>
+#include "common/mpmc_ring.hpp"
 #include "market_data/market_data_feed.hpp"
 #include "market_data/random_market_data_provider.hpp"
 #include "market_data/security_seeder.hpp"
 #include <chrono>
+#include <poll.h>
+#include <sys/epoll.h>
 #include <thread>
 
 using namespace mini_mart::market_data;
@@ -293,3 +296,332 @@ TEST_F(MarketDataFeedTest, ThreadSafety) {
     EXPECT_GT(subscribe_count.load(), 0);
     EXPECT_GT(unsubscribe_count.load(), 0);
 }
+
+namespace {
+
+// Provider driven by the test: publish() and send() invoke the feed
+// callbacks inline
+class ManualProvider : public MarketDataProvider {
+public:
+    bool start() override { running_ = true; return true; }
+    void stop() override { running_ = false; }
+    bool is_running() const override { return running_; }
+    bool subscribe(const SecurityId &) override { return true; }
+    bool unsubscribe(const SecurityId &) override { return true; }
+    void set_callback(MarketDataCallback callback) override { callback_ = std::move(callback); }
+    void set_message_callback(MarketDataMessageCallback callback) override {
+        message_callback_ = std::move(callback);
+    }
+    std::vector<SecurityId> get_subscribed_securities() const override { return {}; }
+
+    void send(const MarketDataEnvelope &message) { message_callback_(message); }
+
+    void publish(const SecurityId &security_id, uint64_t best_bid_raw) {
+        MarketDataL2Message message{};
+        message.security_id = security_id;
+        message.num_bid_levels = 1;
+        message.bids[0] = {price_from_raw(best_bid_raw), 100};
+        message.timestamp_ns = mini_mart::common::time_utils::now_ns();
+        callback_(message);
+    }
+
+private:
+    bool running_{false};
+    MarketDataCallback callback_;
+    MarketDataMessageCallback message_callback_;
+};
+
+struct CountingSink {
+    std::shared_ptr<std::atomic<uint64_t>> count = std::make_shared<std::atomic<uint64_t>>(0);
+    bool on_message(const MarketDataL2Message &) {
+        count->fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+};
+
+template <typename Feed, typename Counter>
+void publish_and_drain(ManualProvider &provider, Feed &feed, const SecurityId &id,
+                       const Counter &consumed, uint64_t count) {
+    ASSERT_TRUE(feed.start());
+    ASSERT_TRUE(feed.subscribe(id));
+    for (uint64_t i = 0; i < count; ++i) {
+        provider.publish(id, 1000000 + i);
+        // Keep the ring from overflowing
+        while (i + 1 - consumed() > 128) {
+            std::this_thread::yield();
+        }
+    }
+    while (consumed() < count) {
+        std::this_thread::yield();
+    }
+    feed.stop();
+}
+
+} // namespace
+
+TEST(MarketDataFeedPolicyTest, NoStatisticsSpinWaitFanout) {
+    using Sink = FanoutSink<StoreSink<SecurityStore>, CountingSink>;
+    using Feed = BasicMarketDataFeed<SpscRing<MarketDataL2Message, 1024>, SpinWait,
+                                     SteadyClock, NoStatistics, Sink>;
+
+    auto provider = std::make_shared<ManualProvider>();
+    auto store = std::make_shared<SecurityStore>();
+    CountingSink counter;
+    Feed feed(provider, Sink(StoreSink<SecurityStore>(store), counter));
+
+    const SecurityId id = SecuritySeeder::create_security_id("AAPL");
+    publish_and_drain(*provider, feed, id, [&] { return counter.count->load(); }, 5000);
+
+    SecurityStore::SecuritySnapshot snapshot;
+    ASSERT_TRUE(store->get_security_snapshot(id, snapshot));
+    EXPECT_EQ(snapshot.best_bid, price_from_raw(1000000 + 4999));
+    EXPECT_EQ(snapshot.update_count, 5000u);
+
+    // The consumer commits at most store_commit_batch updates at a time and
+    // leaves nothing uncommitted when it stops
+    const uint64_t commits = store->committed_sequence();
+    EXPECT_GE(commits, 5000u / FeedConfig().store_commit_batch);
+    EXPECT_LE(commits, 5000u);
+    uint64_t commit = 0;
+    ASSERT_EQ(store->get_consistent_snapshots(&id, 1, &snapshot, &commit),
+              SecurityStore::ConsistentRead::SUCCESS);
+    EXPECT_EQ(commit, commits);
+    EXPECT_EQ(snapshot.commit_sequence, commits);
+
+    // Compiled out: nothing counted
+    EXPECT_EQ(feed.get_statistics().messages_produced.load(), 0u);
+    EXPECT_EQ(feed.get_statistics().messages_consumed.load(), 0u);
+}
+
+TEST(MarketDataFeedPolicyTest, AtomicStatisticsBackoffMpmcRing) {
+    using Feed = BasicMarketDataFeed<MpmcRing<MarketDataL2Message, 256>, BackoffWait,
+                                     HighResolutionClock, AtomicStatistics>;
+
+    auto provider = std::make_shared<ManualProvider>();
+    auto store = std::make_shared<SecurityStore>();
+    FeedConfig config;
+    config.enable_statistics = false; // ignored by AtomicStatistics
+    Feed feed(provider, store, config);
+    EXPECT_EQ(Feed::DEFAULT_RING_SIZE, 256u);
+
+    const SecurityId id = SecuritySeeder::create_security_id("MSFT");
+    const auto &stats = feed.get_statistics();
+    publish_and_drain(*provider, feed, id, [&] { return stats.messages_consumed.load(); }, 2000);
+
+    EXPECT_EQ(stats.messages_produced.load(), 2000u);
+    EXPECT_EQ(stats.messages_consumed.load(), 2000u);
+    EXPECT_EQ(stats.ring_full_events.load(), 0u);
+    EXPECT_GT(stats.get_average_latency_ns(), 0.0);
+    EXPECT_TRUE(store->contains(id));
+}
+
+TEST(MarketDataFeedPolicyTest, StageLatencyMonitorsRaiseAlarms) {
+    auto provider = std::make_shared<ManualProvider>();
+    auto store = std::make_shared<SecurityStore>();
+    FeedConfig config;
+    config.consumer_yield_us = 0;
+    config.latency_window_ms = 1;
+    // Every store apply takes more than 1 ns
+    config.latency_budgets[static_cast<size_t>(FeedStage::STORE_APPLY)] = {1, 1};
+    MarketDataFeed feed(provider, store, config);
+
+    const SecurityId id = SecuritySeeder::create_security_id("AAPL");
+    const auto &stats = feed.get_statistics();
+    ASSERT_TRUE(feed.start());
+    ASSERT_TRUE(feed.subscribe(id));
+    // Two bursts a few windows apart, so the first window is closed and published
+    for (uint64_t burst = 0; burst < 2; ++burst) {
+        for (uint64_t i = 0; i < 100; ++i) {
+            provider->publish(id, 1000000 + i);
+            while (stats.messages_produced.load() - stats.messages_consumed.load() > 128) {
+                std::this_thread::yield();
+            }
+        }
+        while (stats.messages_consumed.load() < (burst + 1) * 100) {
+            std::this_thread::yield();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    feed.stop();
+
+    for (size_t i = 0; i < FEED_STAGE_COUNT; ++i) {
+        const auto snapshot = stats.latency.get_snapshot(static_cast<FeedStage>(i));
+        EXPECT_GT(snapshot.samples, 0u) << feed_stage_name(static_cast<FeedStage>(i));
+        EXPECT_GT(snapshot.window_end_ns, 0u);
+        EXPECT_LE(snapshot.p50_ns, snapshot.p99_ns);
+        EXPECT_LE(snapshot.p99_ns, snapshot.max_ns);
+    }
+    EXPECT_EQ(stats.latency.get_snapshot(FeedStage::STORE_APPLY).breaches, 200u);
+    EXPECT_EQ(stats.latency.get_snapshot(FeedStage::RING_WAIT).breaches, 0u);
+
+    bool saw_max = false;
+    bool saw_p99 = false;
+    LatencyAlarm alarm;
+    while (stats.latency.pop_alarm(alarm)) {
+        EXPECT_EQ(alarm.stage, FeedStage::STORE_APPLY);
+        EXPECT_EQ(alarm.budget_ns, 1u);
+        saw_max |= alarm.kind == LatencyAlarmKind::MAX_OVER_BUDGET;
+        saw_p99 |= alarm.kind == LatencyAlarmKind::P99_OVER_BUDGET;
+    }
+    EXPECT_TRUE(saw_max);
+    EXPECT_TRUE(saw_p99);
+}
+
+namespace {
+
+bool readable(int fd) {
+    pollfd entry{fd, POLLIN, 0};
+    return ::poll(&entry, 1, 0) == 1;
+}
+
+} // namespace
+
+TEST(MarketDataFeedPolicyTest, EventfdWaitSignalsOnlyWhenRingTurnsNonEmpty) {
+    using Feed = BasicMarketDataFeed<SpscRing<MarketDataL2Message, 1024>, EventfdWait>;
+    auto provider = std::make_shared<ManualProvider>();
+    auto store = std::make_shared<SecurityStore>();
+    Feed feed(provider, store);
+    const SecurityId id = SecuritySeeder::create_security_id("AAPL");
+    ASSERT_TRUE(feed.start());
+    ASSERT_TRUE(feed.subscribe(id));
+    ASSERT_GE(feed.notification_fd(), 0);
+    EXPECT_FALSE(readable(feed.notification_fd()));
+
+    // Three pushes into an empty ring: one eventfd write
+    for (uint64_t i = 0; i < 3; ++i) {
+        provider->publish(id, 1000000 + i);
+    }
+    EXPECT_TRUE(readable(feed.notification_fd()));
+    EXPECT_EQ(feed.notifications_sent(), 1u);
+    EXPECT_EQ(feed.poll(), 3u);
+    EXPECT_FALSE(readable(feed.notification_fd()));
+
+    SecurityStore::SecuritySnapshot snapshot;
+    ASSERT_TRUE(store->get_security_snapshot(id, snapshot));
+    EXPECT_EQ(snapshot.update_count, 3u);
+
+    // Stopping early with work left keeps the fd readable
+    provider->publish(id, 1000010);
+    provider->publish(id, 1000011);
+    EXPECT_EQ(feed.notifications_sent(), 2u);
+    EXPECT_EQ(feed.poll(1), 1u);
+    EXPECT_TRUE(readable(feed.notification_fd()));
+    EXPECT_EQ(feed.poll(), 1u);
+    EXPECT_FALSE(readable(feed.notification_fd()));
+    EXPECT_EQ(feed.poll(), 0u);
+    feed.stop();
+}
+
+TEST(MarketDataFeedPolicyTest, EventfdWaitDrivesAnEpollLoop) {
+    using Feed = BasicMarketDataFeed<SpscRing<MarketDataL2Message, 1024>, EventfdWait>;
+    auto provider = std::make_shared<ManualProvider>();
+    auto store = std::make_shared<SecurityStore>();
+    Feed feed(provider, store);
+    const SecurityId id = SecuritySeeder::create_security_id("MSFT");
+    ASSERT_TRUE(feed.start());
+    ASSERT_TRUE(feed.subscribe(id));
+
+    const int epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+    ASSERT_GE(epoll_fd, 0);
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = feed.notification_fd();
+    ASSERT_EQ(::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, feed.notification_fd(), &event), 0);
+
+    constexpr uint64_t MESSAGES = 20000;
+    std::atomic<uint64_t> consumed{0};
+    std::thread producer([&] {
+        for (uint64_t i = 0; i < MESSAGES; ++i) {
+            provider->publish(id, 1000000 + i);
+            while (i + 1 - consumed.load(std::memory_order_acquire) > 512) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint64_t total = 0;
+    while (total < MESSAGES) {
+        epoll_event ready{};
+        const int count = ::epoll_wait(epoll_fd, &ready, 1, 5000);
+        ASSERT_EQ(count, 1) << "missed a wakeup after " << total << " messages";
+        total += feed.poll(256);
+        consumed.store(total, std::memory_order_release);
+    }
+    producer.join();
+    ::close(epoll_fd);
+    feed.stop();
+
+    SecurityStore::SecuritySnapshot snapshot;
+    ASSERT_TRUE(store->get_security_snapshot(id, snapshot));
+    EXPECT_EQ(snapshot.update_count, MESSAGES);
+    EXPECT_LE(feed.notifications_sent(), MESSAGES);
+}
+
+TEST(MarketDataFeedPolicyTest, EnvelopeRingDispatchesMixedStream) {
+    struct TradeCounter {
+        std::shared_ptr<std::atomic<uint64_t>> trades = std::make_shared<std::atomic<uint64_t>>(0);
+        bool on_message(const TradeMessage &) {
+            trades->fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    };
+    using Sink = FanoutSink<StoreSink<SecurityStore>, CountingSink, TradeCounter>;
+    using Feed = BasicMarketDataFeed<SpscRing<MarketDataEnvelope, 1024>, YieldWait,
+                                     HighResolutionClock, RuntimeStatistics, Sink>;
+    static_assert(Feed::ENVELOPED);
+
+    auto provider = std::make_shared<ManualProvider>();
+    auto store = std::make_shared<SecurityStore>();
+    CountingSink l2_counter;
+    TradeCounter trade_counter;
+    Feed feed(provider, Sink(StoreSink<SecurityStore>(store), l2_counter, trade_counter));
+    const SecurityId id = SecuritySeeder::create_security_id("AAPL");
+    ASSERT_TRUE(feed.start());
+    ASSERT_TRUE(feed.subscribe(id));
+
+    TradeMessage trade{};
+    trade.security_id = id;
+    trade.price = price_from_raw(1000300);
+    trade.quantity = 10;
+    BookDeltaMessage delta{};
+    delta.security_id = id;
+    delta.side = Side::ASK;
+    delta.level = {price_from_raw(1000400), 5};
+    // publish() shares the provider's producer slot: refused until the
+    // provider has called back, and from any other thread
+    EXPECT_FALSE(feed.publish(trade));
+    // L2 via the provider's callback, the rest via its message callback
+    for (uint64_t i = 0; i < 100; ++i) {
+        provider->publish(id, 1000000 + i);
+        provider->send(trade);
+        provider->send(delta);
+        provider->send(HeartbeatMessage{});
+    }
+    std::thread other_thread([&] { EXPECT_FALSE(feed.publish(trade)); });
+    other_thread.join();
+    // The store refuses a trade for a security it does not hold
+    TradeMessage unknown_trade = trade;
+    unknown_trade.security_id = SecuritySeeder::create_security_id("NOPE");
+    ASSERT_TRUE(feed.publish(unknown_trade));
+    const auto &stats = feed.get_statistics();
+    // Heartbeats reach no handler: counted as skipped, not consumed
+    while (stats.messages_consumed.load() + stats.messages_skipped.load() +
+               stats.messages_rejected.load() < 401) {
+        std::this_thread::yield();
+    }
+    feed.stop();
+
+    EXPECT_EQ(stats.messages_produced.load(), 401u);
+    EXPECT_EQ(stats.messages_consumed.load(), 300u);
+    EXPECT_EQ(stats.messages_skipped.load(), 100u);
+    EXPECT_EQ(stats.messages_rejected.load(), 1u);
+    EXPECT_EQ(l2_counter.count->load(), 100u);
+    EXPECT_EQ(trade_counter.trades->load(), 100u);
+    SecurityStore::SecuritySnapshot snapshot;
+    ASSERT_TRUE(store->get_security_snapshot(id, snapshot));
+    EXPECT_EQ(snapshot.update_count, 300u);
+    EXPECT_EQ(snapshot.total_volume, 1000u);
+    EXPECT_EQ(snapshot.last_trade_price, price_from_raw(1000300));
+    EXPECT_EQ(snapshot.best_bid, price_from_raw(1000099));
+    EXPECT_EQ(snapshot.best_ask, price_from_raw(1000400));
+}
@@ -288,6 +288,34 @@ TEST_F(MarketDataProviderTest, ThreadSafety) {
   EXPECT_TRUE(true); // If we get here, no crashes occurred
 }
 
+TEST_F(MarketDataProviderTest, HeartbeatsOnTheL2CallbackThread) {
+  config_.heartbeat_interval_us = 200;
+  provider_ = std::make_unique<RandomMarketDataProvider>(config_);
+  std::atomic<std::thread::id> l2_thread{};
+  std::atomic<int> heartbeats{0};
+  std::atomic<int> off_thread{0};
+
+  provider_->set_callback([&](const MarketDataL2Message &) {
+    l2_thread.store(std::this_thread::get_id());
+  });
+  provider_->set_message_callback([&](const MarketDataEnvelope &message) {
+    EXPECT_TRUE(message.is<HeartbeatMessage>());
+    const std::thread::id seen = l2_thread.load();
+    if (seen != std::thread::id{} && seen != std::this_thread::get_id()) {
+      off_thread++;
+    }
+    heartbeats++;
+  });
+  EXPECT_TRUE(provider_->subscribe(SecuritySeeder::create_security_id("AAPL")));
+  EXPECT_TRUE(provider_->start());
+  while (heartbeats.load() < 3) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  provider_->stop();
+
+  EXPECT_EQ(off_thread.load(), 0);
+}
+
 // Test SecuritySeeder functionality
 TEST(SecuritySeederTest, CreateSecurityId) {
   auto aapl = SecuritySeeder::create_security_id("AAPL");
@@ -0,0 +1,87 @@
+#include "types/message_envelope.hpp"
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace mini_mart::types;
+
+namespace {
+
+SecurityId symbol(const char *text) {
+  SecurityId id{};
+  for (size_t i = 0; i < id.size() && text[i] != '\0'; ++i) {
+    id[i] = text[i];
+  }
+  return id;
+}
+
+// Names the overload that was called
+struct NamingVisitor {
+  std::string operator()(const MarketDataL2Message &) const { return "l2"; }
+  std::string operator()(const TradeMessage &trade) const {
+    return "trade " + std::to_string(trade.quantity);
+  }
+  std::string operator()(const BookDeltaMessage &) const { return "delta"; }
+  std::string operator()(const HeartbeatMessage &) const { return "heartbeat"; }
+};
+
+} // namespace
+
+TEST(MessageEnvelopeTest, SlotIsNoLargerThanTheLargestMessage) {
+  EXPECT_EQ(sizeof(MarketDataEnvelope), sizeof(MarketDataL2Message));
+  EXPECT_EQ(MarketDataEnvelope::MAX_TYPE, static_cast<size_t>(MessageType::BOOK_DELTA));
+  EXPECT_TRUE(MarketDataEnvelope::holds<TradeMessage>);
+  EXPECT_FALSE((MessageEnvelope<TradeMessage>::holds<MarketDataL2Message>));
+}
+
+TEST(MessageEnvelopeTest, StoreStampsTypeAndVisitRoutesByIt) {
+  TradeMessage trade{};
+  trade.security_id = symbol("AAPL");
+  trade.price = price_from_raw(1500000);
+  trade.quantity = 300;
+
+  MarketDataEnvelope envelope(trade);
+  EXPECT_EQ(envelope.type(), MessageType::TRADE);
+  EXPECT_EQ(envelope.header().length, sizeof(TradeMessage));
+  ASSERT_TRUE(envelope.is<TradeMessage>());
+  EXPECT_FALSE(envelope.is<MarketDataL2Message>());
+  EXPECT_EQ(envelope.as<TradeMessage>().price, price_from_raw(1500000));
+  EXPECT_EQ(envelope.visit(NamingVisitor{}), "trade 300");
+
+  envelope.store(MarketDataL2Message{});
+  EXPECT_EQ(envelope.visit(NamingVisitor{}), "l2");
+  envelope.store(BookDeltaMessage{});
+  EXPECT_EQ(envelope.visit(NamingVisitor{}), "delta");
+  envelope.store(HeartbeatMessage{});
+  EXPECT_EQ(envelope.visit(NamingVisitor{}), "heartbeat");
+
+  // Generic handlers work too; a default envelope holds nothing
+  const auto size_of = [](const auto &message) { return sizeof(message); };
+  EXPECT_EQ(envelope.visit(size_of), sizeof(HeartbeatMessage));
+  EXPECT_EQ(MarketDataEnvelope{}.visit(size_of), 0u);
+  EXPECT_EQ(MarketDataEnvelope{}.visit(NamingVisitor{}), "");
+}
+
+TEST(MessageEnvelopeTest, AssignValidatesWireMessages) {
+  BookDeltaMessage delta{};
+  delta.header.type = static_cast<uint16_t>(MessageType::BOOK_DELTA);
+  delta.header.length = sizeof(BookDeltaMessage);
+  delta.level_index = 2;
+
+  MarketDataEnvelope envelope;
+  ASSERT_TRUE(envelope.assign(&delta, sizeof(delta)));
+  EXPECT_EQ(envelope.as<BookDeltaMessage>().level_index, 2u);
+
+  // Wrong length for the type, truncated, and unknown types are rejected
+  EXPECT_FALSE(envelope.assign(&delta, sizeof(delta) - 8));
+  EXPECT_FALSE(envelope.assign(&delta, 4));
+  delta.header.type = 0;
+  EXPECT_FALSE(envelope.assign(&delta, sizeof(delta)));
+  delta.header.type = 99;
+  EXPECT_FALSE(envelope.assign(&delta, sizeof(delta)));
+  EXPECT_TRUE(envelope.is<BookDeltaMessage>()); // unchanged by failures
+
+  // An envelope over fewer types rejects the others
+  MessageEnvelope<MarketDataL2Message, HeartbeatMessage> narrow;
+  delta.header.type = static_cast<uint16_t>(MessageType::BOOK_DELTA);
+  EXPECT_FALSE(narrow.assign(&delta, sizeof(delta)));
+}
@@ -0,0 +1,137 @@
+#include "types/notional.hpp"
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace mini_mart::types;
+
+// ============================================================================
+// SCALED DIVISION
+// ============================================================================
+
+static_assert(divide_pow10<4>(static_cast<uint128_t>(123456789)) == 12345);
+static_assert(divide_pow10<0>(static_cast<uint128_t>(7)) == 7);
+
+TEST(NotionalTest, DividePow10MatchesGenericDivision) {
+    std::mt19937_64 rng(42);
+    for (int i = 0; i < 10000; ++i) {
+        const uint128_t value = (static_cast<uint128_t>(rng()) << 64) | rng();
+        ASSERT_EQ(divide_pow10<1>(value), value / 10u);
+        ASSERT_EQ(divide_pow10<4>(value), value / 10000u);
+        ASSERT_EQ(divide_pow10<9>(value), value / 1000000000u);
+        ASSERT_EQ(divide_pow10<12>(value), value / 1000000000000u);
+        ASSERT_EQ(divide_pow10<18>(value), value / 1000000000000000000u);
+    }
+    const uint128_t max = ~static_cast<uint128_t>(0);
+    EXPECT_EQ(divide_pow10<4>(max), max / 10000u);
+}
+
+// ============================================================================
+// NOTIONAL
+// ============================================================================
+
+TEST(NotionalTest, DoesNotWrapWherePriceTimesQuantityDoes) {
+    // $50,000.00 x 10^12 units: 5e20 raw, past 2^64
+    const Price price = price_from_dollars(50000.0);
+    const Quantity quantity = 1000000000000u;
+    const Notional notional = Notional::of(price, quantity);
+
+    // Price * uint64_t keeps only the low 64 bits
+    EXPECT_TRUE((notional.raw() >> 64) != 0);
+    EXPECT_EQ((price * quantity).raw(), static_cast<uint64_t>(notional.raw()));
+    EXPECT_EQ(notional.whole_dollars(), static_cast<uint128_t>(50000) * quantity);
+    EXPECT_EQ(notional.per_unit(quantity), price);
+}
+
+TEST(NotionalTest, ArithmeticAndConversion) {
+    Notional total;
+    total += Notional::of(1755000_cents, 100); // $175.50 x 100
+    total += Notional::of(1754900_cents, 300); // $175.49 x 300
+    EXPECT_EQ(total.raw(), 701970000u);
+    EXPECT_EQ(total.whole_dollars(), 70197u);
+    EXPECT_DOUBLE_EQ(total.to_double(), 70197.0);
+    EXPECT_EQ(total.to_fixed<FixedPoint<2>>().raw(), 7019700u);
+    EXPECT_EQ(total.to_fixed<CryptoPrice>().raw(), 7019700000000u);
+    EXPECT_EQ(total.per_unit(400), Price{1754925ul});
+
+    EXPECT_LT(total - Notional::of(1ul, 1), total);
+    EXPECT_TRUE(Notional{}.is_zero());
+}
+
+// ============================================================================
+// VWAP / TWAP
+// ============================================================================
+
+TEST(NotionalTest, VwapBatchMatchesPerLevelAndIsExact) {
+    std::mt19937_64 rng(7);
+    std::vector<PriceLevel> levels(1000);
+    for (auto &level : levels) {
+        level.price = Price{1000000 + rng() % 10000};
+        level.quantity = 1 + rng() % 5000000;
+    }
+
+    VwapAccumulator one_by_one;
+    for (const auto &level : levels) {
+        one_by_one.add(level.price, level.quantity);
+    }
+    VwapAccumulator batched;
+    batched.add(levels.data(), 600);
+    VwapAccumulator rest;
+    rest.add(levels.data() + 600, levels.size() - 600);
+    batched.merge(rest);
+
+    uint128_t expected_notional = 0;
+    uint64_t expected_volume = 0;
+    for (const auto &level : levels) {
+        expected_notional += static_cast<uint128_t>(level.price.raw()) * level.quantity;
+        expected_volume += level.quantity;
+    }
+    EXPECT_EQ(batched.notional().raw(), expected_notional);
+    EXPECT_EQ(batched.volume(), expected_volume);
+    EXPECT_EQ(batched.vwap(), one_by_one.vwap());
+    EXPECT_EQ(batched.vwap().raw(), static_cast<uint64_t>(expected_notional / expected_volume));
+
+    batched.reset();
+    EXPECT_EQ(batched.vwap(), Price{});
+    EXPECT_EQ(batched.volume(), 0u);
+}
+
+TEST(NotionalTest, VwapOverADayOfHeavyVolume) {
+    // 10^7 prints of 10^6 shares at $250,000: notional ~2.5e22 raw
+    VwapAccumulator vwap;
+    const PriceLevel print{price_from_dollars(250000.0), 1000000};
+    for (int i = 0; i < 10000000; ++i) {
+        vwap.add(&print, 1);
+    }
+    EXPECT_EQ(vwap.vwap(), print.price);
+    EXPECT_EQ(vwap.notional().whole_dollars(), static_cast<uint128_t>(250000) * 1000000 * 10000000);
+}
+
+TEST(NotionalTest, TwapWeightsEachPriceByHowLongItStood) {
+    TwapAccumulator twap;
+    EXPECT_EQ(twap.twap(), Price{});
+    twap.sample(1000000_cents, 0);          // $100 for 3s
+    twap.sample(1100000_cents, 3000000000); // $110 for 1s
+    EXPECT_EQ(twap.twap(), 1000000_cents);
+    twap.close(4000000000);
+    EXPECT_EQ(twap.twap(), 1025000_cents);
+    EXPECT_EQ(twap.duration_ns(), 4000000000u);
+
+    // Same series through the batch path, split across two calls
+    const PriceLevel levels[] = {{1000000_cents, 0}, {1100000_cents, 0}, {1100000_cents, 0}};
+    const uint64_t timestamps[] = {0, 3000000000, 4000000000};
+    TwapAccumulator batched;
+    batched.sample(levels, timestamps, 2);
+    batched.sample(levels + 2, timestamps + 2, 1);
+    EXPECT_EQ(batched.twap(), twap.twap());
+    EXPECT_EQ(batched.duration_ns(), twap.duration_ns());
+
+    batched.reset();
+    EXPECT_EQ(batched.duration_ns(), 0u);
+
+    // Closing an empty window starts no zero-price interval
+    batched.close(1000000000);
+    batched.sample(1000000_cents, 2000000000);
+    batched.close(3000000000);
+    EXPECT_EQ(batched.twap(), 1000000_cents);
+    EXPECT_EQ(batched.duration_ns(), 1000000000u);
+}
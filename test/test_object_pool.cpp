@@ -0,0 +1,216 @@
+#include "common/arena.hpp"
+#include "common/object_pool.hpp"
+#include <gtest/gtest.h>
+#include <list>
+#include <map>
+#include <thread>
+#include <vector>
+
+using namespace mini_mart::common;
+
+namespace {
+
+struct Order {
+  uint64_t id;
+  uint64_t price;
+  uint64_t quantity;
+  Order *next;
+
+  Order(uint64_t order_id, uint64_t order_price, uint64_t order_quantity)
+      : id(order_id), price(order_price), quantity(order_quantity),
+        next(nullptr) {}
+};
+
+} // namespace
+
+TEST(ObjectPoolTest, CreateDestroyAndExhaustion) {
+  ObjectPool<Order> pool(4);
+  EXPECT_EQ(pool.capacity(), 4u);
+  EXPECT_EQ(pool.available(), 4u);
+
+  std::vector<Order *> orders;
+  for (uint64_t i = 0; i < 4; ++i) {
+    Order *order = pool.create(i, 100 + i, 10u);
+    ASSERT_NE(order, nullptr);
+    EXPECT_TRUE(pool.owns(order));
+    EXPECT_EQ(order->id, i);
+    orders.push_back(order);
+  }
+  EXPECT_EQ(pool.available(), 0u);
+  EXPECT_EQ(pool.create(99u, 0u, 0u), nullptr);
+
+  pool.destroy(orders.back());
+  orders.pop_back();
+  EXPECT_EQ(pool.available(), 1u);
+
+  // LIFO free list: the block just freed is handed out again
+  Order *reused = pool.create(7u, 7u, 7u);
+  ASSERT_NE(reused, nullptr);
+  orders.push_back(reused);
+
+  for (Order *order : orders) {
+    pool.destroy(order);
+  }
+  EXPECT_EQ(pool.available(), 4u);
+}
+
+TEST(ObjectPoolTest, BlocksAreAlignedAndDistinct) {
+  struct alignas(64) Wide {
+    char data[80];
+  };
+  ObjectPool<Wide> pool(8);
+  std::vector<Wide *> blocks;
+  for (int i = 0; i < 8; ++i) {
+    Wide *w = pool.create();
+    ASSERT_NE(w, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(w) % 64, 0u);
+    for (Wide *other : blocks) {
+      EXPECT_GE(static_cast<size_t>(std::abs(reinterpret_cast<char *>(w) -
+                                             reinterpret_cast<char *>(other))),
+                sizeof(Wide));
+    }
+    blocks.push_back(w);
+  }
+  for (Wide *w : blocks) {
+    pool.destroy(w);
+  }
+}
+
+#ifndef NDEBUG
+TEST(ObjectPoolTest, DebugPoisonsFreedMemoryAndCountsUsage) {
+  FixedBlockPool pool(32, 2);
+  void *a = pool.allocate();
+  void *b = pool.allocate();
+  EXPECT_EQ(pool.allocate(), nullptr);
+  std::memset(b, 0x11, 32);
+  pool.deallocate(b);
+
+  const auto *bytes = static_cast<const unsigned char *>(b);
+  // First word holds the free-list link; the rest must be poisoned
+  for (size_t i = sizeof(void *); i < 32; ++i) {
+    EXPECT_EQ(bytes[i], FREED_MEMORY_PATTERN);
+  }
+
+  const auto &stats = pool.get_statistics();
+  EXPECT_EQ(stats.allocations, 2u);
+  EXPECT_EQ(stats.deallocations, 1u);
+  EXPECT_EQ(stats.failed_allocations, 1u);
+  EXPECT_EQ(stats.in_use, 1u);
+  EXPECT_EQ(stats.high_water, 2u);
+  pool.deallocate(a);
+}
+#endif
+
+TEST(ObjectPoolTest, ConcurrentPoolWithLocalCaches) {
+  constexpr uint32_t capacity = 1024;
+  constexpr int iterations = 20000;
+  ConcurrentObjectPool<Order> pool(capacity);
+  std::atomic<int> failures{0};
+
+  auto worker = [&](uint64_t base) {
+    ConcurrentObjectPool<Order>::LocalCache cache(pool);
+    std::vector<Order *> live;
+    for (int i = 0; i < iterations; ++i) {
+      if (live.size() < 100) {
+        Order *order = cache.create(base + static_cast<uint64_t>(i), 1u, 1u);
+        if (order == nullptr) {
+          failures.fetch_add(1);
+          continue;
+        }
+        live.push_back(order);
+      } else {
+        for (Order *order : live) {
+          if (order->price != 1u) {
+            failures.fetch_add(1);
+          }
+          cache.destroy(order);
+        }
+        live.clear();
+      }
+    }
+    for (Order *order : live) {
+      cache.destroy(order);
+    }
+  };
+
+  std::thread t1(worker, 0);
+  std::thread t2(worker, 1000000);
+  t1.join();
+  t2.join();
+  EXPECT_EQ(failures.load(), 0);
+
+  // Every slot must be back on the global list
+  std::vector<Order *> all;
+  for (uint32_t i = 0; i < capacity; ++i) {
+    Order *order = pool.create(0u, 0u, 0u);
+    ASSERT_NE(order, nullptr);
+    all.push_back(order);
+  }
+  EXPECT_EQ(pool.create(0u, 0u, 0u), nullptr);
+  for (Order *order : all) {
+    pool.destroy(order);
+  }
+
+#ifndef NDEBUG
+  // Counted across both threads' caches and the global list
+  const AllocatorStatistics stats = pool.get_statistics();
+  EXPECT_EQ(stats.failed_allocations, 1u);
+  EXPECT_EQ(stats.in_use, 0u);
+  EXPECT_EQ(stats.allocations, stats.deallocations);
+  EXPECT_GE(stats.allocations, uint64_t{capacity} + 2 * 100);
+  EXPECT_EQ(stats.high_water, capacity);
+#endif
+}
+
+TEST(MonotonicArenaTest, BumpAllocationAndReset) {
+  MonotonicArena arena(256);
+  void *a = arena.allocate(10, 1);
+  void *b = arena.allocate(8, 8);
+  ASSERT_NE(a, nullptr);
+  ASSERT_NE(b, nullptr);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % 8, 0u);
+  EXPECT_EQ(arena.used(), 24u);
+
+  EXPECT_EQ(arena.allocate(512), nullptr);
+
+  arena.reset();
+  EXPECT_EQ(arena.used(), 0u);
+  EXPECT_EQ(arena.allocate(10, 1), a);
+}
+
+TEST(MonotonicArenaTest, ArenaAllocatorBacksVector) {
+  MonotonicArena arena(64 * 1024);
+  {
+    std::vector<uint64_t, ArenaAllocator<uint64_t>> scratch{
+        ArenaAllocator<uint64_t>(arena)};
+    for (uint64_t i = 0; i < 1000; ++i) {
+      scratch.push_back(i);
+    }
+    EXPECT_EQ(scratch[999], 999u);
+  }
+  EXPECT_GT(arena.used(), 1000 * sizeof(uint64_t));
+  arena.reset();
+  EXPECT_EQ(arena.remaining(), arena.capacity());
+}
+
+TEST(PoolAllocatorTest, NodeContainersDrawFromPool) {
+  FixedBlockPool pool(64, 256);
+  {
+    std::map<uint64_t, uint64_t, std::less<>,
+             PoolAllocator<std::pair<const uint64_t, uint64_t>>>
+        book{PoolAllocator<std::pair<const uint64_t, uint64_t>>(pool)};
+    for (uint64_t i = 0; i < 100; ++i) {
+      book[i] = i * 10;
+    }
+    EXPECT_EQ(pool.available(), 156u);
+    book.erase(50);
+    EXPECT_EQ(pool.available(), 157u);
+    EXPECT_EQ(book.at(99), 990u);
+  }
+  EXPECT_EQ(pool.available(), 256u);
+
+  std::list<int, PoolAllocator<int>> levels{PoolAllocator<int>(pool)};
+  levels.push_back(1);
+  levels.push_back(2);
+  EXPECT_EQ(pool.available(), 254u);
+}
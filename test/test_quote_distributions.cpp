@@ -0,0 +1,191 @@
+#include "l2_test_messages.hpp"
+#include "market_data/feed_policies.hpp"
+#include "market_data/quote_distributions.hpp"
+#include "market_data/security_store.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace mini_mart::common;
+using namespace mini_mart::market_data;
+using namespace mini_mart::types;
+using namespace mini_mart::test;
+
+TEST(LogLinearHistogramTest, MergedPercentilesStayWithinRelativeError) {
+  using Sketch = LogLinearHistogram<3, 36>;
+  std::mt19937_64 rng(17);
+  std::lognormal_distribution<double> spread(6.0, 1.5);
+  std::vector<uint64_t> values;
+  Sketch shards[4];
+  Sketch whole;
+  for (int i = 0; i < 40000; ++i) {
+    const auto value = static_cast<uint64_t>(spread(rng)) + 1;
+    values.push_back(value);
+    shards[i % 4].record(value);
+    whole.record(value);
+  }
+  Sketch merged;
+  for (const Sketch &shard : shards) {
+    merged.merge(shard);
+  }
+  EXPECT_EQ(merged.count(), whole.count());
+  EXPECT_EQ(merged.max(), whole.max());
+
+  std::sort(values.begin(), values.end());
+  for (const double q : {0.01, 0.25, 0.5, 0.9, 0.99, 0.999}) {
+    EXPECT_EQ(merged.percentile(q), whole.percentile(q));
+    // Same rank convention: the ceil(q x n)-th smallest sample
+    const auto rank = static_cast<size_t>(std::ceil(q * static_cast<double>(values.size())));
+    const auto exact = static_cast<double>(values[rank - 1]);
+    const auto reported = static_cast<double>(merged.percentile(q));
+    EXPECT_GE(reported, exact * 0.999);
+    EXPECT_LE(reported, exact * 1.125) << "q=" << q;
+  }
+  EXPECT_LT(sizeof(Sketch), 1200u);
+}
+
+TEST(QuoteDistributionTrackerTest, RecordsSpreadSizeAndGapPerClosedInterval) {
+  QuoteDistributionTracker<> tracker(1000);
+  const size_t aapl = tracker.add_security(make_security_id("AAPL"));
+  const size_t msft = tracker.add_security(make_security_id("MSFT"));
+  EXPECT_EQ(tracker.add_security(make_security_id("AAPL")), QuoteDistributionTracker<>::NOT_FOUND);
+
+  EXPECT_TRUE(tracker.on_message(top_of_book("AAPL", 1500000, 1500100, 100, 300, 500)));
+  EXPECT_TRUE(tracker.on_message(top_of_book("AAPL", 1500000, 1500300, 400, 200, 500)));
+  EXPECT_FALSE(tracker.on_message(top_of_book("NVDA", 1, 2, 500, 1, 1)));
+  EXPECT_EQ(tracker.current_interval(), 0u);
+
+  QuoteDistributions out;
+  EXPECT_FALSE(tracker.merge_closed(aapl, 0, out)); // still open
+
+  EXPECT_TRUE(tracker.on_message(top_of_book("AAPL", 1500000, 1500100, 1200, 100, 100)));
+  EXPECT_EQ(tracker.current_interval(), 1u);
+  ASSERT_TRUE(tracker.merge_closed(aapl, 0, out));
+  EXPECT_EQ(out[QuoteMetric::SPREAD].count(), 2u);
+  EXPECT_EQ(out[QuoteMetric::SPREAD].max(), 300u);
+  EXPECT_EQ(out[QuoteMetric::SPREAD].percentile(0.5), 103u); // 100's bucket is [96, 103]
+  EXPECT_EQ(out[QuoteMetric::TOP_SIZE].count(), 4u);
+  EXPECT_EQ(out[QuoteMetric::UPDATE_GAP].count(), 1u);
+  EXPECT_EQ(out[QuoteMetric::UPDATE_GAP].max(), 300u);
+
+  // MSFT had no updates: nothing to add, but not an error
+  QuoteDistributions idle;
+  EXPECT_TRUE(tracker.merge_closed(msft, 0, idle));
+  EXPECT_EQ(idle[QuoteMetric::SPREAD].count(), 0u);
+
+  // Interval 0's generation is reused by AAPL's first update in interval 2
+  EXPECT_TRUE(tracker.on_message(top_of_book("AAPL", 1500000, 1500100, 2100, 100, 100)));
+  QuoteDistributions stale;
+  EXPECT_FALSE(tracker.merge_closed(aapl, 0, stale));
+  ASSERT_TRUE(tracker.merge_closed(aapl, 1, stale));
+  EXPECT_EQ(stale[QuoteMetric::UPDATE_GAP].max(), 800u); // gaps span intervals
+  EXPECT_EQ(tracker.updates(), 4u);
+}
+
+TEST(QuoteDistributionTrackerTest, StatsThreadMergesShardsWhileConsumersRecord) {
+  // Two shards, each recording exactly 50 updates per security per interval
+  constexpr uint64_t INTERVAL = 1000;
+  constexpr uint64_t INTERVALS = 400;
+  QuoteDistributionTracker<> shards[2]{QuoteDistributionTracker<>(INTERVAL), QuoteDistributionTracker<>(INTERVAL)};
+  const char *symbols[2][2] = {{"AAPL", "MSFT"}, {"NVDA", "SPY"}};
+  for (size_t s = 0; s < 2; ++s) {
+    for (const char *symbol : symbols[s]) {
+      shards[s].add_security(make_security_id(symbol));
+    }
+  }
+
+  std::atomic<bool> done{false};
+  std::atomic<uint64_t> torn{0};
+  std::thread stats([&] {
+    while (!done.load(std::memory_order_acquire)) {
+      const uint64_t current = shards[1].current_interval();
+      if (current == 0 || shards[0].current_interval() < current) {
+        continue;
+      }
+      QuoteDistributions total;
+      bool retained = true;
+      for (auto &shard : shards) {
+        for (size_t i = 0; i < shard.security_count(); ++i) {
+          retained = shard.merge_closed(i, current - 1, total) && retained;
+        }
+      }
+      if (retained) {
+        torn.fetch_add(total[QuoteMetric::SPREAD].count() == 200 ? 0 : 1);
+      }
+    }
+  });
+
+  std::thread consumers[2];
+  for (size_t s = 0; s < 2; ++s) {
+    consumers[s] = std::thread([&, s] {
+      for (uint64_t t = 0; t < INTERVALS * INTERVAL; t += 10) {
+        shards[s].on_message(top_of_book(symbols[s][(t / 10) % 2], 1000000, 1000100 + t % 70, t, 100, 200));
+      }
+      shards[s].on_message(top_of_book(symbols[s][0], 1000000, 1000100, INTERVALS * INTERVAL, 100, 100));
+    });
+  }
+  for (auto &consumer : consumers) {
+    consumer.join();
+  }
+  done.store(true, std::memory_order_release);
+  stats.join();
+
+  EXPECT_EQ(torn.load(), 0u);
+  QuoteDistributions last;
+  for (auto &shard : shards) {
+    for (size_t i = 0; i < shard.security_count(); ++i) {
+      ASSERT_TRUE(shard.merge_closed(i, INTERVALS - 1, last));
+    }
+  }
+  EXPECT_EQ(last[QuoteMetric::SPREAD].count(), 200u);
+  EXPECT_EQ(last[QuoteMetric::UPDATE_GAP].percentile(0.5), 20u);
+}
+
+TEST(QuoteDistributionTrackerTest, ObservesTheFeedThroughFanoutSink) {
+  using Tracker = QuoteDistributionTracker<>;
+  auto tracker = std::make_shared<Tracker>(1000000);
+  tracker->add_security(make_security_id("SPY"));
+  auto store = std::make_shared<SecurityStore>();
+  FanoutSink<StoreSink<SecurityStore>, SharedObserver<Tracker>> sink{StoreSink<SecurityStore>(store),
+                                                                     SharedObserver<Tracker>(tracker)};
+  sink.add_security(make_security_id("SPY"));
+  EXPECT_TRUE(sink.on_message(top_of_book("SPY", 5000000, 5000100, 5, 10, 10)));
+  EXPECT_EQ(tracker->updates(), 1u);
+}
+
+TEST(QuoteDistributionTrackerTest, RecordsTopOfBookDeltasThroughTheStore) {
+  using Tracker = QuoteDistributionTracker<>;
+  auto tracker = std::make_shared<Tracker>(1000);
+  const size_t spy = tracker->add_security(make_security_id("SPY"));
+  auto store = std::make_shared<SecurityStore>();
+  using Observer = DeltaAsSnapshot<SharedObserver<Tracker>, SecurityStore>;
+  FanoutSink<StoreSink<SecurityStore>, Observer> sink{StoreSink<SecurityStore>(store),
+                                                      Observer(SharedObserver<Tracker>(tracker), store)};
+  sink.add_security(make_security_id("SPY"));
+  EXPECT_TRUE(sink.on_message(top_of_book("SPY", 5000000, 5000100, 5, 10, 10)));
+
+  BookDeltaMessage delta{};
+  delta.security_id = make_security_id("SPY");
+  delta.timestamp_ns = 25;
+  delta.side = Side::ASK;
+  delta.action = DeltaAction::SET;
+  delta.level = {price_from_dollars(500.03), 30};
+  EXPECT_TRUE(sink.on_message(delta));
+  delta.level_index = 1; // behind the touch: not an update
+  delta.timestamp_ns = 30;
+  EXPECT_TRUE(sink.on_message(delta));
+  EXPECT_EQ(tracker->updates(), 2u);
+
+  tracker->on_message(top_of_book("SPY", 5000000, 5000100, 1000));
+  QuoteDistributions closed;
+  ASSERT_TRUE(tracker->merge_closed(spy, 0, closed));
+  EXPECT_EQ(closed[QuoteMetric::SPREAD].count(), 2u);
+  EXPECT_EQ(closed[QuoteMetric::SPREAD].max(), 300u);
+  EXPECT_EQ(closed[QuoteMetric::UPDATE_GAP].count(), 1u);
+  EXPECT_EQ(closed[QuoteMetric::UPDATE_GAP].percentile(0.5), 20u);
+}
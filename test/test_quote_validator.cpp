@@ -0,0 +1,218 @@
+#include "market_data/feed_policies.hpp"
+#include "market_data/quote_validator.hpp"
+#include "market_data/security_store.hpp"
+#include <gtest/gtest.h>
+#include <memory>
+
+using namespace mini_mart::market_data;
+using namespace mini_mart::types;
+
+namespace {
+
+// Five levels a cent apart on each side, best bid bid_raw
+MarketDataL2Message book(const char *symbol, uint64_t bid_raw, uint64_t spread_raw = 100) {
+  MarketDataL2Message message{};
+  message.security_id = make_security_id(symbol);
+  message.timestamp_ns = 1;
+  for (uint64_t i = 0; i < 5; ++i) {
+    message.bids[i] = {Price{bid_raw - i * 100}, 100 + i};
+    message.asks[i] = {Price{bid_raw + spread_raw + i * 100}, 200 + i};
+  }
+  message.num_bid_levels = 5;
+  message.num_ask_levels = 5;
+  return message;
+}
+
+struct CountingObserver {
+  std::shared_ptr<int> seen = std::make_shared<int>(0);
+  bool on_message(const MarketDataL2Message &) {
+    ++*seen;
+    return true;
+  }
+};
+
+} // namespace
+
+TEST(QuoteValidatorTest, FlagsStructuralDefects) {
+  EXPECT_EQ(check_book_levels(book("AAPL", 1500000)), 0);
+  EXPECT_EQ(check_book_levels(book("AAPL", 1500000, 0)), 0); // locked
+
+  MarketDataL2Message one_sided = book("AAPL", 1500000);
+  one_sided.num_ask_levels = 0;
+  one_sided.bids[3] = {price_from_raw(0u), 0}; // past num_bid_levels: ignored
+  one_sided.num_bid_levels = 3;
+  EXPECT_EQ(check_book_levels(one_sided), 0);
+
+  MarketDataL2Message crossed = book("AAPL", 1500000);
+  crossed.asks[0].price = price_from_raw(1499900u);
+  EXPECT_EQ(check_book_levels(crossed), defect_bit(QuoteDefect::CROSSED));
+
+  MarketDataL2Message unsorted = book("AAPL", 1500000);
+  unsorted.bids[3].price = unsorted.bids[2].price;
+  unsorted.asks[4].price = price_from_raw(1500000u);
+  EXPECT_EQ(check_book_levels(unsorted),
+            defect_bit(QuoteDefect::UNSORTED_BIDS) | defect_bit(QuoteDefect::UNSORTED_ASKS));
+
+  MarketDataL2Message zeros = book("AAPL", 1500000);
+  zeros.bids[4].price = price_from_raw(0u);
+  zeros.asks[2].quantity = 0;
+  EXPECT_EQ(check_book_levels(zeros), defect_bit(QuoteDefect::ZERO_PRICE) | defect_bit(QuoteDefect::ZERO_QUANTITY));
+
+  MarketDataL2Message too_deep = book("AAPL", 1500000);
+  too_deep.num_bid_levels = 6;
+  EXPECT_EQ(check_book_levels(too_deep), defect_bit(QuoteDefect::LEVEL_COUNT));
+}
+
+TEST(QuoteValidatorTest, JumpFilterWarmsUpThenTracksTheAverageMove) {
+  QuoteValidator<> validator;
+  uint64_t bid = 1000000; // $100
+  EXPECT_EQ(validator.validate(0, book("AAPL", bid)), 0);
+  EXPECT_EQ(validator.validate(0, book("AAPL", bid * 10)), defect_bit(QuoteDefect::PRICE_JUMP));
+  EXPECT_EQ(validator.validate(0, book("AAPL", bid / 10)), defect_bit(QuoteDefect::PRICE_JUMP));
+  // Warming up, only max_jump applies
+  EXPECT_EQ(validator.validate(0, book("AAPL", bid * 13 / 10)), 0);
+  bid = bid * 13 / 10;
+  for (int i = 0; i < 40; ++i) {
+    bid = i % 2 == 0 ? bid + 100 : bid - 100;
+    EXPECT_EQ(validator.validate(0, book("AAPL", bid)), 0);
+  }
+  // Warm: a 6% move is past the 5% floor, 3% is not
+  EXPECT_EQ(validator.validate(0, book("AAPL", bid * 106 / 100)), defect_bit(QuoteDefect::PRICE_JUMP));
+  EXPECT_EQ(validator.validate(0, book("AAPL", bid * 103 / 100)), 0);
+
+  EXPECT_EQ(validator.validated(), 46u);
+  EXPECT_EQ(validator.rejected(), 3u);
+  EXPECT_EQ(validator.rejected(QuoteDefect::PRICE_JUMP), 3u);
+  EXPECT_EQ(validator.rejected(QuoteDefect::CROSSED), 0u);
+
+  // Slots are independent; reset forgets
+  EXPECT_EQ(validator.validate(1, book("MSFT", 40000000)), 0);
+  validator.reset(0);
+  EXPECT_EQ(validator.validate(0, book("NVDA", 9000000)), 0);
+}
+
+TEST(QuoteValidatorTest, ReanchorsAfterPersistentJumps) {
+  QuoteValidatorConfig config;
+  config.reanchor_after = 4;
+  QuoteValidator<> validator(config);
+  EXPECT_EQ(validator.validate(0, book("AAPL", 1000000)), 0);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_NE(validator.validate(0, book("AAPL", 2000000)), 0);
+  }
+  EXPECT_EQ(validator.reanchored(), 0u);
+  EXPECT_EQ(validator.validate(0, book("AAPL", 2000000)), 0); // new level
+  EXPECT_EQ(validator.reanchored(), 1u);
+  EXPECT_EQ(validator.validate(0, book("AAPL", 2000100)), 0);
+  EXPECT_NE(validator.validate(0, book("AAPL", 1000000)), 0);
+
+  // Structurally bad quotes don't count towards a reanchor
+  MarketDataL2Message crossed = book("AAPL", 9000000);
+  crossed.asks[0].price = price_from_raw(1u);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(validator.validate(0, crossed), defect_bit(QuoteDefect::CROSSED));
+  }
+  EXPECT_EQ(validator.reanchored(), 1u);
+}
+
+TEST(QuoteValidatorTest, QuarantinesIntoABoundedRing) {
+  QuoteValidator<> validator;
+  MarketDataL2Message zero = book("AAPL", 1500000);
+  zero.bids[0].quantity = 0;
+  const size_t total = QuoteValidator<>::QUARANTINE_RING_SIZE + 10;
+  for (size_t i = 0; i < total; ++i) {
+    zero.timestamp_ns = i;
+    validator.validate(0, zero);
+  }
+  EXPECT_EQ(validator.rejected(), total);
+  EXPECT_EQ(validator.quarantine_dropped(), 10u);
+
+  QuarantinedQuote quote;
+  size_t popped = 0;
+  while (validator.pop_quarantined(quote)) {
+    ASSERT_TRUE(quote.message.is<MarketDataL2Message>());
+    EXPECT_EQ(quote.message.as<MarketDataL2Message>().timestamp_ns, popped);
+    EXPECT_EQ(quote.defects, defect_bit(QuoteDefect::ZERO_QUANTITY));
+    ++popped;
+  }
+  EXPECT_EQ(popped, QuoteValidator<>::QUARANTINE_RING_SIZE);
+}
+
+TEST(QuoteValidatorTest, SinkKeepsBadQuotesFromStoreAndObservers) {
+  using Sink = ValidatingStoreSink<SecurityStore>;
+  auto store = std::make_shared<SecurityStore>();
+  auto validator = std::make_shared<QuoteValidator<>>();
+  CountingObserver observer;
+  FanoutSink<Sink, CountingObserver> sink{Sink(store, validator), observer};
+  ASSERT_TRUE(sink.add_security(make_security_id("AAPL")));
+
+  EXPECT_TRUE(sink.on_message(book("AAPL", 1500000)));
+  MarketDataL2Message crossed = book("AAPL", 1600000);
+  crossed.asks[0].price = price_from_raw(1500000u);
+  EXPECT_FALSE(sink.on_message(crossed));
+  EXPECT_FALSE(sink.on_message(book("AAPL", 15000000))); // 10x
+  EXPECT_FALSE(sink.on_message(book("MSFT", 1500000)));  // unknown
+  EXPECT_EQ(*observer.seen, 1);
+  EXPECT_EQ(validator->validated(), 3u);
+
+  SecurityStore::SecuritySnapshot snapshot;
+  ASSERT_TRUE(store->get_security_snapshot(make_security_id("AAPL"), snapshot));
+  EXPECT_EQ(snapshot.best_bid, price_from_raw(1500000u));
+  EXPECT_EQ(snapshot.update_count, 1u);
+
+  QuarantinedQuote quote;
+  ASSERT_TRUE(validator->pop_quarantined(quote));
+  EXPECT_EQ(quote.defects, defect_bit(QuoteDefect::CROSSED));
+  ASSERT_TRUE(validator->pop_quarantined(quote));
+  EXPECT_EQ(quote.defects, defect_bit(QuoteDefect::PRICE_JUMP));
+  EXPECT_EQ(quote.message.as<MarketDataL2Message>().bids[0].price, price_from_raw(15000000u));
+
+  // A new security in the freed slot starts without the old one's history
+  ASSERT_TRUE(sink.remove_security(make_security_id("AAPL")));
+  ASSERT_TRUE(sink.add_security(make_security_id("BRK")));
+  EXPECT_TRUE(sink.on_message(book("BRK", 40000000)));
+  EXPECT_TRUE(sink.on_message(book("BRK", 40000100)));
+}
+
+TEST(QuoteValidatorTest, SinkChecksBookDeltasAgainstTheStoredTouch) {
+  using Sink = ValidatingStoreSink<SecurityStore>;
+  auto store = std::make_shared<SecurityStore>();
+  auto validator = std::make_shared<QuoteValidator<>>();
+  Sink sink(store, validator);
+  ASSERT_TRUE(sink.add_security(make_security_id("AAPL")));
+  ASSERT_TRUE(sink.on_message(book("AAPL", 1500000))); // 150.00 / 150.01
+
+  BookDeltaMessage delta{};
+  delta.security_id = make_security_id("AAPL");
+  delta.side = Side::BID;
+  delta.action = DeltaAction::SET;
+  delta.level = {price_from_raw(1500200u), 100}; // above the best ask
+  EXPECT_FALSE(sink.on_message(delta));
+  delta.level = {price_from_raw(1500100u), 100}; // locked is allowed
+  EXPECT_TRUE(sink.on_message(delta));
+
+  delta.side = Side::ASK;
+  delta.level = {price_from_raw(1500000u), 100}; // below the new best bid
+  EXPECT_FALSE(sink.on_message(delta));
+  delta.level_index = 2;
+  delta.level = {price_from_raw(0u), 0};
+  EXPECT_FALSE(sink.on_message(delta));
+  delta.action = DeltaAction::DELETE; // carries no level
+  EXPECT_TRUE(sink.on_message(delta));
+
+  SecurityStore::SecuritySnapshot snapshot;
+  ASSERT_TRUE(store->get_security_snapshot(make_security_id("AAPL"), snapshot));
+  EXPECT_EQ(snapshot.best_bid, price_from_raw(1500100u));
+  EXPECT_EQ(snapshot.best_ask, price_from_raw(1500100u));
+  EXPECT_EQ(snapshot.num_ask_levels, 4u);
+  EXPECT_EQ(validator->validated(), 6u);
+  EXPECT_EQ(validator->rejected(), 3u);
+  EXPECT_EQ(validator->rejected(QuoteDefect::CROSSED), 2u);
+
+  QuarantinedQuote quote;
+  ASSERT_TRUE(validator->pop_quarantined(quote));
+  ASSERT_TRUE(quote.message.is<BookDeltaMessage>());
+  EXPECT_EQ(quote.message.as<BookDeltaMessage>().level.price, price_from_raw(1500200u));
+  ASSERT_TRUE(validator->pop_quarantined(quote));
+  ASSERT_TRUE(validator->pop_quarantined(quote));
+  EXPECT_EQ(quote.defects, defect_bit(QuoteDefect::ZERO_PRICE) | defect_bit(QuoteDefect::ZERO_QUANTITY));
+}
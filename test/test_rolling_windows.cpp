@@ -0,0 +1,184 @@
+#include "l2_test_messages.hpp"
+#include "common/rolling_window.hpp"
+#include "market_data/feed_policies.hpp"
+#include "market_data/rolling_windows.hpp"
+#include "market_data/security_store.hpp"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace mini_mart::common;
+using namespace mini_mart::market_data;
+using namespace mini_mart::types;
+using namespace mini_mart::test;
+
+namespace {
+
+struct Sample {
+  uint64_t timestamp_ns;
+  int64_t value;
+};
+
+// Samples inside (now - length, now], the way the aggregators define it
+std::vector<int64_t> in_window(const std::vector<Sample> &samples, uint64_t now_ns, uint64_t length_ns) {
+  std::vector<int64_t> values;
+  for (const Sample &sample : samples) {
+    if (sample.timestamp_ns + length_ns > now_ns) {
+      values.push_back(sample.value);
+    }
+  }
+  return values;
+}
+
+} // namespace
+
+TEST(RollingWindowTest, ExtremaAndMomentsMatchBruteForceAcrossWindows) {
+  const std::array<uint64_t, 3> lengths{50, 400, 3000};
+  RollingMin<int64_t, 1024, 3> low(lengths);
+  RollingMax<int64_t, 1024, 3> high(lengths);
+  RollingMoments<1024, 3> moments(lengths);
+
+  std::mt19937_64 rng(5);
+  std::vector<Sample> samples;
+  uint64_t now = 0;
+  for (int i = 0; i < 20000; ++i) {
+    now += rng() % 20; // repeated timestamps included
+    const auto value = static_cast<int64_t>(rng() % 2001) - 1000;
+    samples.push_back({now, value});
+    low.push(now, value);
+    high.push(now, value);
+    moments.push(now, value);
+
+    if (i % 97 != 0) {
+      continue;
+    }
+    for (size_t w = 0; w < lengths.size(); ++w) {
+      const std::vector<int64_t> values = in_window(samples, now, lengths[w]);
+      ASSERT_FALSE(values.empty());
+      EXPECT_EQ(low.value(w), *std::min_element(values.begin(), values.end()));
+      EXPECT_EQ(high.value(w), *std::max_element(values.begin(), values.end()));
+      ASSERT_EQ(moments.count(w), values.size());
+      int64_t sum = 0;
+      double squares = 0;
+      for (const int64_t expected : values) {
+        sum += expected;
+        squares += static_cast<double>(expected * expected);
+      }
+      EXPECT_EQ(moments.sum(w), sum);
+      EXPECT_EQ(static_cast<double>(moments.sum_squares(w)), squares);
+      const double n = static_cast<double>(values.size());
+      const double mean = static_cast<double>(sum) / n;
+      EXPECT_NEAR(moments.variance(w), squares / n - mean * mean, 1e-6);
+    }
+  }
+  EXPECT_EQ(moments.truncated(), 0u);
+  EXPECT_EQ(low.truncated(), 0u);
+}
+
+TEST(RollingWindowTest, ExpireEmptiesIdleWindowsAndOverflowIsCounted) {
+  RollingMax<uint64_t, 8, 2> high({100, 1000});
+  RollingMoments<8, 2> moments({100, 1000});
+  high.push(10, 7);
+  moments.push(10, 7);
+  high.expire(200);
+  moments.expire(200);
+  EXPECT_TRUE(high.empty(0));
+  EXPECT_EQ(high.value(0), 0u);
+  EXPECT_EQ(moments.count(0), 0u);
+  EXPECT_EQ(high.value(1), 7u);
+  EXPECT_EQ(moments.sum(1), 7);
+
+  // Twelve samples inside the long window; only the newest eight fit
+  for (uint64_t t = 300; t < 312; ++t) {
+    moments.push(t, 1);
+  }
+  EXPECT_EQ(moments.count(1), 8u);
+  EXPECT_EQ(moments.sum(1), 8);
+  EXPECT_EQ(moments.truncated(), 5u);
+}
+
+TEST(RollingWindowEngineTest, TracksMidStatisticsPerSecurity) {
+  RollingWindowEngine<2, 256> engine({5000, 60000});
+  const size_t aapl = engine.add_security(make_security_id("AAPL"));
+  const size_t msft = engine.add_security(make_security_id("MSFT"));
+  ASSERT_NE(aapl, decltype(engine)::NOT_FOUND);
+  EXPECT_EQ(engine.add_security(make_security_id("AAPL")), decltype(engine)::NOT_FOUND);
+
+  // AAPL mids 100.00, 101.00, 99.00, 100.00 at t = 0, 2000, 4000, 6000
+  EXPECT_TRUE(engine.on_message(top_of_book("AAPL", 999900, 1000100, 0)));
+  EXPECT_TRUE(engine.on_message(top_of_book("AAPL", 1009900, 1010100, 2000)));
+  EXPECT_TRUE(engine.on_message(top_of_book("MSFT", 3999000, 4001000, 3000)));
+  EXPECT_TRUE(engine.on_message(top_of_book("AAPL", 989900, 990100, 4000)));
+  EXPECT_TRUE(engine.on_message(top_of_book("AAPL", 999900, 1000100, 6000)));
+  EXPECT_FALSE(engine.on_message(top_of_book("NVDA", 999900, 1000100, 6000)));
+
+  // Short window (1000, 6000]: 101, 99, 100
+  const RollingStats recent = engine.stats(aapl, 0);
+  EXPECT_EQ(recent.samples, 3u);
+  EXPECT_EQ(recent.low, price_from_dollars(99.0));
+  EXPECT_EQ(recent.high, price_from_dollars(101.0));
+  EXPECT_DOUBLE_EQ(recent.mean, 100.0);
+  EXPECT_NEAR(recent.stddev, std::sqrt(2.0 / 3.0), 1e-9);
+  // Returns +1%, -1.9802%, +1.0101% (the first one's predecessor is older)
+  EXPECT_NEAR(recent.realized_vol, std::sqrt(0.01 * 0.01 + 0.0198019 * 0.0198019 + 0.0101010 * 0.0101010),
+              1e-6);
+
+  const RollingStats minute = engine.stats(aapl, 1);
+  EXPECT_EQ(minute.samples, 4u);
+  EXPECT_EQ(minute.low, price_from_dollars(99.0));
+  EXPECT_EQ(engine.stats(msft, 1).samples, 1u);
+  EXPECT_EQ(engine.stats(msft, 1).realized_vol, 0.0);
+
+  engine.expire(aapl, 70000);
+  EXPECT_EQ(engine.stats(aapl, 1).samples, 0u);
+  EXPECT_EQ(engine.updates(), 5u);
+  EXPECT_EQ(engine.truncated(), 0u);
+}
+
+inline constexpr auto ROLLING_UNIVERSE = make_symbol_table({"AAPL", "MSFT", "SPY"});
+
+TEST(RollingWindowEngineTest, StaticIndexAndFanoutSink) {
+  using Engine = RollingWindowEngine<1, 64, StaticSecurityIndex<ROLLING_UNIVERSE>>;
+  auto engine = std::make_shared<Engine>(std::array<uint64_t, 1>{1000});
+  EXPECT_EQ(engine->add_security(make_security_id("TSLA")), Engine::NOT_FOUND);
+  const size_t spy = engine->add_security(make_security_id("SPY"));
+  ASSERT_EQ(spy, 0u);
+  EXPECT_EQ(engine->find(make_security_id("SPY")), spy);
+  EXPECT_EQ(engine->find(make_security_id("AAPL")), Engine::NOT_FOUND);
+
+  auto store = std::make_shared<SecurityStore>();
+  static_assert(!FlushingObserver<SharedObserver<Engine>>); // nothing to publish
+  FanoutSink<StoreSink<SecurityStore>, SharedObserver<Engine>> sink{StoreSink<SecurityStore>(store),
+                                                                    SharedObserver<Engine>(engine)};
+  sink.add_security(make_security_id("SPY"));
+  EXPECT_TRUE(sink.on_message(top_of_book("SPY", 5000000, 5000200, 1)));
+  EXPECT_TRUE(sink.on_message(top_of_book("SPY", 5001000, 5001200, 2)));
+  EXPECT_EQ(engine->stats(spy, 0).high.raw(), 5001100u);
+  EXPECT_EQ(engine->stats(spy, 0).low.raw(), 5000100u);
+}
+
+TEST(RollingWindowEngineTest, TopOfBookDeltasMoveTheMid) {
+  using Engine = RollingWindowEngine<1, 64>;
+  auto engine = std::make_shared<Engine>(std::array<uint64_t, 1>{1000});
+  const size_t spy = engine->add_security(make_security_id("SPY"));
+
+  auto store = std::make_shared<SecurityStore>();
+  using Observer = DeltaAsSnapshot<SharedObserver<Engine>, SecurityStore>;
+  FanoutSink<StoreSink<SecurityStore>, Observer> sink{StoreSink<SecurityStore>(store),
+                                                      Observer(SharedObserver<Engine>(engine), store)};
+  sink.add_security(make_security_id("SPY"));
+  EXPECT_TRUE(sink.on_message(top_of_book("SPY", 5000000, 5000200, 1)));
+
+  BookDeltaMessage delta{};
+  delta.security_id = make_security_id("SPY");
+  delta.timestamp_ns = 2;
+  delta.side = Side::ASK;
+  delta.action = DeltaAction::SET;
+  delta.level = {price_from_dollars(500.20), 100};
+  EXPECT_TRUE(sink.on_message(delta));
+  EXPECT_EQ(engine->stats(spy, 0).samples, 2u);
+  EXPECT_EQ(engine->stats(spy, 0).high.raw(), 5001000u);
+  EXPECT_EQ(engine->updates(), 2u);
+}
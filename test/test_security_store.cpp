@@ -454,3 +454,394 @@ TEST_F(SecurityStoreTest, MaxCapacityHandling) {
   EXPECT_TRUE(store_->add_security(overflow_sec));
   EXPECT_EQ(store_->size(), SecurityStore::MAX_SECURITIES);
 }
+
+TEST_F(SecurityStoreTest, ReusedSlotStartsWithEmptyBook) {
+  EXPECT_FALSE(store_->add_security(SecurityId{}));
+
+  ASSERT_TRUE(store_->add_security(aapl_id_));
+  ASSERT_TRUE(store_->update_from_l2(create_test_message(aapl_id_)));
+  ASSERT_TRUE(store_->remove_security(aapl_id_));
+  EXPECT_FALSE(store_->update_from_l2(create_test_message(aapl_id_)));
+
+  // MSFT takes the freed slot and must not inherit AAPL's book
+  ASSERT_TRUE(store_->add_security(msft_id_));
+  SecurityStore::SecuritySnapshot snapshot;
+  ASSERT_TRUE(store_->get_security_snapshot(msft_id_, snapshot));
+  EXPECT_EQ(snapshot.security_id, msft_id_);
+  EXPECT_EQ(snapshot.update_count, 0u);
+  EXPECT_EQ(snapshot.best_bid, Price{0.0});
+
+  std::vector<SecurityId> seen;
+  store_->for_each_snapshot([&](const SecurityStore::SecuritySnapshot &s) {
+    seen.push_back(s.security_id);
+  });
+  ASSERT_EQ(seen.size(), 1u);
+  EXPECT_EQ(seen[0], msft_id_);
+  EXPECT_EQ(store_->get_all_securities(), seen);
+}
+
+TEST_F(SecurityStoreTest, ConsistentSnapshotsFollowCommits) {
+  ASSERT_TRUE(store_->add_security(aapl_id_));
+  ASSERT_TRUE(store_->add_security(msft_id_));
+  EXPECT_EQ(store_->committed_sequence(), 0u);
+
+  // Unbatched updates commit one at a time
+  ASSERT_TRUE(store_->update_from_l2(create_test_message(aapl_id_)));
+  ASSERT_TRUE(store_->update_from_l2(create_test_message(msft_id_)));
+  EXPECT_EQ(store_->committed_sequence(), 2u);
+
+  const SecurityId pair[] = {aapl_id_, msft_id_};
+  SecurityStore::SecuritySnapshot snapshots[2];
+  uint64_t commit = 0;
+  using Result = SecurityStore::ConsistentRead;
+  ASSERT_EQ(store_->get_consistent_snapshots(pair, 2, snapshots, &commit), Result::SUCCESS);
+  EXPECT_EQ(commit, 2u);
+  EXPECT_EQ(snapshots[0].security_id, aapl_id_);
+  EXPECT_EQ(snapshots[0].commit_sequence, 1u);
+  EXPECT_EQ(snapshots[1].security_id, msft_id_);
+  EXPECT_EQ(snapshots[1].commit_sequence, 2u);
+
+  // Securities written by an open batch cannot be read consistently yet
+  store_->begin_batch();
+  ASSERT_TRUE(store_->update_from_l2(create_test_message(aapl_id_, price_from_raw(1010000))));
+  ASSERT_TRUE(store_->update_from_l2(create_test_message(msft_id_, price_from_raw(1010000))));
+  EXPECT_EQ(store_->committed_sequence(), 2u);
+  EXPECT_EQ(store_->get_consistent_snapshots(pair, 2, snapshots, &commit, 4),
+            Result::RETRIES_EXHAUSTED);
+
+  EXPECT_EQ(store_->commit(), 3u);
+  ASSERT_EQ(store_->get_consistent_snapshots(pair, 2, snapshots, &commit), Result::SUCCESS);
+  EXPECT_EQ(commit, 3u);
+  EXPECT_EQ(snapshots[0].best_bid, price_from_raw(1010000));
+  EXPECT_EQ(snapshots[1].best_bid, price_from_raw(1010000));
+
+  // An empty batch publishes nothing
+  store_->begin_batch();
+  EXPECT_EQ(store_->commit(), 3u);
+
+  const SecurityId unknown[] = {aapl_id_, googl_id_};
+  EXPECT_EQ(store_->get_consistent_snapshots(unknown, 2, snapshots),
+            Result::UNKNOWN_SECURITY);
+}
+
+TEST_F(SecurityStoreTest, ConsistentSnapshotsNeverTearAcrossCommits) {
+  ASSERT_TRUE(store_->add_security(aapl_id_));
+  ASSERT_TRUE(store_->add_security(msft_id_));
+  ASSERT_TRUE(store_->add_security(googl_id_));
+
+  // Every commit moves AAPL and MSFT to the same bid; GOOGL updates alone
+  // in between, so a torn read would see the pair disagree
+  std::atomic<bool> running{true};
+  std::thread writer([&] {
+    for (uint64_t i = 1; running.load(std::memory_order_relaxed); ++i) {
+      const Price bid = price_from_raw(1000000 + i);
+      store_->begin_batch();
+      store_->update_from_l2(create_test_message(aapl_id_, bid, bid + 100));
+      store_->update_from_l2(create_test_message(msft_id_, bid, bid + 100));
+      store_->commit();
+      store_->update_from_l2(create_test_message(googl_id_, bid, bid + 100));
+      if (i % 64 == 0) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  const SecurityId pair[] = {aapl_id_, msft_id_};
+  SecurityStore::SecuritySnapshot snapshots[2];
+  int successes = 0;
+  uint64_t last_commit = 0;
+  for (int i = 0; i < 20000; ++i) {
+    uint64_t commit = 0;
+    if (store_->get_consistent_snapshots(pair, 2, snapshots, &commit) !=
+        SecurityStore::ConsistentRead::SUCCESS) {
+      continue;
+    }
+    ++successes;
+    EXPECT_EQ(snapshots[0].best_bid, snapshots[1].best_bid);
+    EXPECT_EQ(snapshots[0].commit_sequence, snapshots[1].commit_sequence);
+    EXPECT_LE(snapshots[0].commit_sequence, commit);
+    EXPECT_GE(commit, last_commit);
+    last_commit = commit;
+  }
+
+  running.store(false, std::memory_order_relaxed);
+  writer.join();
+  EXPECT_GT(successes, 0);
+}
+
+TEST_F(SecurityStoreTest, HistoryKeepsRecentBookVersions) {
+  using HistoryStore = BasicSecurityStore<DynamicSecurityIndex, 4>;
+  auto store = std::make_unique<HistoryStore>();
+  ASSERT_TRUE(store->add_security(aapl_id_));
+
+  HistoryStore::HistoryRange range;
+  EXPECT_FALSE(store->get_history_since(msft_id_, 0, range));
+  ASSERT_TRUE(store->get_history_since(aapl_id_, 0, range));
+  EXPECT_EQ(range.count, 0u);
+  EXPECT_EQ(range.latest_version, 0u);
+
+  for (uint64_t i = 0; i < 3; ++i) {
+    ASSERT_TRUE(store->update_from_l2(create_test_message(aapl_id_, price_from_raw(1000000) + i)));
+  }
+  EXPECT_EQ(store->history_version(aapl_id_), 3u);
+
+  ASSERT_TRUE(store->get_history_since(aapl_id_, 1, range));
+  ASSERT_EQ(range.count, 2u);
+  EXPECT_FALSE(range.missed_versions);
+  EXPECT_EQ(range.latest_version, 3u);
+  EXPECT_EQ(range.versions[0].version, 2u);
+  EXPECT_EQ(range.versions[1].version, 3u);
+  EXPECT_EQ(range.versions[1].bids[0].price, price_from_raw(1000002));
+  // The test message has 3 bid and 3 ask levels; only HISTORY_LEVELS are kept
+  EXPECT_EQ(range.versions[1].num_bid_levels, 3u);
+  EXPECT_EQ(range.versions[1].bids[2].quantity, 250u);
+
+  // Up to date: nothing new
+  ASSERT_TRUE(store->get_history_since(aapl_id_, 3, range));
+  EXPECT_EQ(range.count, 0u);
+
+  // Six more writes wrap the depth-4 ring: versions 6..9 remain
+  for (uint64_t i = 3; i < 9; ++i) {
+    ASSERT_TRUE(store->update_from_l2(create_test_message(aapl_id_, price_from_raw(1000000) + i)));
+  }
+  ASSERT_TRUE(store->get_history_since(aapl_id_, 3, range));
+  EXPECT_TRUE(range.missed_versions);
+  ASSERT_EQ(range.count, 4u);
+  for (size_t i = 0; i < range.count; ++i) {
+    EXPECT_EQ(range.versions[i].version, 6u + i);
+    EXPECT_EQ(range.versions[i].bids[0].price, price_from_raw(1000005 + i));
+  }
+
+  // A reused slot starts a fresh history
+  ASSERT_TRUE(store->remove_security(aapl_id_));
+  ASSERT_TRUE(store->add_security(msft_id_));
+  ASSERT_TRUE(store->get_history_since(msft_id_, 0, range));
+  EXPECT_EQ(range.count, 0u);
+}
+
+TEST_F(SecurityStoreTest, HistoryReadsDuringWritesAreWhole) {
+  using HistoryStore = BasicSecurityStore<DynamicSecurityIndex, 8>;
+  auto store = std::make_unique<HistoryStore>();
+  ASSERT_TRUE(store->add_security(aapl_id_));
+
+  // Every version's bid equals its version number, so a torn copy shows up
+  std::atomic<bool> running{true};
+  std::thread writer([&] {
+    for (uint64_t i = 1; running.load(std::memory_order_relaxed); ++i) {
+      store->update_from_l2(
+          create_test_message(aapl_id_, price_from_raw(i), price_from_raw(i) + 500));
+      if (i % 64 == 0) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  HistoryStore::HistoryRange range;
+  uint64_t since = 0;
+  for (int i = 0; i < 20000; ++i) {
+    ASSERT_TRUE(store->get_history_since(aapl_id_, since, range));
+    for (size_t j = 0; j < range.count; ++j) {
+      const auto &book = range.versions[j];
+      EXPECT_GT(book.version, since);
+      EXPECT_EQ(book.bids[0].price, price_from_raw(book.version));
+      EXPECT_EQ(book.asks[0].price, price_from_raw(book.version) + 500);
+      if (j > 0) {
+        EXPECT_GT(book.version, range.versions[j - 1].version);
+      }
+    }
+    since = range.latest_version;
+  }
+
+  running.store(false, std::memory_order_relaxed);
+  writer.join();
+}
+
+TEST_F(SecurityStoreTest, WaitForUpdateWakesOnWatchedCommits) {
+  using namespace std::chrono_literals;
+  using Result = SecurityStore::WaitResult;
+  ASSERT_TRUE(store_->add_security(aapl_id_));
+  ASSERT_TRUE(store_->add_security(msft_id_));
+  ASSERT_TRUE(store_->add_security(googl_id_));
+
+  const SecurityId unknown[] = {SecuritySeeder::create_security_id("NOPE")};
+  EXPECT_EQ(store_->open_wait_group(unknown, 1), SecurityStore::NO_WAIT_GROUP);
+  const SecurityId watched[] = {aapl_id_, msft_id_};
+  const size_t group = store_->open_wait_group(watched, 2);
+  ASSERT_NE(group, SecurityStore::NO_WAIT_GROUP);
+
+  uint64_t since = store_->committed_sequence();
+  EXPECT_EQ(store_->wait_for_update(group, since, 1ms), Result::TIMED_OUT);
+
+  // Unwatched securities do not wake the group
+  ASSERT_TRUE(store_->update_from_l2(create_test_message(googl_id_)));
+  EXPECT_EQ(store_->wait_for_update(group, since, 1ms), Result::TIMED_OUT);
+
+  // An update committed before the wait returns immediately
+  ASSERT_TRUE(store_->update_from_l2(create_test_message(msft_id_)));
+  ASSERT_EQ(store_->wait_for_update(group, since, 0ns), Result::UPDATED);
+  EXPECT_EQ(since, store_->committed_sequence());
+  EXPECT_EQ(store_->wait_for_update(group, since, 1ms), Result::TIMED_OUT);
+
+  // A sleeping waiter is woken by the commit, not by the batched write
+  std::atomic<bool> woke{false};
+  std::thread waiter([&] {
+    uint64_t waiter_since = since;
+    EXPECT_EQ(store_->wait_for_update(group, waiter_since, 10s), Result::UPDATED);
+    woke.store(true);
+  });
+  std::this_thread::sleep_for(5ms);
+  store_->begin_batch();
+  ASSERT_TRUE(store_->update_from_l2(create_test_message(aapl_id_)));
+  std::this_thread::sleep_for(5ms);
+  EXPECT_FALSE(woke.load());
+  store_->commit();
+  waiter.join();
+  EXPECT_TRUE(woke.load());
+
+  // Closed groups are reusable and stop watching
+  store_->close_wait_group(group);
+  const SecurityId single[] = {googl_id_};
+  EXPECT_EQ(store_->open_wait_group(single, 1), group);
+}
+
+TEST_F(SecurityStoreTest, WaitForUpdateNeverMissesAWakeup) {
+  using namespace std::chrono_literals;
+  ASSERT_TRUE(store_->add_security(aapl_id_));
+  const size_t group = store_->open_wait_group(&aapl_id_, 1);
+  ASSERT_NE(group, SecurityStore::NO_WAIT_GROUP);
+
+  // Ping-pong: each round the waiter must see the writer's next commit
+  constexpr int ROUNDS = 2000;
+  std::atomic<int> acknowledged{0};
+  std::thread waiter([&] {
+    uint64_t since = 0;
+    for (int round = 1; round <= ROUNDS; ++round) {
+      ASSERT_EQ(store_->wait_for_update(group, since, 10s),
+                SecurityStore::WaitResult::UPDATED);
+      acknowledged.store(round, std::memory_order_release);
+    }
+  });
+  for (int round = 1; round <= ROUNDS; ++round) {
+    ASSERT_TRUE(store_->update_from_l2(create_test_message(aapl_id_)));
+    while (acknowledged.load(std::memory_order_acquire) < round) {
+      std::this_thread::yield();
+    }
+  }
+  waiter.join();
+  store_->close_wait_group(group);
+}
+
+TEST_F(SecurityStoreTest, WaitGroupOpenedMidBatchSeesTheBatchCommit) {
+  using namespace std::chrono_literals;
+  ASSERT_TRUE(store_->add_security(aapl_id_));
+  const uint64_t since = store_->committed_sequence();
+
+  // The write reads the wait-group mask before the group exists, so its
+  // commit does not bump the group's futex word
+  store_->begin_batch();
+  ASSERT_TRUE(store_->update_from_l2(create_test_message(aapl_id_)));
+  const size_t group = store_->open_wait_group(&aapl_id_, 1);
+  ASSERT_NE(group, SecurityStore::NO_WAIT_GROUP);
+
+  std::atomic<bool> woke{false};
+  std::thread waiter([&] {
+    uint64_t waiter_since = since;
+    EXPECT_EQ(store_->wait_for_update(group, waiter_since, 10s),
+              SecurityStore::WaitResult::UPDATED);
+    woke.store(true);
+  });
+  std::this_thread::sleep_for(5ms);
+  EXPECT_FALSE(woke.load());
+  const auto committed_at = std::chrono::steady_clock::now();
+  store_->commit();
+  waiter.join();
+  EXPECT_LT(std::chrono::steady_clock::now() - committed_at, 5s);
+  store_->close_wait_group(group);
+}
+
+TEST_F(SecurityStoreTest, TradesAndBookDeltas) {
+  ASSERT_TRUE(store_->add_security(aapl_id_));
+  ASSERT_TRUE(store_->update_from_l2(create_test_message(aapl_id_)));
+
+  TradeMessage trade{};
+  trade.security_id = aapl_id_;
+  trade.timestamp_ns = 42;
+  trade.price = price_from_raw(1000200);
+  trade.quantity = 300;
+  ASSERT_TRUE(store_->apply_trade(trade));
+  ASSERT_TRUE(store_->apply_trade(trade));
+
+  SecurityStore::SecuritySnapshot snapshot;
+  ASSERT_TRUE(store_->get_security_snapshot(aapl_id_, snapshot));
+  EXPECT_EQ(snapshot.last_trade_price, price_from_raw(1000200));
+  EXPECT_EQ(snapshot.total_volume, 600u);
+  EXPECT_EQ(snapshot.last_update_ns, 42u);
+  EXPECT_EQ(snapshot.num_bid_levels, 3u); // book untouched
+
+  // Replace the best bid, then delete it: level 1 moves up
+  BookDeltaMessage delta{};
+  delta.security_id = aapl_id_;
+  delta.side = Side::BID;
+  delta.level_index = 0;
+  delta.level = {price_from_raw(1000100), 700};
+  ASSERT_TRUE(store_->apply_book_delta(delta));
+  ASSERT_TRUE(store_->get_security_snapshot(aapl_id_, snapshot));
+  EXPECT_EQ(snapshot.best_bid, price_from_raw(1000100));
+  EXPECT_EQ(snapshot.bids[0].quantity, 700u);
+
+  delta.action = DeltaAction::DELETE;
+  ASSERT_TRUE(store_->apply_book_delta(delta));
+  ASSERT_TRUE(store_->get_security_snapshot(aapl_id_, snapshot));
+  EXPECT_EQ(snapshot.num_bid_levels, 2u);
+  EXPECT_EQ(snapshot.best_bid, price_from_raw(1000000 - 50));
+  EXPECT_EQ(snapshot.bids[1].price, price_from_raw(1000000 - 100));
+  EXPECT_EQ(snapshot.bids[2].quantity, 0u);
+
+  // Emptying a side clears its best price
+  ASSERT_TRUE(store_->apply_book_delta(delta));
+  ASSERT_TRUE(store_->apply_book_delta(delta));
+  ASSERT_TRUE(store_->get_security_snapshot(aapl_id_, snapshot));
+  EXPECT_EQ(snapshot.num_bid_levels, 0u);
+  EXPECT_EQ(snapshot.best_bid, Price{0.0});
+  EXPECT_EQ(snapshot.update_count, 7u);
+
+  // SET may only append the next level: no holes below the best
+  delta.action = DeltaAction::SET;
+  delta.level_index = 1;
+  EXPECT_FALSE(store_->apply_book_delta(delta));
+  delta.level_index = 0;
+  ASSERT_TRUE(store_->apply_book_delta(delta));
+  delta.level_index = 1;
+  delta.level = {price_from_raw(1000000), 200};
+  ASSERT_TRUE(store_->apply_book_delta(delta));
+  delta.level_index = 3;
+  EXPECT_FALSE(store_->apply_book_delta(delta));
+  ASSERT_TRUE(store_->get_security_snapshot(aapl_id_, snapshot));
+  EXPECT_EQ(snapshot.num_bid_levels, 2u);
+  EXPECT_EQ(snapshot.best_bid, price_from_raw(1000100));
+  EXPECT_EQ(snapshot.bids[1].quantity, 200u);
+  EXPECT_EQ(snapshot.update_count, 9u);
+
+  // DELETE of a level the side does not have changes nothing
+  const uint64_t commit = store_->committed_sequence();
+  delta.action = DeltaAction::DELETE;
+  delta.level_index = 2;
+  EXPECT_FALSE(store_->apply_book_delta(delta));
+  delta.side = Side::ASK;
+  delta.level_index = 3;
+  EXPECT_FALSE(store_->apply_book_delta(delta));
+  delta.side = Side::BID;
+  delta.action = DeltaAction::SET;
+  ASSERT_TRUE(store_->get_security_snapshot(aapl_id_, snapshot));
+  EXPECT_EQ(snapshot.num_bid_levels, 2u);
+  EXPECT_EQ(snapshot.update_count, 9u);
+  EXPECT_EQ(store_->committed_sequence(), commit);
+
+  delta.level_index = 5;
+  EXPECT_FALSE(store_->apply_book_delta(delta));
+  delta.security_id = msft_id_;
+  delta.level_index = 0;
+  EXPECT_FALSE(store_->apply_book_delta(delta));
+  trade.security_id = msft_id_;
+  EXPECT_FALSE(store_->apply_trade(trade));
+}
@@ -0,0 +1,156 @@
+#include "market_data/security_seeder.hpp"
+#include "market_data/security_store_checkpoint.hpp"
+#include <atomic>
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace mini_mart::market_data;
+using namespace mini_mart::types;
+using mini_mart::types::price_from_raw;
+
+class SecurityStoreCheckpointTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    path_ = "/tmp/mini_mart_checkpoint_test_" + std::to_string(::getpid());
+    std::remove(path_.c_str());
+    store_ = std::make_shared<SecurityStore>();
+    aapl_id_ = SecuritySeeder::create_security_id("AAPL");
+    msft_id_ = SecuritySeeder::create_security_id("MSFT");
+  }
+
+  void TearDown() override { std::remove(path_.c_str()); }
+
+  static MarketDataL2Message create_message(const SecurityId &security_id,
+                                            uint64_t best_bid_raw,
+                                            uint64_t timestamp_ns) {
+    MarketDataL2Message message{};
+    message.header.type = static_cast<uint16_t>(MessageType::MARKET_DATA_L2);
+    message.header.length = sizeof(MarketDataL2Message);
+    message.security_id = security_id;
+    message.timestamp_ns = timestamp_ns;
+    message.num_bid_levels = 2;
+    message.bids[0] = {price_from_raw(best_bid_raw), 1000};
+    message.bids[1] = {price_from_raw(best_bid_raw - 100), 500};
+    message.num_ask_levels = 1;
+    message.asks[0] = {price_from_raw(best_bid_raw + 500), 800};
+    return message;
+  }
+
+  SecurityStoreCheckpointer::Config make_config() const {
+    SecurityStoreCheckpointer::Config config;
+    config.path = path_;
+    config.interval_ms = 5;
+    return config;
+  }
+
+  std::string path_;
+  std::shared_ptr<SecurityStore> store_;
+  SecurityId aapl_id_;
+  SecurityId msft_id_;
+};
+
+TEST_F(SecurityStoreCheckpointTest, RestoreWithoutFileFails) {
+  SecurityStore restored;
+  CheckpointError error = CheckpointError::SUCCESS;
+  EXPECT_EQ(SecurityStoreCheckpointer::restore(restored, path_, &error), -1);
+  EXPECT_EQ(error, CheckpointError::OPEN_FAILED);
+  EXPECT_EQ(restored.size(), 0u);
+}
+
+TEST_F(SecurityStoreCheckpointTest, RoundTripRestoresStaleBooks) {
+  ASSERT_TRUE(store_->add_security(aapl_id_));
+  ASSERT_TRUE(store_->add_security(msft_id_));
+  ASSERT_TRUE(store_->update_from_l2(create_message(aapl_id_, 1500000, 111)));
+  ASSERT_TRUE(store_->update_from_l2(create_message(msft_id_, 3000000, 222)));
+
+  {
+    SecurityStoreCheckpointer checkpointer(store_, make_config());
+    ASSERT_TRUE(checkpointer.checkpoint_now());
+    // Second checkpoint lands in the other region and becomes active
+    ASSERT_TRUE(store_->update_from_l2(create_message(aapl_id_, 1510000, 333)));
+    ASSERT_TRUE(checkpointer.checkpoint_now());
+    EXPECT_EQ(checkpointer.checkpoints_written(), 2u);
+  }
+
+  SecurityStore restored;
+  EXPECT_EQ(SecurityStoreCheckpointer::restore(restored, path_), 2);
+  EXPECT_EQ(restored.size(), 2u);
+
+  SecurityStore::SecuritySnapshot snapshot;
+  ASSERT_TRUE(restored.get_security_snapshot(aapl_id_, snapshot));
+  EXPECT_TRUE(snapshot.stale);
+  EXPECT_EQ(snapshot.best_bid, price_from_raw(1510000));
+  EXPECT_EQ(snapshot.last_update_ns, 333u);
+  EXPECT_EQ(snapshot.update_count, 2u);
+  EXPECT_EQ(snapshot.num_bid_levels, 2);
+  EXPECT_EQ(snapshot.bids[1].quantity, 500u);
+
+  ASSERT_TRUE(restored.get_security_snapshot(msft_id_, snapshot));
+  EXPECT_TRUE(snapshot.stale);
+  EXPECT_EQ(snapshot.best_ask, price_from_raw(3000500));
+
+  // First live update clears the stale marker
+  ASSERT_TRUE(restored.update_from_l2(create_message(aapl_id_, 1520000, 444)));
+  ASSERT_TRUE(restored.get_security_snapshot(aapl_id_, snapshot));
+  EXPECT_FALSE(snapshot.stale);
+  EXPECT_EQ(snapshot.best_bid, price_from_raw(1520000));
+}
+
+TEST_F(SecurityStoreCheckpointTest, RejectsCorruptFile) {
+  FILE *file = std::fopen(path_.c_str(), "wb");
+  ASSERT_NE(file, nullptr);
+  std::vector<char> garbage(SecurityStoreCheckpointer::FILE_SIZE, 0x5A);
+  std::fwrite(garbage.data(), 1, garbage.size(), file);
+  std::fclose(file);
+
+  SecurityStore restored;
+  CheckpointError error = CheckpointError::SUCCESS;
+  EXPECT_EQ(SecurityStoreCheckpointer::restore(restored, path_, &error), -1);
+  EXPECT_EQ(error, CheckpointError::BAD_FORMAT);
+}
+
+TEST_F(SecurityStoreCheckpointTest, BackgroundCheckpointsDuringUpdates) {
+  ASSERT_TRUE(store_->add_security(aapl_id_));
+  SecurityStoreCheckpointer checkpointer(store_, make_config());
+  ASSERT_TRUE(checkpointer.start());
+  EXPECT_FALSE(checkpointer.start());
+
+  // Writer keeps the book internally consistent: ask = bid + 500
+  std::atomic<bool> done{false};
+  std::thread writer([&] {
+    uint64_t bid = 1000000;
+    while (!done.load(std::memory_order_relaxed)) {
+      store_->update_from_l2(create_message(aapl_id_, bid, bid));
+      bid += 100;
+    }
+  });
+
+  SecurityStore::SecuritySnapshot snapshot;
+  for (int i = 0; i < 2000; ++i) {
+    ASSERT_TRUE(store_->get_security_snapshot(aapl_id_, snapshot));
+    if (snapshot.update_count > 0) {
+      ASSERT_EQ(snapshot.best_ask.raw() - snapshot.best_bid.raw(), 500u);
+      ASSERT_EQ(snapshot.bids[0].price, snapshot.best_bid);
+    }
+  }
+
+  // On-demand checkpoints interleave with the background thread's
+  for (int i = 0; i < 20; ++i) {
+    ASSERT_TRUE(checkpointer.checkpoint_now());
+  }
+  while (checkpointer.checkpoints_written() < 23) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  done.store(true);
+  writer.join();
+  checkpointer.stop();
+  EXPECT_FALSE(checkpointer.is_running());
+
+  SecurityStore restored;
+  ASSERT_EQ(SecurityStoreCheckpointer::restore(restored, path_), 1);
+  ASSERT_TRUE(restored.get_security_snapshot(aapl_id_, snapshot));
+  EXPECT_EQ(snapshot.best_ask.raw() - snapshot.best_bid.raw(), 500u);
+  EXPECT_EQ(snapshot.last_update_ns, snapshot.best_bid.raw());
+}
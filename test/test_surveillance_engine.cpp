@@ -0,0 +1,215 @@
+#include "l2_test_messages.hpp"
+#include "market_data/security_store.hpp"
+#include "market_data/surveillance_engine.hpp"
+#include <gtest/gtest.h>
+#include <memory>
+
+using namespace mini_mart::market_data;
+using namespace mini_mart::types;
+using namespace mini_mart::test;
+
+namespace {
+
+using Engine = SurveillanceEngine<SecurityStore>;
+
+constexpr uint64_t MS = 1000000;
+
+OrderEventMessage event(OrderAction action, uint64_t order_id, uint32_t participant, uint64_t timestamp_ns,
+                        Side side = Side::BID, uint64_t price_raw = 1500000, Quantity quantity = 100,
+                        const char *symbol = "AAPL") {
+  OrderEventMessage message{};
+  message.security_id = make_security_id(symbol);
+  message.timestamp_ns = timestamp_ns;
+  message.order_id = order_id;
+  message.price = price_from_raw(price_raw);
+  message.quantity = quantity;
+  message.participant_id = participant;
+  message.side = side;
+  message.action = action;
+  return message;
+}
+
+// Touch at $150.00 / $150.01
+std::shared_ptr<SecurityStore> store_with_touch() {
+  auto store = std::make_shared<SecurityStore>();
+  store->add_security(make_security_id("AAPL"));
+  store->update_from_l2(top_of_book("AAPL", 1500000, 1500100, 1, 500, 500));
+  return store;
+}
+
+} // namespace
+
+TEST(SurveillanceEngineTest, OrderToTradeRatioAlertsOncePerWindow) {
+  Engine engine(nullptr);
+  // 60 add/cancel pairs and one fill: 120 orders per execution
+  uint64_t id = 1;
+  for (uint64_t i = 0; i < 60; ++i, ++id) {
+    engine.on_message(event(OrderAction::ADD, id, 7, i * MS));
+    engine.on_message(event(OrderAction::CANCEL, id, 7, i * MS, Side::BID, 1500000, 0));
+  }
+  engine.on_message(event(OrderAction::ADD, id, 7, 60 * MS));
+  engine.on_message(event(OrderAction::EXECUTE, id, 7, 60 * MS));
+  EXPECT_EQ(engine.activity(7, Engine::ADDS), 61u);
+  EXPECT_EQ(engine.activity(7, Engine::CANCELS), 60u);
+  EXPECT_EQ(engine.activity(7, Engine::EXECUTIONS), 1u);
+  EXPECT_EQ(engine.open_orders(), 0u);
+
+  SurveillanceAlert alert;
+  ASSERT_TRUE(engine.pop_alert(alert));
+  EXPECT_EQ(alert.kind, SurveillanceAlertKind::ORDER_TO_TRADE);
+  EXPECT_EQ(alert.participant_id, 7u);
+  EXPECT_EQ(alert.observed, 100u); // tripped at the 100th order
+  EXPECT_EQ(alert.threshold, 20u);
+  EXPECT_EQ(alert.timestamp_ns, 49 * MS);
+  EXPECT_FALSE(engine.pop_alert(alert)); // suppressed for the rest of the window
+  EXPECT_EQ(engine.alerts_raised(), 1u);
+
+  // A participant that trades as much as it quotes stays quiet
+  for (uint64_t i = 0; i < 200; ++i, ++id) {
+    engine.on_message(event(OrderAction::ADD, id, 8, i * MS));
+    engine.on_message(event(OrderAction::EXECUTE, id, 8, i * MS));
+  }
+  EXPECT_FALSE(engine.pop_alert(alert));
+}
+
+TEST(SurveillanceEngineTest, CreditsCancelsAndFillsToTheOrderOwner) {
+  Engine engine(nullptr);
+  // A market maker quoting 150 orders, half filled by aggressors the
+  // venue names on the execute
+  for (uint64_t id = 1; id <= 150; ++id) {
+    engine.on_message(event(OrderAction::ADD, id, 9, id * MS));
+    if (id % 2 == 0) {
+      engine.on_message(event(OrderAction::EXECUTE, id, 20 + static_cast<uint32_t>(id % 5), id * MS));
+    }
+  }
+  engine.on_message(event(OrderAction::CANCEL, 1, 21, 200 * MS, Side::BID, 1500000, 0));
+  EXPECT_EQ(engine.activity(9, Engine::EXECUTIONS), 75u);
+  EXPECT_EQ(engine.activity(9, Engine::CANCELS), 1u);
+  EXPECT_EQ(engine.activity(21, Engine::EXECUTIONS), 0u);
+  EXPECT_EQ(engine.activity(21, Engine::CANCELS), 0u);
+  SurveillanceAlert alert;
+  EXPECT_FALSE(engine.pop_alert(alert));
+
+  // Unknown orders are counted against the participant named
+  engine.on_message(event(OrderAction::CANCEL, 999, 21, 200 * MS));
+  EXPECT_EQ(engine.activity(21, Engine::CANCELS), 1u);
+  EXPECT_EQ(engine.unmatched_events(), 1u);
+}
+
+TEST(SurveillanceEngineTest, WindowExpiresOnTheTimeWheel) {
+  SurveillanceConfig config;
+  config.min_orders_for_ratio = 10;
+  config.max_orders_per_execution = 5;
+  Engine engine(nullptr, config);
+  for (uint64_t id = 1; id <= 9; ++id) {
+    engine.on_message(event(OrderAction::ADD, id, 3, id * MS));
+  }
+  EXPECT_EQ(engine.activity(3, Engine::ADDS), 9u);
+  // Two seconds later the earlier adds have left the window
+  engine.on_message(event(OrderAction::ADD, 10, 3, 2000 * MS));
+  EXPECT_EQ(engine.activity(3, Engine::ADDS), 1u);
+  SurveillanceAlert alert;
+  EXPECT_FALSE(engine.pop_alert(alert));
+  for (uint64_t id = 11; id <= 19; ++id) {
+    engine.on_message(event(OrderAction::ADD, id, 3, 2000 * MS + id));
+  }
+  ASSERT_TRUE(engine.pop_alert(alert));
+  EXPECT_EQ(alert.kind, SurveillanceAlertKind::ORDER_TO_TRADE);
+  EXPECT_EQ(alert.observed, 10u);
+  EXPECT_EQ(engine.open_orders(), 19u);
+}
+
+TEST(SurveillanceEngineTest, RapidCancelsNearTheTouch) {
+  SurveillanceConfig config;
+  config.max_rapid_cancels = 5;
+  Engine engine(store_with_touch(), config);
+  uint64_t id = 1;
+  // Far from the touch, or resting too long: not counted
+  for (uint64_t i = 0; i < 10; ++i, ++id) {
+    engine.on_message(event(OrderAction::ADD, id, 2, i * MS, Side::BID, 1400000));
+    engine.on_message(event(OrderAction::CANCEL, id, 2, i * MS + MS));
+    engine.on_message(event(OrderAction::ADD, id + 100, 2, i * MS, Side::ASK, 1500100));
+    engine.on_message(event(OrderAction::CANCEL, id + 100, 2, i * MS + 50 * MS));
+  }
+  // Partial cancels leave the order live
+  engine.on_message(event(OrderAction::ADD, 500, 2, 20 * MS, Side::ASK, 1500200));
+  engine.on_message(event(OrderAction::CANCEL, 500, 2, 20 * MS, Side::ASK, 1500200, 40));
+  EXPECT_EQ(engine.activity(2, Engine::RAPID_CANCELS), 0u);
+  EXPECT_EQ(engine.open_orders(), 1u);
+
+  // Improving or joining the touch and pulling within 10ms
+  for (uint64_t i = 0; i < 5; ++i, ++id) {
+    engine.on_message(event(OrderAction::ADD, id, 2, 30 * MS, Side::BID, 1500000 + i * 10));
+    engine.on_message(event(OrderAction::CANCEL, id, 2, 35 * MS));
+  }
+  EXPECT_EQ(engine.activity(2, Engine::RAPID_CANCELS), 5u);
+  SurveillanceAlert alert;
+  ASSERT_TRUE(engine.pop_alert(alert));
+  EXPECT_EQ(alert.kind, SurveillanceAlertKind::RAPID_CANCELS);
+  EXPECT_EQ(alert.security_id, make_security_id("AAPL"));
+  EXPECT_EQ(alert.observed, 5u);
+  EXPECT_EQ(alert.timestamp_ns, 35 * MS);
+
+  // Unknown securities have no touch
+  engine.on_message(event(OrderAction::ADD, 900, 2, 40 * MS, Side::BID, 1500000, 100, "MSFT"));
+  engine.on_message(event(OrderAction::CANCEL, 900, 2, 40 * MS));
+  EXPECT_EQ(engine.activity(2, Engine::RAPID_CANCELS), 5u);
+}
+
+TEST(SurveillanceEngineTest, LayeringOnOppositeSideFill) {
+  Engine engine(nullptr);
+  // Three ask levels of 500 each, then a bid that gets hit
+  engine.on_message(event(OrderAction::ADD, 1, 4, MS, Side::ASK, 1500500, 500));
+  engine.on_message(event(OrderAction::ADD, 2, 4, MS, Side::ASK, 1500600, 300));
+  engine.on_message(event(OrderAction::ADD, 3, 4, MS, Side::ASK, 1500600, 200));
+  engine.on_message(event(OrderAction::ADD, 4, 4, MS, Side::BID, 1500000));
+  engine.on_message(event(OrderAction::ADD, 5, 4, MS, Side::ASK, 1500700, 100, "MSFT"));
+  engine.on_message(event(OrderAction::EXECUTE, 4, 4, 2 * MS, Side::BID, 1500000, 50));
+  SurveillanceAlert alert;
+  EXPECT_FALSE(engine.pop_alert(alert)); // two AAPL levels only
+
+  engine.on_message(event(OrderAction::ADD, 6, 4, 3 * MS, Side::ASK, 1500800, 500));
+  engine.on_message(event(OrderAction::EXECUTE, 4, 4, 4 * MS, Side::BID, 1500000, 50));
+  ASSERT_TRUE(engine.pop_alert(alert));
+  EXPECT_EQ(alert.kind, SurveillanceAlertKind::LAYERING);
+  EXPECT_EQ(alert.participant_id, 4u);
+  EXPECT_EQ(alert.observed, 3u);
+  EXPECT_EQ(alert.timestamp_ns, 4 * MS);
+
+  // Cancelling the layers clears them; a new window may alert again
+  for (uint64_t id : {1u, 2u, 3u, 6u}) {
+    engine.on_message(event(OrderAction::CANCEL, id, 4, 5 * MS, Side::ASK, 0, 0));
+  }
+  engine.on_message(event(OrderAction::ADD, 7, 4, 2000 * MS));
+  engine.on_message(event(OrderAction::EXECUTE, 7, 4, 2000 * MS));
+  EXPECT_FALSE(engine.pop_alert(alert));
+  EXPECT_EQ(engine.open_orders(), 1u); // the MSFT ask
+}
+
+TEST(SurveillanceEngineTest, CountsIgnoredUnmatchedAndDroppedAlerts) {
+  SurveillanceConfig config;
+  config.min_orders_for_ratio = 1;
+  config.max_orders_per_execution = 0; // every order alerts
+  Engine engine(nullptr, config);
+
+  // One alert per participant fills the ring; the next one is dropped
+  for (uint32_t p = 0; p < Engine::ALERT_RING_SIZE; ++p) {
+    engine.on_message(event(OrderAction::ADD, p + 1, p, 0));
+  }
+  engine.on_message(event(OrderAction::ADD, 5000, 0, MS)); // same window
+  EXPECT_EQ(engine.alerts_raised(), Engine::ALERT_RING_SIZE);
+  EXPECT_EQ(engine.alerts_dropped(), 0u);
+  engine.on_message(event(OrderAction::ADD, 5001, 0, 2000 * MS));
+  EXPECT_EQ(engine.alerts_raised(), Engine::ALERT_RING_SIZE + 1);
+  EXPECT_EQ(engine.alerts_dropped(), 1u);
+
+  EXPECT_FALSE(engine.on_message(event(OrderAction::ADD, 6000, 1024, 0)));
+  EXPECT_EQ(engine.ignored_events(), 1u);
+  EXPECT_TRUE(engine.on_message(event(OrderAction::CANCEL, 99999, 1, 0)));
+  EXPECT_EQ(engine.unmatched_events(), 1u);
+  EXPECT_TRUE(engine.on_message(event(OrderAction::ADD, 0, 1, 0))); // no id to track
+  EXPECT_TRUE(engine.on_message(event(OrderAction::ADD, 1, 1, 0))); // already live
+  EXPECT_EQ(engine.orders_dropped(), 2u);
+  EXPECT_EQ(engine.events(), Engine::ALERT_RING_SIZE + 5);
+  EXPECT_EQ(engine.open_orders(), Engine::ALERT_RING_SIZE + 2);
+}
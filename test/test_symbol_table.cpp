@@ -0,0 +1,131 @@
+#include "market_data/random_market_data_provider.hpp"
+#include "market_data/security_seeder.hpp"
+#include "market_data/security_store.hpp"
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace mini_mart::market_data;
+using namespace mini_mart::types;
+
+namespace {
+
+inline constexpr auto TEST_UNIVERSE =
+    make_symbol_table({"AAPL", "MSFT", "GOOGL", "SPY", "QQQ", "BRK.B"});
+
+using TestIndex = StaticSecurityIndex<TEST_UNIVERSE>;
+
+// Built and checked entirely at compile time
+static_assert(TEST_UNIVERSE.valid());
+static_assert(TEST_UNIVERSE.find(make_security_id("AAPL")) == 0);
+static_assert(TEST_UNIVERSE.find(make_security_id("BRK.B")) == 5);
+static_assert(TEST_UNIVERSE.find(make_security_id("TSLA")) ==
+              TEST_UNIVERSE.NOT_FOUND);
+static_assert(!make_symbol_table({"AAPL", "MSFT", "AAPL"}).valid());
+
+// "AA", "AB", ... packed back to back
+inline constexpr auto TWO_LETTER_SYMBOLS = [] {
+  std::array<char, 400> chars{};
+  for (size_t i = 0; i < 200; ++i) {
+    chars[2 * i] = static_cast<char>('A' + i / 26);
+    chars[2 * i + 1] = static_cast<char>('A' + i % 26);
+  }
+  return chars;
+}();
+
+MarketDataL2Message create_message(const SecurityId &security_id, uint64_t bid) {
+  MarketDataL2Message message{};
+  message.security_id = security_id;
+  message.timestamp_ns = bid;
+  message.num_bid_levels = 1;
+  message.bids[0] = {price_from_raw(bid), 100};
+  message.num_ask_levels = 1;
+  message.asks[0] = {price_from_raw(bid + 100), 100};
+  return message;
+}
+
+} // namespace
+
+TEST(StaticSymbolTableTest, DenseIndicesForEverySymbol) {
+  for (uint32_t i = 0; i < TEST_UNIVERSE.size(); ++i) {
+    const SecurityId id = TEST_UNIVERSE.symbol(i);
+    EXPECT_EQ(TEST_UNIVERSE.find(id), i);
+  }
+  EXPECT_FALSE(TEST_UNIVERSE.contains(make_security_id("")));
+  EXPECT_FALSE(TEST_UNIVERSE.contains(make_security_id("AAPLX")));
+  EXPECT_EQ(make_security_id("AAPL"), SecuritySeeder::create_security_id("AAPL"));
+}
+
+TEST(StaticSymbolTableTest, LargeUniverseHasPerfectHash) {
+  constexpr auto table = [] {
+    std::array<std::string_view, 200> symbols{};
+    for (size_t i = 0; i < symbols.size(); ++i) {
+      symbols[i] = std::string_view(TWO_LETTER_SYMBOLS.data() + 2 * i, 2);
+    }
+    return StaticSymbolTable<200>(symbols);
+  }();
+  static_assert(table.valid());
+  for (uint32_t i = 0; i < table.size(); ++i) {
+    EXPECT_EQ(table.find(table.symbol(i)), i);
+  }
+}
+
+TEST(StaticSymbolTableTest, SeederBasePriceById) {
+  EXPECT_EQ(SecuritySeeder::get_base_price(make_security_id("AAPL")), 175.0);
+  EXPECT_EQ(SecuritySeeder::get_base_price(make_security_id("NFLX")), 450.0);
+  EXPECT_EQ(SecuritySeeder::get_base_price(make_security_id("ZZZZ"), 12.5), 12.5);
+  for (const auto &entry : SecuritySeeder::MAJOR_US_EQUITIES) {
+    EXPECT_EQ(SecuritySeeder::get_base_price(make_security_id(entry.symbol)),
+              SecuritySeeder::get_base_price(std::string(entry.symbol)));
+  }
+}
+
+TEST(StaticSymbolTableTest, StoreWithStaticIndex) {
+  BasicSecurityStore<TestIndex> store;
+  EXPECT_EQ(store.MAX_SECURITIES, 6u);
+
+  const SecurityId spy = make_security_id("SPY");
+  EXPECT_TRUE(store.add_security(spy));
+  EXPECT_FALSE(store.add_security(spy));
+  EXPECT_FALSE(store.add_security(make_security_id("TSLA")));
+  EXPECT_EQ(store.size(), 1u);
+
+  EXPECT_TRUE(store.update_from_l2(create_message(spy, 4500000)));
+  EXPECT_FALSE(store.update_from_l2(create_message(make_security_id("QQQ"), 1)));
+
+  BasicSecurityStore<TestIndex>::SecuritySnapshot snapshot;
+  ASSERT_TRUE(store.get_security_snapshot(spy, snapshot));
+  EXPECT_EQ(snapshot.best_bid, price_from_raw(4500000));
+
+  EXPECT_TRUE(store.remove_security(spy));
+  EXPECT_FALSE(store.contains(spy));
+  EXPECT_TRUE(store.add_security(spy));
+  EXPECT_EQ(store.get_all_securities().size(), 1u);
+}
+
+TEST(StaticSymbolTableTest, ProviderWithStaticIndex) {
+  BasicRandomMarketDataProvider<TestIndex>::Config config;
+  config.update_interval_us = 100;
+  BasicRandomMarketDataProvider<TestIndex> provider(config);
+
+  EXPECT_TRUE(provider.subscribe(make_security_id("AAPL")));
+  EXPECT_FALSE(provider.subscribe(make_security_id("AAPL")));
+  EXPECT_FALSE(provider.subscribe(make_security_id("TSLA")));
+
+  std::atomic<int> received{0};
+  std::atomic<bool> wrong_symbol{false};
+  provider.set_callback([&](const MarketDataL2Message &message) {
+    if (message.security_id != make_security_id("AAPL")) {
+      wrong_symbol.store(true);
+    }
+    received.fetch_add(1);
+  });
+
+  ASSERT_TRUE(provider.start());
+  while (received.load() < 10) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  provider.stop();
+  EXPECT_FALSE(wrong_symbol.load());
+  EXPECT_TRUE(provider.unsubscribe(make_security_id("AAPL")));
+  EXPECT_TRUE(provider.get_subscribed_securities().empty());
+}
@@ -0,0 +1,341 @@
+#include "common/chase_lev_deque.hpp"
+#include "common/mpmc_ring.hpp"
+#include "common/work_stealing_pool.hpp"
+#include <gtest/gtest.h>
+#include <sched.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace mini_mart::common;
+
+TEST(ChaseLevDequeTest, OwnerPushPopIsLifo) {
+  ChaseLevDeque<int *, 8> deque;
+  int values[3] = {1, 2, 3};
+
+  for (auto &v : values) {
+    EXPECT_TRUE(deque.try_push(&v));
+  }
+  EXPECT_EQ(deque.size(), 3u);
+
+  int *out = nullptr;
+  EXPECT_TRUE(deque.try_pop(out));
+  EXPECT_EQ(*out, 3);
+  EXPECT_TRUE(deque.try_pop(out));
+  EXPECT_EQ(*out, 2);
+  EXPECT_TRUE(deque.try_pop(out));
+  EXPECT_EQ(*out, 1);
+  EXPECT_FALSE(deque.try_pop(out));
+  EXPECT_TRUE(deque.empty());
+}
+
+TEST(ChaseLevDequeTest, StealIsFifo) {
+  ChaseLevDeque<int *, 8> deque;
+  int values[3] = {1, 2, 3};
+
+  for (auto &v : values) {
+    EXPECT_TRUE(deque.try_push(&v));
+  }
+
+  int *out = nullptr;
+  EXPECT_TRUE(deque.try_steal(out));
+  EXPECT_EQ(*out, 1);
+  EXPECT_TRUE(deque.try_pop(out));
+  EXPECT_EQ(*out, 3);
+  EXPECT_TRUE(deque.try_steal(out));
+  EXPECT_EQ(*out, 2);
+  EXPECT_FALSE(deque.try_steal(out));
+}
+
+TEST(ChaseLevDequeTest, PushFailsWhenFull) {
+  ChaseLevDeque<int *, 4> deque;
+  int value = 0;
+
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(deque.try_push(&value));
+  }
+  EXPECT_FALSE(deque.try_push(&value));
+
+  int *out = nullptr;
+  EXPECT_TRUE(deque.try_steal(out));
+  EXPECT_TRUE(deque.try_push(&value));
+}
+
+TEST(ChaseLevDequeTest, ConcurrentStealNoLossNoDuplicates) {
+  constexpr int num_items = 20000;
+  ChaseLevDeque<int *, 1024> deque;
+  std::vector<int> items(num_items);
+  std::vector<std::atomic<int>> seen(num_items);
+  std::atomic<bool> done{false};
+
+  auto record = [&](int *p) { seen[static_cast<size_t>(p - items.data())]++; };
+
+  std::vector<std::thread> thieves;
+  for (int t = 0; t < 2; ++t) {
+    thieves.emplace_back([&]() {
+      int *out = nullptr;
+      while (!done.load() || !deque.empty()) {
+        if (deque.try_steal(out)) {
+          record(out);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  int *out = nullptr;
+  for (int i = 0; i < num_items; ++i) {
+    while (!deque.try_push(&items[static_cast<size_t>(i)])) {
+      if (deque.try_pop(out)) {
+        record(out);
+      }
+    }
+    if (i % 3 == 0 && deque.try_pop(out)) {
+      record(out);
+    }
+  }
+  while (deque.try_pop(out)) {
+    record(out);
+  }
+  done.store(true);
+  for (auto &thief : thieves) {
+    thief.join();
+  }
+
+  for (int i = 0; i < num_items; ++i) {
+    EXPECT_EQ(seen[static_cast<size_t>(i)].load(), 1) << "item " << i;
+  }
+}
+
+TEST(MpmcRingTest, PushPopAndCapacity) {
+  MpmcRing<int, 4> ring;
+  EXPECT_EQ(ring.get_capacity(), 4u);
+  EXPECT_TRUE(ring.empty());
+
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(ring.try_push(i));
+  }
+  EXPECT_FALSE(ring.try_push(99));
+  EXPECT_EQ(ring.size(), 4u);
+
+  int value = -1;
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(ring.try_pop(value));
+    EXPECT_EQ(value, i);
+  }
+  EXPECT_FALSE(ring.try_pop(value));
+}
+
+TEST(MpmcRingTest, MultipleProducersConsumers) {
+  constexpr int per_producer = 5000;
+  constexpr int num_producers = 3;
+  MpmcRing<int, 256> ring;
+  std::atomic<long> sum{0};
+  std::atomic<int> consumed{0};
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < num_producers; ++p) {
+    threads.emplace_back([&ring, p]() {
+      for (int i = 1; i <= per_producer; ++i) {
+        while (!ring.try_push(p * per_producer + i)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (int c = 0; c < 2; ++c) {
+    threads.emplace_back([&]() {
+      int value;
+      while (consumed.load() < num_producers * per_producer) {
+        if (ring.try_pop(value)) {
+          sum.fetch_add(value);
+          consumed.fetch_add(1);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  const long n = num_producers * per_producer;
+  EXPECT_EQ(consumed.load(), n);
+  EXPECT_EQ(sum.load(), n * (n + 1) / 2);
+}
+
+class WorkStealingPoolTest : public ::testing::Test {
+protected:
+  static WorkStealingPool::Config make_config(size_t workers) {
+    WorkStealingPool::Config config;
+    config.num_workers = workers;
+    config.idle_sleep_us = 10;
+    return config;
+  }
+
+  static long fib(WorkStealingPool &pool, int n) {
+    if (n < 12) {
+      return n < 2 ? n : fib(pool, n - 1) + fib(pool, n - 2);
+    }
+    long a = 0;
+    WorkStealingPool::TaskGroup group;
+    if (!pool.submit(group, [&]() { a = fib(pool, n - 1); })) {
+      a = fib(pool, n - 1);
+    }
+    long b = fib(pool, n - 2);
+    pool.wait(group);
+    return a + b;
+  }
+};
+
+TEST_F(WorkStealingPoolTest, StartStop) {
+  WorkStealingPool pool(make_config(2));
+  EXPECT_FALSE(pool.is_running());
+  EXPECT_FALSE(pool.submit([]() {}));
+
+  EXPECT_TRUE(pool.start());
+  EXPECT_TRUE(pool.is_running());
+  EXPECT_FALSE(pool.start());
+  EXPECT_EQ(pool.worker_count(), 2u);
+
+  pool.stop();
+  EXPECT_FALSE(pool.is_running());
+  EXPECT_TRUE(pool.start());
+}
+
+TEST_F(WorkStealingPoolTest, RunsAllSubmittedTasks) {
+  WorkStealingPool pool(make_config(3));
+  ASSERT_TRUE(pool.start());
+
+  constexpr int num_tasks = 2000;
+  std::atomic<int> counter{0};
+  WorkStealingPool::TaskGroup group;
+  for (int i = 0; i < num_tasks; ++i) {
+    while (!pool.submit(group, [&counter]() { counter.fetch_add(1); })) {
+      std::this_thread::yield();
+    }
+  }
+  pool.wait(group);
+
+  EXPECT_TRUE(group.done());
+  EXPECT_EQ(counter.load(), num_tasks);
+  auto stats = pool.get_statistics();
+  EXPECT_EQ(stats.tasks_executed, static_cast<uint64_t>(num_tasks));
+  EXPECT_EQ(stats.tasks_submitted, static_cast<uint64_t>(num_tasks));
+}
+
+TEST_F(WorkStealingPoolTest, NestedForkJoin) {
+  WorkStealingPool pool(make_config(2));
+  ASSERT_TRUE(pool.start());
+
+  long result = 0;
+  WorkStealingPool::TaskGroup group;
+  ASSERT_TRUE(pool.submit(group, [&]() { result = fib(pool, 22); }));
+  pool.wait(group);
+
+  EXPECT_EQ(result, 17711);
+}
+
+TEST_F(WorkStealingPoolTest, WorkerSpawnsPastFullQueuesStillRun) {
+  WorkStealingPool pool(make_config(1));
+  ASSERT_TRUE(pool.start());
+
+  // More than the deque and inbox hold: the rest run inline
+  constexpr size_t num_tasks =
+      WorkStealingPool::DEQUE_CAPACITY + WorkStealingPool::INBOX_CAPACITY + 100;
+  std::atomic<size_t> counter{0};
+  std::atomic<size_t> failures{0};
+  WorkStealingPool::TaskGroup group;
+  ASSERT_TRUE(pool.submit(group, [&]() {
+    for (size_t i = 0; i < num_tasks; ++i) {
+      if (!pool.submit(group, [&counter]() { counter.fetch_add(1); })) {
+        failures.fetch_add(1);
+      }
+    }
+  }));
+  // Not wait(): the spawning task must run on the worker, not be stolen here
+  while (!group.done()) {
+    std::this_thread::yield();
+  }
+
+  EXPECT_EQ(failures.load(), 0u);
+  EXPECT_EQ(counter.load(), num_tasks);
+  EXPECT_EQ(pool.get_statistics().submit_failures, 0u);
+}
+
+TEST_F(WorkStealingPoolTest, AffinityHintReachesWorkerInbox) {
+  WorkStealingPool pool(make_config(2));
+  ASSERT_TRUE(pool.start());
+
+  std::atomic<size_t> ran_on{WorkStealingPool::NO_AFFINITY};
+  WorkStealingPool::TaskGroup group;
+  ASSERT_TRUE(pool.submit(
+      group, [&]() { ran_on.store(pool.current_worker_index()); }, 1));
+  pool.wait(group);
+
+  // The hint is a preference; an idle worker (or the waiter) may steal it
+  EXPECT_NE(ran_on.load(), 2u);
+  EXPECT_EQ(pool.current_worker_index(), WorkStealingPool::NO_AFFINITY);
+}
+
+TEST_F(WorkStealingPoolTest, ExcludedCoresAreNotAllowed) {
+  cpu_set_t process_cores;
+  ASSERT_EQ(sched_getaffinity(0, sizeof(cpu_set_t), &process_cores), 0);
+  const std::vector<int> all_cores = WorkStealingPool::compute_allowed_cores({});
+  ASSERT_EQ(static_cast<int>(all_cores.size()), CPU_COUNT(&process_cores));
+  for (int core : all_cores) {
+    EXPECT_TRUE(CPU_ISSET(static_cast<size_t>(core), &process_cores));
+  }
+
+  auto allowed = WorkStealingPool::compute_allowed_cores({all_cores.front()});
+  EXPECT_EQ(allowed.size(), all_cores.size() - 1);
+  EXPECT_EQ(std::find(allowed.begin(), allowed.end(), all_cores.front()), allowed.end());
+
+  // Nothing left to run on, pinned or not
+  for (bool pin : {true, false}) {
+    WorkStealingPool::Config config = make_config(1);
+    config.pin_threads = pin;
+    config.excluded_cores = all_cores;
+    WorkStealingPool pool(config);
+    EXPECT_FALSE(pool.start());
+  }
+}
+
+TEST_F(WorkStealingPoolTest, UnpinnedWorkersStayOffExcludedCores) {
+  const std::vector<int> all_cores = WorkStealingPool::compute_allowed_cores({});
+  if (all_cores.size() < 2) {
+    GTEST_SKIP() << "needs at least two cores in the process cpuset";
+  }
+  const int excluded = all_cores.front();
+  WorkStealingPool::Config config = make_config(2);
+  config.excluded_cores = {excluded};
+  ASSERT_FALSE(config.pin_threads);
+  WorkStealingPool pool(config);
+  ASSERT_TRUE(pool.start());
+
+  // Not wait(): the waiting thread could run the tasks itself
+  std::atomic<int> on_excluded{0};
+  std::atomic<int> cores_seen{0};
+  std::atomic<size_t> done{0};
+  for (size_t worker = 0; worker < pool.worker_count(); ++worker) {
+    ASSERT_TRUE(pool.submit(
+        [&] {
+          cpu_set_t cores;
+          if (sched_getaffinity(0, sizeof(cpu_set_t), &cores) == 0) {
+            on_excluded.fetch_add(CPU_ISSET(static_cast<size_t>(excluded), &cores) ? 1 : 0);
+            cores_seen.store(CPU_COUNT(&cores));
+          }
+          done.fetch_add(1, std::memory_order_release);
+        },
+        worker));
+  }
+  while (done.load(std::memory_order_acquire) < pool.worker_count()) {
+    std::this_thread::yield();
+  }
+
+  EXPECT_EQ(on_excluded.load(), 0);
+  EXPECT_EQ(static_cast<size_t>(cores_seen.load()), all_cores.size() - 1);
+}